@@ -24,6 +24,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 
+#include <arrow/compute/api_vector.h>
 #include <arrow/csv/reader.h>
 #include <arrow/io/api.h>
 #include <arrow/json/reader.h>
@@ -33,6 +34,9 @@
 #include <parquet/arrow/reader.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
+#include <utility>
 
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
@@ -82,6 +86,149 @@ size_t columnIndex(int col_id) {
   return static_cast<size_t>(col_id - 1000);
 }
 
+// Thrown by streaming import when the reader cannot convert a block to the column
+// types, e.g. when types inferred from the first block are too narrow for the
+// following blocks.
+class BlockConversionError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+struct CsvReaderOptions {
+  arrow::csv::ReadOptions read = arrow::csv::ReadOptions::Defaults();
+  arrow::csv::ParseOptions parse = arrow::csv::ParseOptions::Defaults();
+  arrow::csv::ConvertOptions convert = arrow::csv::ConvertOptions::Defaults();
+};
+
+CsvReaderOptions getCsvReaderOptions(hdk::ir::Context& ctx,
+                                     const ArrowStorage::CsvParseOptions& parse_options,
+                                     const ColumnInfoList& col_infos) {
+  CsvReaderOptions res;
+
+  res.parse.quoting = false;
+  res.parse.escaping = false;
+  res.parse.newlines_in_values = false;
+  res.parse.delimiter = parse_options.delimiter;
+
+  res.read.use_threads = true;
+  res.read.block_size = parse_options.block_size;
+  res.read.autogenerate_column_names = !parse_options.header && col_infos.empty();
+  res.read.skip_rows = parse_options.skip_rows;
+
+  res.convert.check_utf8 = false;
+  res.convert.include_columns = res.read.column_names;
+  res.convert.strings_can_be_null = true;
+
+  for (auto& col_info : col_infos) {
+    if (!col_info->is_rowid) {
+      if (!parse_options.header) {
+        res.read.column_names.push_back(col_info->name);
+      }
+      if (col_info->type) {
+        res.convert.column_types.emplace(col_info->name,
+                                         getArrowImportType(ctx, col_info->type));
+      }
+    }
+  }
+
+  return res;
+}
+
+struct JsonReaderOptions {
+  arrow::json::ReadOptions read = arrow::json::ReadOptions::Defaults();
+  arrow::json::ParseOptions parse = arrow::json::ParseOptions::Defaults();
+};
+
+JsonReaderOptions getJsonReaderOptions(
+    hdk::ir::Context& ctx,
+    const ArrowStorage::JsonParseOptions& parse_options,
+    const ColumnInfoList& col_infos) {
+  arrow::FieldVector fields;
+  fields.reserve(col_infos.size());
+  for (auto& col_info : col_infos) {
+    if (!col_info->is_rowid) {
+      fields.emplace_back(
+          std::make_shared<arrow::Field>(col_info->name,
+                                         getArrowImportType(ctx, col_info->type),
+                                         col_info->type->nullable()));
+    }
+  }
+  auto schema = std::make_shared<arrow::Schema>(std::move(fields));
+
+  JsonReaderOptions res;
+  res.parse.newlines_in_values = false;
+  res.parse.explicit_schema = schema;
+
+  res.read.use_threads = true;
+  res.read.block_size = parse_options.block_size;
+
+  return res;
+}
+
+std::shared_ptr<arrow::io::InputStream> openInputFile(const std::string& file_name) {
+  auto file_result = arrow::io::ReadableFile::Open(file_name.c_str());
+  ARROW_THROW_NOT_OK(file_result.status());
+  return file_result.ValueOrDie();
+}
+
+std::shared_ptr<arrow::Array> makeDataPlaceholder(std::shared_ptr<arrow::DataType> type,
+                                                  int64_t length) {
+  return arrow::MakeArray(
+      arrow::ArrayData::Make(std::move(type), length, {nullptr, nullptr}, 0));
+}
+
+/**
+ * Get number of Arrow array elements used for a single row. Fixed length arrays
+ * are stored as flat arrays of their elements.
+ */
+size_t elemsPerRow(const hdk::ir::Type* type) {
+  if (type->isFixedLenArray()) {
+    return type->size() / type->as<hdk::ir::ArrayBaseType>()->elemType()->size();
+  }
+  return 1;
+}
+
+/**
+ * Replace the specified slice of a chunked array with new data. Data out of
+ * the slice is not copied.
+ */
+std::shared_ptr<arrow::ChunkedArray> replaceSlice(
+    std::shared_ptr<arrow::ChunkedArray> arr,
+    size_t offset,
+    size_t length,
+    std::shared_ptr<arrow::Array> data) {
+  arrow::ArrayVector chunks = arr->Slice(0, offset)->chunks();
+  if (data->length()) {
+    chunks.push_back(std::move(data));
+  }
+  for (auto& chunk : arr->Slice(offset + length)->chunks()) {
+    chunks.push_back(chunk);
+  }
+  return arrow::ChunkedArray::Make(std::move(chunks), arr->type()).ValueOrDie();
+}
+
+/**
+ * Build a new array from specified rows of concatenated chunks.
+ */
+std::shared_ptr<arrow::Array> takeRows(const arrow::ArrayVector& chunks,
+                                       const std::vector<int64_t>& rows,
+                                       size_t elems_per_row) {
+  arrow::Int64Builder builder;
+  ARROW_THROW_NOT_OK(builder.Reserve(rows.size() * elems_per_row));
+  for (auto row : rows) {
+    for (int64_t i = 0; i < static_cast<int64_t>(elems_per_row); ++i) {
+      builder.UnsafeAppend(row * static_cast<int64_t>(elems_per_row) + i);
+    }
+  }
+  std::shared_ptr<arrow::Array> indices;
+  ARROW_THROW_NOT_OK(builder.Finish(&indices));
+  std::shared_ptr<arrow::Array> values;
+  ARROW_ASSIGN_OR_THROW(values, arrow::Concatenate(chunks));
+  std::shared_ptr<arrow::Array> res;
+  ARROW_ASSIGN_OR_THROW(res, arrow::compute::Take(*values, *indices));
+  return res;
+}
+
 }  // anonymous namespace
 
 void ArrowStorage::fetchBuffer(const ChunkKey& key,
@@ -95,7 +242,8 @@ void ArrowStorage::fetchBuffer(const ChunkKey& key,
   data_lock.unlock();
 
   size_t col_idx = columnIndex(key[CHUNK_KEY_COLUMN_IDX]);
-  size_t frag_idx = static_cast<size_t>(key[CHUNK_KEY_FRAGMENT_IDX] - 1);
+  CHECK_EQ(table.frag_idx_by_id.count(key[CHUNK_KEY_FRAGMENT_IDX]), (size_t)1);
+  size_t frag_idx = table.frag_idx_by_id.at(key[CHUNK_KEY_FRAGMENT_IDX]);
   CHECK_LT(frag_idx, table.fragments.size());
   CHECK_LT(col_idx, table.col_data.size());
 
@@ -104,7 +252,9 @@ void ArrowStorage::fetchBuffer(const ChunkKey& key,
           key[CHUNK_KEY_DB_IDX], key[CHUNK_KEY_TABLE_IDX], key[CHUNK_KEY_COLUMN_IDX])
           ->type;
   dest->reserve(num_bytes);
-  if (!col_type->isVarLen()) {
+  if (is_packed_data_key(key)) {
+    fetchPackedData(table, frag_idx, col_idx, dest, num_bytes);
+  } else if (!col_type->isVarLen()) {
     CHECK_EQ(key.size(), (size_t)4);
     size_t elem_size = col_type->size();
     fetchFixedLenData(table, frag_idx, col_idx, dest, num_bytes, elem_size);
@@ -157,10 +307,23 @@ std::unique_ptr<AbstractDataToken> ArrowStorage::getZeroCopyBufferMemory(
 
   if (!col_type->isVarLen()) {
     size_t col_idx = columnIndex(key[CHUNK_KEY_COLUMN_IDX]);
-    size_t frag_idx = static_cast<size_t>(key[CHUNK_KEY_FRAGMENT_IDX] - 1);
+    CHECK_EQ(table.frag_idx_by_id.count(key[CHUNK_KEY_FRAGMENT_IDX]), (size_t)1);
+    size_t frag_idx = table.frag_idx_by_id.at(key[CHUNK_KEY_FRAGMENT_IDX]);
+    auto& frag = table.fragments[frag_idx];
+    if (is_packed_data_key(key)) {
+      auto packed = frag.packed[col_idx];
+      CHECK(packed);
+      const int8_t* ptr = packed->data()->GetValues<int8_t>(1);
+      size_t size = static_cast<size_t>(packed->length());
+      return std::make_unique<ArrowChunkDataToken>(
+          std::move(packed), col_type, ptr, size);
+    }
     CHECK_EQ(key.size(), (size_t)4);
+    // Packed fragments have no plain data to share, they are decoded on fetch.
+    if (frag.packed[col_idx]) {
+      return nullptr;
+    }
     size_t elem_size = col_type->size();
-    auto& frag = table.fragments[frag_idx];
     size_t rows_to_fetch = num_bytes ? num_bytes / elem_size : frag.row_count;
     const auto* fixed_type =
         dynamic_cast<const arrow::FixedWidthType*>(table.col_data[col_idx]->type().get());
@@ -195,6 +358,13 @@ void ArrowStorage::fetchFixedLenData(const TableData& table,
                                      size_t elem_size) const {
   auto& frag = table.fragments[frag_idx];
   size_t rows_to_fetch = num_bytes ? num_bytes / elem_size : frag.row_count;
+  if (frag.packed[col_idx]) {
+    unpackFixedLenData(frag.packed[col_idx]->data()->GetValues<int8_t>(1),
+                       rows_to_fetch,
+                       elem_size,
+                       dest->getMemoryPtr());
+    return;
+  }
   const auto* fixed_type =
       dynamic_cast<const arrow::FixedWidthType*>(table.col_data[col_idx]->type().get());
   CHECK(fixed_type);
@@ -216,6 +386,17 @@ void ArrowStorage::fetchFixedLenData(const TableData& table,
   }
 }
 
+void ArrowStorage::fetchPackedData(const TableData& table,
+                                   size_t frag_idx,
+                                   size_t col_idx,
+                                   Data_Namespace::AbstractBuffer* dest,
+                                   size_t num_bytes) const {
+  auto& packed = table.fragments[frag_idx].packed[col_idx];
+  CHECK(packed);
+  CHECK_EQ(num_bytes, static_cast<size_t>(packed->length()));
+  memcpy(dest->getMemoryPtr(), packed->data()->GetValues<int8_t>(1), num_bytes);
+}
+
 void ArrowStorage::fetchVarLenOffsets(const TableData& table,
                                       size_t frag_idx,
                                       size_t col_idx,
@@ -309,7 +490,7 @@ TableFragmentsInfo ArrowStorage::getTableMetadata(int db_id, int table_id) const
   for (size_t frag_idx = 0; frag_idx < table.fragments.size(); ++frag_idx) {
     auto& frag = table.fragments[frag_idx];
     auto& frag_info = res.fragments.emplace_back();
-    frag_info.fragmentId = static_cast<int>(frag_idx + 1);
+    frag_info.fragmentId = frag.id;
     frag_info.physicalTableId = table_id;
     frag_info.setPhysicalNumTuples(frag.row_count);
     frag_info.deviceIds.push_back(0);  // Data_Namespace::DISK_LEVEL
@@ -659,6 +840,7 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
   fragments.resize(frag_count);
   for (auto& frag : fragments) {
     frag.metadata.resize(at->columns().size());
+    frag.packed.resize(at->columns().size());
   }
 
   mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
@@ -809,7 +991,16 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
   });  // each column
   dict_lock.unlock();
 
+  size_t first_changed_frag = 0;
+  bool repack_last_frag = false;
   if (table.row_count) {
+    // Packed data of the last fragment is going to be extended, so decode it.
+    first_changed_frag = table.fragments.size();
+    if (table.fragments.back().row_count < table.fragment_size) {
+      first_changed_frag = table.fragments.size() - 1;
+      repack_last_frag = unpackFragment(table_id, table, first_changed_frag);
+    }
+
     // If table is not empty then we have to merge chunked arrays.
     CHECK_EQ(table.col_data.size(), col_data.size());
     for (size_t i = 0; i < table.col_data.size(); ++i) {
@@ -837,13 +1028,22 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
             std::make_shared<ChunkMetadata>(col_type, num_bytes, num_elems, stats);
       }
       start_frag = 1;
+
+      // New packing of the extended fragment can have another base and bit width
+      // with the same packed size. Cached chunks of the fragment would still look
+      // valid to buffer managers, so the fragment gets a new id.
+      if (repack_last_frag) {
+        renewFragmentId(table_id, table, table.fragments.size() - 1);
+      }
     }
 
     // Copy the rest of fragments adjusting offset.
     table.fragments.reserve(table.fragments.size() + fragments.size() - start_frag);
     for (size_t frag_idx = start_frag; frag_idx < fragments.size(); ++frag_idx) {
-      table.fragments.emplace_back(std::move(fragments[frag_idx]));
-      table.fragments.back().offset += table.row_count;
+      auto& frag = table.fragments.emplace_back(std::move(fragments[frag_idx]));
+      frag.offset += table.row_count;
+      frag.id = table.next_frag_id++;
+      table.frag_idx_by_id[frag.id] = table.fragments.size() - 1;
     }
 
     table.row_count += at->num_rows();
@@ -851,12 +1051,488 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
     CHECK_EQ(table.row_count, (size_t)0);
     table.col_data = std::move(col_data);
     table.fragments = std::move(fragments);
+    table.frag_idx_by_id.clear();
+    for (size_t frag_idx = 0; frag_idx < table.fragments.size(); ++frag_idx) {
+      table.fragments[frag_idx].id = table.next_frag_id++;
+      table.frag_idx_by_id[table.fragments[frag_idx].id] = frag_idx;
+    }
     table.row_count = at->num_rows();
   }
 
+  if (config_->storage.enable_column_compression) {
+    packFragments(table_id, table, first_changed_frag, table.fragments.size());
+  }
+
   auto table_info = getTableInfo(db_id_, table_id);
   table_info->fragments = table.fragments.size();
   table_info->row_count = table.row_count;
+  ++table_info->data_version;
+
+  auto retired_keys = std::exchange(table.retired_chunk_keys, {});
+  table_lock.unlock();
+  retireChunks(retired_keys);
+}
+
+void ArrowStorage::packFragments(int table_id,
+                                 TableData& table,
+                                 size_t start_frag,
+                                 size_t end_frag) {
+  if (start_frag >= end_frag) {
+    return;
+  }
+
+  auto col_count = table.col_data.size();
+  tbb::parallel_for(tbb::blocked_range(size_t(0), col_count), [&](auto range) {
+    for (size_t col_idx = range.begin(); col_idx != range.end(); ++col_idx) {
+      auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+      std::vector<bool> pack_frag(end_frag, false);
+      bool has_packed = false;
+      for (size_t frag_idx = start_frag; frag_idx < end_frag; ++frag_idx) {
+        auto& frag = table.fragments[frag_idx];
+        CHECK(!frag.packed[col_idx]);
+        pack_frag[frag_idx] =
+            frag.row_count &&
+            getPackedBitWidth(col_type, frag.metadata[col_idx]->chunkStats()) >= 0;
+        has_packed = has_packed || pack_frag[frag_idx];
+      }
+      if (!has_packed) {
+        continue;
+      }
+
+      // Rebuild the column so that no chunk references plain data of packed
+      // fragments. Plain fragments sharing buffers with packed ones are copied.
+      auto col_arr = table.col_data[col_idx];
+      arrow::ArrayVector chunks =
+          col_arr->Slice(0, table.fragments[start_frag].offset)->chunks();
+      for (size_t frag_idx = start_frag; frag_idx < end_frag; ++frag_idx) {
+        auto& frag = table.fragments[frag_idx];
+        auto frag_arr = col_arr->Slice(frag.offset, frag.row_count);
+        if (!pack_frag[frag_idx]) {
+          if (frag.row_count) {
+            chunks.push_back(arrow::Concatenate(frag_arr->chunks()).ValueOrDie());
+          }
+          continue;
+        }
+
+        auto meta = std::make_shared<ChunkMetadata>(*frag.metadata[col_idx]);
+        frag.packed[col_idx] = packFixedLenData(frag_arr, col_type, meta->chunkStats());
+        meta->setPackedNumBytes(static_cast<size_t>(frag.packed[col_idx]->length()));
+        frag.metadata[col_idx] = meta;
+        chunks.push_back(makeDataPlaceholder(col_arr->type(), frag.row_count));
+      }
+      auto& last_frag = table.fragments[end_frag - 1];
+      auto tail = col_arr->Slice(last_frag.offset + last_frag.row_count);
+      for (auto& chunk : tail->chunks()) {
+        chunks.push_back(chunk);
+      }
+      table.col_data[col_idx] =
+          arrow::ChunkedArray::Make(std::move(chunks), col_arr->type()).ValueOrDie();
+    }
+  });
+}
+
+bool ArrowStorage::unpackFragment(int table_id, TableData& table, size_t frag_idx) {
+  auto& frag = table.fragments[frag_idx];
+  bool has_packed = false;
+  for (size_t col_idx = 0; col_idx < frag.packed.size(); ++col_idx) {
+    if (!frag.packed[col_idx]) {
+      continue;
+    }
+    has_packed = true;
+
+    auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+    auto col_arr = table.col_data[col_idx];
+    table.col_data[col_idx] = replaceSlice(
+        col_arr,
+        frag.offset,
+        frag.row_count,
+        unpackFixedLenData(
+            frag.packed[col_idx], frag.row_count, col_type, col_arr->type()));
+
+    frag.packed[col_idx].reset();
+    auto meta = std::make_shared<ChunkMetadata>(*frag.metadata[col_idx]);
+    meta->setPackedNumBytes(0);
+    frag.metadata[col_idx] = meta;
+  }
+  return has_packed;
+}
+
+void ArrowStorage::renewFragmentId(int table_id, TableData& table, size_t frag_idx) {
+  auto& frag = table.fragments[frag_idx];
+  for (size_t col_idx = 0; col_idx < table.col_data.size(); ++col_idx) {
+    table.retired_chunk_keys.push_back({db_id_, table_id, columnId(col_idx), frag.id});
+  }
+  table.frag_idx_by_id.erase(frag.id);
+  frag.id = table.next_frag_id++;
+  table.frag_idx_by_id[frag.id] = frag_idx;
+}
+
+void ArrowStorage::deleteRows(const std::string& table_name,
+                              const std::vector<int64_t>& row_ids) {
+  auto tinfo = getTableInfo(db_id_, table_name);
+  if (!tinfo) {
+    throw std::runtime_error("Unknown table: "s + table_name);
+  }
+  deleteRows(tinfo->table_id, row_ids);
+}
+
+void ArrowStorage::deleteRows(int table_id, const std::vector<int64_t>& row_ids) {
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  if (!tables_.count(table_id)) {
+    throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
+  }
+
+  auto& table = *tables_.at(table_id);
+  mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
+  data_lock.unlock();
+
+  auto frag_rows = groupRowsByFragment(table, row_ids);
+  if (frag_rows.empty()) {
+    return;
+  }
+
+  std::vector<int> rewritten_frags;
+  // Go in reverse order to keep offsets of fragments to process valid.
+  for (auto it = frag_rows.rbegin(); it != frag_rows.rend(); ++it) {
+    auto frag_idx = it->first;
+    auto& deleted = it->second;
+    unpackFragment(table_id, table, frag_idx);
+
+    auto& frag = table.fragments[frag_idx];
+    std::vector<int64_t> rows_to_keep;
+    rows_to_keep.reserve(frag.row_count);
+    for (size_t i = 0; i < deleted.size(); ++i) {
+      if (deleted[i] < 0) {
+        rows_to_keep.push_back(static_cast<int64_t>(i));
+      }
+    }
+
+    auto col_count = table.col_data.size();
+    std::vector<std::shared_ptr<arrow::Array>> col_data(col_count);
+    tbb::parallel_for(tbb::blocked_range(size_t(0), col_count), [&](auto range) {
+      for (size_t col_idx = range.begin(); col_idx != range.end(); ++col_idx) {
+        auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+        auto elems = elemsPerRow(col_type);
+        auto frag_arr =
+            table.col_data[col_idx]->Slice(frag.offset * elems, frag.row_count * elems);
+        col_data[col_idx] = takeRows(frag_arr->chunks(), rows_to_keep, elems);
+      }
+    });
+    rewriteFragment(table_id, table, frag_idx, col_data, rows_to_keep.size());
+    rewritten_frags.push_back(frag.id);
+  }
+
+  finalizeRewrite(table_id, table, std::move(rewritten_frags));
+
+  auto retired_keys = std::exchange(table.retired_chunk_keys, {});
+  table_lock.unlock();
+  retireChunks(retired_keys);
+}
+
+void ArrowStorage::updateRows(std::shared_ptr<arrow::Table> values,
+                              const std::vector<int64_t>& row_ids,
+                              const std::string& table_name) {
+  auto tinfo = getTableInfo(db_id_, table_name);
+  if (!tinfo) {
+    throw std::runtime_error("Unknown table: "s + table_name);
+  }
+  updateRows(values, row_ids, tinfo->table_id);
+}
+
+void ArrowStorage::updateRows(std::shared_ptr<arrow::Table> values,
+                              const std::vector<int64_t>& row_ids,
+                              int table_id) {
+  if (static_cast<size_t>(values->num_rows()) != row_ids.size()) {
+    throw std::runtime_error("Mismatched rows count for update: "s +
+                             std::to_string(values->num_rows()) + " != "s +
+                             std::to_string(row_ids.size()));
+  }
+
+  std::vector<ColumnInfoPtr> col_infos;
+  for (auto& field : values->schema()->fields()) {
+    auto col_info = getColumnInfo(db_id_, table_id, field->name());
+    if (!col_info || col_info->is_rowid) {
+      throw std::runtime_error("Unknown column to update: "s + field->name());
+    }
+    // Updated dictionary encoded columns are materialized to encode new values.
+    // It has to be done before the table is locked.
+    auto elem_type = col_info->type->isArray()
+                         ? col_info->type->as<hdk::ir::ArrayBaseType>()->elemType()
+                         : col_info->type;
+    if (elem_type->isExtDictionary()) {
+      getDictMetadata(elem_type->as<hdk::ir::ExtDictionaryType>()->dictId());
+    }
+    col_infos.push_back(col_info);
+  }
+
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  if (!tables_.count(table_id)) {
+    throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
+  }
+
+  auto& table = *tables_.at(table_id);
+  mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
+  data_lock.unlock();
+
+  auto col_count = table.col_data.size();
+  std::vector<std::shared_ptr<arrow::Array>> new_values(col_count);
+  {
+    mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+    for (size_t i = 0; i < col_infos.size(); ++i) {
+      auto col_idx = columnIndex(col_infos[i]->column_id);
+      auto col_arr = convertUpdateValues(values->column(i), col_infos[i]->type);
+      if (!col_arr->type()->Equals(table.col_data[col_idx]->type())) {
+        throw std::runtime_error("Mismatched type for column "s + col_infos[i]->name +
+                                 ": "s + table.col_data[col_idx]->type()->ToString() +
+                                 " vs. "s + col_arr->type()->ToString());
+      }
+      ARROW_ASSIGN_OR_THROW(new_values[col_idx], arrow::Concatenate(col_arr->chunks()));
+    }
+  }
+
+  auto frag_rows = groupRowsByFragment(table, row_ids);
+  std::vector<int> rewritten_frags;
+  for (auto& [frag_idx, updated] : frag_rows) {
+    unpackFragment(table_id, table, frag_idx);
+
+    // New fragment rows are taken from the fragment data followed by values
+    // used for this fragment.
+    auto& frag = table.fragments[frag_idx];
+    std::vector<int64_t> value_rows;
+    std::vector<int64_t> rows(frag.row_count);
+    for (size_t i = 0; i < updated.size(); ++i) {
+      if (updated[i] < 0) {
+        rows[i] = static_cast<int64_t>(i);
+      } else {
+        rows[i] = static_cast<int64_t>(frag.row_count + value_rows.size());
+        value_rows.push_back(updated[i]);
+      }
+    }
+
+    std::vector<std::shared_ptr<arrow::Array>> col_data(col_count);
+    tbb::parallel_for(tbb::blocked_range(size_t(0), col_count), [&](auto range) {
+      for (size_t col_idx = range.begin(); col_idx != range.end(); ++col_idx) {
+        if (!new_values[col_idx]) {
+          continue;
+        }
+        auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+        auto elems = elemsPerRow(col_type);
+        auto chunks =
+            table.col_data[col_idx]
+                ->Slice(frag.offset * elems, frag.row_count * elems)
+                ->chunks();
+        chunks.push_back(takeRows({new_values[col_idx]}, value_rows, elems));
+        col_data[col_idx] = takeRows(chunks, rows, elems);
+      }
+    });
+    rewriteFragment(table_id, table, frag_idx, col_data, frag.row_count);
+    rewritten_frags.push_back(frag.id);
+  }
+
+  if (!rewritten_frags.empty()) {
+    finalizeRewrite(table_id, table, std::move(rewritten_frags));
+  }
+
+  auto retired_keys = std::exchange(table.retired_chunk_keys, {});
+  table_lock.unlock();
+  retireChunks(retired_keys);
+}
+
+std::map<size_t, std::vector<int64_t>> ArrowStorage::groupRowsByFragment(
+    const TableData& table,
+    const std::vector<int64_t>& row_ids) const {
+  // For each affected fragment build a vector mapping fragment rows to their
+  // positions in row_ids or -1 for rows not listed there. For deletion it
+  // serves as a delete bitmap of the fragment.
+  std::map<size_t, std::vector<int64_t>> res;
+  for (size_t i = 0; i < row_ids.size(); ++i) {
+    auto row_id = row_ids[i];
+    if (row_id < 0 || static_cast<size_t>(row_id) >= table.row_count) {
+      throw std::runtime_error("Invalid rowid: "s + std::to_string(row_id));
+    }
+    auto frag_it = std::upper_bound(
+        table.fragments.begin(),
+        table.fragments.end(),
+        static_cast<size_t>(row_id),
+        [](size_t pos, const DataFragment& frag) { return pos < frag.offset; });
+    CHECK(frag_it != table.fragments.begin());
+    --frag_it;
+    auto& rows = res[static_cast<size_t>(frag_it - table.fragments.begin())];
+    if (rows.empty()) {
+      rows.resize(frag_it->row_count, -1);
+    }
+    rows[row_id - frag_it->offset] = static_cast<int64_t>(i);
+  }
+  return res;
+}
+
+std::shared_ptr<arrow::ChunkedArray> ArrowStorage::convertUpdateValues(
+    std::shared_ptr<arrow::ChunkedArray> arr,
+    const hdk::ir::Type* type) {
+  if (!type->nullable() && arr->null_count() != 0 &&
+      arr->type()->id() != arrow::Type::STRING) {
+    throw std::runtime_error("Null values used in non-nullable type: "s +
+                             type->toString());
+  }
+
+  auto elem_type =
+      type->isArray() ? type->as<hdk::ir::ArrayBaseType>()->elemType() : type;
+  StringDictionary* dict = nullptr;
+  if (elem_type->isExtDictionary()) {
+    auto dict_id = elem_type->as<hdk::ir::ExtDictionaryType>()->dictId();
+    dict = dicts_.at(dict_id)->dict()->stringDict.get();
+  }
+
+  if (type->isDecimal()) {
+    return convertDecimalToInteger(arr, type);
+  } else if (type->isExtDictionary()) {
+    switch (arr->type()->id()) {
+      case arrow::Type::STRING:
+        return createDictionaryEncodedColumn(dict, arr, type);
+      case arrow::Type::DICTIONARY:
+        return convertArrowDictionary(dict, arr, type);
+      default:
+        throw std::runtime_error("Unexpected data type for dictionary encoded column: "s +
+                                 arr->type()->ToString());
+    }
+  } else if (type->isString()) {
+    return arr;
+  }
+  return replaceNullValues(arr, type, dict);
+}
+
+void ArrowStorage::rewriteFragment(
+    int table_id,
+    TableData& table,
+    size_t frag_idx,
+    const std::vector<std::shared_ptr<arrow::Array>>& col_data,
+    size_t row_count) {
+  auto& frag = table.fragments[frag_idx];
+  CHECK_EQ(col_data.size(), table.col_data.size());
+  tbb::parallel_for(tbb::blocked_range(size_t(0), col_data.size()), [&](auto range) {
+    for (size_t col_idx = range.begin(); col_idx != range.end(); ++col_idx) {
+      if (!col_data[col_idx]) {
+        CHECK_EQ(frag.row_count, row_count);
+        continue;
+      }
+      CHECK(!frag.packed[col_idx]);
+      auto col_type = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+      auto elems = elemsPerRow(col_type);
+      table.col_data[col_idx] = replaceSlice(table.col_data[col_idx],
+                                             frag.offset * elems,
+                                             frag.row_count * elems,
+                                             col_data[col_idx]);
+      frag.metadata[col_idx] = computeChunkMetadata(
+          std::make_shared<arrow::ChunkedArray>(col_data[col_idx]), col_type, row_count);
+    }
+  });
+  frag.row_count = row_count;
+  renewFragmentId(table_id, table, frag_idx);
+}
+
+void ArrowStorage::finalizeRewrite(int table_id,
+                                   TableData& table,
+                                   std::vector<int> rewritten_frags) {
+  // Remove emptied fragments and fix offsets shifted by deletions.
+  table.fragments.erase(
+      std::remove_if(table.fragments.begin(),
+                     table.fragments.end(),
+                     [](const DataFragment& frag) { return frag.row_count == 0; }),
+      table.fragments.end());
+  table.frag_idx_by_id.clear();
+  size_t offset = 0;
+  for (size_t frag_idx = 0; frag_idx < table.fragments.size(); ++frag_idx) {
+    auto& frag = table.fragments[frag_idx];
+    frag.offset = offset;
+    offset += frag.row_count;
+    table.frag_idx_by_id[frag.id] = frag_idx;
+  }
+  table.row_count = offset;
+
+  if (config_->storage.enable_column_compression) {
+    for (auto frag_id : rewritten_frags) {
+      if (table.frag_idx_by_id.count(frag_id)) {
+        auto frag_idx = table.frag_idx_by_id.at(frag_id);
+        packFragments(table_id, table, frag_idx, frag_idx + 1);
+      }
+    }
+  }
+
+  auto table_info = getTableInfo(db_id_, table_id);
+  table_info->fragments = table.fragments.size();
+  table_info->row_count = table.row_count;
+  ++table_info->data_version;
+}
+
+TableInfoPtr ArrowStorage::importRecordBatches(
+    std::shared_ptr<arrow::RecordBatchReader> reader,
+    const std::string& table_name,
+    const std::vector<ColumnDescription>& columns,
+    const TableOptions& options) {
+  auto res = createTable(table_name, columns, options);
+  try {
+    appendRecordBatches(reader, res->table_id);
+  } catch (...) {
+    // Don't leave partially imported table.
+    dropTable(res->table_id);
+    throw;
+  }
+  return res;
+}
+
+void ArrowStorage::appendRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                                       int table_id) {
+  // Parsed blocks are grouped and appended to the table by a separate task
+  // while the reader keeps parsing the next group. Dictionary encoding and
+  // stats computation in appendArrowTable are parallel on their own, so parsing
+  // and conversion overlap and only two groups of blocks (plus the reader's
+  // read-ahead) are kept in memory at any moment. New fragments become visible
+  // as soon as their group is appended.
+  size_t max_blocks = std::max(config_->storage.streaming_import_blocks, (size_t)1);
+  tbb::task_group append_tasks;
+  size_t blocks = 0;
+  size_t rows = 0;
+  auto time = measure<>::execution([&]() {
+    try {
+      arrow::RecordBatchVector batches;
+      bool done = false;
+      while (!done) {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        auto status = reader->ReadNext(&batch);
+        if (status.IsInvalid() || status.IsTypeError()) {
+          throw BlockConversionError(status.ToString());
+        }
+        ARROW_THROW_NOT_OK(status);
+        done = !batch;
+        if (batch && batch->num_rows()) {
+          rows += batch->num_rows();
+          batches.emplace_back(std::move(batch));
+        }
+        if (batches.size() >= max_blocks || (done && !batches.empty())) {
+          auto at_res = arrow::Table::FromRecordBatches(reader->schema(), batches);
+          ARROW_THROW_NOT_OK(at_res.status());
+          blocks += batches.size();
+          batches.clear();
+          // Groups are appended in order to preserve rows order.
+          append_tasks.wait();
+          append_tasks.run([this, at = at_res.ValueOrDie(), table_id]() {
+            appendArrowTable(at, table_id);
+          });
+        }
+      }
+      append_tasks.wait();
+    } catch (...) {
+      // Running append cannot be safely cancelled, let it finish.
+      try {
+        append_tasks.wait();
+      } catch (...) {
+      }
+      throw;
+    }
+  });
+
+  VLOG(1) << "Streamed " << rows << " rows in " << blocks << " blocks in " << time
+          << "ms";
 }
 
 TableInfoPtr ArrowStorage::importCsvFile(const std::string& file_name,
@@ -874,24 +1550,45 @@ TableInfoPtr ArrowStorage::importCsvFile(const std::string& file_name,
       col_types.emplace(col.name, col.type);
     }
   }
-  auto at = parseCsvFile(file_name, parse_options, col_infos);
+
   // We allow partial schema specification in columns arg which
   // means missing columns and/or column types. Fill missing
   // info using parsed table schema.
-  std::vector<ColumnDescription> updated_columns;
-  updated_columns.reserve(at->columns().size());
-  for (size_t i = 0; i < at->columns().size(); ++i) {
-    ColumnDescription col_desc;
-    col_desc.name = at->schema()->field(i)->name();
-    if (col_types.count(col_desc.name)) {
-      col_desc.type = col_types.at(col_desc.name);
-    } else {
-      col_desc.type = getTargetImportType(ctx_, *at->schema()->field(i)->type());
+  auto get_columns = [&](std::shared_ptr<arrow::Schema> schema) {
+    std::vector<ColumnDescription> updated_columns;
+    updated_columns.reserve(schema->num_fields());
+    for (int i = 0; i < schema->num_fields(); ++i) {
+      ColumnDescription col_desc;
+      col_desc.name = schema->field(i)->name();
+      if (col_types.count(col_desc.name)) {
+        col_desc.type = col_types.at(col_desc.name);
+      } else {
+        col_desc.type = getTargetImportType(ctx_, *schema->field(i)->type());
+      }
+      updated_columns.emplace_back(std::move(col_desc));
+    }
+    return updated_columns;
+  };
+
+  if (config_->storage.enable_streaming_import) {
+    auto reader = makeCsvReader(openInputFile(file_name), parse_options, col_infos);
+    auto schema = reader->schema();
+    bool inferred_types = static_cast<size_t>(schema->num_fields()) > col_types.size();
+    try {
+      return importRecordBatches(reader, table_name, get_columns(schema), options);
+    } catch (const BlockConversionError& e) {
+      if (!inferred_types) {
+        throw;
+      }
+      // Types inferred from the first block might be too narrow for the following
+      // blocks. Parse the whole file to infer types from all blocks.
+      LOG(WARNING) << "Streaming import of " << file_name
+                   << " failed, retrying with non-streaming import: " << e.what();
     }
-    updated_columns.emplace_back(std::move(col_desc));
   }
 
-  auto res = createTable(table_name, updated_columns, options);
+  auto at = parseCsvFile(file_name, parse_options, col_infos);
+  auto res = createTable(table_name, get_columns(at->schema()), options);
   appendArrowTable(at, res->table_id);
   return res;
 }
@@ -900,6 +1597,28 @@ TableInfoPtr ArrowStorage::importCsvFile(const std::string& file_name,
                                          const std::string& table_name,
                                          const TableOptions& options,
                                          const CsvParseOptions parse_options) {
+  if (config_->storage.enable_streaming_import) {
+    auto reader = makeCsvReader(openInputFile(file_name), parse_options);
+    std::vector<ColumnDescription> columns;
+    for (auto& field : reader->schema()->fields()) {
+      ColumnDescription desc{field->name(), getTargetImportType(ctx_, *field->type())};
+      columns.emplace_back(std::move(desc));
+    }
+    // All column types are inferred from the first block.
+    bool inferred_types = !columns.empty();
+    try {
+      return importRecordBatches(reader, table_name, columns, options);
+    } catch (const BlockConversionError& e) {
+      if (!inferred_types) {
+        throw;
+      }
+      // Types inferred from the first block might be too narrow for the following
+      // blocks. Parse the whole file to infer types from all blocks.
+      LOG(WARNING) << "Streaming import of " << file_name
+                   << " failed, retrying with non-streaming import: " << e.what();
+    }
+  }
+
   auto at = parseCsvFile(file_name, parse_options);
   return importArrowTable(at, table_name, options);
 }
@@ -922,6 +1641,12 @@ void ArrowStorage::appendCsvFile(const std::string& file_name,
   }
 
   auto col_infos = listColumns(db_id_, table_id);
+  if (config_->storage.enable_streaming_import) {
+    appendRecordBatches(makeCsvReader(openInputFile(file_name), parse_options, col_infos),
+                        table_id);
+    return;
+  }
+
   auto at = parseCsvFile(file_name, parse_options, col_infos);
   appendArrowTable(at, table_id);
 }
@@ -944,6 +1669,12 @@ void ArrowStorage::appendCsvData(const std::string& csv_data,
   }
 
   auto col_infos = listColumns(db_id_, table_id);
+  if (config_->storage.enable_streaming_import) {
+    auto input = std::make_shared<arrow::io::BufferReader>(csv_data);
+    appendRecordBatches(makeCsvReader(input, parse_options, col_infos), table_id);
+    return;
+  }
+
   auto at = parseCsvData(csv_data, parse_options, col_infos);
   appendArrowTable(at, table_id);
 }
@@ -966,6 +1697,12 @@ void ArrowStorage::appendJsonData(const std::string& json_data,
   }
 
   auto col_infos = listColumns(db_id_, table_id);
+  if (config_->storage.enable_streaming_import) {
+    auto input = std::make_shared<arrow::io::BufferReader>(json_data);
+    appendRecordBatches(makeJsonReader(input, parse_options, col_infos), table_id);
+    return;
+  }
+
   auto at = parseJsonData(json_data, parse_options, col_infos);
   appendArrowTable(at, table_id);
 }
@@ -1042,6 +1779,12 @@ void ArrowStorage::dropTable(int table_id, bool throw_if_not_exist) {
   for (auto dict_id : dicts_to_remove) {
     dicts_.erase(dict_id);
   }
+
+  table_lock.unlock();
+  schema_lock.unlock();
+  dict_lock.unlock();
+  data_lock.unlock();
+  retireChunks({{db_id_, table_id}});
 }
 
 void ArrowStorage::checkNewTableParams(const std::string& table_name,
@@ -1128,6 +1871,32 @@ void ArrowStorage::compareSchemas(std::shared_ptr<arrow::Schema> lhs,
   }
 }
 
+std::shared_ptr<ChunkMetadata> ArrowStorage::computeChunkMetadata(
+    std::shared_ptr<arrow::ChunkedArray> arr,
+    const hdk::ir::Type* type,
+    size_t row_count) {
+  size_t num_bytes = 0;
+  if (type->isString() || type->isVarLenArray()) {
+    if (row_count) {
+      num_bytes = computeTotalStringsLength(arr, 0, row_count);
+    }
+  } else {
+    num_bytes = row_count * type->size();
+  }
+  auto meta = std::make_shared<ChunkMetadata>(type, num_bytes, row_count);
+  if (type->isString()) {
+    meta->fillStringChunkStats(arr->null_count());
+  } else if (type->isExtDictionary() && arr->type()->id() == arrow::Type::STRING) {
+    // Not materialized dictionary, use the same stats as on import.
+    int32_t min = 0;
+    int32_t max = -1;
+    meta->fillChunkStats(min, max, /*has_nulls=*/true);
+  } else {
+    meta->fillChunkStats(computeStats(arr, type));
+  }
+  return meta;
+}
+
 ChunkStats ArrowStorage::computeStats(std::shared_ptr<arrow::ChunkedArray> arr,
                                       const hdk::ir::Type* type) {
   auto elem_type =
@@ -1165,10 +1934,7 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseCsvFile(
     const std::string& file_name,
     const CsvParseOptions parse_options,
     const ColumnInfoList& col_infos) const {
-  std::shared_ptr<arrow::io::ReadableFile> inp;
-  auto file_result = arrow::io::ReadableFile::Open(file_name.c_str());
-  ARROW_THROW_NOT_OK(file_result.status());
-  return parseCsv(file_result.ValueOrDie(), parse_options, col_infos);
+  return parseCsv(openInputFile(file_name), parse_options, col_infos);
 }
 
 std::shared_ptr<arrow::Table> ArrowStorage::parseCsvData(
@@ -1184,39 +1950,10 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseCsv(
     const CsvParseOptions parse_options,
     const ColumnInfoList& col_infos) const {
   auto io_context = arrow::io::default_io_context();
-
-  auto arrow_parse_options = arrow::csv::ParseOptions::Defaults();
-  arrow_parse_options.quoting = false;
-  arrow_parse_options.escaping = false;
-  arrow_parse_options.newlines_in_values = false;
-  arrow_parse_options.delimiter = parse_options.delimiter;
-
-  auto arrow_read_options = arrow::csv::ReadOptions::Defaults();
-  arrow_read_options.use_threads = true;
-  arrow_read_options.block_size = parse_options.block_size;
-  arrow_read_options.autogenerate_column_names =
-      !parse_options.header && col_infos.empty();
-  arrow_read_options.skip_rows = parse_options.skip_rows;
-
-  auto arrow_convert_options = arrow::csv::ConvertOptions::Defaults();
-  arrow_convert_options.check_utf8 = false;
-  arrow_convert_options.include_columns = arrow_read_options.column_names;
-  arrow_convert_options.strings_can_be_null = true;
-
-  for (auto& col_info : col_infos) {
-    if (!col_info->is_rowid) {
-      if (!parse_options.header) {
-        arrow_read_options.column_names.push_back(col_info->name);
-      }
-      if (col_info->type) {
-        arrow_convert_options.column_types.emplace(
-            col_info->name, getArrowImportType(ctx_, col_info->type));
-      }
-    }
-  }
+  auto opts = getCsvReaderOptions(ctx_, parse_options, col_infos);
 
   auto table_reader_result = arrow::csv::TableReader::Make(
-      io_context, input, arrow_read_options, arrow_parse_options, arrow_convert_options);
+      io_context, input, opts.read, opts.parse, opts.convert);
   ARROW_THROW_NOT_OK(table_reader_result.status());
   auto table_reader = table_reader_result.ValueOrDie();
 
@@ -1244,28 +1981,10 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseJson(
     std::shared_ptr<arrow::io::InputStream> input,
     const JsonParseOptions parse_options,
     const ColumnInfoList& col_infos) const {
-  arrow::FieldVector fields;
-  fields.reserve(col_infos.size());
-  for (auto& col_info : col_infos) {
-    if (!col_info->is_rowid) {
-      fields.emplace_back(
-          std::make_shared<arrow::Field>(col_info->name,
-                                         getArrowImportType(ctx_, col_info->type),
-                                         col_info->type->nullable()));
-    }
-  }
-  auto schema = std::make_shared<arrow::Schema>(std::move(fields));
-
-  auto arrow_parse_options = arrow::json::ParseOptions::Defaults();
-  arrow_parse_options.newlines_in_values = false;
-  arrow_parse_options.explicit_schema = schema;
-
-  auto arrow_read_options = arrow::json::ReadOptions::Defaults();
-  arrow_read_options.use_threads = true;
-  arrow_read_options.block_size = parse_options.block_size;
+  auto opts = getJsonReaderOptions(ctx_, parse_options, col_infos);
 
   auto table_reader_result = arrow::json::TableReader::Make(
-      arrow::default_memory_pool(), input, arrow_read_options, arrow_parse_options);
+      arrow::default_memory_pool(), input, opts.read, opts.parse);
   ARROW_THROW_NOT_OK(table_reader_result.status());
   auto table_reader = table_reader_result.ValueOrDie();
 
@@ -1308,6 +2027,30 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseParquetFile(
   return table;
 }
 
+std::shared_ptr<arrow::RecordBatchReader> ArrowStorage::makeCsvReader(
+    std::shared_ptr<arrow::io::InputStream> input,
+    const CsvParseOptions parse_options,
+    const ColumnInfoList& col_infos) const {
+  auto opts = getCsvReaderOptions(ctx_, parse_options, col_infos);
+  // Streaming reader infers column types from the first block and uses them for
+  // the rest of the input. Imports into new tables fall back to the table reader,
+  // which promotes inferred types, when a later block doesn't fit them.
+  auto reader_result = arrow::csv::StreamingReader::Make(
+      arrow::io::default_io_context(), input, opts.read, opts.parse, opts.convert);
+  ARROW_THROW_NOT_OK(reader_result.status());
+  return reader_result.ValueOrDie();
+}
+
+std::shared_ptr<arrow::RecordBatchReader> ArrowStorage::makeJsonReader(
+    std::shared_ptr<arrow::io::InputStream> input,
+    const JsonParseOptions parse_options,
+    const ColumnInfoList& col_infos) const {
+  auto opts = getJsonReaderOptions(ctx_, parse_options, col_infos);
+  auto reader_result = arrow::json::StreamingReader::Make(input, opts.read, opts.parse);
+  ARROW_THROW_NOT_OK(reader_result.status());
+  return reader_result.ValueOrDie();
+}
+
 ArrowStorage::DictionaryData::DictionaryData(
     std::unique_ptr<DictDescriptor>&& dict_descriptor,
     const hdk::ir::ExtDictionaryType* type,
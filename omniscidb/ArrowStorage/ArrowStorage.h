@@ -22,6 +22,8 @@
 
 #include <arrow/api.h>
 
+#include <map>
+
 namespace hdk::ir {
 class Type;
 }
@@ -127,6 +129,21 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   void appendParquetFile(const std::string& file_name, const std::string& table_name);
   void appendParquetFile(const std::string& file_name, int table_id);
 
+  // Delete rows with specified rowid values. Only fragments holding deleted rows
+  // are rewritten. Rowids of rows following deleted ones are shifted.
+  void deleteRows(const std::string& table_name, const std::vector<int64_t>& row_ids);
+  void deleteRows(int table_id, const std::vector<int64_t>& row_ids);
+
+  // Set new values for rows with specified rowid values. Updated columns are
+  // matched by names of the values table columns, i-th row of values is used
+  // for row_ids[i]. Only fragments holding updated rows are rewritten.
+  void updateRows(std::shared_ptr<arrow::Table> values,
+                  const std::vector<int64_t>& row_ids,
+                  const std::string& table_name);
+  void updateRows(std::shared_ptr<arrow::Table> values,
+                  const std::vector<int64_t>& row_ids,
+                  int table_id);
+
   void dropTable(const std::string& table_name, bool throw_if_not_exist = false);
   void dropTable(int table_id, bool throw_if_not_exist = false);
 
@@ -149,11 +166,28 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
                                           const ColumnInfoList& col_infos = {}) const;
   std::shared_ptr<arrow::Table> parseParquetFile(const std::string& file_name) const;
 
+  // Streaming readers produce parsed blocks one by one on demand. They are used
+  // for pipelined import when StorageConfig::enable_streaming_import is set.
+  std::shared_ptr<arrow::RecordBatchReader> makeCsvReader(
+      std::shared_ptr<arrow::io::InputStream> input,
+      const CsvParseOptions parse_options,
+      const ColumnInfoList& col_infos = {}) const;
+  std::shared_ptr<arrow::RecordBatchReader> makeJsonReader(
+      std::shared_ptr<arrow::io::InputStream> input,
+      const JsonParseOptions parse_options,
+      const ColumnInfoList& col_infos = {}) const;
+
  private:
   struct DataFragment {
+    // Rewritten fragments get new ids, so data cached for the previous fragment
+    // version is never matched by chunk keys.
+    int id = 0;
     size_t offset = 0;
     size_t row_count = 0;
     std::vector<std::shared_ptr<ChunkMetadata>> metadata;
+    // Bit-packed column data (see Shared/PackedChunk.h). Plain data of packed
+    // columns is replaced with data-less placeholders in TableData::col_data.
+    std::vector<std::shared_ptr<arrow::Array>> packed;
   };
 
   struct TableData {
@@ -162,7 +196,12 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
     std::shared_ptr<arrow::Schema> schema;
     std::vector<std::shared_ptr<arrow::ChunkedArray>> col_data;
     std::vector<DataFragment> fragments;
+    std::unordered_map<int, size_t> frag_idx_by_id;
+    int next_frag_id = 1;
     size_t row_count = 0;
+    // Key prefixes of chunks of replaced fragments, which are passed to
+    // retireChunks after the table lock is released.
+    std::vector<ChunkKey> retired_chunk_keys;
   };
 
   struct DictionaryData {
@@ -207,10 +246,20 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   void checkNewTableParams(const std::string& table_name,
                            const std::vector<ColumnDescription>& columns,
                            const TableOptions& options) const;
+  TableInfoPtr importRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                                   const std::string& table_name,
+                                   const std::vector<ColumnDescription>& columns,
+                                   const TableOptions& options);
+  void appendRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                           int table_id);
   void compareSchemas(std::shared_ptr<arrow::Schema> lhs,
                       std::shared_ptr<arrow::Schema> rhs);
   ChunkStats computeStats(std::shared_ptr<arrow::ChunkedArray> arr,
                           const hdk::ir::Type* type);
+  std::shared_ptr<ChunkMetadata> computeChunkMetadata(
+      std::shared_ptr<arrow::ChunkedArray> arr,
+      const hdk::ir::Type* type,
+      size_t row_count);
   TableFragmentsInfo getEmptyTableMetadata(int table_id) const;
   void fetchFixedLenData(const TableData& table,
                          size_t frag_idx,
@@ -218,6 +267,11 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
                          Data_Namespace::AbstractBuffer* dest,
                          size_t num_bytes,
                          size_t elem_size) const;
+  void fetchPackedData(const TableData& table,
+                       size_t frag_idx,
+                       size_t col_idx,
+                       Data_Namespace::AbstractBuffer* dest,
+                       size_t num_bytes) const;
   void fetchVarLenOffsets(const TableData& table,
                           size_t frag_idx,
                           size_t col_idx,
@@ -235,6 +289,23 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
                             size_t elem_size,
                             size_t num_bytes) const;
 
+  void packFragments(int table_id, TableData& table, size_t start_frag, size_t end_frag);
+  bool unpackFragment(int table_id, TableData& table, size_t frag_idx);
+  void renewFragmentId(int table_id, TableData& table, size_t frag_idx);
+
+  std::map<size_t, std::vector<int64_t>> groupRowsByFragment(
+      const TableData& table,
+      const std::vector<int64_t>& row_ids) const;
+  std::shared_ptr<arrow::ChunkedArray> convertUpdateValues(
+      std::shared_ptr<arrow::ChunkedArray> arr,
+      const hdk::ir::Type* type);
+  void rewriteFragment(int table_id,
+                       TableData& table,
+                       size_t frag_idx,
+                       const std::vector<std::shared_ptr<arrow::Array>>& col_data,
+                       size_t row_count);
+  void finalizeRewrite(int table_id, TableData& table, std::vector<int> rewritten_frags);
+
   void materializeDictionary(DictionaryData* dict_data);
 
   int db_id_;
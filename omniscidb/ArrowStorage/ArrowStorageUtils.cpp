@@ -16,10 +16,12 @@
 
 #include "IR/Context.h"
 #include "Shared/InlineNullValues.h"
+#include "Shared/PackedChunk.h"
 
 #include <tbb/parallel_for.h>
 #include <tbb/task_group.h>
 
+#include <cstring>
 #include <iostream>
 
 using namespace std::string_literals;
@@ -880,6 +882,45 @@ std::shared_ptr<arrow::ChunkedArray> convertDecimalToInteger(
   return std::make_shared<arrow::ChunkedArray>(array);
 }
 
+template <typename T>
+void packValues(uint8_t* dst,
+                std::shared_ptr<arrow::ChunkedArray> arr,
+                const PackedChunkHeader& header) {
+  const uint64_t null_code = (uint64_t(1) << header.bit_width) - 1;
+  uint64_t bit_pos = 0;
+  for (auto& chunk : arr->chunks()) {
+    const T* src = chunk->data()->GetValues<T>(1);
+    for (int64_t i = 0; i < chunk->length(); ++i) {
+      uint64_t code = src[i] == inline_int_null_value<T>()
+                          ? null_code
+                          : static_cast<uint64_t>(static_cast<int64_t>(src[i]) -
+                                                  header.base);
+      code <<= (bit_pos & 7);
+      for (uint8_t* byte = dst + (bit_pos >> 3); code; code >>= 8, ++byte) {
+        *byte |= static_cast<uint8_t>(code);
+      }
+      bit_pos += header.bit_width;
+    }
+  }
+}
+
+template <typename T>
+void unpackValues(T* dst, const int8_t* packed, size_t num_elems) {
+  const auto* header = reinterpret_cast<const PackedChunkHeader*>(packed);
+  const auto* data =
+      reinterpret_cast<const uint8_t*>(packed + sizeof(PackedChunkHeader));
+  const uint64_t mask = (uint64_t(1) << header->bit_width) - 1;
+  uint64_t bit_pos = 0;
+  for (size_t i = 0; i < num_elems; ++i) {
+    uint64_t word = 0;
+    memcpy(&word, data + (bit_pos >> 3), sizeof(word));
+    const uint64_t code = (word >> (bit_pos & 7)) & mask;
+    dst[i] = header->has_nulls && code == mask
+                 ? inline_int_null_value<T>()
+                 : static_cast<T>(header->base + static_cast<int64_t>(code));
+    bit_pos += header->bit_width;
+  }
+}
 }  // anonymous namespace
 
 std::shared_ptr<arrow::ChunkedArray> replaceNullValues(
@@ -1015,6 +1056,14 @@ const hdk::ir::Type* getTargetImportType(hdk::ir::Context& ctx,
           break;
       }
       break;
+    case Type::LIST: {
+      // Allows to import query results holding arrays, e.g. HLL sketches.
+      auto elem_type = getTargetImportType(
+          ctx, *static_cast<const arrow::ListType&>(type).value_type());
+      if (!elem_type->isVarLen() && !elem_type->isExtDictionary()) {
+        return ctx.arrayVarLen(elem_type);
+      }
+    } break;
     default:
       break;
   }
@@ -1227,3 +1276,75 @@ std::shared_ptr<arrow::ChunkedArray> convertArrowDictionary(
   }
   return std::make_shared<arrow::ChunkedArray>(converted_chunks);
 }
+
+int32_t getPackedBitWidth(const hdk::ir::Type* type, const ChunkStats& stats) {
+  if (!type->isInteger() && !type->isDecimal() && !type->isTimestamp() &&
+      !type->isTime()) {
+    return -1;
+  }
+  if (type->size() != 8 && (type->size() != 4 || type->isDateTime())) {
+    return -1;
+  }
+  auto min = extract_min_stat_int_type(stats, type);
+  auto max = extract_max_stat_int_type(stats, type);
+  if (min > max) {
+    return -1;
+  }
+  auto bit_width = packed_bit_width(min, max, stats.has_nulls);
+  if (bit_width > kMaxPackedBitWidth || bit_width > type->size() * 4) {
+    return -1;
+  }
+  return bit_width;
+}
+
+std::shared_ptr<arrow::Array> packFixedLenData(std::shared_ptr<arrow::ChunkedArray> arr,
+                                               const hdk::ir::Type* type,
+                                               const ChunkStats& stats) {
+  PackedChunkHeader header;
+  header.base = extract_min_stat_int_type(stats, type);
+  header.bit_width = getPackedBitWidth(type, stats);
+  header.has_nulls = stats.has_nulls;
+  CHECK_GE(header.bit_width, 0);
+
+  auto size = packed_chunk_size(arr->length(), header.bit_width);
+  auto buf = arrow::AllocateBuffer(size).ValueOrDie();
+  memset(buf->mutable_data(), 0, size);
+  memcpy(buf->mutable_data(), &header, sizeof(header));
+  auto dst = buf->mutable_data() + sizeof(header);
+  if (type->size() == 8) {
+    packValues<int64_t>(dst, arr, header);
+  } else {
+    CHECK_EQ(type->size(), 4);
+    packValues<int32_t>(dst, arr, header);
+  }
+  return std::make_shared<arrow::UInt8Array>(size, std::move(buf));
+}
+
+void unpackFixedLenData(const int8_t* packed,
+                        size_t num_elems,
+                        size_t elem_size,
+                        int8_t* dst) {
+  if (elem_size == 8) {
+    unpackValues(reinterpret_cast<int64_t*>(dst), packed, num_elems);
+  } else {
+    CHECK_EQ(elem_size, (size_t)4);
+    unpackValues(reinterpret_cast<int32_t*>(dst), packed, num_elems);
+  }
+}
+
+std::shared_ptr<arrow::Array> unpackFixedLenData(
+    std::shared_ptr<arrow::Array> packed,
+    size_t num_elems,
+    const hdk::ir::Type* type,
+    std::shared_ptr<arrow::DataType> arrow_type) {
+  auto buf = arrow::AllocateBuffer(num_elems * type->size()).ValueOrDie();
+  unpackFixedLenData(packed->data()->GetValues<int8_t>(1),
+                     num_elems,
+                     type->size(),
+                     reinterpret_cast<int8_t*>(buf->mutable_data()));
+  auto data = arrow::ArrayData::Make(std::move(arrow_type),
+                                     static_cast<int64_t>(num_elems),
+                                     {nullptr, std::move(buf)},
+                                     0);
+  return arrow::MakeArray(data);
+}
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "DataMgr/ChunkMetadata.h"
 #include "IR/Type.h"
 #include "StringDictionary/StringDictionary.h"
 
@@ -44,3 +45,23 @@ std::shared_ptr<arrow::ChunkedArray> convertArrowDictionary(
     StringDictionary* dict,
     std::shared_ptr<arrow::ChunkedArray> arr,
     const hdk::ir::Type* type);
+
+// Return bit width to store a chunk with given stats in the bit-packed layout
+// (see Shared/PackedChunk.h) or -1 if the type cannot be packed or packing
+// wouldn't reduce the chunk size at least twice.
+int32_t getPackedBitWidth(const hdk::ir::Type* type, const ChunkStats& stats);
+
+std::shared_ptr<arrow::Array> packFixedLenData(std::shared_ptr<arrow::ChunkedArray> arr,
+                                               const hdk::ir::Type* type,
+                                               const ChunkStats& stats);
+
+void unpackFixedLenData(const int8_t* packed,
+                        size_t num_elems,
+                        size_t elem_size,
+                        int8_t* dst);
+
+std::shared_ptr<arrow::Array> unpackFixedLenData(
+    std::shared_ptr<arrow::Array> packed,
+    size_t num_elems,
+    const hdk::ir::Type* type,
+    std::shared_ptr<arrow::DataType> arrow_type);
@@ -231,6 +231,12 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     opTab.addOperator(new ApproxMedian());
     opTab.addOperator(new ApproxPercentile());
     opTab.addOperator(new ApproxQuantile());
+    opTab.addOperator(new Median());
+    opTab.addOperator(new PercentileCont());
+    opTab.addOperator(new PercentileDisc());
+    opTab.addOperator(new HllSketch());
+    opTab.addOperator(new HllMerge());
+    opTab.addOperator(new HllMergeCount());
     opTab.addOperator(new MapDAvg());
     opTab.addOperator(new Sample());
     opTab.addOperator(new LastSample());
@@ -1787,6 +1793,137 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     }
   }
 
+  static class Median extends SqlAggFunction {
+    Median() {
+      super("MEDIAN",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
+  static class PercentileCont extends SqlAggFunction {
+    PercentileCont() {
+      super("PERCENTILE_CONT",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC, SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
+  static class PercentileDisc extends SqlAggFunction {
+    PercentileDisc() {
+      super("PERCENTILE_DISC",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC, SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
+  static class HllSketch extends SqlAggFunction {
+    HllSketch() {
+      super("HLL_SKETCH",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.or(OperandTypes.family(SqlTypeFamily.ANY),
+                      OperandTypes.family(SqlTypeFamily.ANY, SqlTypeFamily.INTEGER)),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createArrayType(
+              typeFactory.createSqlType(SqlTypeName.TINYINT), -1);
+    }
+  }
+
+  static class HllMerge extends SqlAggFunction {
+    HllMerge() {
+      super("HLL_MERGE",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.or(OperandTypes.family(SqlTypeFamily.ARRAY),
+                      OperandTypes.family(SqlTypeFamily.ARRAY, SqlTypeFamily.INTEGER)),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createArrayType(
+              typeFactory.createSqlType(SqlTypeName.TINYINT), -1);
+    }
+  }
+
+  static class HllMergeCount extends SqlAggFunction {
+    HllMergeCount() {
+      super("HLL_MERGE_COUNT",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.or(OperandTypes.family(SqlTypeFamily.ARRAY),
+                      OperandTypes.family(SqlTypeFamily.ARRAY, SqlTypeFamily.INTEGER)),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.BIGINT);
+    }
+  }
+
   static class MapDAvg extends SqlAggFunction {
     MapDAvg() {
       super("AVG",
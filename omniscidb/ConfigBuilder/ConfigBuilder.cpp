@@ -82,12 +82,19 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<bool>(&config_->exec.sub_tasks.enable)
           ->default_value(config_->exec.sub_tasks.enable)
           ->implicit_value(true),
-      "Enable parallel processing of a single data fragment on CPU. This can improve CPU "
-      "load balance and decrease reduction overhead.");
+      "Enable parallel processing of a single data fragment on CPU. Fragments are split "
+      "into row ranges which are dynamically distributed between CPU threads. This can "
+      "improve CPU load balance and decrease reduction overhead.");
   opt_desc.add_options()("cpu-sub-task-size",
                          po::value<size_t>(&config_->exec.sub_tasks.sub_task_size)
                              ->default_value(config_->exec.sub_tasks.sub_task_size),
-                         "Set CPU sub-task size in rows.");
+                         "Set maximum CPU sub-task size in rows.");
+  opt_desc.add_options()(
+      "cpu-sub-task-min-size",
+      po::value<size_t>(&config_->exec.sub_tasks.min_sub_task_size)
+          ->default_value(config_->exec.sub_tasks.min_sub_task_size),
+      "Set minimum CPU sub-task size in rows. Sub-task size is chosen to have several "
+      "sub-tasks per CPU thread within minimum and maximum sizes.");
 
   // exec.join
   opt_desc.add_options()("enable-loop-join",
@@ -110,6 +117,32 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->exec.join.huge_join_hash_min_load)
           ->default_value(config_->exec.join.huge_join_hash_min_load),
       "A minimal predicted load level for huge perfect hash tables in percent.");
+  opt_desc.add_options()(
+      "enable-join-probe-prefetch",
+      po::value<bool>(&config_->exec.join.enable_probe_prefetch)
+          ->default_value(config_->exec.join.enable_probe_prefetch)
+          ->implicit_value(true),
+      "Enable/disable software prefetching of hash table entries in CPU hash join "
+      "probes.");
+  opt_desc.add_options()(
+      "join-probe-prefetch-threshold",
+      po::value<size_t>(&config_->exec.join.probe_prefetch_threshold)
+          ->default_value(config_->exec.join.probe_prefetch_threshold),
+      "Minimal hash table size in bytes to prefetch its entries in hash join probes. "
+      "Zero means the size of the last level CPU cache.");
+  opt_desc.add_options()(
+      "join-probe-prefetch-distance",
+      po::value<size_t>(&config_->exec.join.probe_prefetch_distance)
+          ->default_value(config_->exec.join.probe_prefetch_distance),
+      "Number of outer rows to look ahead when prefetching hash table entries in hash "
+      "join probes.");
+  opt_desc.add_options()(
+      "enable-range-join",
+      po::value<bool>(&config_->exec.join.enable_range_join)
+          ->default_value(config_->exec.join.enable_range_join)
+          ->implicit_value(true),
+      "Enable/disable sort-based range joins on CPU for join conditions consisting of "
+      "inequalities only.");
 
   // exec.group_by
   opt_desc.add_options()("bigint-count",
@@ -216,6 +249,48 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->exec.group_by.partitioning_buffer_target_size),
       "A preferred aggregation output buffer size used to compute number of partitions "
       "to use.");
+  opt_desc.add_options()(
+      "enable-roaring-count-distinct",
+      po::value<bool>(&config_->exec.group_by.enable_roaring_count_distinct)
+          ->default_value(config_->exec.group_by.enable_roaring_count_distinct)
+          ->implicit_value(true),
+      "Use roaring bitmaps for exact COUNT(DISTINCT) on CPU when dense bitmaps are too "
+      "large.");
+  opt_desc.add_options()(
+      "roaring-count-distinct-threshold",
+      po::value<size_t>(&config_->exec.group_by.roaring_count_distinct_threshold)
+          ->default_value(config_->exec.group_by.roaring_count_distinct_threshold),
+      "Total size of dense COUNT(DISTINCT) bitmaps in bytes above which roaring "
+      "bitmaps are used instead.");
+  opt_desc.add_options()(
+      "enable-two-phase-count-distinct",
+      po::value<bool>(&config_->exec.group_by.enable_two_phase_count_distinct)
+          ->default_value(config_->exec.group_by.enable_two_phase_count_distinct)
+          ->implicit_value(true),
+      "Execute grouped COUNT(DISTINCT) on values with unknown or huge range as a "
+      "distinct aggregation followed by COUNT.");
+  opt_desc.add_options()(
+      "two-phase-count-distinct-threshold",
+      po::value<size_t>(&config_->exec.group_by.two_phase_count_distinct_threshold)
+          ->default_value(config_->exec.group_by.two_phase_count_distinct_threshold),
+      "Minimal number of input rows to use two-phase COUNT(DISTINCT).");
+  opt_desc.add_options()(
+      "enable-group-by-buffer-pool",
+      po::value<bool>(&config_->exec.group_by.enable_buffer_pool)
+          ->default_value(config_->exec.group_by.enable_buffer_pool)
+          ->implicit_value(true),
+      "Reuse initialized CPU group by buffers across queries instead of allocating "
+      "and initializing new buffers for each kernel.");
+  opt_desc.add_options()(
+      "group-by-buffer-pool-size",
+      po::value<size_t>(&config_->exec.group_by.buffer_pool_size)
+          ->default_value(config_->exec.group_by.buffer_pool_size),
+      "Maximum size in bytes of idle buffers kept in the group by buffer pool.");
+  opt_desc.add_options()(
+      "group-by-buffer-pool-max-buffer-size",
+      po::value<size_t>(&config_->exec.group_by.buffer_pool_max_buffer_size)
+          ->default_value(config_->exec.group_by.buffer_pool_max_buffer_size),
+      "Maximum size in bytes of a group by buffer to be reused through the pool.");
 
   // exec.window
   opt_desc.add_options()("enable-window-functions",
@@ -346,6 +421,46 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->implicit_value(true),
       "Enable the filter function protection feature for the SQL JIT compiler. "
       "Normally should be on but techs might want to disable for troubleshooting.");
+  opt_desc.add_options()(
+      "enable-tiered-compilation",
+      po::value<bool>(&config_->exec.codegen.enable_tiered_compilation)
+          ->default_value(config_->exec.codegen.enable_tiered_compilation)
+          ->implicit_value(true),
+      "Compile CPU kernels with minimal optimizations first and recompile them with "
+      "full optimizations in background when they are reused.");
+  opt_desc.add_options()(
+      "tier-up-threshold",
+      po::value<size_t>(&config_->exec.codegen.tier_up_threshold)
+          ->default_value(config_->exec.codegen.tier_up_threshold),
+      "Number of code cache hits for a CPU kernel compiled with minimal optimizations "
+      "to schedule its optimized recompilation.");
+  opt_desc.add_options()(
+      "enable-interpreter",
+      po::value<bool>(&config_->exec.codegen.enable_interpreter)
+          ->default_value(config_->exec.codegen.enable_interpreter)
+          ->implicit_value(true),
+      "Execute supported non-grouped aggregations over small inputs with an "
+      "interpreter instead of compiling them.");
+  opt_desc.add_options()(
+      "interpreter-max-input-rows",
+      po::value<size_t>(&config_->exec.codegen.interpreter_max_input_rows)
+          ->default_value(config_->exec.codegen.interpreter_max_input_rows),
+      "Max number of input rows for a query to be executed by the interpreter.");
+  opt_desc.add_options()(
+      "enable-speculative-compilation",
+      po::value<bool>(&config_->exec.codegen.enable_speculative_compilation)
+          ->default_value(config_->exec.codegen.enable_speculative_compilation)
+          ->implicit_value(true),
+      "Compile later query steps in background while earlier steps are executed when "
+      "inputs of those steps are already known.");
+  opt_desc.add_options()(
+      "enable-runtime-dylib",
+      po::value<bool>(&config_->exec.codegen.enable_runtime_dylib)
+          ->default_value(config_->exec.codegen.enable_runtime_dylib)
+          ->implicit_value(true),
+      "Compile runtime functions once and call them from CPU kernels instead of "
+      "cloning them into each kernel module. Functions which need to be inlined are "
+      "still cloned.");
 
   // exec
   opt_desc.add_options()("streaming-top-n-max",
@@ -358,6 +473,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->exec.parallel_top_min),
       "For ResultSets requiring a heap sort, the number of rows necessary to trigger "
       "parallelTop() to sort.");
+  opt_desc.add_options()(
+      "enable-top-n-fragment-pruning",
+      po::value<bool>(&config_->exec.enable_top_n_fragment_pruning)
+          ->default_value(config_->exec.enable_top_n_fragment_pruning)
+          ->implicit_value(true),
+      "Use chunk stats to filter out rows and fragments which cannot get into the "
+      "result of ORDER BY with LIMIT over a single table.");
   opt_desc.add_options()(
       "enable-experimental-string-functions",
       po::value<bool>(&config_->exec.enable_experimental_string_functions)
@@ -406,6 +528,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                              ->default_value(config_->exec.initialize_with_gpu_vendor),
                          "GPU vendor to use for Data Manager initialization. Valid "
                          "values are \"intel\" and \"nvidia\".");
+  opt_desc.add_options()(
+      "enable-numa-affinity",
+      po::value<bool>(&config_->exec.enable_numa_affinity)
+          ->default_value(config_->exec.enable_numa_affinity)
+          ->implicit_value(true),
+      "Run CPU kernels in per-NUMA node thread pools. Each fragment is always "
+      "processed by the same node and its chunks are placed in this node's memory.");
 
   opt_desc.add_options()(
       "use-cost-model",
@@ -507,6 +636,39 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       "there is not enough free memory to accomodate the target slab size, smaller "
       "slabs will be allocated, down to the minimum size specified by "
       "min-cpu-slab-size.");
+  opt_desc.add_options()(
+      "cpu-buffer-eviction-policy",
+      po::value<std::string>(&config_->mem.cpu.eviction_policy)
+          ->default_value(config_->mem.cpu.eviction_policy),
+      "Eviction policy for CPU buffer pool. Use 'lru' to evict least recently used "
+      "chunks first or 'lru2' to evict chunks used only once before chunks used "
+      "repeatedly, which protects frequently used chunks from large scans.");
+  opt_desc.add_options()(
+      "cpu-buffer-priority-tables",
+      po::value<std::string>(&config_->mem.cpu.priority_tables)
+          ->default_value(config_->mem.cpu.priority_tables),
+      "Comma-separated list of tables in <db_id>:<table_id> format. Chunks of these "
+      "tables are evicted from CPU buffer pool only when there are no other chunks "
+      "to evict.");
+  opt_desc.add_options()(
+      "enable-huge-pages",
+      po::value<bool>(&config_->mem.cpu.enable_huge_pages)
+          ->default_value(config_->mem.cpu.enable_huge_pages)
+          ->implicit_value(true),
+      "Use transparent huge pages for CPU buffer pool slabs and large query buffers "
+      "to reduce TLB misses.");
+  opt_desc.add_options()(
+      "enable-prefault",
+      po::value<bool>(&config_->mem.cpu.enable_prefault)
+          ->default_value(config_->mem.cpu.enable_prefault)
+          ->implicit_value(true),
+      "Touch all pages of new CPU buffer pool slabs and large query buffers in "
+      "parallel to avoid page faults during query execution.");
+  opt_desc.add_options()(
+      "huge-pages-buffer-threshold",
+      po::value<size_t>(&config_->mem.cpu.huge_pages_buffer_threshold)
+          ->default_value(config_->mem.cpu.huge_pages_buffer_threshold),
+      "Minimal size of a query buffer to use huge pages and prefaulting for.");
 
   // mem.gpu
   opt_desc.add_options()(
@@ -582,6 +744,21 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->cache.max_cacheable_hashtable_size_bytes)
           ->default_value(config_->cache.max_cacheable_hashtable_size_bytes),
       "The maximum size of hashtable that is available to cache, in bytes");
+  opt_desc.add_options()("use-query-resultset-cache",
+                         po::value<bool>(&config_->cache.use_query_resultset_cache)
+                             ->default_value(config_->cache.use_query_resultset_cache)
+                             ->implicit_value(true),
+                         "Reuse result sets of query steps.");
+  opt_desc.add_options()(
+      "query-resultset-cache-total-bytes",
+      po::value<size_t>(&config_->cache.query_resultset_cache_total_bytes)
+          ->default_value(config_->cache.query_resultset_cache_total_bytes),
+      "Size of total memory space for query resultset cache, in bytes.");
+  opt_desc.add_options()(
+      "max-query-resultset-size-bytes",
+      po::value<size_t>(&config_->cache.max_query_resultset_size_bytes)
+          ->default_value(config_->cache.max_query_resultset_size_bytes),
+      "The maximum size of query resultset that is available to cache, in bytes");
   opt_desc.add_options()(
       "gpu-code-cache-eviction-percent",
       po::value<double>(&config_->cache.gpu_fraction_code_cache_to_evict)
@@ -596,6 +773,11 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                          po::value<size_t>(&config_->cache.code_cache_size)
                              ->default_value(config_->cache.code_cache_size),
                          "Maximum number of entries in a code cache");
+  opt_desc.add_options()(
+      "cardinality-cache-size",
+      po::value<size_t>(&config_->cache.cardinality_cache_size)
+          ->default_value(config_->cache.cardinality_cache_size),
+      "Maximum number of cached cardinality estimations of each kind");
 
   // debug
   opt_desc.add_options()("build-rel-alg-cache",
@@ -636,6 +818,26 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       "processing on import as we might require. This might increase overall execution "
       "time. This option can be used to split data import and execution for performance "
       "measurements.");
+  opt_desc.add_options()(
+      "enable-streaming-import",
+      po::value<bool>(&config_->storage.enable_streaming_import)
+          ->default_value(config_->storage.enable_streaming_import)
+          ->implicit_value(true),
+      "Enable streaming CSV and JSON import in Arrow Storage. Parsed blocks are "
+      "appended to the table while the following blocks are still being parsed.");
+  opt_desc.add_options()(
+      "streaming-import-blocks",
+      po::value<size_t>(&config_->storage.streaming_import_blocks)
+          ->default_value(config_->storage.streaming_import_blocks),
+      "Number of parsed blocks accumulated by streaming import before they are "
+      "appended to the table.");
+  opt_desc.add_options()(
+      "enable-column-compression",
+      po::value<bool>(&config_->storage.enable_column_compression)
+          ->default_value(config_->storage.enable_column_compression)
+          ->implicit_value(true),
+      "Enable bit-packed storage of integer columns in Arrow Storage. Fragments with "
+      "a narrow value range are stored packed and decoded by generated code on CPU.");
 
   if (allow_gtest_flags) {
     opt_desc.add_options()("gtest_list_tests", "list all test");
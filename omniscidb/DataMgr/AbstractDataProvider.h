@@ -16,6 +16,11 @@
 
 #include "AbstractBufferMgr.h"
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 /**
  * This calss simply exists to hold all 'UNREACHABLE' definitions of
  * AbstractBufferMgr. This class should be removed when we have DataProvider
@@ -23,8 +28,21 @@
  */
 class AbstractDataProvider : public Data_Namespace::AbstractBufferMgr {
  public:
+  using RetiredChunksHandler = std::function<void(const ChunkKey&)>;
+
   AbstractDataProvider() : Data_Namespace::AbstractBufferMgr(0) {}
 
+  /**
+   * Register a handler to be called with key prefixes of chunks which are never
+   * going to be requested again, e.g. when a fragment gets a new id after its data
+   * is rewritten. It allows buffer managers to release cached copies of such chunks.
+   * The handler is dropped when the referenced object is destroyed.
+   */
+  void addRetiredChunksHandler(std::weak_ptr<const RetiredChunksHandler> handler) {
+    std::lock_guard<std::mutex> lock(retired_chunks_handlers_mutex_);
+    retired_chunks_handlers_.emplace_back(std::move(handler));
+  }
+
   Data_Namespace::AbstractBuffer* createBuffer(const ChunkKey& key,
                                                const size_t pageSize = 0,
                                                const size_t initialSize = 0) override {
@@ -121,4 +139,33 @@ class AbstractDataProvider : public Data_Namespace::AbstractBufferMgr {
     UNREACHABLE();
     return 0;
   }
+
+ protected:
+  void retireChunks(const std::vector<ChunkKey>& key_prefixes) {
+    if (key_prefixes.empty()) {
+      return;
+    }
+    std::vector<std::shared_ptr<const RetiredChunksHandler>> handlers;
+    {
+      std::lock_guard<std::mutex> lock(retired_chunks_handlers_mutex_);
+      auto it = retired_chunks_handlers_.begin();
+      while (it != retired_chunks_handlers_.end()) {
+        if (auto handler = it->lock()) {
+          handlers.emplace_back(std::move(handler));
+          ++it;
+        } else {
+          it = retired_chunks_handlers_.erase(it);
+        }
+      }
+    }
+    for (auto& handler : handlers) {
+      for (auto& key_prefix : key_prefixes) {
+        (*handler)(key_prefix);
+      }
+    }
+  }
+
+ private:
+  std::mutex retired_chunks_handlers_mutex_;
+  std::vector<std::weak_ptr<const RetiredChunksHandler>> retired_chunks_handlers_;
 };
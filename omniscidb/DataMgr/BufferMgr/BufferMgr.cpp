@@ -24,10 +24,12 @@
 #include <algorithm>
 #include <iomanip>
 #include <limits>
+#include <optional>
 
 #include "DataMgr/BufferMgr/Buffer.h"
 #include "Logger/Logger.h"
 #include "Shared/measure.h"
+#include "Shared/numa.h"
 #include "Shared/scope.h"
 
 using namespace std;
@@ -60,7 +62,8 @@ BufferMgr::BufferMgr(const int device_id,
     , allocations_capped_(false)
     , parent_mgr_(parent_mgr)
     , max_buffer_id_(0)
-    , buffer_epoch_(0) {
+    , buffer_epoch_(1)
+    , eviction_policy_(std::make_unique<LruEvictionPolicy>()) {
   CHECK(max_buffer_pool_size_ > 0);
   CHECK(page_size_ > 0);
   // TODO change checks on run-time configurable slab size variables to exceptions
@@ -111,8 +114,11 @@ void BufferMgr::clear() {
   chunk_index_.clear();
   slabs_.clear();
   slab_segments_.clear();
+  slab_free_segs_.clear();
+  slab_numa_nodes_.clear();
   unsized_segs_.clear();
-  buffer_epoch_ = 0;
+  // Zero epoch is reserved to mark segments without previous accesses.
+  buffer_epoch_ = 1;
 }
 
 /// Throws a runtime_error if the Chunk already exists
@@ -182,6 +188,10 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
+      updateTableStats(evict_it->chunk_key, 0, 0, 1);
+    }
+    if (evict_it->mem_status == FREE) {
+      removeFreeSegment(slab_num, evict_it);
     }
     if (evict_it->buffer != nullptr) {
       // If we don't delete buffers here then we lose reference to them later and cause
@@ -192,8 +202,8 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
         evict_it);  // erase operations returns next iterator - safe if we ever move
                     // to a vector (as opposed to erase(evict_it++)
   }
-  BufferSeg data_seg(
-      start_page, num_pages_requested, USED, buffer_epoch_++);  // until we can
+  BufferSeg data_seg(start_page, num_pages_requested, USED);
+  eviction_policy_->onInsert(data_seg, buffer_epoch_++);
   // data_seg.pinCount++;
   data_seg.slab_num = slab_num;
   auto data_seg_it =
@@ -202,11 +212,13 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     size_t excess_pages = num_pages - num_pages_requested;
     if (evict_it != slab_segments_[slab_num].end() &&
         evict_it->mem_status == FREE) {  // need to merge with current page
+      removeFreeSegment(slab_num, evict_it);
       evict_it->start_page = start_page + num_pages_requested;
       evict_it->num_pages += excess_pages;
+      addFreeSegment(slab_num, evict_it);
     } else {  // need to insert a free seg before evict_it for excess_pages
       BufferSeg free_seg(start_page + num_pages_requested, excess_pages, FREE);
-      slab_segments_[slab_num].insert(evict_it, free_seg);
+      addFreeSegment(slab_num, slab_segments_[slab_num].insert(evict_it, free_seg));
     }
   }
   return data_seg_it;
@@ -232,9 +244,15 @@ BufferList::iterator BufferMgr::reserveBuffer(
         next_it->num_pages >= num_pages_extra_needed) {
       // Then we can just use the next BufferSeg which happens to be free
       size_t leftover_pages = next_it->num_pages - num_pages_extra_needed;
+      removeFreeSegment(slab_num, next_it);
       seg_it->num_pages = num_pages_requested;
-      next_it->num_pages = leftover_pages;
-      next_it->start_page = seg_it->start_page + seg_it->num_pages;
+      if (leftover_pages > 0) {
+        next_it->num_pages = leftover_pages;
+        next_it->start_page = seg_it->start_page + seg_it->num_pages;
+        addFreeSegment(slab_num, next_it);
+      } else {
+        slab_segments_[slab_num].erase(next_it);
+      }
       return seg_it;
     }
   }
@@ -245,6 +263,11 @@ BufferList::iterator BufferMgr::reserveBuffer(
   // Below should be in copy constructor for BufferSeg?
   new_seg_it->buffer = seg_it->buffer;
   new_seg_it->chunk_key = seg_it->chunk_key;
+  if (slab_num >= 0) {
+    // Moving a buffer is not an access, keep its history.
+    new_seg_it->last_touched = seg_it->last_touched;
+    new_seg_it->prev_touched = seg_it->prev_touched;
+  }
   int8_t* old_mem = new_seg_it->buffer->mem_;
   new_seg_it->buffer->mem_ =
       slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
@@ -264,37 +287,57 @@ BufferList::iterator BufferMgr::reserveBuffer(
     std::lock_guard<std::mutex> lock(chunk_index_mutex_);
     chunk_index_[new_seg_it->chunk_key] = new_seg_it;
   }
+  sized_segs_lock.unlock();
+  finishSlabPreparation();
 
   return new_seg_it;
 }
 
+void BufferMgr::addFreeSegment(const int slab_num, BufferList::iterator seg_it) {
+  // It is assumed that caller holds a lock on sized_segs_mutex_.
+  CHECK_EQ(seg_it->mem_status, FREE);
+  auto res = slab_free_segs_[slab_num].emplace(
+      std::make_pair(seg_it->num_pages, seg_it->start_page), seg_it);
+  CHECK(res.second);
+}
+
+void BufferMgr::removeFreeSegment(const int slab_num, BufferList::iterator seg_it) {
+  // It is assumed that caller holds a lock on sized_segs_mutex_.
+  auto erased = slab_free_segs_[slab_num].erase(
+      std::make_pair(seg_it->num_pages, seg_it->start_page));
+  CHECK_EQ(erased, size_t(1));
+}
+
 BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
                                                      const size_t num_pages_requested) {
   // It is assumed that caller holds a lock on sized_segs_mutex_.
-  for (auto buffer_it = slab_segments_[slab_num].begin();
-       buffer_it != slab_segments_[slab_num].end();
-       ++buffer_it) {
-    if (buffer_it->mem_status == FREE && buffer_it->num_pages >= num_pages_requested) {
-      // startPage doesn't change
-      size_t excess_pages = buffer_it->num_pages - num_pages_requested;
-      buffer_it->num_pages = num_pages_requested;
-      buffer_it->mem_status = USED;
-      buffer_it->last_touched = buffer_epoch_++;
-      buffer_it->slab_num = slab_num;
-      if (excess_pages > 0) {
-        BufferSeg free_seg(
-            buffer_it->start_page + num_pages_requested, excess_pages, FREE);
-        auto temp_it = buffer_it;  // this should make a copy and not be a reference
-        // - as we do not want to increment buffer_it
-        temp_it++;
-        slab_segments_[slab_num].insert(temp_it, free_seg);
-      }
-      return buffer_it;
-    }
-  }
-  // If here then we did not find a free buffer of sufficient size in this slab,
-  // return the end iterator
-  return slab_segments_[slab_num].end();
+  // Pick the smallest free segment which is big enough (the one with the lowest
+  // start page among equally sized ones) to keep large free segments for large
+  // chunks.
+  auto& free_segs = slab_free_segs_[slab_num];
+  auto free_it = free_segs.lower_bound(
+      std::make_pair(num_pages_requested, std::numeric_limits<int>::min()));
+  if (free_it == free_segs.end()) {
+    // If here then we did not find a free buffer of sufficient size in this slab,
+    // return the end iterator
+    return slab_segments_[slab_num].end();
+  }
+  auto buffer_it = free_it->second;
+  free_segs.erase(free_it);
+  CHECK_EQ(buffer_it->mem_status, FREE);
+  CHECK_GE(buffer_it->num_pages, num_pages_requested);
+  // startPage doesn't change
+  size_t excess_pages = buffer_it->num_pages - num_pages_requested;
+  buffer_it->num_pages = num_pages_requested;
+  buffer_it->mem_status = USED;
+  eviction_policy_->onInsert(*buffer_it, buffer_epoch_++);
+  buffer_it->slab_num = slab_num;
+  if (excess_pages > 0) {
+    BufferSeg free_seg(buffer_it->start_page + num_pages_requested, excess_pages, FREE);
+    addFreeSegment(slab_num,
+                   slab_segments_[slab_num].insert(std::next(buffer_it), free_seg));
+  }
+  return buffer_it;
 }
 
 BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
@@ -306,11 +349,25 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   size_t num_slabs = slab_segments_.size();
 
-  for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
-    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
-    if (seg_it != slab_segments_[slab_num].end()) {
-      return seg_it;
+  // When the requesting thread works for a NUMA node, slabs of this node are
+  // checked first. Then we try to allocate a new slab on this node and only after
+  // that use slabs of other nodes.
+  const int numa_node = numa::current_node();
+  auto find_in_slabs = [&](bool local_node) -> std::optional<BufferList::iterator> {
+    for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+      if (numa_node >= 0 && (slab_numa_nodes_[slab_num] == numa_node) != local_node) {
+        continue;
+      }
+      auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+      if (seg_it != slab_segments_[slab_num].end()) {
+        return seg_it;
+      }
     }
+    return std::nullopt;
+  };
+
+  if (auto seg_it = find_in_slabs(true)) {
+    return *seg_it;
   }
 
   // If we're here then we didn't find a free segment of sufficient size
@@ -325,7 +382,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           current_max_slab_page_size_) {  // don't try to allocate if the
                                           // new slab won't be big enough
         auto alloc_ms = measure<>::execution(
-            [&]() { addSlab(current_max_slab_page_size_ * page_size_); });
+            [&]() { addSlab(current_max_slab_page_size_ * page_size_, numa_node); });
         LOG(INFO) << "ALLOCATION slab of " << current_max_slab_page_size_ << " pages ("
                   << current_max_slab_page_size_ * page_size_ << "B) created in "
                   << alloc_ms << " ms " << getStringMgrType() << ":" << device_id_;
@@ -334,6 +391,15 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
       }
       // if here then addSlab succeeded
       num_pages_allocated_ += current_max_slab_page_size_;
+      slab_numa_nodes_.push_back(numa_node);
+      slab_free_segs_.resize(slab_segments_.size());
+      for (auto seg_it = slab_segments_[num_slabs].begin();
+           seg_it != slab_segments_[num_slabs].end();
+           ++seg_it) {
+        if (seg_it->mem_status == FREE) {
+          addFreeSegment(num_slabs, seg_it);
+        }
+      }
       return findFreeBufferInSlab(
           num_slabs,
           num_pages_requested);  // has to succeed since we made sure to request a slab
@@ -368,9 +434,15 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
     throw FailedToCreateFirstSlab(num_bytes);
   }
 
+  if (numa_node >= 0) {
+    if (auto seg_it = find_in_slabs(false)) {
+      return *seg_it;
+    }
+  }
+
   // If here then we can't add a slab - so we need to evict
 
-  size_t min_score = std::numeric_limits<size_t>::max();
+  uint64_t min_score = std::numeric_limits<uint64_t>::max();
   // We're going for lowest score here, like golf
   // This is because score is the sum of the lastTouched score for all pages evicted.
   // Evicting fewer pages and older pages will lower the score
@@ -389,7 +461,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
       // if (buffer_it->mem_status == FREE || buffer_it->buffer->getPinCount() == 0) {
       size_t page_count = 0;
-      size_t score = 0;
+      uint64_t score = 0;
       bool solution_found = false;
       auto evict_it = buffer_it;
       for (; evict_it != slab_segments_[slab_num].end(); ++evict_it) {
@@ -409,7 +481,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           // large chunk so under memory pressure a query would evict its own current
           // chunks and cause reloads rather than evict several smaller unused older
           // chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+          score = std::max(score, getEvictionPriority(*evict_it));
         }
         if (page_count >= num_pages_requested) {
           solution_found = true;
@@ -679,6 +751,7 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
       // LOG(INFO) << "PrevIt: " << " " << getStringMgrType() << ":" << device_id_;
       // printSeg(prev_it);
       if (prev_it->mem_status == FREE) {
+        removeFreeSegment(slab_num, prev_it);
         seg_it->start_page = prev_it->start_page;
         seg_it->num_pages += prev_it->num_pages;
         slab_segments_[slab_num].erase(prev_it);
@@ -687,6 +760,7 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     auto next_it = std::next(seg_it);
     if (next_it != slab_segments_[slab_num].end()) {
       if (next_it->mem_status == FREE) {
+        removeFreeSegment(slab_num, next_it);
         seg_it->num_pages += next_it->num_pages;
         slab_segments_[slab_num].erase(next_it);
       }
@@ -694,6 +768,7 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     seg_it->mem_status = FREE;
     // seg_it->pinCount = 0;
     seg_it->buffer = 0;
+    addFreeSegment(slab_num, seg_it);
   }
 }
 
@@ -721,7 +796,8 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
         buffer_it->second->buffer->pin();
         sized_segs_lock.unlock();
 
-        buffer_it->second->last_touched = buffer_epoch_++;  // race
+        eviction_policy_->onAccess(*buffer_it->second, buffer_epoch_++);  // race
+        updateTableStats(key, 1, 0, 0);
 
         // If we need to fetch a missing part of buffer, then lock it by
         // creating a conditional variable.
@@ -743,6 +819,7 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
         res = buffer_it->second->buffer;
       } else {  // If wasn't in pool then we need to fetch it
         sized_segs_lock.unlock();
+        updateTableStats(key, 0, 1, 0);
         // Create conditional variable to later notify all other threads
         // trying to fetch the same chunk.
         in_progress_buffer_cvs_[key] = std::make_shared<std::condition_variable>();
@@ -785,6 +862,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   bool found_buffer = buffer_it != chunk_index_.end();
   chunk_index_lock.unlock();
   AbstractBuffer* buffer;
+  updateTableStats(key, found_buffer, !found_buffer, 0);
   if (!found_buffer) {
     sized_segs_lock.unlock();
     CHECK(parent_mgr_ != 0);
@@ -801,6 +879,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   } else {
     buffer = buffer_it->second->buffer;
     buffer->pin();
+    eviction_policy_->onAccess(*buffer_it->second, buffer_epoch_++);
     sized_segs_lock.unlock();
 
     if (num_bytes > buffer->size()) {
@@ -887,7 +966,51 @@ MemoryInfo BufferMgr::getMemoryInfo() {
       mi.nodeMemoryData.push_back(md);
     }
   }
+
+  std::lock_guard<std::mutex> table_stats_lock(table_stats_mutex_);
+  for (auto& [table, stats] : table_stats_) {
+    mi.tableStats.push_back(stats);
+  }
   return mi;
 }
 
+void BufferMgr::setEvictionPolicy(std::unique_ptr<EvictionPolicy> policy) {
+  CHECK(policy);
+  eviction_policy_ = std::move(policy);
+}
+
+void BufferMgr::setPriorityTables(std::set<std::pair<int, int>> tables) {
+  priority_tables_ = std::move(tables);
+}
+
+uint64_t BufferMgr::getEvictionPriority(const BufferSeg& seg) const {
+  auto priority = eviction_policy_->getPriority(seg);
+  if (!priority_tables_.empty() && has_table_prefix(seg.chunk_key) &&
+      priority_tables_.count(get_table_prefix(seg.chunk_key))) {
+    // Policies use up to 33 bits, so this puts priority tables after all others.
+    priority |= uint64_t(1) << 34;
+  }
+  return priority;
+}
+
+void BufferMgr::updateTableStats(const ChunkKey& key,
+                                 size_t hits,
+                                 size_t misses,
+                                 size_t evictions) {
+  // Buffers allocated through alloc() have negative db_id and don't belong to
+  // tables.
+  if (!has_table_prefix(key) || key[CHUNK_KEY_DB_IDX] < 0) {
+    return;
+  }
+  auto table = get_table_prefix(key);
+  std::lock_guard<std::mutex> table_stats_lock(table_stats_mutex_);
+  auto it = table_stats_.find(table);
+  if (it == table_stats_.end()) {
+    it = table_stats_.emplace(table, TableBufferStats{table.first, table.second}).first;
+  }
+  it->second.hits += hits;
+  it->second.misses += misses;
+  it->second.evictions += evictions;
+}
+
 }  // namespace Buffer_Namespace
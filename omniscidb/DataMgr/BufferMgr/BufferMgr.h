@@ -31,10 +31,12 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/BufferMgr/BufferSeg.h"
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
 #include "Shared/boost_stacktrace.hpp"
 #include "Shared/types.h"
 
@@ -96,12 +98,23 @@ struct MemoryData {
   MemStatus memStatus;
 };
 
+struct TableBufferStats {
+  int db_id;
+  int table_id;
+  // Chunk requests served from the pool and fetched from the parent manager.
+  size_t hits = 0;
+  size_t misses = 0;
+  // Chunks evicted to free space for other chunks.
+  size_t evictions = 0;
+};
+
 struct MemoryInfo {
   size_t pageSize;
   size_t maxNumPages;
   size_t numPageAllocated;
   bool isAllocationCapped;
   std::vector<MemoryData> nodeMemoryData;
+  std::vector<TableBufferStats> tableStats;
 };
 
 /**
@@ -197,6 +210,13 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   MemoryInfo getMemoryInfo();
 
+  // Eviction settings are not synchronized with buffer requests and should be set
+  // before the pool is used.
+  void setEvictionPolicy(std::unique_ptr<EvictionPolicy> policy);
+  // Chunks of priority tables are evicted only when there are no other chunks to
+  // evict. Tables are identified by {db_id, table_id}.
+  void setPriorityTables(std::set<std::pair<int, int>> tables);
+
  protected:
   const size_t
       max_buffer_pool_size_;    /// max number of bytes allocated for the buffer pool
@@ -216,7 +236,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
   int getBufferId();
-  virtual void addSlab(const size_t slab_size) = 0;
+  // numa_node is the NUMA node preferred for the slab memory, -1 for any node.
+  virtual void addSlab(const size_t slab_size, const int numa_node) = 0;
+  // Called without sized_segs_mutex_ held after a buffer got its segment, so slow
+  // preparation of slabs added meanwhile doesn't block other buffer requests.
+  virtual void finishSlabPreparation() {}
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
                               const size_t page_size,
@@ -228,6 +252,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
     return nullptr;
   }
   void clear();
+  uint64_t getEvictionPriority(const BufferSeg& seg) const;
+  void updateTableStats(const ChunkKey& key,
+                        size_t hits,
+                        size_t misses,
+                        size_t evictions);
 
   std::mutex chunk_index_mutex_;
   std::mutex sized_segs_mutex_;
@@ -248,9 +277,21 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   AbstractBufferMgr* parent_mgr_;
   int max_buffer_id_;
   unsigned int buffer_epoch_;
+  std::unique_ptr<EvictionPolicy> eviction_policy_;
+  std::set<std::pair<int, int>> priority_tables_;
+  std::mutex table_stats_mutex_;
+  std::map<std::pair<int, int>, TableBufferStats> table_stats_;
 
   BufferList unsized_segs_;
-
+  // Free segments of each slab ordered by size and start page. Used to find the
+  // smallest free segment fitting a request in O(log n) rather than scanning all
+  // segments of the slab. Access should be synced through sized_segs_mutex_.
+  std::vector<std::map<std::pair<size_t, int>, BufferList::iterator>> slab_free_segs_;
+  // NUMA node of each slab, -1 if the slab was allocated without node preference.
+  std::vector<int> slab_numa_nodes_;
+
+  void addFreeSegment(const int slab_num, BufferList::iterator seg_it);
+  void removeFreeSegment(const int slab_num, BufferList::iterator seg_it);
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
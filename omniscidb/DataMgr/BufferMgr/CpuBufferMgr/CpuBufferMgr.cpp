@@ -18,10 +18,12 @@
 
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
+#include "Shared/huge_pages.h"
+#include "Shared/numa.h"
 
 namespace Buffer_Namespace {
 
-void CpuBufferMgr::addSlab(const size_t slab_size) {
+void CpuBufferMgr::addSlab(const size_t slab_size, const int numa_node) {
   CHECK(allocator_);
   slabs_.resize(slabs_.size() + 1);
   try {
@@ -30,13 +32,48 @@ void CpuBufferMgr::addSlab(const size_t slab_size) {
     slabs_.resize(slabs_.size() - 1);
     throw FailedToCreateSlab(slab_size);
   }
+  prepareSlabMemory(slabs_.back(), slab_size, numa_node);
   slab_segments_.resize(slab_segments_.size() + 1);
   slab_segments_[slab_segments_.size() - 1].push_back(
       BufferSeg(0, slab_size / page_size_));
 }
 
+void CpuBufferMgr::prepareSlabMemory(int8_t* slab,
+                                     const size_t slab_size,
+                                     const int numa_node) {
+  // Memory policy and huge pages advice are applied before the first touch, so
+  // prefaulting allocates pages on the right node with the right page size.
+  numa::bind_to_node(slab, slab_size, numa_node);
+  if (use_huge_pages_) {
+    huge_pages::advise(slab, slab_size);
+  }
+  if (prefault_) {
+    std::lock_guard<std::mutex> lock(pending_prefaults_mutex_);
+    pending_prefaults_.emplace_back(slab, slab_size);
+  }
+}
+
+void CpuBufferMgr::finishSlabPreparation() {
+  std::vector<std::pair<int8_t*, size_t>> slabs;
+  {
+    std::lock_guard<std::mutex> lock(pending_prefaults_mutex_);
+    slabs.swap(pending_prefaults_);
+  }
+  // Other threads may already use segments of these slabs. Prefaulting preserves
+  // the memory content, so it is safe.
+  for (auto& [slab, slab_size] : slabs) {
+    huge_pages::prefault(slab, slab_size);
+  }
+}
+
+void CpuBufferMgr::clearPendingPrefaults() {
+  std::lock_guard<std::mutex> lock(pending_prefaults_mutex_);
+  pending_prefaults_.clear();
+}
+
 void CpuBufferMgr::freeAllMem() {
   CHECK(allocator_);
+  clearPendingPrefaults();
   initializeMem();
 }
 
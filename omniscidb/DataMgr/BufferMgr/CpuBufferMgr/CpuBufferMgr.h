@@ -52,15 +52,31 @@ class CpuBufferMgr : public BufferMgr {
       const size_t page_size,
       std::unique_ptr<AbstractDataToken> token) override;
 
+  // Configures memory of slabs added after the call.
+  void setSlabMemoryOptions(bool use_huge_pages, bool prefault) {
+    use_huge_pages_ = use_huge_pages;
+    prefault_ = prefault;
+  }
+
  protected:
-  void addSlab(const size_t slab_size) override;
+  void addSlab(const size_t slab_size, const int numa_node) override;
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator segment_iter,
                       const size_t page_size,
                       const size_t initial_size) override;
   virtual void initializeMem();
+  // Places a new slab on the NUMA node and applies huge pages option. Prefaulting
+  // takes long for big slabs, so the slab is only queued for it here.
+  void prepareSlabMemory(int8_t* slab, const size_t slab_size, const int numa_node);
+  // Prefaults slabs queued by prepareSlabMemory.
+  void finishSlabPreparation() override;
+  void clearPendingPrefaults();
 
   GpuMgr* gpu_mgr_;
+  bool use_huge_pages_ = false;
+  bool prefault_ = false;
+  std::mutex pending_prefaults_mutex_;
+  std::vector<std::pair<int8_t*, size_t>> pending_prefaults_;
 
  private:
   std::unique_ptr<Arena> allocator_;
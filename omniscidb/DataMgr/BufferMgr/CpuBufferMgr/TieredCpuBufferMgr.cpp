@@ -63,7 +63,7 @@ Arena* TieredCpuBufferMgr::getAllocatorForSlab(int32_t slab_num) const {
   return shared::get_from_map(slab_to_allocator_map_, slab_num);
 }
 
-void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
+void TieredCpuBufferMgr::addSlab(const size_t slab_size, const int numa_node) {
   CHECK(!allocators_.empty());
   CHECK(allocators_.begin()->first.get() != nullptr);
   slabs_.resize(slabs_.size() + 1);
@@ -82,6 +82,9 @@ void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
         slabs_.resize(slabs_.size() - 1);
         throw FailedToCreateSlab(slab_size);
       }
+      if (allocator_type == CpuTier::DRAM) {
+        prepareSlabMemory(slabs_.back(), slab_size, numa_node);
+      }
       slab_to_allocator_map_[slabs_.size() - 1] = allocator.get();
       allocated_slab = true;
       break;
@@ -103,6 +106,7 @@ void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
 void TieredCpuBufferMgr::freeAllMem() {
   CHECK(!allocators_.empty());
   CHECK(allocators_.begin()->first.get() != nullptr);
+  clearPendingPrefaults();
   initializeMem();
 }
 
@@ -53,7 +53,7 @@ class TieredCpuBufferMgr : public CpuBufferMgr {
   std::string dump() const;
 
  private:
-  void addSlab(const size_t slab_size) override;
+  void addSlab(const size_t slab_size, const int numa_node) override;
   void freeAllMem() override;
   void initializeMem() override;
 
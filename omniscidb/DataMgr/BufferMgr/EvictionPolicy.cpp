@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
+
+#include <stdexcept>
+
+namespace Buffer_Namespace {
+
+std::unique_ptr<EvictionPolicy> EvictionPolicy::create(const std::string& name) {
+  if (name == "lru") {
+    return std::make_unique<LruEvictionPolicy>();
+  }
+  if (name == "lru2") {
+    return std::make_unique<Lru2EvictionPolicy>();
+  }
+  throw std::runtime_error("Unknown buffer pool eviction policy: " + name);
+}
+
+void LruEvictionPolicy::onInsert(BufferSeg& seg, unsigned int epoch) const {
+  seg.last_touched = epoch;
+  seg.prev_touched = 0;
+}
+
+void LruEvictionPolicy::onAccess(BufferSeg& seg, unsigned int epoch) const {
+  seg.last_touched = epoch;
+}
+
+uint64_t LruEvictionPolicy::getPriority(const BufferSeg& seg) const {
+  return seg.last_touched;
+}
+
+void Lru2EvictionPolicy::onInsert(BufferSeg& seg, unsigned int epoch) const {
+  seg.last_touched = epoch;
+  seg.prev_touched = 0;
+}
+
+void Lru2EvictionPolicy::onAccess(BufferSeg& seg, unsigned int epoch) const {
+  seg.prev_touched = seg.last_touched;
+  seg.last_touched = epoch;
+}
+
+uint64_t Lru2EvictionPolicy::getPriority(const BufferSeg& seg) const {
+  // Segments with a single access have an infinite backward 2-distance. Order them
+  // by the last access and put all of them before segments with two accesses.
+  if (!seg.prev_touched) {
+    return seg.last_touched;
+  }
+  return (uint64_t(1) << 32) | seg.prev_touched;
+}
+
+}  // namespace Buffer_Namespace
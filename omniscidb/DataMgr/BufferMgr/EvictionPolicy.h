@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "DataMgr/BufferMgr/BufferSeg.h"
+
+#include <memory>
+#include <string>
+
+namespace Buffer_Namespace {
+
+// Defines the order in which unpinned chunks are evicted from a buffer pool. The
+// policy maintains access history of used segments and maps it to an eviction
+// priority. When a buffer pool is full, BufferMgr evicts a range of contiguous
+// segments with the lowest maximum priority.
+class EvictionPolicy {
+ public:
+  virtual ~EvictionPolicy() = default;
+
+  // Called when a chunk gets a new segment (a buffer pool miss).
+  virtual void onInsert(BufferSeg& seg, unsigned int epoch) const = 0;
+  // Called on each following access to the chunk (a buffer pool hit).
+  virtual void onAccess(BufferSeg& seg, unsigned int epoch) const = 0;
+  // Segments with lower priority are evicted first. Values fit into 33 bits.
+  virtual uint64_t getPriority(const BufferSeg& seg) const = 0;
+
+  // Supported names are "lru" and "lru2". Throws std::runtime_error for unknown
+  // names.
+  static std::unique_ptr<EvictionPolicy> create(const std::string& name);
+};
+
+// Evicts least recently used chunks first.
+class LruEvictionPolicy : public EvictionPolicy {
+ public:
+  void onInsert(BufferSeg& seg, unsigned int epoch) const override;
+  void onAccess(BufferSeg& seg, unsigned int epoch) const override;
+  uint64_t getPriority(const BufferSeg& seg) const override;
+};
+
+// LRU-2 policy. Chunks accessed only once are evicted before chunks accessed
+// several times. The latter are ordered by the time of the penultimate access.
+// Chunks fetched by a single large scan therefore cannot flush chunks which are
+// repeatedly used by other queries.
+class Lru2EvictionPolicy : public EvictionPolicy {
+ public:
+  void onInsert(BufferSeg& seg, unsigned int epoch) const override;
+  void onAccess(BufferSeg& seg, unsigned int epoch) const override;
+  uint64_t getPriority(const BufferSeg& seg) const override;
+};
+
+}  // namespace Buffer_Namespace
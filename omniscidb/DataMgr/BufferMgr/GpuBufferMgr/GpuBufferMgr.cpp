@@ -55,7 +55,7 @@ GpuBufferMgr::~GpuBufferMgr() {
   }
 }
 
-void GpuBufferMgr::addSlab(const size_t slab_size) {
+void GpuBufferMgr::addSlab(const size_t slab_size, const int numa_node) {
   slabs_.resize(slabs_.size() + 1);
   try {
     slabs_.back() = gpu_mgr_->allocateDeviceMem(slab_size, device_id_);
@@ -39,7 +39,7 @@ class GpuBufferMgr : public BufferMgr {
   ~GpuBufferMgr() override;
 
  private:
-  void addSlab(const size_t slab_size) override;
+  void addSlab(const size_t slab_size, const int numa_node) override;
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator seg_it,
                       const size_t page_size,
@@ -185,6 +185,12 @@ class ChunkMetadata {
   const hdk::ir::Type* type() const { return type_; }
   size_t numBytes() const { return num_bytes_; }
   size_t numElements() const { return num_elements_; }
+  // Size of the chunk in the bit-packed layout or 0 if the chunk is not packed.
+  size_t packedNumBytes() const { return packed_num_bytes_; }
+  bool isPacked() const { return packed_num_bytes_ != 0; }
+  void setPackedNumBytes(size_t packed_num_bytes) {
+    packed_num_bytes_ = packed_num_bytes;
+  }
   const ChunkStats& chunkStats() const {
     maybeMaterializeStats();
     return chunk_stats_;
@@ -195,6 +201,9 @@ class ChunkMetadata {
     std::string res = "type: " + type_->toString() +
                       " numBytes: " + to_string(num_bytes_) + " numElements " +
                       to_string(num_elements_);
+    if (packed_num_bytes_) {
+      res += " packedNumBytes: " + to_string(packed_num_bytes_);
+    }
     auto elem_type =
         type_->isArray() ? type_->as<hdk::ir::ArrayBaseType>()->elemType() : type_;
     if (stats_materialize_fn_) {
@@ -281,6 +290,7 @@ class ChunkMetadata {
   const hdk::ir::Type* type_;
   size_t num_bytes_;
   size_t num_elements_;
+  size_t packed_num_bytes_ = 0;
   mutable ChunkStats chunk_stats_;
   mutable StatsMaterializeFn stats_materialize_fn_;
 };
@@ -25,6 +25,7 @@
 #include "BufferMgr/GpuBufferMgr/GpuBufferMgr.h"
 #include "CudaMgr/CudaMgr.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
+#include "Shared/StringTransform.h"
 
 #ifdef __APPLE__
 #include <sys/sysctl.h>
@@ -226,8 +227,13 @@ void DataMgr::populateMgrs(const Config& config,
   // no need for locking, as this is only called in the constructor
   bufferMgrs_.resize(2);
   levelSizes_.resize(2);
-  bufferMgrs_[MemoryLevel::DISK_LEVEL].push_back(
-      new PersistentStorageMgr(userSpecifiedNumReaderThreads));
+  auto ps_mgr = new PersistentStorageMgr(userSpecifiedNumReaderThreads);
+  // Data providers own retired chunks, so only cached copies are deleted.
+  ps_mgr->setRetiredChunksHandler([this](const ChunkKey& key_prefix) {
+    deleteChunksWithPrefix(key_prefix, MemoryLevel::CPU_LEVEL);
+    deleteChunksWithPrefix(key_prefix, MemoryLevel::GPU_LEVEL);
+  });
+  bufferMgrs_[MemoryLevel::DISK_LEVEL].push_back(ps_mgr);
 
   levelSizes_[DISK_LEVEL] = 1;
   size_t page_size{512};
@@ -339,6 +345,46 @@ void DataMgr::populateMgrs(const Config& config,
                          page_size,
                          cpu_tier_sizes);
   }
+
+  auto cpu_buffer_mgr = dynamic_cast<Buffer_Namespace::CpuBufferMgr*>(
+      bufferMgrs_[MemoryLevel::CPU_LEVEL][0]);
+  CHECK(cpu_buffer_mgr);
+  cpu_buffer_mgr->setEvictionPolicy(
+      Buffer_Namespace::EvictionPolicy::create(config.mem.cpu.eviction_policy));
+  cpu_buffer_mgr->setPriorityTables(parsePriorityTables(config.mem.cpu.priority_tables));
+  cpu_buffer_mgr->setSlabMemoryOptions(config.mem.cpu.enable_huge_pages,
+                                       config.mem.cpu.enable_prefault);
+}
+
+std::set<std::pair<int, int>> DataMgr::parsePriorityTables(const std::string& tables) {
+  std::set<std::pair<int, int>> res;
+  for (auto& table : split(tables, ",")) {
+    auto table_str = strip(table);
+    if (table_str.empty()) {
+      continue;
+    }
+    auto ids = split(table_str, ":");
+    // std::stoi ignores trailing characters, so check the whole id is parsed.
+    auto parse_id = [](const std::string& id_str) {
+      auto id = strip(id_str);
+      size_t parsed = 0;
+      auto res = std::stoi(id, &parsed);
+      if (parsed != id.size()) {
+        throw std::invalid_argument(id);
+      }
+      return res;
+    };
+    try {
+      if (ids.size() != 2) {
+        throw std::invalid_argument(table_str);
+      }
+      res.emplace(parse_id(ids[0]), parse_id(ids[1]));
+    } catch (const std::logic_error&) {
+      throw std::runtime_error("Invalid priority table '" + table_str +
+                               "', expected <db_id>:<table_id>.");
+    }
+  }
+  return res;
 }
 
 std::vector<Buffer_Namespace::MemoryInfo> DataMgr::getMemoryInfo(
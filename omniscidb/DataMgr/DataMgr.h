@@ -218,6 +218,10 @@ class DataMgr {
   SystemMemoryUsage getSystemMemoryUsage() const;
   static size_t getTotalSystemMemory();
 
+  // Parses a comma-separated list of <db_id>:<table_id> pairs. Throws
+  // std::runtime_error for malformed entries.
+  static std::set<std::pair<int, int>> parsePriorityTables(const std::string& tables);
+
   PersistentStorageMgr* getPersistentStorageMgr() const;
 
   const DictDescriptor* getDictMetadata(int dict_id, bool load_dict = true) const;
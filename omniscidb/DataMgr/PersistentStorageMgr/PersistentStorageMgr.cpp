@@ -150,6 +150,17 @@ void PersistentStorageMgr::registerDataProvider(
     std::shared_ptr<AbstractBufferMgr> provider) {
   CHECK_EQ(mgr_by_schema_id_.count(schema_id), (size_t)0);
   mgr_by_schema_id_[schema_id] = provider;
+  auto data_provider = std::dynamic_pointer_cast<AbstractDataProvider>(provider);
+  if (data_provider && retired_chunks_handler_) {
+    data_provider->addRetiredChunksHandler(retired_chunks_handler_);
+  }
+}
+
+void PersistentStorageMgr::setRetiredChunksHandler(
+    AbstractDataProvider::RetiredChunksHandler handler) {
+  retired_chunks_handler_ =
+      std::make_shared<const AbstractDataProvider::RetiredChunksHandler>(
+          std::move(handler));
 }
 
 bool PersistentStorageMgr::hasDataProvider(int schema_id) const {
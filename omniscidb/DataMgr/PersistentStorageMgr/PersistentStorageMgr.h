@@ -17,6 +17,7 @@
 #pragma once
 
 #include "DataMgr/AbstractBufferMgr.h"
+#include "DataMgr/AbstractDataProvider.h"
 
 using namespace Data_Namespace;
 
@@ -58,6 +59,9 @@ class PersistentStorageMgr : public AbstractBufferMgr {
 
   void registerDataProvider(int schema_id, std::shared_ptr<AbstractBufferMgr>);
 
+  // The handler is passed to all data providers registered after this call.
+  void setRetiredChunksHandler(AbstractDataProvider::RetiredChunksHandler handler);
+
   bool hasDataProvider(int schema_id) const;
   std::shared_ptr<AbstractBufferMgr> getDataProvider(int schema_id) const;
 
@@ -70,4 +74,6 @@ class PersistentStorageMgr : public AbstractBufferMgr {
   int recoverDataWrapperIfCachedAndGetHighestFragId(const ChunkKey& table_key);
 
   std::unordered_map<int, std::shared_ptr<AbstractBufferMgr>> mgr_by_schema_id_;
+  std::shared_ptr<const AbstractDataProvider::RetiredChunksHandler>
+      retired_chunks_handler_;
 };
@@ -785,8 +785,7 @@ class AggExpr : public Expr {
   AggExpr(const Type* type, AggType a, ExprPtr arg, bool d, ExprPtr arg1)
       : Expr(type, true), agg_type_(a), arg_(arg), is_distinct_(d), arg1_(arg1) {
     if (arg1) {
-      if (agg_type_ == AggType::kApproxCountDistinct ||
-          agg_type_ == AggType::kApproxQuantile) {
+      if (isHll(agg_type_) || isQuantile(agg_type_)) {
         CHECK(arg1_->is<Constant>());
       } else {
         CHECK(agg_type_ == AggType::kCorr);
@@ -809,8 +808,8 @@ class AggExpr : public Expr {
   AggType agg_type_;  // aggregate type: kAvg, kMin, kMax, kSum, kCount
   ExprPtr arg_;       // argument to aggregate
   bool is_distinct_;  // true only if it is for COUNT(DISTINCT x)
-  // APPROX_COUNT_DISTINCT error_rate, APPROX_QUANTILE quantile,
-  // CORR second arg
+  // APPROX_COUNT_DISTINCT error_rate, APPROX_QUANTILE, PERCENTILE_CONT and
+  // PERCENTILE_DISC quantile, CORR second arg
   ExprPtr arg1_;
 };
 
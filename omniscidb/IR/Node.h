@@ -274,7 +274,11 @@ class Scan : public Node {
         boost::hash_combine(*hash_, info->name);
       }
     }
-    return *hash_;
+    // Table data might be modified after the node is created, so the data
+    // version is not cached.
+    auto res = *hash_;
+    boost::hash_combine(res, table_info_->data_version);
+    return res;
   }
 
   std::shared_ptr<Node> deepCopy() const override {
@@ -76,6 +76,11 @@ enum class AggType {
   kCount,
   kApproxCountDistinct,
   kApproxQuantile,
+  kPercentileCont,
+  kPercentileDisc,
+  kHllSketch,
+  kHllMerge,
+  kHllMergeCount,
   kSample,
   kSingleValue,
   // Compound aggregates
@@ -83,6 +88,22 @@ enum class AggType {
   kCorr,
 };
 
+inline bool isExactQuantile(AggType agg) {
+  return agg == AggType::kPercentileCont || agg == AggType::kPercentileDisc;
+}
+inline bool isQuantile(AggType agg) {
+  return agg == AggType::kApproxQuantile || isExactQuantile(agg);
+}
+// Aggregates returning HyperLogLog registers instead of the estimated count.
+inline bool isHllSketch(AggType agg) {
+  return agg == AggType::kHllSketch || agg == AggType::kHllMerge;
+}
+// Aggregates backed by HyperLogLog registers.
+inline bool isHll(AggType agg) {
+  return agg == AggType::kApproxCountDistinct || agg == AggType::kHllMergeCount ||
+         isHllSketch(agg);
+}
+
 enum class WindowFunctionKind {
   RowNumber,
   Rank,
@@ -184,6 +205,16 @@ inline std::string toString(hdk::ir::AggType agg) {
       return "APPROX_COUNT_DISTINCT";
     case hdk::ir::AggType::kApproxQuantile:
       return "APPROX_PERCENTILE";
+    case hdk::ir::AggType::kPercentileCont:
+      return "PERCENTILE_CONT";
+    case hdk::ir::AggType::kPercentileDisc:
+      return "PERCENTILE_DISC";
+    case hdk::ir::AggType::kHllSketch:
+      return "HLL_SKETCH";
+    case hdk::ir::AggType::kHllMerge:
+      return "HLL_MERGE";
+    case hdk::ir::AggType::kHllMergeCount:
+      return "HLL_MERGE_COUNT";
     case hdk::ir::AggType::kSample:
       return "SAMPLE";
     case hdk::ir::AggType::kSingleValue:
@@ -9,6 +9,7 @@
 #include "Analyzer/Analyzer.h"
 #include "IR/ExprCollector.h"
 #include "IR/ExprRewriter.h"
+#include "ResultSet/HyperLogLog.h"
 #include "Shared/SqlTypesLayout.h"
 
 #include <boost/algorithm/string.hpp>
@@ -541,17 +542,25 @@ BuilderExpr BuilderExpr::count(bool is_distinct) const {
   return {builder_, agg, name, true};
 }
 
-BuilderExpr BuilderExpr::approxCountDist() const {
+BuilderExpr BuilderExpr::approxCountDist(int err_percent) const {
   if (!expr_->is<hdk::ir::ColumnRef>()) {
     throw InvalidQueryError()
         << "ApproxCountDist method is valid for column references only. Used for: "
         << expr_->toString();
   }
+  if (err_percent < 0 || err_percent > 100) {
+    throw InvalidQueryError()
+        << "ApproxCountDist expects error rate between 1 and 100 but got " << err_percent;
+  }
+  ExprPtr err_rate;
+  if (err_percent) {
+    err_rate = builder_->cst(err_percent, builder_->ctx_.int32(false)).expr();
+  }
   auto count_type = builder_->config_->exec.group_by.bigint_count
                         ? builder_->ctx_.int64(false)
                         : builder_->ctx_.int32(false);
   auto agg =
-      makeExpr<AggExpr>(count_type, AggType::kApproxCountDistinct, expr_, true, nullptr);
+      makeExpr<AggExpr>(count_type, AggType::kApproxCountDistinct, expr_, true, err_rate);
   auto name = name_.empty() ? "approx_count_dist" : name_ + "_approx_count_dist";
   return {builder_, agg, name, true};
 }
@@ -574,6 +583,88 @@ BuilderExpr BuilderExpr::approxQuantile(double val) const {
   return {builder_, agg, name, true};
 }
 
+BuilderExpr BuilderExpr::percentile(double val, bool interpolate) const {
+  auto agg_kind = interpolate ? AggType::kPercentileCont : AggType::kPercentileDisc;
+  if (!expr_->type()->isNumber()) {
+    throw InvalidQueryError() << "Unsupported type for " << agg_kind
+                              << " aggregate: " << expr_->type()->toString();
+  }
+  if (val < 0.0 || val > 1.0) {
+    throw InvalidQueryError() << agg_kind
+                              << " expects argument between 0.0 and 1.0 but got " << val;
+  }
+  Datum d;
+  d.doubleval = val;
+  auto cst = makeExpr<Constant>(builder_->ctx_.fp64(), false, d);
+  auto agg = makeExpr<AggExpr>(builder_->ctx_.fp64(), agg_kind, expr_, false, cst);
+  std::string suffix = interpolate ? "percentile_cont" : "percentile_disc";
+  auto name = name_.empty() ? suffix : name_ + "_" + suffix;
+  return {builder_, agg, name, true};
+}
+
+BuilderExpr BuilderExpr::percentileCont(double val) const {
+  return percentile(val, true);
+}
+
+BuilderExpr BuilderExpr::percentileDisc(double val) const {
+  return percentile(val, false);
+}
+
+BuilderExpr BuilderExpr::median() const {
+  auto name = name_.empty() ? "median" : name_ + "_median";
+  return {builder_, percentileCont(0.5).expr(), name, true};
+}
+
+BuilderExpr BuilderExpr::hll(AggType agg_kind, int precision) const {
+  if (precision &&
+      (precision < kMinHllPrecisionBits || precision > kMaxHllPrecisionBits)) {
+    throw InvalidQueryError() << agg_kind << " expects precision between "
+                              << kMinHllPrecisionBits << " and " << kMaxHllPrecisionBits
+                              << " but got " << precision;
+  }
+  ExprPtr precision_cst;
+  if (precision) {
+    precision_cst = builder_->cst(precision, builder_->ctx_.int32(false)).expr();
+  }
+  auto res_type = agg_kind == AggType::kHllMergeCount
+                      ? builder_->ctx_.int64(false)
+                      : builder_->ctx_.arrayVarLen(builder_->ctx_.int8(false), 4, false);
+  auto agg = makeExpr<AggExpr>(res_type, agg_kind, expr_, false, precision_cst);
+  std::string suffix = agg_kind == AggType::kHllSketch
+                           ? "hll_sketch"
+                           : (agg_kind == AggType::kHllMerge ? "hll_merge"
+                                                             : "hll_merge_count");
+  auto name = name_.empty() ? suffix : name_ + "_" + suffix;
+  return {builder_, agg, name, true};
+}
+
+BuilderExpr BuilderExpr::hllSketch(int precision) const {
+  if (expr_->type()->isBuffer()) {
+    throw InvalidQueryError() << "Unsupported type for HLL_SKETCH aggregate: "
+                              << expr_->type()->toString();
+  }
+  return hll(AggType::kHllSketch, precision);
+}
+
+BuilderExpr BuilderExpr::hllMerge(int precision) const {
+  if (!expr_->type()->isArray() ||
+      !expr_->type()->as<ArrayBaseType>()->elemType()->isInt8()) {
+    throw InvalidQueryError() << "HLL_MERGE aggregate expects TINYINT array but got: "
+                              << expr_->type()->toString();
+  }
+  return hll(AggType::kHllMerge, precision);
+}
+
+BuilderExpr BuilderExpr::hllMergeCount(int precision) const {
+  if (!expr_->type()->isArray() ||
+      !expr_->type()->as<ArrayBaseType>()->elemType()->isInt8()) {
+    throw InvalidQueryError()
+        << "HLL_MERGE_COUNT aggregate expects TINYINT array but got: "
+        << expr_->type()->toString();
+  }
+  return hll(AggType::kHllMergeCount, precision);
+}
+
 BuilderExpr BuilderExpr::sample() const {
   auto agg = makeExpr<AggExpr>(expr_->type(), AggType::kSample, expr_, false, nullptr);
   auto name = name_.empty() ? "sample" : name_ + "_sample";
@@ -675,6 +766,17 @@ BuilderExpr BuilderExpr::agg(const std::string& agg_str, const BuilderExpr& arg)
       {"approx count distinct", AggType::kApproxCountDistinct},
       {"approx_quantile", AggType::kApproxQuantile},
       {"approx quantile", AggType::kApproxQuantile},
+      {"percentile_cont", AggType::kPercentileCont},
+      {"percentile cont", AggType::kPercentileCont},
+      {"percentile_disc", AggType::kPercentileDisc},
+      {"percentile disc", AggType::kPercentileDisc},
+      {"median", AggType::kPercentileCont},
+      {"hll_sketch", AggType::kHllSketch},
+      {"hll sketch", AggType::kHllSketch},
+      {"hll_merge", AggType::kHllMerge},
+      {"hll merge", AggType::kHllMerge},
+      {"hll_merge_count", AggType::kHllMergeCount},
+      {"hll merge count", AggType::kHllMergeCount},
       {"sample", AggType::kSample},
       {"single_value", AggType::kSingleValue},
       {"single value", AggType::kSingleValue},
@@ -693,6 +795,15 @@ BuilderExpr BuilderExpr::agg(const std::string& agg_str, const BuilderExpr& arg)
   if (kind == AggType::kApproxQuantile && !arg.expr()) {
     throw InvalidQueryError("Missing argument for approximate quantile aggregate.");
   }
+  if (agg_str_lower == "median") {
+    if (arg.expr()) {
+      throw InvalidQueryError("Unexpected argument for median aggregate.");
+    }
+    return median();
+  }
+  if (isExactQuantile(kind) && !arg.expr()) {
+    throw InvalidQueryError() << "Missing argument for " << kind << " aggregate.";
+  }
   if (kind == AggType::kCorr && !arg.expr()) {
     throw InvalidQueryError("Missing argument for corr aggregate.");
   }
@@ -724,17 +835,30 @@ BuilderExpr BuilderExpr::agg(AggType agg_kind,
     throw InvalidQueryError() << "Distinct property cannot be set to true for "
                               << agg_kind << " aggregate.";
   }
-  if (arg.expr() && agg_kind != AggType::kApproxQuantile && agg_kind != AggType::kCorr) {
-    throw InvalidQueryError() << "Aggregate argument is supported for approximate "
-                                 "quantile and corr only but provided for "
+  if (arg.expr() && !isQuantile(agg_kind) && !isHll(agg_kind) &&
+      agg_kind != AggType::kCorr) {
+    throw InvalidQueryError() << "Aggregate argument is supported for quantile, "
+                                 "HyperLogLog and corr only but provided for "
                               << agg_kind;
   }
-  if (agg_kind == AggType::kApproxQuantile) {
+  if (isQuantile(agg_kind)) {
     if (!arg.expr()->is<Constant>() || !arg.type()->isFloatingPoint()) {
-      throw InvalidQueryError() << "Expected fp constant argumnt for approximate "
-                                   "quantile. Provided: "
-                                << arg.expr()->toString();
+      throw InvalidQueryError()
+          << "Expected fp constant argument for " << agg_kind
+          << " aggregate. Provided: " << arg.expr()->toString();
+    }
+  }
+  int hll_arg = 0;
+  if (isHll(agg_kind) && arg.expr()) {
+    auto cst = arg.expr()->as<Constant>();
+    if (!cst || !arg.type()->isNumber() ||
+        (arg.type()->isFloatingPoint() && cst->fpVal() != std::floor(cst->fpVal()))) {
+      throw InvalidQueryError()
+          << "Expected integer constant argument for " << agg_kind
+          << " aggregate. Provided: " << arg.expr()->toString();
     }
+    hll_arg = arg.type()->isFloatingPoint() ? static_cast<int>(cst->fpVal())
+                                            : static_cast<int>(cst->intVal());
   }
 
   switch (agg_kind) {
@@ -749,9 +873,19 @@ BuilderExpr BuilderExpr::agg(AggType agg_kind,
     case AggType::kCount:
       return count(is_distinct);
     case AggType::kApproxCountDistinct:
-      return approxCountDist();
+      return approxCountDist(hll_arg);
     case AggType::kApproxQuantile:
       return approxQuantile(arg.expr()->as<Constant>()->fpVal());
+    case AggType::kPercentileCont:
+      return percentileCont(arg.expr()->as<Constant>()->fpVal());
+    case AggType::kPercentileDisc:
+      return percentileDisc(arg.expr()->as<Constant>()->fpVal());
+    case AggType::kHllSketch:
+      return hllSketch(hll_arg);
+    case AggType::kHllMerge:
+      return hllMerge(hll_arg);
+    case AggType::kHllMergeCount:
+      return hllMergeCount(hll_arg);
     case AggType::kSample:
       return sample();
     case AggType::kSingleValue:
@@ -72,8 +72,15 @@ class BuilderExpr {
   BuilderExpr max() const;
   BuilderExpr sum() const;
   BuilderExpr count(bool is_distinct = false) const;
-  BuilderExpr approxCountDist() const;
+  // Zero error rate or precision means the default precision from the config.
+  BuilderExpr approxCountDist(int err_percent = 0) const;
   BuilderExpr approxQuantile(double val) const;
+  BuilderExpr percentileCont(double val) const;
+  BuilderExpr percentileDisc(double val) const;
+  BuilderExpr median() const;
+  BuilderExpr hllSketch(int precision = 0) const;
+  BuilderExpr hllMerge(int precision = 0) const;
+  BuilderExpr hllMergeCount(int precision = 0) const;
   BuilderExpr sample() const;
   BuilderExpr singleValue() const;
   BuilderExpr stdDev() const;
@@ -242,6 +249,9 @@ class BuilderExpr {
   friend class QueryBuilder;
   friend class BuilderNode;
 
+  BuilderExpr percentile(double val, bool interpolate) const;
+  BuilderExpr hll(AggType agg_kind, int precision) const;
+
   const QueryBuilder* builder_;
   ExprPtr expr_;
   std::string name_;
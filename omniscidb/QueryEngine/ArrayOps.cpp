@@ -24,6 +24,7 @@
 
 #include <cstdint>
 
+#include "ResultSet/HyperLogLog.h"
 #include "Shared/TypePunning.h"
 #include "Shared/funcannotations.h"
 #include "ThirdParty/robin_hood.h"
@@ -336,6 +337,32 @@ COUNT_DISTINCT_ARRAY(double)
 
 #undef COUNT_DISTINCT_ARRAY
 
+extern "C" RUNTIME_EXPORT int32_t agg_hll_merge(int64_t* agg,
+                                                int8_t* chunk_iter_,
+                                                const uint64_t row_pos,
+                                                const uint32_t b) {
+  ChunkIter* chunk_iter = reinterpret_cast<ChunkIter*>(chunk_iter_);
+  ArrayDatum ad;
+  bool is_end;
+  ChunkIter_get_nth(chunk_iter, row_pos, &ad, &is_end);
+  if (ad.is_null || !ad.length) {
+    return 0;
+  }
+  uint32_t sketch_bits = 0;
+  while ((size_t(1) << sketch_bits) < ad.length) {
+    ++sketch_bits;
+  }
+  // Registers can be folded to a lower precision only.
+  if ((size_t(1) << sketch_bits) != ad.length || sketch_bits < b) {
+    return Executor::ERR_HLL_SKETCH_PRECISION;
+  }
+  hll_merge_sketch(reinterpret_cast<uint8_t*>(*agg),
+                   b,
+                   reinterpret_cast<const int8_t*>(ad.pointer),
+                   sketch_bits);
+  return 0;
+}
+
 #include <string>
 
 extern "C" RUNTIME_EXPORT uint64_t string_decompress(const int32_t string_id,
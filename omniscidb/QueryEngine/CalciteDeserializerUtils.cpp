@@ -39,8 +39,15 @@ const hdk::ir::Type* get_agg_type(hdk::ir::AggType agg_kind,
     case hdk::ir::AggType::kAvg:
       return ctx.fp64();
     case hdk::ir::AggType::kApproxCountDistinct:
+    case hdk::ir::AggType::kHllMergeCount:
       return ctx.int64();
+    case hdk::ir::AggType::kHllSketch:
+    case hdk::ir::AggType::kHllMerge:
+      // HyperLogLog registers.
+      return ctx.arrayVarLen(ctx.int8(false), 4, false);
     case hdk::ir::AggType::kApproxQuantile:
+    case hdk::ir::AggType::kPercentileCont:
+    case hdk::ir::AggType::kPercentileDisc:
       return ctx.fp64();
     case hdk::ir::AggType::kSingleValue:
       if (arg_expr->type()->isVarLen()) {
@@ -112,6 +112,21 @@ inline hdk::ir::AggType to_agg_kind(const std::string& agg_name) {
       agg_name == "APPROX_QUANTILE") {
     return hdk::ir::AggType::kApproxQuantile;
   }
+  if (agg_name == "MEDIAN" || agg_name == "PERCENTILE_CONT") {
+    return hdk::ir::AggType::kPercentileCont;
+  }
+  if (agg_name == "PERCENTILE_DISC") {
+    return hdk::ir::AggType::kPercentileDisc;
+  }
+  if (agg_name == "HLL_SKETCH") {
+    return hdk::ir::AggType::kHllSketch;
+  }
+  if (agg_name == "HLL_MERGE") {
+    return hdk::ir::AggType::kHllMerge;
+  }
+  if (agg_name == "HLL_MERGE_COUNT") {
+    return hdk::ir::AggType::kHllMergeCount;
+  }
   if (agg_name == std::string("ANY_VALUE") || agg_name == std::string("SAMPLE") ||
       agg_name == std::string("LAST_SAMPLE")) {
     return hdk::ir::AggType::kSample;
@@ -59,6 +59,11 @@ class RequestPartitionedAggregation : public std::runtime_error {
   size_t estimated_buffer_entries_;
 };
 
+class RequestTwoPhaseCountDistinct : public std::runtime_error {
+ public:
+  RequestTwoPhaseCountDistinct() : std::runtime_error("RequestTwoPhaseCountDistinct") {}
+};
+
 RelAlgExecutionUnit create_ndv_execution_unit(const RelAlgExecutionUnit& ra_exe_unit,
                                               SchemaProvider* schema_provider,
                                               const Config& config,
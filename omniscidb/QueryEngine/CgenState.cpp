@@ -17,6 +17,7 @@
 #include "QueryEngine/CgenState.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExecutionEngineWrapper.h"
 #include "QueryEngine/OutputBufferInitialization.h"
 
 #include <llvm/IR/InstIterator.h>
@@ -39,6 +40,7 @@ CgenState::CgenState(const size_t num_query_infos,
     , context_(context)
     , ir_builder_(context_)
     , ext_module_context_(ext_module_context)
+    , use_runtime_dylib_(false)
     , contains_left_deep_outer_join_(contains_left_deep_outer_join)
     , outer_join_match_found_per_level_(std::max(num_query_infos, size_t(1)) - 1)
     , needs_error_check_(false)
@@ -52,6 +54,7 @@ CgenState::CgenState(const Config& config, llvm::LLVMContext& context)
     , context_(context)
     , ir_builder_(context_)
     , ext_module_context_(nullptr)
+    , use_runtime_dylib_(false)
     , contains_left_deep_outer_join_(false)
     , needs_error_check_(false)
     , automatic_ir_metadata_(config.debug.enable_automatic_ir_metadata)
@@ -183,6 +186,11 @@ void CgenState::maybeCloneFunctionRecursive(llvm::Function* fn, bool is_l0) {
     return;
   }
 
+  if (use_runtime_dylib_ && !CodeGenerator::inlineRuntimeFunction(func_impl) &&
+      ORCJITSession::instance().hasRuntimeFunction(fn->getName())) {
+    return;
+  }
+
   auto DestI = fn->arg_begin();
   for (auto arg_it = func_impl->arg_begin(); arg_it != func_impl->arg_end(); ++arg_it) {
     DestI->setName(arg_it->getName());
@@ -371,6 +371,9 @@ struct CgenState {
   std::unordered_map<int, std::vector<llvm::Value*>> fetch_cache_;
 
   ExtensionModuleContext* ext_module_context_;
+  // CPU modules call runtime functions in the runtime JITDylib instead of cloning
+  // them, see ORCJITSession.
+  bool use_runtime_dylib_;
 
   struct FunctionOperValue {
     const hdk::ir::FunctionOper* foper;
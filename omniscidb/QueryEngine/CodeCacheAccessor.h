@@ -104,11 +104,36 @@ class CodeCacheAccessor {
     compilation_cv_.notify_all();
   }
 
+  // Replace the cached value for key only if it is still old_value, i.e. the entry
+  // was not evicted or re-created meanwhile.
+  bool replace(const CodeCacheKey& key,
+               const CodeCacheVal<CompilationContext>& old_value,
+               const CodeCacheVal<CompilationContext>& new_value) {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    auto it = code_cache_.find(key);
+    if (it == code_cache_.cend() || it->second != old_value) {
+      return false;
+    }
+    overwrite_count_++;
+    code_cache_.put(key, new_value);
+    return true;
+  }
+
   void clear() {
     std::lock_guard<std::mutex> lock(code_cache_mutex_);
     code_cache_.clear();
   }
 
+  int64_t get_found_count() {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    return found_count_;
+  }
+
+  int64_t get_overwrite_count() {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    return overwrite_count_;
+  }
+
   void evictFractionEntries(const float fraction) {
     std::lock_guard<std::mutex> lock(code_cache_mutex_);
     evict_count_++;
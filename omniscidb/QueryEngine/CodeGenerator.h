@@ -73,6 +73,13 @@ class CodeGenerator {
   // Generates the index of the current row in the context of query execution.
   llvm::Value* posArg(const hdk::ir::Expr*) const;
 
+  // Generates a load of an outer table column at an arbitrary row of the
+  // current fragment. The column should be already fetched by the generated
+  // code. Returns nullptr if the column cannot be loaded this way.
+  llvm::Value* codegenLookaheadColVar(const hdk::ir::ColumnVar* col_var,
+                                      llvm::Value* pos_arg,
+                                      const CompilationOptions& co);
+
   llvm::Value* toBool(llvm::Value*);
 
   llvm::Value* castArrayPointer(llvm::Value* ptr, const hdk::ir::Type* elem_type);
@@ -84,6 +91,10 @@ class CodeGenerator {
 
   static bool alwaysCloneRuntimeFunction(const llvm::Function* func);
 
+  // Runtime functions which CPU kernels clone instead of calling them in the runtime
+  // JITDylib.
+  static bool inlineRuntimeFunction(const llvm::Function* func);
+
   static void link_udf_module(const std::unique_ptr<llvm::Module>& udf_module,
                               llvm::Module& module,
                               CgenState* cgen_state,
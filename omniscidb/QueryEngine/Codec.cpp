@@ -83,6 +83,21 @@ llvm::Instruction* FixedWidthReal::codegenDecode(llvm::Value* byte_stream,
   return llvm::CallInst::Create(f, args);
 }
 
+FixedWidthPackedInt::FixedWidthPackedInt(const int64_t null_val) : null_val_(null_val) {}
+
+llvm::Instruction* FixedWidthPackedInt::codegenDecode(llvm::Value* byte_stream,
+                                                      llvm::Value* pos,
+                                                      llvm::Module* llvm_module) const {
+  auto& context = llvm_module->getContext();
+  auto f = llvm_module->getFunction("fixed_width_packed_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
 FixedWidthSmallDate::FixedWidthSmallDate(const size_t byte_width)
     : byte_width_{byte_width}, null_val_{byte_width == 4 ? NULL_INT : NULL_SMALLINT} {}
 
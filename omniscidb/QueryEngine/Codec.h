@@ -76,6 +76,18 @@ class FixedWidthReal : public Decoder {
   const bool is_double_;
 };
 
+// Decoder for frame-of-reference bit-packed chunks (see Shared/PackedChunk.h).
+class FixedWidthPackedInt : public Decoder {
+ public:
+  FixedWidthPackedInt(const int64_t null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* llvm_module) const override;
+
+ private:
+  const int64_t null_val_;
+};
+
 class FixedWidthSmallDate : public Decoder {
  public:
   FixedWidthSmallDate(const size_t byte_width);
@@ -172,7 +172,8 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     std::list<ChunkIter>& chunk_iter_holder,
     const Data_Namespace::MemoryLevel memory_level,
     const int device_id,
-    DeviceAllocator* allocator) const {
+    DeviceAllocator* allocator,
+    const bool packed) const {
   int db_id = col_info->db_id;
   int table_id = col_info->table_id;
   int col_id = col_info->column_id;
@@ -192,6 +193,14 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
   {
     ChunkKey chunk_key{
         col_info->db_id, fragment.physicalTableId, col_id, fragment.fragmentId};
+    size_t num_bytes = chunk_meta_it->second->numBytes();
+    if (packed) {
+      // Packed chunks are stored under a separate key and decoded by generated code.
+      CHECK(!is_varlen);
+      CHECK(chunk_meta_it->second->isPacked());
+      chunk_key.push_back(3);
+      num_bytes = chunk_meta_it->second->packedNumBytes();
+    }
     std::unique_ptr<std::lock_guard<std::mutex>> varlen_chunk_lock;
     if (is_varlen) {
       varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_fetch_mutex_));
@@ -201,7 +210,7 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
         chunk_key,
         memory_level,
         memory_level == Data_Namespace::CPU_LEVEL ? 0 : device_id,
-        chunk_meta_it->second->numBytes(),
+        num_bytes,
         chunk_meta_it->second->numElements());
     std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
     chunk_holder.push_back(chunk);
@@ -27,8 +27,12 @@ namespace {
 
 // Return the right decoder for a given column expression. Doesn't handle
 // variable length data. The decoder encapsulates the code generation logic.
-std::shared_ptr<Decoder> get_col_decoder(const hdk::ir::ColumnVar* col_var) {
+std::shared_ptr<Decoder> get_col_decoder(const hdk::ir::ColumnVar* col_var,
+                                         const bool packed) {
   const auto& type = col_var->type();
+  if (packed) {
+    return std::make_shared<FixedWidthPackedInt>(inline_int_null_value(type));
+  }
   switch (type->id()) {
     case hdk::ir::Type::kBoolean:
     case hdk::ir::Type::kInteger:
@@ -155,6 +159,21 @@ std::vector<llvm::Value*> CodeGenerator::codegenColVar(const hdk::ir::ColumnVar*
   return {it_ok.first->second};
 }
 
+llvm::Value* CodeGenerator::codegenLookaheadColVar(const hdk::ir::ColumnVar* col_var,
+                                                   llvm::Value* pos_arg,
+                                                   const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto& col_type = col_var->type();
+  if (col_var->rteIdx() != 0 || col_var->isVirtual() || col_type->isVarLen() ||
+      col_type->isArray() || col_type->isFloatingPoint() ||
+      plan_state_->isLazyFetchColumn(col_var) ||
+      WindowProjectNodeContext::getActiveWindowFunctionContext(executor())) {
+    return nullptr;
+  }
+  auto col_byte_stream = colByteStream(col_var, true, co.hoist_literals);
+  return codegenFixedLengthColVar(col_var, col_byte_stream, pos_arg);
+}
+
 llvm::Value* CodeGenerator::codegenWindowPosition(
     WindowFunctionContext* window_func_context,
     llvm::Value* pos_arg) {
@@ -172,7 +191,7 @@ llvm::Value* CodeGenerator::codegenFixedLengthColVar(const hdk::ir::ColumnVar* c
                                                      llvm::Value* col_byte_stream,
                                                      llvm::Value* pos_arg) {
   AUTOMATIC_IR_METADATA(cgen_state_);
-  const auto decoder = get_col_decoder(col_var);
+  const auto decoder = get_col_decoder(col_var, plan_state_->isPackedColumn(col_var));
   auto dec_val = decoder->codegenDecode(col_byte_stream, pos_arg, cgen_state_->module_);
   cgen_state_->ir_builder_.Insert(dec_val);
   auto dec_type = dec_val->getType();
@@ -461,7 +480,10 @@ const hdk::ir::Expr* remove_cast_to_int(const hdk::ir::Expr* expr) {
 
 hdk::ir::ExprPtr CodeGenerator::hashJoinLhs(const hdk::ir::ColumnVar* rhs) const {
   for (const auto& tautological_eq : plan_state_->join_info_.equi_join_tautologies_) {
-    CHECK(tautological_eq->isEquivalence());
+    // Range join conditions don't make inner columns equal to outer ones.
+    if (!tautological_eq->isEquivalence()) {
+      continue;
+    }
     if (dynamic_cast<const hdk::ir::ExpressionTuple*>(tautological_eq->leftOperand())) {
       auto lhs_col = hashJoinLhsTuple(rhs, tautological_eq.get());
       if (lhs_col) {
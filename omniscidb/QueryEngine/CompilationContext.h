@@ -18,13 +18,27 @@
 
 #include "QueryEngine/ExecutionEngineWrapper.h"
 
+#include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
 
 class CompilationContext {
  public:
   virtual ~CompilationContext() {}
 };
 
+// Kernels compiled by the baseline tier keep their unoptimized bitcode to be
+// recompiled with full optimizations after they are reused often enough.
+struct TierUpInfo {
+  std::string bitcode;
+  std::string query_func;
+  std::string multifrag_query_func;
+  std::vector<std::string> live_funcs;
+  std::atomic<size_t> use_count{0};
+  std::atomic<bool> scheduled{false};
+};
+
 class CpuCompilationContext : public CompilationContext {
  public:
   CpuCompilationContext(std::unique_ptr<ExecutionEngineWrapper>&& execution_engine)
@@ -41,7 +55,15 @@ class CpuCompilationContext : public CompilationContext {
 
   void* func() const { return func_; }
 
+  void setTierUpInfo(std::unique_ptr<TierUpInfo> info) {
+    tier_up_info_ = std::move(info);
+  }
+
+  // Null for kernels compiled with full optimizations.
+  TierUpInfo* tierUpInfo() const { return tier_up_info_.get(); }
+
  private:
   void* func_{nullptr};
   std::unique_ptr<ExecutionEngineWrapper> execution_engine_;
+  std::unique_ptr<TierUpInfo> tier_up_info_;
 };
@@ -29,7 +29,9 @@
 #include "Shared/Config.h"
 #include "Shared/DeviceType.h"
 
-enum class ExecutorOptLevel { Default, ReductionJIT };
+// Baseline is used for the first compilation of CPU kernels when tiered compilation
+// is enabled.
+enum class ExecutorOptLevel { Default, ReductionJIT, Baseline };
 
 enum class ExecutorExplainType { Default, Optimized };
 
@@ -21,12 +21,14 @@
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/NvidiaKernel.h"
 
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/IntrinsicInst.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
@@ -101,60 +103,50 @@ std::shared_ptr<CpuCompilationContext> CPUBackend::generateNativeCPUCode(
   compiler::optimize_ir(func, llvm_module, live_funcs, /*is_gpu_smem_used=*/false, co);
 #endif  // WITH_JIT_DEBUG
 
-  auto init_err = llvm::InitializeNativeTarget();
-  CHECK(!init_err);
-
-  llvm::InitializeNativeTargetAsmPrinter();
-  llvm::InitializeNativeTargetAsmParser();
-
-  std::string err_str;
   std::unique_ptr<llvm::Module> owner(llvm_module);
+  auto execution_engine = std::make_unique<ExecutionEngineWrapper>(
+      ORCJITSession::instance(), co.opt_level == ExecutorOptLevel::Default);
+  execution_engine->addModule(std::move(owner));
+  return std::make_shared<CpuCompilationContext>(std::move(execution_engine));
+}
 
-  llvm::TargetOptions to;
-  to.EnableFastISel = true;
-
-  auto llvm_err_to_str = [](const llvm::Error& err) {
-    std::string msg;
-    llvm::raw_string_ostream os(msg);
-    os << err;
-    return msg;
-  };
-
-#if LLVM_VERSION_MAJOR > 12
-  auto self_epc = llvm::cantFail(llvm::orc::SelfExecutorProcessControl::Create());
-  auto execution_session =
-      std::make_unique<llvm::orc::ExecutionSession>(std::move(self_epc));
-#else
-  auto execution_session = std::make_unique<llvm::orc::ExecutionSession>();
-#endif
-
-  auto target_machine_builder_or_error = llvm::orc::JITTargetMachineBuilder::detectHost();
-  if (!target_machine_builder_or_error) {
-    LOG(FATAL) << "Failed to initialize JITTargetMachineBuilder: "
-               << llvm_err_to_str(target_machine_builder_or_error.takeError());
-  }
-  llvm::orc::JITTargetMachineBuilder target_machine_builder =
-      std::move(*target_machine_builder_or_error);
-  target_machine_builder.getOptions().EnableFastISel = true;
-
-  if (co.opt_level == ExecutorOptLevel::ReductionJIT) {
-    target_machine_builder.setCodeGenOptLevel(llvm::CodeGenOpt::None);
+std::shared_ptr<CpuCompilationContext> CPUBackend::generateOptimizedCPUCode(
+    const TierUpInfo& info) {
+  auto timer = DEBUG_TIMER(__func__);
+  llvm::orc::ThreadSafeContext context(std::make_unique<llvm::LLVMContext>());
+  auto buffer = llvm::MemoryBuffer::getMemBuffer(info.bitcode, "", false);
+  auto module_or_err =
+      llvm::parseBitcodeFile(buffer->getMemBufferRef(), *context.getContext());
+  if (!module_or_err) {
+    throw std::runtime_error("Cannot parse kernel bitcode: " +
+                             llvm::toString(module_or_err.takeError()));
   }
-
-  auto data_layout_or_err = target_machine_builder.getDefaultDataLayoutForTarget();
-  if (!data_layout_or_err) {
-    LOG(FATAL) << "Failed to initialize data layout: "
-               << llvm_err_to_str(data_layout_or_err.takeError());
+  auto module = std::move(*module_or_err);
+  auto query_func = module->getFunction(info.query_func);
+  auto multifrag_query_func = module->getFunction(info.multifrag_query_func);
+  CHECK(query_func);
+  CHECK(multifrag_query_func);
+  std::unordered_set<llvm::Function*> live_funcs;
+  for (auto& name : info.live_funcs) {
+    if (auto func = module->getFunction(name)) {
+      live_funcs.insert(func);
+    }
   }
-  std::unique_ptr<llvm::DataLayout> data_layout =
-      std::make_unique<llvm::DataLayout>(std::move(*data_layout_or_err));
+#ifndef WITH_JIT_DEBUG
+  compiler::optimize_ir(query_func,
+                        module.get(),
+                        live_funcs,
+                        /*is_gpu_smem_used=*/false,
+                        CompilationOptions::defaults(ExecutorDeviceType::CPU));
+#endif  // WITH_JIT_DEBUG
 
-  auto execution_engine =
-      std::make_unique<ExecutionEngineWrapper>(std::move(execution_session),
-                                               std::move(target_machine_builder),
-                                               std::move(data_layout));
-  execution_engine->addModule(std::move(owner));
-  return std::make_shared<CpuCompilationContext>(std::move(execution_engine));
+  auto execution_engine = std::make_unique<ExecutionEngineWrapper>(
+      ORCJITSession::instance(), /*optimize=*/true);
+  execution_engine->addModule(std::move(module), std::move(context));
+  auto cpu_compilation_context =
+      std::make_shared<CpuCompilationContext>(std::move(execution_engine));
+  cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  return cpu_compilation_context;
 }
 
 std::unique_ptr<llvm::TargetMachine> CUDABackend::initializeNVPTXBackend(
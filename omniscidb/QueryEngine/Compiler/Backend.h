@@ -29,6 +29,7 @@ enum class NvidiaDeviceArch;
 }
 
 class CudaCompilationContext;
+struct TierUpInfo;
 
 namespace compiler {
 
@@ -140,6 +141,12 @@ class CPUBackend : public Backend {
       const std::unordered_set<llvm::Function*>& live_funcs,
       const CompilationOptions& co);
 
+  // Recompile a kernel compiled by the baseline tier with full optimizations. Can be
+  // called concurrently with code generation because the kernel bitcode is parsed
+  // into a separate LLVM context.
+  static std::shared_ptr<CpuCompilationContext> generateOptimizedCPUCode(
+      const TierUpInfo& info);
+
  private:
   inline const static CodegenTraitsDescriptor traitsDescriptor{cpu_cgen_traits_desc};
 };
@@ -131,37 +131,44 @@ void optimize_ir(llvm::Function* query_func,
   FPM.addPass(llvm::VerifierPass());
   MPM.addPass(llvm::AlwaysInlinerPass());
 
-  CGPM.addPass(AnnotateInternalFunctionsPass());
-  MPM.addPass(createModuleToPostOrderCGSCCPassAdaptor(std::move(CGPM)));
-
-  FPM.addPass(llvm::SROAPass());
-  // mem ssa drops unused load and store instructions, e.g. passing variables directly
-  // where possible
-  FPM.addPass(llvm::EarlyCSEPass(/*enable_mem_ssa=*/true));  // Catch trivial redundancies
-
-  if (!is_gpu_smem_used) {
-    // thread jumps can change the execution order around SMEM sections guarded by
-    // `__syncthreads()`, which results in race conditions. For now, disable jump
-    // threading for shared memory queries. In the future, consider handling shared
-    // memory
-    // aggregations with a separate kernel launch
-    FPM.addPass(llvm::JumpThreadingPass());  // Thread jumps.
-  }
-  FPM.addPass(llvm::SimplifyCFGPass());
-  // remove load/stores in PHIs if instructions can be accessed directly post thread
-  FPM.addPass(llvm::GVNPass());
+  if (co.opt_level == ExecutorOptLevel::Baseline) {
+    // The baseline tier only promotes allocas to registers to get a kernel ready
+    // as soon as possible. Reused kernels are recompiled with the full pipeline.
+    FPM.addPass(llvm::PromotePass());
+    MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
+  } else {
+    CGPM.addPass(AnnotateInternalFunctionsPass());
+    MPM.addPass(createModuleToPostOrderCGSCCPassAdaptor(std::move(CGPM)));
+
+    FPM.addPass(llvm::SROAPass());
+    // mem ssa drops unused load and store instructions, e.g. passing variables directly
+    // where possible. Catch trivial redundancies.
+    FPM.addPass(llvm::EarlyCSEPass(/*enable_mem_ssa=*/true));
+
+    if (!is_gpu_smem_used) {
+      // thread jumps can change the execution order around SMEM sections guarded by
+      // `__syncthreads()`, which results in race conditions. For now, disable jump
+      // threading for shared memory queries. In the future, consider handling shared
+      // memory
+      // aggregations with a separate kernel launch
+      FPM.addPass(llvm::JumpThreadingPass());  // Thread jumps.
+    }
+    FPM.addPass(llvm::SimplifyCFGPass());
+    // remove load/stores in PHIs if instructions can be accessed directly post thread
+    FPM.addPass(llvm::GVNPass());
 
-  FPM.addPass(llvm::DSEPass());  // DeadStoreEliminationPass
-  LPM.addPass(llvm::LICMPass());
-  FPM.addPass(createFunctionToLoopPassAdaptor(std::move(LPM), /*UseMemorySSA=*/true));
+    FPM.addPass(llvm::DSEPass());  // DeadStoreEliminationPass
+    LPM.addPass(llvm::LICMPass());
+    FPM.addPass(createFunctionToLoopPassAdaptor(std::move(LPM), /*UseMemorySSA=*/true));
 
-  FPM.addPass(llvm::InstCombinePass());
-  FPM.addPass(llvm::PromotePass());
+    FPM.addPass(llvm::InstCombinePass());
+    FPM.addPass(llvm::PromotePass());
 
-  MPM.addPass(llvm::GlobalOptPass());
-  MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
+    MPM.addPass(llvm::GlobalOptPass());
+    MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
 
-  FPM.addPass(llvm::SimplifyCFGPass());  // cleanup after everything
+    FPM.addPass(llvm::SimplifyCFGPass());  // cleanup after everything
+  }
 
   MPM.run(*llvm_module, MAM);
 
@@ -0,0 +1,144 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CardinalityRecycler.h"
+
+bool CardinalityRecycler::isEnabled(QueryPlanHash key) const {
+  return config_->cache.enable_data_recycler &&
+         config_->cache.use_estimator_result_cache && key != EMPTY_HASHED_PLAN_DAG_KEY;
+}
+
+std::optional<size_t> CardinalityRecycler::getItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::optional<CardinalityCacheMetaInfo> meta_info) const {
+  if (!isEnabled(key)) {
+    return std::nullopt;
+  }
+  CHECK(meta_info);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto cardinality_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(cardinality_cache);
+  auto candidate = getCachedItem(key, *cardinality_cache);
+  if (!candidate || !candidate->cached_item) {
+    return std::nullopt;
+  }
+  CHECK(candidate->meta_info);
+  if (candidate->meta_info->input_table_generations ==
+      meta_info->input_table_generations) {
+    VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Recycle item in a cache: " << *candidate->cached_item;
+    return candidate->cached_item;
+  }
+  return std::nullopt;
+}
+
+void CardinalityRecycler::putItemToCache(
+    QueryPlanHash key,
+    std::optional<size_t> item,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t item_size,
+    size_t compute_time,
+    std::optional<CardinalityCacheMetaInfo> meta_info) {
+  if (!isEnabled(key) || !item) {
+    return;
+  }
+  CHECK(meta_info);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  // the latest value replaces the one computed for previous table generations
+  removeItemFromCache(key, item_type, device_identifier, lock, meta_info);
+  auto cardinality_cache = getCachedItemContainer(item_type, device_identifier);
+  const auto max_size = std::max(config_->cache.cardinality_cache_size, size_t(1));
+  if (cardinality_cache->size() >= max_size) {
+    cleanupCacheForInsertion(item_type, device_identifier, max_size - 1, lock);
+  }
+  cardinality_cache->emplace_back(key, item, nullptr, meta_info);
+  VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Put item to cache: " << *item;
+}
+
+void CardinalityRecycler::removeItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<CardinalityCacheMetaInfo> meta_info) {
+  auto cardinality_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(cardinality_cache);
+  auto filter = [key](auto const& item) { return item.key == key; };
+  auto itr = std::find_if(cardinality_cache->cbegin(), cardinality_cache->cend(), filter);
+  if (itr != cardinality_cache->cend()) {
+    cardinality_cache->erase(itr);
+  }
+}
+
+void CardinalityRecycler::cleanupCacheForInsertion(
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t required_size,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<CardinalityCacheMetaInfo> meta_info) {
+  // new items are appended to the end of the container, so the oldest ones are
+  // removed from its beginning
+  auto cardinality_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(cardinality_cache);
+  if (cardinality_cache->size() > required_size) {
+    removeCachedItemFromBeginning(
+        item_type,
+        device_identifier,
+        static_cast<int>(cardinality_cache->size() - required_size));
+  }
+}
+
+bool CardinalityRecycler::hasItemInCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<CardinalityCacheMetaInfo> meta_info) const {
+  if (!isEnabled(key)) {
+    return false;
+  }
+  auto cardinality_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(cardinality_cache);
+  return getCachedItem(key, *cardinality_cache).has_value();
+}
+
+void CardinalityRecycler::clearCache() {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  for (auto& item_type : getCacheItemType()) {
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& kv : *item_cache) {
+      kv.second->clear();
+    }
+  }
+}
+
+std::string CardinalityRecycler::toString() const {
+  std::ostringstream oss;
+  oss << "A current status of the Cardinality Recycler:\n";
+  for (auto& item_type : getCacheItemType()) {
+    oss << "\t" << DataRecyclerUtil::toStringCacheItemType(item_type) << "\n";
+    auto cache_container =
+        getCachedItemContainer(item_type, CARDINALITY_CACHE_DEVICE_IDENTIFIER);
+    for (auto& item : *cache_container) {
+      oss << "\t\tkey: " << item.key << ", value: " << *item.cached_item << "\n";
+    }
+  }
+  return oss.str();
+}
@@ -0,0 +1,98 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRecycler.h"
+#include "QueryEngine/TableGenerations.h"
+#include "Shared/Config.h"
+
+constexpr DeviceIdentifier CARDINALITY_CACHE_DEVICE_IDENTIFIER =
+    DataRecyclerUtil::CPU_DEVICE_IDENTIFIER;
+
+// Generations of physical tables the cached estimation was computed for.
+struct CardinalityCacheMetaInfo {
+  TableGenerations input_table_generations;
+};
+
+// Caches cardinality estimations and row counts of execution units:
+//  - COUNTALL_CARD_EST: result of the filtered COUNT(*) pre-flight query;
+//  - NDV_CARD_EST: groups buffer entry guess computed by the NDV estimator;
+//  - FILTER_SEL: number of rows selected by filters of a single table step
+//    measured during the step execution.
+// Cached values are used only when input tables are unchanged. Modified tables
+// change the query plan DAG and therefore the cache key, so stale entries are never
+// hit again. The number of entries of each kind is limited by
+// cache.cardinality_cache_size and the oldest entries are evicted first.
+class CardinalityRecycler
+    : public DataRecycler<std::optional<size_t>, CardinalityCacheMetaInfo> {
+ public:
+  CardinalityRecycler(ConfigPtr config)
+      : DataRecycler({CacheItemType::COUNTALL_CARD_EST,
+                      CacheItemType::NDV_CARD_EST,
+                      CacheItemType::FILTER_SEL},
+                     std::numeric_limits<size_t>::max(),
+                     std::numeric_limits<size_t>::max(),
+                     0)
+      , config_(config) {}
+
+  std::optional<size_t> getItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::optional<CardinalityCacheMetaInfo> meta_info = std::nullopt) const override;
+
+  void putItemToCache(
+      QueryPlanHash key,
+      std::optional<size_t> item,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t item_size,
+      size_t compute_time,
+      std::optional<CardinalityCacheMetaInfo> meta_info = std::nullopt) override;
+
+  // nothing to do with cardinality recycler
+  void initCache() override {}
+
+  void clearCache() override;
+
+  std::string toString() const override;
+
+ private:
+  bool isEnabled(QueryPlanHash key) const;
+
+  bool hasItemInCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<CardinalityCacheMetaInfo> meta_info = std::nullopt) const override;
+
+  void removeItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<CardinalityCacheMetaInfo> meta_info = std::nullopt) override;
+
+  // removes the oldest entries to keep at most required_size entries in the cache
+  void cleanupCacheForInsertion(
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t required_size,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<CardinalityCacheMetaInfo> meta_info = std::nullopt) override;
+
+  ConfigPtr config_;
+};
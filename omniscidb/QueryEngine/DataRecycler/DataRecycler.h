@@ -38,11 +38,10 @@ enum CacheItemType {
   BASELINE_HT,              // Baseline hashtable
   HT_HASHING_SCHEME,        // Hashtable layout
   BASELINE_HT_APPROX_CARD,  // Approximated cardinality for baseline hashtable
-  // TODO (yoonmin): support the following items for recycling
-  // ROW_RS,             Row-wise resultset
-  // COUNTALL_CARD_EST,  Cardinality of query result
-  // NDV_CARD_EST,       # Non-distinct value
-  // FILTER_SEL          Selectivity of (push-downed) filter node
+  ROW_RS,                   // Resultset of a query step
+  COUNTALL_CARD_EST,        // Cardinality of query result
+  NDV_CARD_EST,             // # Non-distinct value
+  FILTER_SEL,               // # Rows selected by filters
   NUM_CACHE_ITEM_TYPE
 };
 
@@ -113,13 +112,15 @@ using CacheMetricInfoMap =
 
 class DataRecyclerUtil {
  public:
-  // need to add more constants if necessary: ROW_RS, COUNTALL_CARD_EST, NDV_CARD_EST,
-  // FILTER_SEL, ...
   static constexpr auto cache_item_type_str =
       shared::string_view_array("Perfect Join Hashtable",
                                 "Baseline Join Hashtable",
                                 "Hashing Scheme for Join Hashtable",
-                                "Baseline Join Hashtable's Approximated Cardinality");
+                                "Baseline Join Hashtable's Approximated Cardinality",
+                                "Query Resultset",
+                                "Filtered Count Estimation",
+                                "NDV Estimation",
+                                "Filter Selectivity");
   static std::string_view toStringCacheItemType(CacheItemType item_type) {
     static_assert(cache_item_type_str.size() == NUM_CACHE_ITEM_TYPE);
     return cache_item_type_str[item_type];
@@ -0,0 +1,236 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ResultSetRecycler.h"
+#include "ResultSet/ResultSet.h"
+#include "Shared/funcannotations.h"
+
+EXTERN extern bool g_is_test_env;
+
+namespace {
+
+bool is_valid_cached_item(
+    const CachedItem<hdk::ResultSetTableTokenPtr, ResultSetCacheMetaInfo>& item,
+    const std::optional<ResultSetCacheMetaInfo>& meta_info) {
+  if (!meta_info || !item.meta_info) {
+    return !meta_info && !item.meta_info;
+  }
+  return item.meta_info->input_table_generations == meta_info->input_table_generations;
+}
+
+}  // namespace
+
+bool ResultSetRecycler::isEnabled(QueryPlanHash key) const {
+  return config_->cache.enable_data_recycler &&
+         config_->cache.use_query_resultset_cache && key != EMPTY_HASHED_PLAN_DAG_KEY;
+}
+
+bool ResultSetRecycler::hasItemInCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetCacheMetaInfo> meta_info) const {
+  if (!isEnabled(key)) {
+    return false;
+  }
+  CHECK_EQ(item_type, CacheItemType::ROW_RS);
+  auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(resultset_cache);
+  return getCachedItem(key, *resultset_cache).has_value();
+}
+
+hdk::ResultSetTableTokenPtr ResultSetRecycler::getItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::optional<ResultSetCacheMetaInfo> meta_info) const {
+  if (!isEnabled(key)) {
+    return nullptr;
+  }
+  CHECK_EQ(item_type, CacheItemType::ROW_RS);
+  hdk::ResultSetTableTokenPtr token;
+  {
+    std::lock_guard<std::mutex> lock(getCacheLock());
+    auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+    auto candidate_rs = getCachedItem(key, *resultset_cache);
+    if (!candidate_rs) {
+      return nullptr;
+    }
+    if (!is_valid_cached_item(*candidate_rs, meta_info)) {
+      // one of the input tables has changed, the outdated result set is
+      // replaced when the step result is put to the cache again
+      VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+              << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+              << "] Skip outdated item in a cache";
+      return nullptr;
+    }
+    candidate_rs->item_metric->incRefCount();
+    token = candidate_rs->cached_item;
+  }
+  VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Recycle item in a cache";
+  // cached result sets can be iterated by several consumers at the same time,
+  // so each of them gets own result set objects sharing the cached data
+  return token->shallowCopy();
+}
+
+void ResultSetRecycler::putItemToCache(QueryPlanHash key,
+                                       hdk::ResultSetTableTokenPtr item_ptr,
+                                       CacheItemType item_type,
+                                       DeviceIdentifier device_identifier,
+                                       size_t item_size,
+                                       size_t compute_time,
+                                       std::optional<ResultSetCacheMetaInfo> meta_info) {
+  if (!isEnabled(key) || !item_ptr) {
+    return;
+  }
+  CHECK_EQ(item_type, CacheItemType::ROW_RS);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  if (hasItemInCache(key, item_type, device_identifier, lock, meta_info)) {
+    auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+    auto cached_rs = getCachedItem(key, *resultset_cache);
+    if (is_valid_cached_item(*cached_rs, meta_info)) {
+      // this resultset is already cached
+      return;
+    }
+    removeItemFromCache(key, item_type, device_identifier, lock, meta_info);
+  }
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto cache_status = metric_tracker.canAddItem(device_identifier, item_size);
+  if (cache_status == CacheAvailability::UNAVAILABLE) {
+    // resultset is too large
+    return;
+  } else if (cache_status == CacheAvailability::AVAILABLE_AFTER_CLEANUP) {
+    auto required_size = metric_tracker.calculateRequiredSpaceForItemAddition(
+        device_identifier, item_size);
+    cleanupCacheForInsertion(item_type, device_identifier, required_size, lock);
+  }
+  auto new_cache_metric_ptr = metric_tracker.putNewCacheItemMetric(
+      key, device_identifier, item_size, compute_time);
+  CHECK_EQ(item_size, new_cache_metric_ptr->getMemSize());
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::ADD, item_size);
+  VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Put item to cache";
+  auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+  resultset_cache->emplace_back(key, item_ptr, new_cache_metric_ptr, meta_info);
+}
+
+void ResultSetRecycler::removeItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetCacheMetaInfo> meta_info) {
+  if (!isEnabled(key)) {
+    return;
+  }
+  auto& cache_metrics = getMetricTracker(item_type);
+  auto cache_metric = cache_metrics.getCacheItemMetric(key, device_identifier);
+  CHECK(cache_metric);
+  auto resultset_size = cache_metric->getMemSize();
+  auto resultset_container = getCachedItemContainer(item_type, device_identifier);
+  auto filter = [key](auto const& item) { return item.key == key; };
+  auto itr =
+      std::find_if(resultset_container->cbegin(), resultset_container->cend(), filter);
+  if (itr == resultset_container->cend()) {
+    return;
+  }
+  resultset_container->erase(itr);
+  cache_metrics.removeCacheItemMetric(key, device_identifier);
+  cache_metrics.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, resultset_size);
+}
+
+void ResultSetRecycler::cleanupCacheForInsertion(
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t required_size,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetCacheMetaInfo> meta_info) {
+  // the same policy as for hashtables: sort cached items by their importance (# of
+  // references, size and compute time) and remove the least important ones
+  int elimination_target_offset = 0;
+  size_t removed_size = 0;
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto actual_space_to_free = metric_tracker.getTotalCacheSize() / 2;
+  if (!g_is_test_env && required_size < actual_space_to_free) {
+    required_size = actual_space_to_free;
+  }
+  metric_tracker.sortCacheInfoByQueryMetric(device_identifier);
+  auto cached_item_metrics = metric_tracker.getCacheItemMetrics(device_identifier);
+  sortCacheContainerByQueryMetric(item_type, device_identifier);
+
+  for (auto& metric : cached_item_metrics) {
+    auto target_size = metric->getMemSize();
+    ++elimination_target_offset;
+    removed_size += target_size;
+    if (removed_size > required_size) {
+      break;
+    }
+  }
+
+  removeCachedItemFromBeginning(item_type, device_identifier, elimination_target_offset);
+  metric_tracker.removeMetricFromBeginning(device_identifier, elimination_target_offset);
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, removed_size);
+}
+
+void ResultSetRecycler::clearCache() {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  for (auto& item_type : getCacheItemType()) {
+    getMetricTracker(item_type).clearCacheMetricTracker();
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& kv : *item_cache) {
+      kv.second->clear();
+    }
+  }
+}
+
+std::string ResultSetRecycler::toString() const {
+  std::ostringstream oss;
+  oss << "A current status of the Resultset Recycler:\n";
+  for (auto& item_type : getCacheItemType()) {
+    oss << "\t" << DataRecyclerUtil::toStringCacheItemType(item_type);
+    auto& metric_tracker = getMetricTracker(item_type);
+    oss << "\n\t# cached resultsets:\n";
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& cache_container : *item_cache) {
+      oss << "\t\tDevice"
+          << DataRecyclerUtil::getDeviceIdentifierString(cache_container.first)
+          << ", # resultsets: " << cache_container.second->size() << "\n";
+      for (auto& rs : *cache_container.second) {
+        oss << "\t\t\tRS] " << rs.cached_item->toString() << " "
+            << rs.item_metric->toString() << "\n";
+      }
+    }
+    oss << "\t" << metric_tracker.toString() << "\n";
+  }
+  return oss.str();
+}
+
+size_t ResultSetRecycler::getResultSetTableSize(const hdk::ResultSetTableToken& token) {
+  size_t res = 0;
+  for (size_t rs_idx = 0; rs_idx < token.resultSetCount(); ++rs_idx) {
+    auto rs = token.resultSet(rs_idx);
+    for (size_t storage_idx = 0; storage_idx < rs->getStorageCount(); ++storage_idx) {
+      res += rs->getStorage(storage_idx)->getQueryMemDesc().getBufferSizeBytes(
+          ExecutorDeviceType::CPU);
+    }
+  }
+  return res;
+}
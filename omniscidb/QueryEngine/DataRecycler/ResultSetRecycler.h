@@ -0,0 +1,96 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRecycler.h"
+#include "QueryEngine/TableGenerations.h"
+#include "ResultSetRegistry/ResultSetTableToken.h"
+#include "Shared/Config.h"
+
+constexpr DeviceIdentifier RESULTSET_CACHE_DEVICE_IDENTIFIER =
+    DataRecyclerUtil::CPU_DEVICE_IDENTIFIER;
+
+// Generations of physical tables the cached result set was computed from.
+// A cached result set is reused only when all of its input tables still
+// have the same number of rows, i.e. appends to the inputs invalidate it.
+struct ResultSetCacheMetaInfo {
+  TableGenerations input_table_generations;
+};
+
+// Caches the final result of a query step keyed by the step's query plan DAG hash.
+// Result sets are kept in CPU memory regardless of the device used to compute them.
+// Consumers get shallow copies of cached result sets, so iteration by one consumer
+// doesn't affect others, but the shared data must not be modified.
+class ResultSetRecycler
+    : public DataRecycler<hdk::ResultSetTableTokenPtr, ResultSetCacheMetaInfo> {
+ public:
+  ResultSetRecycler(ConfigPtr config)
+      : DataRecycler({CacheItemType::ROW_RS},
+                     config->cache.query_resultset_cache_total_bytes,
+                     config->cache.max_query_resultset_size_bytes,
+                     0)
+      , config_(config) {}
+
+  hdk::ResultSetTableTokenPtr getItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) const override;
+
+  void putItemToCache(
+      QueryPlanHash key,
+      hdk::ResultSetTableTokenPtr item_ptr,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t item_size,
+      size_t compute_time,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) override;
+
+  // nothing to do with resultset recycler
+  void initCache() override {}
+
+  void clearCache() override;
+
+  std::string toString() const override;
+
+  // Memory held by the result sets of the table referenced by the token.
+  static size_t getResultSetTableSize(const hdk::ResultSetTableToken& token);
+
+ private:
+  bool isEnabled(QueryPlanHash key) const;
+
+  bool hasItemInCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) const override;
+
+  void removeItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) override;
+
+  void cleanupCacheForInsertion(
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t required_size,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) override;
+
+  ConfigPtr config_;
+};
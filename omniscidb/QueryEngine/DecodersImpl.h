@@ -25,6 +25,7 @@
 #define QUERYENGINE_DECODERSIMPL_H
 
 #include <cstdint>
+#include "../Shared/PackedChunk.h"
 #include "../Shared/funcannotations.h"
 
 extern "C" DEVICE ALWAYS_INLINE int64_t
@@ -168,6 +169,34 @@ extern "C" DEVICE NEVER_INLINE int64_t SUFFIX(fixed_width_small_date_decode_noin
       byte_stream, byte_width, null_val, ret_null_val, pos);
 }
 
+// Decodes a value from a frame-of-reference bit-packed chunk (see
+// Shared/PackedChunk.h). Header loads don't depend on the position, so they
+// are hoisted out of the scan loop once this function is inlined.
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(fixed_width_packed_int_decode)(GENERIC_ADDR_SPACE const int8_t* byte_stream,
+                                      const int64_t null_val,
+                                      const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto header =
+      reinterpret_cast<GENERIC_ADDR_SPACE const PackedChunkHeader*>(byte_stream);
+  const auto bit_width = static_cast<uint64_t>(header->bit_width);
+  const uint64_t bit_pos = static_cast<uint64_t>(pos) * bit_width;
+  const auto bytes = reinterpret_cast<GENERIC_ADDR_SPACE const uint8_t*>(
+                         byte_stream + sizeof(PackedChunkHeader)) +
+                     (bit_pos >> 3);
+  // Byte-wise load is combined into a single unaligned load by LLVM.
+  uint64_t word = 0;
+  for (int i = 0; i < 8; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  const uint64_t mask = (uint64_t(1) << bit_width) - 1;
+  const uint64_t code = (word >> (bit_pos & 7)) & mask;
+  return header->has_nulls && code == mask ? null_val
+                                            : header->base + static_cast<int64_t>(code);
+}
+
 #undef SUFFIX
 
 #endif  // QUERYENGINE_DECODERSIMPL_H
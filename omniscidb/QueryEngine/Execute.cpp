@@ -53,6 +53,7 @@
 #include "QueryEngine/DynamicWatchdog.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/ErrorHandling.h"
+#include "QueryEngine/ExecutionEngineWrapper.h"
 #include "QueryEngine/ExecutionKernel.h"
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/ExternalCacheInvalidators.h"
@@ -69,12 +70,15 @@
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/SpeculativeTopN.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
+#include "QueryEngine/TierUpWorker.h"
+#include "QueryEngine/VectorizedInterpreter.h"
 #include "QueryEngine/Visitors/TransientStringLiteralsVisitor.h"
 #include "ResultSet/ColRangeInfo.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
 #include "Shared/measure.h"
 #include "Shared/misc.h"
+#include "Shared/numa.h"
 #include "Shared/scope.h"
 #include "ThirdParty/robin_hood.h"
 
@@ -134,6 +138,8 @@ void init_code_caches() {
  * destroyed at exit.
  */
 void Executor::resetCodeCache() {
+  // Pending tier-up tasks update the CPU code cache.
+  TierUpWorker::instance().wait();
   s_stubs_accessor.reset();
   s_code_accessor.reset();
   cpu_code_accessor.reset();
@@ -168,11 +174,21 @@ Executor::Executor(const ExecutorId executor_id,
   std::call_once(first_init_flag_, [this]() {
     query_plan_dag_cache_ =
         std::make_unique<QueryPlanDagCache>(config_->cache.dag_cache_size);
+    resultset_recycler_ = std::make_unique<ResultSetRecycler>(config_);
+    cardinality_recycler_ = std::make_unique<CardinalityRecycler>(config_);
+    group_by_buffer_pool_ = std::make_shared<GroupByBufferPool>(
+        config_->exec.group_by.buffer_pool_size,
+        config_->exec.group_by.buffer_pool_max_buffer_size,
+        cpu_threads());
     code_cache_size = config_->cache.code_cache_size;
     init_code_caches();
   });
   Executor::initialize_extension_module_sources();
   update_extension_modules();
+  if (config_->exec.codegen.enable_runtime_dylib) {
+    ORCJITSession::instance().initRuntimeDylib(
+        Executor::extension_module_sources.at(ExtModuleKinds::template_module));
+  }
 
   if (config_->exec.enable_cost_model) {
     try {
@@ -430,6 +446,13 @@ void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level,
         // For now, assume the user wants to purge the hash table cache when they clear
         // CPU memory (currently used in ExecuteTest to lower memory pressure)
         JoinHashTableCacheInvalidator::invalidateCaches();
+        // Cached query results are held in CPU memory as well.
+        if (resultset_recycler_) {
+          resultset_recycler_->clearCache();
+        }
+        if (group_by_buffer_pool_) {
+          group_by_buffer_pool_->clear();
+        }
       }
       break;
     }
@@ -508,6 +531,14 @@ quantile::TDigest* RowSetMemoryOwner::nullTDigest(double const q) {
       .get();
 }
 
+ExactQuantile* RowSetMemoryOwner::nullExactQuantile(double const q,
+                                                    bool const interpolate) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  return exact_quantiles_
+      .emplace_back(std::make_unique<ExactQuantile>(q, interpolate))
+      .get();
+}
+
 bool Executor::isCPUOnly() const {
   CHECK(data_mgr_);
   return !data_mgr_->getCudaMgr();
@@ -1800,6 +1831,50 @@ hdk::ResultSetTable Executor::executeWorkUnit(
   }
 }
 
+void Executor::compileWorkUnitForCache(const std::vector<InputTableInfo>& query_infos,
+                                       const RelAlgExecutionUnit& ra_exe_unit,
+                                       const CompilationOptions& co,
+                                       const ExecutionOptions& eo,
+                                       const size_t max_groups_buffer_entry_guess,
+                                       const bool has_cardinality_estimation,
+                                       DataProvider* data_provider) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  ScopeGuard cleanup_post_compilation = [this] {
+    plan_state_.reset(nullptr);
+    if (cgen_state_) {
+      cgen_state_->in_values_bitmaps_.clear();
+    }
+  };
+
+  ColumnCacheMap column_cache;
+  ColumnFetcher column_fetcher(this, data_provider, column_cache);
+  ScopeGuard scope_guard = [&column_fetcher] {
+    column_fetcher.freeLinearizedBuf();
+    column_fetcher.freeTemporaryCpuLinearizedIdxBuf();
+  };
+  QueryCompilationDescriptor query_comp_desc;
+  query_comp_desc.setUseGroupByBufferDesc(co.use_groupby_buffer_desc);
+  query_comp_desc.compile(max_groups_buffer_entry_guess,
+                          MAX_BYTE_WIDTH_SUPPORTED,
+                          has_cardinality_estimation,
+                          ra_exe_unit,
+                          query_infos,
+                          column_fetcher,
+                          co,
+                          eo,
+                          this);
+}
+
+std::pair<Executor*, std::unique_lock<std::mutex>>
+Executor::acquireSpeculativeExecutor() {
+  std::unique_lock<std::mutex> lock(speculative_executor_mutex_);
+  if (!speculative_executor_) {
+    speculative_executor_ = getExecutor(data_mgr_, config_);
+  }
+  return {speculative_executor_.get(), std::move(lock)};
+}
+
 std::shared_ptr<StreamExecutionContext> Executor::prepareStreamingExecution(
     const RelAlgExecutionUnit& ra_exe_unit,
     const CompilationOptions& co,
@@ -2470,7 +2545,7 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
     target_infos.push_back(agg_info);
     const bool float_argument_input = takes_float_argument(agg_info);
     if (agg_info.agg_kind == hdk::ir::AggType::kCount ||
-        agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct) {
+        hdk::ir::isHll(agg_info.agg_kind)) {
       entry.push_back(0);
     } else if (agg_info.agg_kind == hdk::ir::AggType::kAvg) {
       entry.push_back(0);
@@ -2599,6 +2674,20 @@ bool has_lazy_fetched_columns(const std::vector<ColumnLazyFetchInfo>& fetched_co
   return false;
 }
 
+// Chooses the sub-task size to have several sub-tasks per CPU thread. Threads which
+// finish their sub-tasks early take sub-tasks of big or slow fragments, so skewed
+// fragments don't leave CPU cores idle at the end of the query.
+size_t get_sub_task_size(const CpuSubTasksConfig& config,
+                         const std::vector<InputTableInfo>& query_infos) {
+  constexpr size_t kSubTasksPerThread = 4;
+  const size_t outer_rows =
+      query_infos.empty() ? 0 : query_infos.front().info.getNumTuples();
+  const size_t min_size = std::max(config.min_sub_task_size, size_t(1));
+  const size_t max_size = std::max(config.sub_task_size, min_size);
+  return std::clamp(
+      outer_rows / (cpu_threads() * kSubTasksPerThread), min_size, max_size);
+}
+
 }  // namespace
 
 std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
@@ -2873,8 +2962,16 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
   const RelAlgExecutionUnit* ra_exe_unit =
       kernels.empty() ? nullptr : &kernels[0]->ra_exe_unit_;
 
-  if (config_->exec.sub_tasks.enable && device_type == ExecutorDeviceType::CPU) {
+  const int numa_nodes = numa::num_nodes();
+  const bool use_numa_nodes = config_->exec.enable_numa_affinity &&
+                              device_type == ExecutorDeviceType::CPU && numa_nodes > 1;
+  // Kernel subtasks are spawned into a single task group, so they are not used with
+  // per-node scheduling.
+  if (config_->exec.sub_tasks.enable && device_type == ExecutorDeviceType::CPU &&
+      !use_numa_nodes) {
     shared_context.setThreadPool(&tg);
+    shared_context.setSubTaskSize(
+        get_sub_task_size(config_->exec.sub_tasks, shared_context.getQueryInfos()));
   }
   ScopeGuard pool_guard([&shared_context]() { shared_context.setThreadPool(nullptr); });
 
@@ -2884,19 +2981,68 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
   }
 
   size_t kernel_idx = 1;
-  for (auto& kernel : kernels) {
-    CHECK(kernel.get());
-    tg.run([this,
-            &kernel,
-            &shared_context,
-            parent_thread_id = logger::thread_id(),
-            crt_kernel_idx = kernel_idx++] {
-      DEBUG_TIMER_NEW_THREAD(parent_thread_id);
-      const size_t thread_i = crt_kernel_idx % cpu_threads();
-      kernel->run(this, thread_i, shared_context);
-    });
-  }
-  tg.wait();
+  if (use_numa_nodes) {
+    // Kernels run in the arena of the node chosen by their outer fragment, so the
+    // same fragment is always processed by the same node. Chunks are fetched by
+    // threads of this node and BufferMgr places them in the node's memory.
+    std::vector<tbb::task_group> node_groups(numa_nodes);
+    for (auto& kernel : kernels) {
+      CHECK(kernel.get());
+      const auto& frag_list = kernel->getFragmentsList();
+      const int node = frag_list.empty() || frag_list[0].fragment_ids.empty()
+                           ? kernel_idx % numa_nodes
+                           : frag_list[0].fragment_ids[0] % numa_nodes;
+      numa::get_node_arena(node).execute([this,
+                                          &kernel,
+                                          &shared_context,
+                                          &node_groups,
+                                          node,
+                                          parent_thread_id = logger::thread_id(),
+                                          crt_kernel_idx = kernel_idx++] {
+        node_groups[node].run([this,
+                               &kernel,
+                               &shared_context,
+                               node,
+                               parent_thread_id,
+                               crt_kernel_idx] {
+          DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+          numa::NodeScope node_scope(node);
+          const size_t thread_i = crt_kernel_idx % cpu_threads();
+          kernel->run(this, thread_i, shared_context);
+        });
+      });
+    }
+    // Wait for all nodes before rethrowing a kernel error.
+    std::exception_ptr kernel_error;
+    for (int node = 0; node < numa_nodes; ++node) {
+      try {
+        numa::get_node_arena(node).execute([&node_groups, node] {
+          node_groups[node].wait();
+        });
+      } catch (...) {
+        if (!kernel_error) {
+          kernel_error = std::current_exception();
+        }
+      }
+    }
+    if (kernel_error) {
+      std::rethrow_exception(kernel_error);
+    }
+  } else {
+    for (auto& kernel : kernels) {
+      CHECK(kernel.get());
+      tg.run([this,
+              &kernel,
+              &shared_context,
+              parent_thread_id = logger::thread_id(),
+              crt_kernel_idx = kernel_idx++] {
+        DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+        const size_t thread_i = crt_kernel_idx % cpu_threads();
+        kernel->run(this, thread_i, shared_context);
+      });
+    }
+    tg.wait();
+  }
 
   for (auto& exec_ctx : shared_context.getTlsExecutionContext()) {
     // The first arg is used for GPU only, it's not our case.
@@ -3159,6 +3305,8 @@ FetchResult Executor::fetchChunks(
                                                         thread_idx);
         }
       } else {
+        const bool packed =
+            col_id->getNestLevel() == 0 && plan_state_->packed_columns_.count(*col_id);
         frag_col_buffers[it->second] =
             column_fetcher.getOneTableColumnFragment(col_id->getColInfo(),
                                                      frag_id,
@@ -3167,7 +3315,8 @@ FetchResult Executor::fetchChunks(
                                                      chunk_iterators,
                                                      memory_level_for_column,
                                                      device_id,
-                                                     device_allocator);
+                                                     device_allocator,
+                                                     packed);
       }
     }
     all_frag_col_buffers.push_back(frag_col_buffers);
@@ -3492,7 +3641,14 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
   if (!is_groupby) {
     std::unique_ptr<OutVecOwner> output_memory_scope;
     std::vector<int64_t*> out_vec;
-    if (device_type == ExecutorDeviceType::CPU) {
+    auto interpreted_code = dynamic_cast<const InterpretedCompilationContext*>(
+        compilation_result.generated_code.get());
+    if (interpreted_code) {
+      CHECK(device_type == ExecutorDeviceType::CPU);
+      out_vec = query_exe_context->launchInterpretedCode(
+          interpreted_code, col_buffers, num_rows, start_rowid, rows_to_process);
+      output_memory_scope.reset(new OutVecOwner(out_vec));
+    } else if (device_type == ExecutorDeviceType::CPU) {
       CpuCompilationContext* cpu_generated_code =
           dynamic_cast<CpuCompilationContext*>(compilation_result.generated_code.get());
       CHECK(cpu_generated_code);
@@ -3544,7 +3700,8 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
         error_code == Executor::ERR_OUT_OF_TIME ||
         error_code == Executor::ERR_INTERRUPTED ||
         error_code == Executor::ERR_SINGLE_VALUE_FOUND_MULTIPLE_VALUES ||
-        error_code == Executor::ERR_WIDTH_BUCKET_INVALID_ARGUMENT) {
+        error_code == Executor::ERR_WIDTH_BUCKET_INVALID_ARGUMENT ||
+        error_code == Executor::ERR_HLL_SKETCH_PRECISION) {
       return error_code;
     }
     if (ra_exe_unit.estimator) {
@@ -3581,11 +3738,10 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
 
         int64_t val1;
         const bool float_argument_input = takes_float_argument(agg_info);
-        if (is_distinct_target(agg_info) ||
-            agg_info.agg_kind == hdk::ir::AggType::kApproxQuantile) {
+        if (is_distinct_target(agg_info) || hdk::ir::isQuantile(agg_info.agg_kind)) {
           CHECK(agg_info.agg_kind == hdk::ir::AggType::kCount ||
-                agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct ||
-                agg_info.agg_kind == hdk::ir::AggType::kApproxQuantile);
+                hdk::ir::isHll(agg_info.agg_kind) ||
+                hdk::ir::isQuantile(agg_info.agg_kind));
           val1 = out_vec[out_vec_idx][0];
           error_code = 0;
         } else {
@@ -3723,7 +3879,8 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
       error_code == Executor::ERR_OUT_OF_TIME ||
       error_code == Executor::ERR_INTERRUPTED ||
       error_code == Executor::ERR_SINGLE_VALUE_FOUND_MULTIPLE_VALUES ||
-      error_code == Executor::ERR_WIDTH_BUCKET_INVALID_ARGUMENT) {
+      error_code == Executor::ERR_WIDTH_BUCKET_INVALID_ARGUMENT ||
+      error_code == Executor::ERR_HLL_SKETCH_PRECISION) {
     return error_code;
   }
 
@@ -4342,6 +4499,18 @@ QueryPlanDagCache& Executor::getQueryPlanDagCache() {
   return *query_plan_dag_cache_;
 }
 
+ResultSetRecycler& Executor::getResultSetRecycler() {
+  return *resultset_recycler_;
+}
+
+CardinalityRecycler& Executor::getCardinalityRecycler() {
+  return *cardinality_recycler_;
+}
+
+GroupByBufferPool& Executor::getGroupByBufferPool() const {
+  return *group_by_buffer_pool_;
+}
+
 JoinColumnsInfo Executor::getJoinColumnsInfo(const hdk::ir::Expr* join_expr,
                                              JoinColumnSide target_side,
                                              bool extract_only_col_id) {
@@ -4349,25 +4518,6 @@ JoinColumnsInfo Executor::getJoinColumnsInfo(const hdk::ir::Expr* join_expr,
       join_expr, target_side, extract_only_col_id);
 }
 
-void Executor::addToCardinalityCache(const std::string& cache_key,
-                                     const size_t cache_value) {
-  if (config_->cache.use_estimator_result_cache) {
-    mapd_unique_lock<mapd_shared_mutex> lock(recycler_mutex_);
-    cardinality_cache_[cache_key] = cache_value;
-    VLOG(1) << "Put estimated cardinality to the cache";
-  }
-}
-
-Executor::CachedCardinality Executor::getCachedCardinality(const std::string& cache_key) {
-  mapd_shared_lock<mapd_shared_mutex> lock(recycler_mutex_);
-  if (config_->cache.use_estimator_result_cache &&
-      cardinality_cache_.find(cache_key) != cardinality_cache_.end()) {
-    VLOG(1) << "Reuse cached cardinality";
-    return {true, cardinality_cache_[cache_key]};
-  }
-  return {false, -1};
-}
-
 bool Executor::checkNonKernelTimeInterrupted() const {
   // this function should be called within an executor which is assigned
   // to the specific query thread (that indicates we already enroll the session)
@@ -4393,6 +4543,8 @@ std::mutex Executor::kernel_mutex_;
 std::atomic<size_t> Executor::executor_id_ctr_{0};
 
 std::unique_ptr<QueryPlanDagCache> Executor::query_plan_dag_cache_;
+std::unique_ptr<ResultSetRecycler> Executor::resultset_recycler_;
 std::once_flag Executor::first_init_flag_;
 mapd_shared_mutex Executor::recycler_mutex_;
-std::unordered_map<std::string, size_t> Executor::cardinality_cache_;
+std::unique_ptr<CardinalityRecycler> Executor::cardinality_recycler_;
+std::shared_ptr<GroupByBufferPool> Executor::group_by_buffer_pool_;
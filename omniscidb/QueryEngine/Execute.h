@@ -47,6 +47,8 @@
 #include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/Compiler/Backend.h"
 #include "QueryEngine/Compiler/Exceptions.h"
+#include "QueryEngine/DataRecycler/CardinalityRecycler.h"
+#include "QueryEngine/DataRecycler/ResultSetRecycler.h"
 #include "QueryEngine/DateTimeUtils.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
 #include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
@@ -67,6 +69,7 @@
 #include "DataMgr/Chunk/Chunk.h"
 #include "IR/Expr.h"
 #include "Logger/Logger.h"
+#include "ResultSet/GroupByBufferPool.h"
 #include "ResultSetRegistry/ResultSetTable.h"
 #include "SchemaMgr/SchemaProvider.h"
 #include "Shared/Config.h"
@@ -385,6 +388,21 @@ class Executor : public StringDictionaryProxyProvider {
                                       DataProvider* data_provider,
                                       ColumnCacheMap& column_cache);
 
+  // Generates code for the work unit without executing it. The code is put into the
+  // code cache, so a later execution of the same unit skips the compilation.
+  void compileWorkUnitForCache(const std::vector<InputTableInfo>& query_infos,
+                               const RelAlgExecutionUnit& ra_exe_unit,
+                               const CompilationOptions& co,
+                               const ExecutionOptions& eo,
+                               const size_t max_groups_buffer_entry_guess,
+                               const bool has_cardinality_estimation,
+                               DataProvider* data_provider);
+
+  // Returns an executor for speculative compilation of query steps, so the code
+  // generation state of this executor is kept intact. It is created once and reused
+  // by all queries. The returned lock serializes compilations on it.
+  std::pair<Executor*, std::unique_lock<std::mutex>> acquireSpeculativeExecutor();
+
   void addTransientStringLiterals(
       const RelAlgExecutionUnit& ra_exe_unit,
       const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner);
@@ -870,13 +888,13 @@ class Executor : public StringDictionaryProxyProvider {
   // while performing non-kernel time task
   bool checkNonKernelTimeInterrupted() const;
 
-  // true when we have matched cardinality, and false otherwise
-  using CachedCardinality = std::pair<bool, size_t>;
-  void addToCardinalityCache(const std::string& cache_key, const size_t cache_value);
-  CachedCardinality getCachedCardinality(const std::string& cache_key);
-
   mapd_shared_mutex& getDataRecyclerLock();
   QueryPlanDagCache& getQueryPlanDagCache();
+  ResultSetRecycler& getResultSetRecycler();
+  CardinalityRecycler& getCardinalityRecycler();
+  GroupByBufferPool& getGroupByBufferPool() const;
+  // Total number of CPU kernel sub-tasks launched by this executor.
+  size_t getSubTasksCount() const { return sub_tasks_count_; }
   JoinColumnsInfo getJoinColumnsInfo(const hdk::ir::Expr* join_expr,
                                      JoinColumnSide target_side,
                                      bool extract_only_col_id);
@@ -995,6 +1013,7 @@ class Executor : public StringDictionaryProxyProvider {
 
   int64_t kernel_queue_time_ms_ = 0;
   int64_t compilation_queue_time_ms_ = 0;
+  std::atomic<size_t> sub_tasks_count_{0};
 
   std::shared_ptr<costmodel::CostModel> cost_model;
 
@@ -1012,10 +1031,12 @@ class Executor : public StringDictionaryProxyProvider {
   static mapd_shared_mutex execute_mutex_;
 
   static std::unique_ptr<QueryPlanDagCache> query_plan_dag_cache_;
+  static std::unique_ptr<ResultSetRecycler> resultset_recycler_;
   static std::once_flag first_init_flag_;
   const QueryPlanHash INVALID_QUERY_PLAN_HASH{std::hash<std::string>{}(EMPTY_QUERY_PLAN)};
   static mapd_shared_mutex recycler_mutex_;
-  static std::unordered_map<std::string, size_t> cardinality_cache_;
+  static std::unique_ptr<CardinalityRecycler> cardinality_recycler_;
+  static std::shared_ptr<GroupByBufferPool> group_by_buffer_pool_;
 
  public:
   static const int32_t ERR_DIV_BY_ZERO{1};
@@ -1031,6 +1052,7 @@ class Executor : public StringDictionaryProxyProvider {
   static const int32_t ERR_STRING_CONST_IN_RESULTSET{13};
   static const int32_t ERR_SINGLE_VALUE_FOUND_MULTIPLE_VALUES{15};
   static const int32_t ERR_WIDTH_BUCKET_INVALID_ARGUMENT{16};
+  static const int32_t ERR_HLL_SKETCH_PRECISION{17};
 
   // Although compilation is Executor-local, an executor may trigger
   // threaded compilations (see executeWorkUnitPerFragment) that share
@@ -1046,6 +1068,9 @@ class Executor : public StringDictionaryProxyProvider {
   std::mutex compilation_mutex_;
   const logger::ThreadId thread_id_;
 
+  std::shared_ptr<Executor> speculative_executor_;
+  std::mutex speculative_executor_mutex_;
+
   // Runtime extension function registration updates
   // extension_modules_ that needs to be kept blocked from codegen
   // until the update is complete.
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ExecutionEngineWrapper.h"
+
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <vector>
+
+namespace {
+
+llvm::orc::JITTargetMachineBuilder makeTargetMachineBuilder(bool optimize) {
+  auto target_machine_builder_or_error = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!target_machine_builder_or_error) {
+    LOG(FATAL) << "Failed to initialize JITTargetMachineBuilder: "
+               << llvmErrorToString(target_machine_builder_or_error.takeError());
+  }
+  llvm::orc::JITTargetMachineBuilder target_machine_builder =
+      std::move(*target_machine_builder_or_error);
+  target_machine_builder.getOptions().EnableFastISel = true;
+  if (!optimize) {
+    target_machine_builder.setCodeGenOptLevel(llvm::CodeGenOpt::None);
+  }
+  return target_machine_builder;
+}
+
+// Collects functions which use the value directly or through constant expressions.
+void collect_user_functions(llvm::Value* value,
+                            std::unordered_set<llvm::Function*>& funcs) {
+  for (auto user : value->users()) {
+    if (auto inst = llvm::dyn_cast<llvm::Instruction>(user)) {
+      funcs.insert(inst->getFunction());
+    } else if (llvm::isa<llvm::ConstantExpr>(user)) {
+      collect_user_functions(user, funcs);
+    }
+  }
+}
+
+bool is_process_symbol(const llvm::GlobalValue& gv) {
+  auto func = llvm::dyn_cast<llvm::Function>(&gv);
+  if (func && func->isIntrinsic()) {
+    return true;
+  }
+  return llvm::sys::DynamicLibrary::SearchForAddressOfSymbol(gv.getName().str()) !=
+         nullptr;
+}
+
+// Drops definitions of runtime functions which cannot be linked without generated
+// code, e.g. query templates calling the row function placeholder, and of all
+// functions calling them. Kernels still clone such functions from the runtime
+// module. Returns names of functions the runtime module exports.
+std::unordered_set<std::string> prepare_runtime_module(llvm::Module& module) {
+  std::vector<llvm::GlobalValue*> unresolved;
+  for (auto& gv : module.global_values()) {
+    if (gv.isDeclaration() && !is_process_symbol(gv)) {
+      unresolved.push_back(&gv);
+    }
+  }
+  while (!unresolved.empty()) {
+    auto gv = unresolved.back();
+    unresolved.pop_back();
+    std::unordered_set<llvm::Function*> users;
+    collect_user_functions(gv, users);
+    for (auto func : users) {
+      if (!func->isDeclaration()) {
+        func->deleteBody();
+        if (!is_process_symbol(*func)) {
+          unresolved.push_back(func);
+        }
+      }
+    }
+  }
+
+  std::unordered_set<std::string> exported;
+  for (auto& func : module) {
+    if (!func.isDeclarationForLinker() && !func.hasLocalLinkage()) {
+      func.setVisibility(llvm::GlobalValue::DefaultVisibility);
+      exported.insert(func.getName().str());
+    }
+  }
+  return exported;
+}
+
+}  // namespace
+
+ORCJITSession& ORCJITSession::instance() {
+  // Never destroyed to let kernels cached in static containers be released
+  // at exit in any order.
+  static auto* session = new ORCJITSession();
+  return *session;
+}
+
+ORCJITSession::ORCJITSession() {
+  auto init_err = llvm::InitializeNativeTarget();
+  CHECK(!init_err);
+
+  llvm::InitializeNativeTargetAsmPrinter();
+  llvm::InitializeNativeTargetAsmParser();
+
+#if LLVM_VERSION_MAJOR > 12
+  auto self_epc = llvm::cantFail(llvm::orc::SelfExecutorProcessControl::Create());
+  execution_session_ = std::make_unique<llvm::orc::ExecutionSession>(std::move(self_epc));
+#else
+  execution_session_ = std::make_unique<llvm::orc::ExecutionSession>();
+#endif
+
+  auto data_layout_or_err =
+      makeTargetMachineBuilder(true).getDefaultDataLayoutForTarget();
+  if (!data_layout_or_err) {
+    LOG(FATAL) << "Failed to initialize data layout: "
+               << llvmErrorToString(data_layout_or_err.takeError());
+  }
+  data_layout_ = std::make_unique<llvm::DataLayout>(std::move(*data_layout_or_err));
+  mangle_ = std::make_unique<llvm::orc::MangleAndInterner>(*execution_session_,
+                                                           *data_layout_);
+  object_layer_ = std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(
+      *execution_session_,
+      []() { return std::make_unique<llvm::SectionMemoryManager>(); });
+#ifdef _WIN32
+  object_layer_->setOverrideObjectFlagsWithResponsibilityFlags(true);
+  object_layer_->setAutoClaimResponsibilityForObjectSymbols(true);
+#endif
+  compile_layer_ = std::make_unique<llvm::orc::IRCompileLayer>(
+      *execution_session_,
+      *object_layer_,
+      std::make_unique<llvm::orc::ConcurrentIRCompiler>(makeTargetMachineBuilder(true)));
+  no_opt_compile_layer_ = std::make_unique<llvm::orc::IRCompileLayer>(
+      *execution_session_,
+      *object_layer_,
+      std::make_unique<llvm::orc::ConcurrentIRCompiler>(makeTargetMachineBuilder(false)));
+
+  auto dylib_or_error = execution_session_->createJITDylib("<process>");
+  if (!dylib_or_error) {
+    LOG(FATAL) << "Failed to create process JITDylib: "
+               << llvmErrorToString(dylib_or_error.takeError());
+  }
+  process_dylib_ = &(*dylib_or_error);
+  process_dylib_->addGenerator(
+      llvm::cantFail(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          data_layout_->getGlobalPrefix())));
+}
+
+llvm::orc::JITDylib& ORCJITSession::createKernelDylib() {
+  auto name = "<kernel_" + std::to_string(next_dylib_id_++) + ">";
+  auto dylib_or_error = execution_session_->createJITDylib(name);
+  if (!dylib_or_error) {
+    LOG(FATAL) << "Failed to create kernel JITDylib: "
+               << llvmErrorToString(dylib_or_error.takeError());
+  }
+  if (runtime_dylib_ready_) {
+    dylib_or_error->addToLinkOrder(*runtime_dylib_);
+  }
+  dylib_or_error->addToLinkOrder(*process_dylib_);
+  return *dylib_or_error;
+}
+
+void ORCJITSession::removeKernelDylib(llvm::orc::JITDylib& dylib) {
+#if LLVM_VERSION_MAJOR > 12
+  auto err = execution_session_->removeJITDylib(dylib);
+#else
+  auto err = dylib.clear();
+#endif
+  if (err) {
+    LOG(ERROR) << "Failed to release kernel JITDylib: " << llvmErrorToString(err);
+    llvm::consumeError(std::move(err));
+  }
+}
+
+void ORCJITSession::initRuntimeDylib(const std::string& bc_path) {
+  std::call_once(runtime_dylib_flag_, [this, &bc_path]() {
+    auto buffer_or_error = llvm::MemoryBuffer::getFile(bc_path);
+    CHECK(!buffer_or_error.getError()) << "bc_path=" << bc_path;
+    llvm::orc::ThreadSafeContext context(std::make_unique<llvm::LLVMContext>());
+    auto module_or_error = llvm::parseBitcodeFile(
+        buffer_or_error.get()->getMemBufferRef(), *context.getContext());
+    if (!module_or_error) {
+      LOG(FATAL) << "Failed to load runtime module: "
+                 << llvmErrorToString(module_or_error.takeError());
+    }
+    auto module = std::move(*module_or_error);
+    runtime_functions_ = prepare_runtime_module(*module);
+    module->setDataLayout(*data_layout_);
+
+    auto dylib_or_error = execution_session_->createJITDylib("<runtime>");
+    if (!dylib_or_error) {
+      LOG(FATAL) << "Failed to create runtime JITDylib: "
+                 << llvmErrorToString(dylib_or_error.takeError());
+    }
+    runtime_dylib_ = &(*dylib_or_error);
+    runtime_dylib_->addToLinkOrder(*process_dylib_);
+    llvm::orc::ThreadSafeModule tsm(std::move(module), std::move(context));
+    auto err = compile_layer_->add(*runtime_dylib_, std::move(tsm));
+    if (err) {
+      LOG(FATAL) << "Cannot add runtime module: " << llvmErrorToString(err);
+    }
+    runtime_dylib_ready_ = true;
+  });
+}
+
+bool ORCJITSession::hasRuntimeFunction(llvm::StringRef name) const {
+  return runtime_dylib_ready_ && runtime_functions_.count(name.str());
+}
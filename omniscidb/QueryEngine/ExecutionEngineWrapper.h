@@ -34,6 +34,10 @@ struct CompilationOptions;
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
 inline std::string llvmErrorToString(const llvm::Error& err) {
   std::string msg;
   llvm::raw_string_ostream os(msg);
@@ -41,50 +45,79 @@ inline std::string llvmErrorToString(const llvm::Error& err) {
   return msg;
 };
 
-class ORCJITExecutionEngineWrapper {
+// Process-wide ORC JIT state shared by all CPU kernels. Creating an execution
+// session with compile layers and detecting the host CPU for each compiled
+// kernel takes a noticeable share of small queries latency, so it is done once.
+// Each kernel is added to its own JITDylib, so kernels can define the same
+// symbols and be released independently.
+//
+// The runtime module is compiled once into a runtime JITDylib linked to every
+// kernel dylib. Kernel modules get only runtime functions which have to be
+// inlined into generated code, calls to other runtime functions are resolved
+// against the runtime dylib. Symbols of the process are resolved through the
+// shared process dylib.
+class ORCJITSession {
  public:
-  ORCJITExecutionEngineWrapper(
-      std::unique_ptr<llvm::orc::ExecutionSession>&& execution_session,
-      llvm::orc::JITTargetMachineBuilder target_machine_builder,
-      std::unique_ptr<llvm::DataLayout> data_layout)
-      : execution_session_(std::move(execution_session))
-      , data_layout_(std::move(data_layout))
-      , mangle_(std::make_unique<llvm::orc::MangleAndInterner>(*this->execution_session_,
-                                                               *data_layout_))
-      , object_layer_(std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(
-            *execution_session_,
-            []() { return std::make_unique<llvm::SectionMemoryManager>(); }))
-      , compiler_layer_(std::make_unique<llvm::orc::IRCompileLayer>(
-            *execution_session_,
-            *object_layer_,
-            std::make_unique<llvm::orc::ConcurrentIRCompiler>(
-                std::move(target_machine_builder)))) {
-#ifdef _WIN32
-    object_layer_->setOverrideObjectFlagsWithResponsibilityFlags(true);
-    object_layer_->setAutoClaimResponsibilityForObjectSymbols(true);
-#endif
-    auto dylib_or_error = execution_session_->createJITDylib("<main>");
-    if (!dylib_or_error) {
-      LOG(FATAL) << "Failed to initialize JITTargetMachineBuilder: "
-                 << llvmErrorToString(dylib_or_error.takeError());
-    }
-    main_dylib_ = &(*dylib_or_error);
-    dylib_or_error->addGenerator(
-        llvm::cantFail(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
-            data_layout_->getGlobalPrefix())));
-  }
+  static ORCJITSession& instance();
 
-  ~ORCJITExecutionEngineWrapper() {
-    llvm::cantFail(execution_session_->endSession());
+  ORCJITSession(const ORCJITSession& other) = delete;
+  ORCJITSession& operator=(const ORCJITSession& other) = delete;
+
+  llvm::orc::ExecutionSession& executionSession() { return *execution_session_; }
+  const llvm::DataLayout& dataLayout() const { return *data_layout_; }
+  llvm::orc::SymbolStringPtr mangle(llvm::StringRef name) { return (*mangle_)(name); }
+
+  // Reduction JIT code is compiled with disabled codegen optimizations.
+  llvm::orc::IRCompileLayer& compileLayer(bool optimize) {
+    return optimize ? *compile_layer_ : *no_opt_compile_layer_;
   }
 
+  llvm::orc::JITDylib& createKernelDylib();
+  void removeKernelDylib(llvm::orc::JITDylib& dylib);
+
+  // Loads the runtime module from the bitcode file and adds it to the runtime
+  // dylib. The module is compiled on the first lookup of its symbol. Following
+  // calls do nothing.
+  void initRuntimeDylib(const std::string& bc_path);
+  // Returns true if kernels can call the runtime function without having its
+  // definition in the kernel module.
+  bool hasRuntimeFunction(llvm::StringRef name) const;
+
+ private:
+  ORCJITSession();
+
+  std::unique_ptr<llvm::orc::ExecutionSession> execution_session_;
+  std::unique_ptr<llvm::DataLayout> data_layout_;
+  std::unique_ptr<llvm::orc::MangleAndInterner> mangle_;
+  std::unique_ptr<llvm::orc::RTDyldObjectLinkingLayer> object_layer_;
+  std::unique_ptr<llvm::orc::IRCompileLayer> compile_layer_;
+  std::unique_ptr<llvm::orc::IRCompileLayer> no_opt_compile_layer_;
+  llvm::orc::JITDylib* process_dylib_;
+  llvm::orc::JITDylib* runtime_dylib_ = nullptr;
+  std::unordered_set<std::string> runtime_functions_;
+  std::once_flag runtime_dylib_flag_;
+  std::atomic<bool> runtime_dylib_ready_{false};
+  std::atomic<size_t> next_dylib_id_{0};
+};
+
+class ORCJITExecutionEngineWrapper {
+ public:
+  ORCJITExecutionEngineWrapper(ORCJITSession& session, bool optimize)
+      : session_(session)
+      , compile_layer_(session.compileLayer(optimize))
+      , dylib_(&session.createKernelDylib()) {}
+
+  ~ORCJITExecutionEngineWrapper() { session_.removeKernelDylib(*dylib_); }
+
   ORCJITExecutionEngineWrapper(const ORCJITExecutionEngineWrapper& other) = delete;
   ORCJITExecutionEngineWrapper(ORCJITExecutionEngineWrapper&& other) = delete;
 
-  void addModule(std::unique_ptr<llvm::Module> module) {
-    module->setDataLayout(*data_layout_);
-    llvm::orc::ThreadSafeModule tsm(std::move(module), getGlobalLLVMThreadSafeContext());
-    auto err = compiler_layer_->add(*main_dylib_, std::move(tsm));
+  void addModule(
+      std::unique_ptr<llvm::Module> module,
+      llvm::orc::ThreadSafeContext context = getGlobalLLVMThreadSafeContext()) {
+    module->setDataLayout(session_.dataLayout());
+    llvm::orc::ThreadSafeModule tsm(std::move(module), std::move(context));
+    auto err = compile_layer_.add(*dylib_, std::move(tsm));
     if (err) {
       LOG(FATAL) << "Cannot add LLVM module: " << llvmErrorToString(err);
     }
@@ -92,9 +125,8 @@ class ORCJITExecutionEngineWrapper {
 
   void* getPointerToFunction(llvm::Function* function) {
     CHECK(function);
-    CHECK(execution_session_);
-    auto symbol =
-        execution_session_->lookup({main_dylib_}, (*mangle_)(function->getName()));
+    auto& session = session_.executionSession();
+    auto symbol = session.lookup({dylib_}, session_.mangle(function->getName()));
     if (!symbol) {
       LOG(FATAL) << "Failed to find function " << std::string(function->getName())
                  << "\nError: " << llvmErrorToString(symbol.takeError());
@@ -102,9 +134,7 @@ class ORCJITExecutionEngineWrapper {
     return reinterpret_cast<void*>(symbol->getAddress());
   }
 
-  bool exists() const {
-    return !(execution_session_ == nullptr);
-  }
+  bool exists() const { return dylib_ != nullptr; }
 
   void removeModule(llvm::Module* module) {
     // Do nothing here. Module is deleted by ORC after materialization.
@@ -115,14 +145,9 @@ class ORCJITExecutionEngineWrapper {
   ORCJITExecutionEngineWrapper& operator=(ORCJITExecutionEngineWrapper&& other) = delete;
 
  private:
-  std::unique_ptr<llvm::orc::ExecutionSession> execution_session_;
-  std::unique_ptr<llvm::DataLayout> data_layout_;
-  std::unique_ptr<llvm::orc::MangleAndInterner> mangle_;
-  std::unique_ptr<llvm::orc::RTDyldObjectLinkingLayer> object_layer_;
-  std::unique_ptr<llvm::orc::IRCompileLayer> compiler_layer_;
-  std::unique_ptr<llvm::JITEventListener> intel_jit_listener_;
-
-  llvm::orc::JITDylib* main_dylib_;
+  ORCJITSession& session_;
+  llvm::orc::IRCompileLayer& compile_layer_;
+  llvm::orc::JITDylib* dylib_;
 };
 
 using ExecutionEngineWrapper = ORCJITExecutionEngineWrapper;
@@ -336,23 +336,31 @@ void ExecutionKernel::runImpl(Executor* executor,
       !need_to_hold_chunk(
           chunks, ra_exe_unit_, std::vector<ColumnLazyFetchInfo>(), chosen_device_type);
 
+  // Sub-tasks split rows of a single outer fragment.
+  can_run_subkernels = can_run_subkernels && fetch_result->num_rows.size() == 1;
+
   // TODO: check for literals? We serialize literals before execution and hold them in
   // result sets. Can we simply do it once and holdin an outer structure?
   if (can_run_subkernels) {
     size_t total_rows = fetch_result->num_rows[0][0];
-    size_t sub_size = executor->getConfig().exec.sub_tasks.sub_task_size;
+    size_t sub_size = shared_context.getSubTaskSize();
+    CHECK_GT(sub_size, size_t(0));
+    auto chunks_ptr =
+        std::make_shared<std::list<std::shared_ptr<Chunk_NS::Chunk>>>(std::move(chunks));
     for (size_t sub_start = start_rowid; sub_start < total_rows; sub_start += sub_size) {
       sub_size = (sub_start + sub_size > total_rows) ? total_rows - sub_start : sub_size;
       auto subtask = std::make_shared<KernelSubtask>(*this,
                                                      shared_context,
                                                      fetch_result,
                                                      chunk_iterators_ptr,
+                                                     chunks_ptr,
                                                      total_num_input_rows,
                                                      sub_start,
                                                      sub_size,
                                                      thread_idx);
       shared_context.getThreadPool()->run(
           [subtask, executor] { subtask->run(executor); });
+      ++executor->sub_tasks_count_;
     }
 
     return;
@@ -28,7 +28,7 @@
 class SharedKernelContext {
  public:
   SharedKernelContext(const std::vector<InputTableInfo>& query_infos)
-      : query_infos_(query_infos), task_group_(nullptr) {}
+      : query_infos_(query_infos), task_group_(nullptr), sub_task_size_(0) {}
 
   const std::vector<uint64_t>& getFragOffsets();
 
@@ -44,6 +44,8 @@ class SharedKernelContext {
 
   auto getThreadPool() { return task_group_; }
   void setThreadPool(tbb::task_group* tg) { task_group_ = tg; }
+  size_t getSubTaskSize() const { return sub_task_size_; }
+  void setSubTaskSize(size_t size) { sub_task_size_ = size; }
   auto& getTlsExecutionContext() { return tls_execution_context_; }
 
  private:
@@ -55,6 +57,7 @@ class SharedKernelContext {
   std::vector<InputTableInfo> query_infos_;
 
   tbb::task_group* task_group_;
+  size_t sub_task_size_;
   tbb::enumerable_thread_specific<std::unique_ptr<QueryExecutionContext>>
       tls_execution_context_;
 };
@@ -90,6 +93,8 @@ class ExecutionKernel {
 
   const RelAlgExecutionUnit& ra_exe_unit_;
 
+  const FragmentsList& getFragmentsList() const { return frag_list; }
+
   std::string toString() const;
 
  private:
@@ -119,6 +124,7 @@ class KernelSubtask {
                 SharedKernelContext& shared_context,
                 std::shared_ptr<FetchResult> fetch_result,
                 std::shared_ptr<std::list<ChunkIter>> chunk_iterators,
+                std::shared_ptr<std::list<std::shared_ptr<Chunk_NS::Chunk>>> chunks,
                 int64_t total_num_input_rows,
                 size_t start_rowid,
                 size_t num_rows_to_process,
@@ -127,6 +133,7 @@ class KernelSubtask {
       , shared_context_(shared_context)
       , fetch_result_(fetch_result)
       , chunk_iterators_(chunk_iterators)
+      , chunks_(chunks)
       , total_num_input_rows_(total_num_input_rows)
       , start_rowid_(start_rowid)
       , num_rows_to_process_(num_rows_to_process)
@@ -141,6 +148,8 @@ class KernelSubtask {
   SharedKernelContext& shared_context_;
   std::shared_ptr<FetchResult> fetch_result_;
   std::shared_ptr<std::list<ChunkIter>> chunk_iterators_;
+  // Keeps fetched chunks pinned until all sub-tasks of the kernel are finished.
+  std::shared_ptr<std::list<std::shared_ptr<Chunk_NS::Chunk>>> chunks_;
   int64_t total_num_input_rows_;
   size_t start_rowid_;
   size_t num_rows_to_process_;
@@ -18,6 +18,7 @@
 #include "Execute.h"
 #include "ExternalExecutor.h"
 #include "IR/ExprCollector.h"
+#include "JoinHashTable/RangeJoinHashTable.h"
 #include "MaxwellCodegenPatch.h"
 #include "RelAlgTranslator.h"
 
@@ -854,6 +855,28 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
       handleNonHashtableQual(current_level_join_conditions.type, qual_bin_oper);
     }
   }
+  if (!current_level_hash_table && co.device_type == ExecutorDeviceType::CPU &&
+      config_->exec.join.enable_range_join &&
+      (current_level_join_conditions.type == JoinType::INNER ||
+       current_level_join_conditions.type == JoinType::LEFT)) {
+    // All join conditions are already evaluated as non-hashtable quals, a range join
+    // table only narrows down inner rows to check for each outer row.
+    try {
+      auto range_join_table =
+          RangeJoinHashTable::getInstance(current_level_join_conditions.quals,
+                                          query_infos,
+                                          current_level_join_conditions.type,
+                                          data_provider,
+                                          column_cache,
+                                          this);
+      plan_state_->join_info_.join_hash_tables_.push_back(range_join_table);
+      plan_state_->join_info_.equi_join_tautologies_.push_back(
+          range_join_table->getRangeQual());
+      current_level_hash_table = range_join_table;
+    } catch (const HashJoinFail& e) {
+      fail_reasons.emplace_back(e.what());
+    }
+  }
   return current_level_hash_table;
 }
 
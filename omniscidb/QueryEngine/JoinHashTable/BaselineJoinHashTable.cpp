@@ -771,6 +771,8 @@ llvm::Value* BaselineJoinHashTable::codegenSlot(const CompilationOptions& co,
                                key_buff_lv->getType()->getPointerAddressSpace()));
   const auto key_size_lv = LL_INT(getKeyComponentCount() * key_component_width);
   const auto hash_table = getHashTableForDevice(size_t(0));
+  codegenProbePrefetch(
+      hash_ptr, (getKeyComponentCount() + 1) * key_component_width, co);
   return executor_->cgen_state_->emitExternalCall(
       "baseline_hash_join_idx_" + std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
@@ -789,6 +791,9 @@ HashJoinMatchingSet BaselineJoinHashTable::codegenMatchingSet(
   CHECK(getHashType() == HashType::OneToMany);
   compiler::CodegenTraits cgen_traits =
       compiler::CodegenTraits::get(co.codegen_traits_desc);
+  codegenProbePrefetch(hashPtr(index, cgen_traits.getLocalAddrSpace()),
+                       getKeyComponentCount() * key_component_width,
+                       co);
   auto hash_ptr = HashJoin::codegenHashTableLoad(index, executor_);
   const auto composite_dict_ptr_type = llvm::Type::getIntNPtrTy(
       LL_CONTEXT, key_component_width * 8, cgen_traits.getLocalAddrSpace());
@@ -930,6 +935,55 @@ llvm::Value* BaselineJoinHashTable::hashPtr(const size_t index,
              : LL_BUILDER.CreateIntToPtr(hash_ptr, pi8_type);
 }
 
+// Issues a software prefetch of the hash table entry for the composite key of
+// an outer row a few rows ahead of the current one. Only keys which consist of
+// outer table columns can be computed ahead of time.
+void BaselineJoinHashTable::codegenProbePrefetch(llvm::Value* hash_ptr,
+                                                 const size_t entry_bytes,
+                                                 const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  const auto hash_table = getHashTableForDevice(size_t(0));
+  CHECK(hash_table);
+  const auto prefetch_pos = HashJoin::codegenPrefetchPos(
+      hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU), executor_, co);
+  if (!prefetch_pos) {
+    return;
+  }
+  CodeGenerator code_generator(executor_, co.codegen_traits_desc);
+  const auto key_component_width = getKeyComponentWidth();
+  std::vector<llvm::Value*> key_lvs;
+  for (const auto& inner_outer_pair : inner_outer_pairs_) {
+    const auto outer_col_var =
+        dynamic_cast<const hdk::ir::ColumnVar*>(inner_outer_pair.second);
+    if (!outer_col_var) {
+      return;
+    }
+    const auto key_lv =
+        code_generator.codegenLookaheadColVar(outer_col_var, prefetch_pos, co);
+    if (!key_lv) {
+      return;
+    }
+    key_lvs.push_back(
+        LL_BUILDER.CreateSExt(key_lv, get_int_type(key_component_width * 8, LL_CONTEXT)));
+  }
+  const auto key_buff_lv = LL_BUILDER.CreateAlloca(
+      get_int_type(key_component_width * 8, LL_CONTEXT), LL_INT(key_lvs.size()));
+  for (size_t i = 0; i < key_lvs.size(); ++i) {
+    const auto key_comp_dest_lv = LL_BUILDER.CreateGEP(
+        key_buff_lv->getType()->getScalarType()->getPointerElementType(),
+        key_buff_lv,
+        LL_INT(i));
+    LL_BUILDER.CreateStore(key_lvs[i], key_comp_dest_lv);
+  }
+  executor_->cgen_state_->emitCall(
+      "baseline_hash_join_prefetch",
+      {hash_ptr,
+       LL_BUILDER.CreatePointerCast(key_buff_lv, llvm::Type::getInt8PtrTy(LL_CONTEXT)),
+       LL_INT(key_lvs.size() * key_component_width),
+       LL_INT(entry_bytes),
+       LL_INT(hash_table->getEntryCount())});
+}
+
 #undef ROW_FUNC
 #undef LL_INT
 #undef LL_BUILDER
@@ -189,6 +189,10 @@ class BaselineJoinHashTable : public HashJoin {
 
   llvm::Value* hashPtr(const size_t index, const unsigned addr_space);
 
+  void codegenProbePrefetch(llvm::Value* hash_ptr,
+                            const size_t entry_bytes,
+                            const CompilationOptions& co);
+
   std::shared_ptr<HashTable> initHashTableOnCpuFromCache(
       QueryPlanHash key,
       CacheItemType item_type,
@@ -25,6 +25,8 @@
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RuntimeFunctions.h"
 
+#include <unistd.h>
+
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif
@@ -225,6 +227,56 @@ llvm::Value* HashJoin::codegenHashTableLoad(const size_t table_idx, Executor* ex
   return hash_ptr;
 }
 
+namespace {
+
+size_t get_last_level_cache_size() {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  static const long llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (llc_size > 0) {
+    return static_cast<size_t>(llc_size);
+  }
+#endif
+  return size_t(32) << 20;
+}
+
+}  // namespace
+
+llvm::Value* HashJoin::codegenPrefetchPos(const size_t hash_table_size,
+                                          Executor* executor,
+                                          const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor->cgen_state_.get());
+  const auto& join_config = executor->getConfig().exec.join;
+  auto cgen_state = executor->cgen_state_.get();
+  if (co.device_type != ExecutorDeviceType::CPU || !join_config.enable_probe_prefetch ||
+      !join_config.probe_prefetch_distance ||
+      cgen_state->current_func_ != cgen_state->row_func_) {
+    return nullptr;
+  }
+  // Prefetching only pays off when hash table accesses are likely to miss
+  // the last level cache.
+  const auto threshold = join_config.probe_prefetch_threshold
+                             ? join_config.probe_prefetch_threshold
+                             : get_last_level_cache_size();
+  if (hash_table_size < threshold) {
+    return nullptr;
+  }
+  auto pos_arg = get_arg_by_name(cgen_state->row_func_, "pos");
+  auto num_rows_arg = get_arg_by_name(cgen_state->row_func_, "num_rows_per_scan");
+  const auto outer_rows_lv = cgen_state->ir_builder_.CreateLoad(
+      num_rows_arg->getType()->getScalarType()->getPointerElementType(),
+      num_rows_arg,
+      "outer_num_rows");
+  const auto distance = static_cast<int64_t>(join_config.probe_prefetch_distance);
+  const auto next_pos_lv =
+      cgen_state->ir_builder_.CreateAdd(pos_arg, cgen_state->llInt(distance));
+  // Stay within the current fragment; the last rows simply prefetch their own
+  // entries again.
+  return cgen_state->ir_builder_.CreateSelect(
+      cgen_state->ir_builder_.CreateICmpSLT(next_pos_lv, outer_rows_lv),
+      next_pos_lv,
+      pos_arg);
+}
+
 //! Make hash table from an in-flight SQL query's parse tree etc.
 std::shared_ptr<HashJoin> HashJoin::getInstance(
     const std::shared_ptr<const hdk::ir::BinOper> qual_bin_oper,
@@ -123,7 +123,7 @@ class HashJoin {
   }
 
   static std::string getHashTypeString(HashType ht) noexcept {
-    const char* HashTypeStrings[3] = {"OneToOne", "OneToMany", "ManyToMany"};
+    const char* HashTypeStrings[4] = {"OneToOne", "OneToMany", "ManyToMany", "Range"};
     return HashTypeStrings[static_cast<int>(ht)];
   };
 
@@ -138,6 +138,13 @@ class HashJoin {
 
   static llvm::Value* codegenHashTableLoad(const size_t table_idx, Executor* executor);
 
+  // Generates the position of an outer table row a few rows ahead of the
+  // current one to prefetch hash table entries for. Returns nullptr if probe
+  // prefetching is disabled or not beneficial for the given hash table size.
+  static llvm::Value* codegenPrefetchPos(const size_t hash_table_size,
+                                         Executor* executor,
+                                         const CompilationOptions& co);
+
   virtual Data_Namespace::MemoryLevel getMemoryLevel() const noexcept = 0;
 
   virtual int getDeviceCount() const noexcept = 0;
@@ -820,6 +820,39 @@ std::vector<llvm::Value*> PerfectJoinHashTable::getHashJoinArgs(
   return hash_join_idx_args;
 }
 
+// Issues a software prefetch of the hash table entry for the key of an outer
+// row a few rows ahead of the current one, so the random access to a large
+// hash table overlaps with probing of the following rows.
+void PerfectJoinHashTable::codegenProbePrefetch(llvm::Value* hash_ptr,
+                                                const hdk::ir::Expr* key_col,
+                                                const int64_t count_buff_off,
+                                                const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  const auto key_col_var = dynamic_cast<const hdk::ir::ColumnVar*>(key_col);
+  if (!key_col_var || isBitwiseEq() || key_col->type()->isDate()) {
+    return;
+  }
+  const auto prefetch_pos = HashJoin::codegenPrefetchPos(
+      getJoinHashBufferSize(ExecutorDeviceType::CPU, 0), executor_, co);
+  if (!prefetch_pos) {
+    return;
+  }
+  CodeGenerator code_generator(executor_, co.codegen_traits_desc);
+  const auto key_lv =
+      code_generator.codegenLookaheadColVar(key_col_var, prefetch_pos, co);
+  if (!key_lv) {
+    return;
+  }
+  // Null keys are out of the [min, max] range and skipped by the runtime.
+  executor_->cgen_state_->emitCall(
+      "hash_join_prefetch",
+      {hash_ptr,
+       executor_->cgen_state_->castToTypeIn(key_lv, 64),
+       executor_->cgen_state_->llInt(col_range_.getIntMin()),
+       executor_->cgen_state_->llInt(col_range_.getIntMax()),
+       executor_->cgen_state_->llInt(count_buff_off)});
+}
+
 HashJoinMatchingSet PerfectJoinHashTable::codegenMatchingSet(const CompilationOptions& co,
                                                              const size_t index) {
   AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
@@ -849,6 +882,7 @@ HashJoinMatchingSet PerfectJoinHashTable::codegenMatchingSet(const CompilationOp
   auto hash_join_idx_args = getHashJoinArgs(pos_ptr, key_col, co);
   const int64_t sub_buff_size = getComponentBufferSize();
   auto key_col_type = key_col->type();
+  codegenProbePrefetch(pos_ptr, key_col, sub_buff_size, co);
 
   auto bucketize = key_col_type->isDate();
   return HashJoin::codegenMatchingSet(hash_join_idx_args,
@@ -1019,6 +1053,7 @@ llvm::Value* PerfectJoinHashTable::codegenSlot(const CompilationOptions& co,
   auto hash_ptr = codegenHashTableLoad(index);
   CHECK(hash_ptr);
   const auto hash_join_idx_args = getHashJoinArgs(hash_ptr, key_col, co);
+  codegenProbePrefetch(hash_ptr, key_col, 0, co);
 
   std::string fname(key_col_type->isDate() ? "bucketized_hash_join_idx"s
                                            : "hash_join_idx"s);
@@ -214,6 +214,11 @@ class PerfectJoinHashTable : public HashJoin {
                                             const hdk::ir::Expr* key_col,
                                             const CompilationOptions& co);
 
+  void codegenProbePrefetch(llvm::Value* hash_ptr,
+                            const hdk::ir::Expr* key_col,
+                            const int64_t count_buff_off,
+                            const CompilationOptions& co);
+
   bool isBitwiseEq() const override;
 
   size_t getComponentBufferSize() const noexcept override;
@@ -0,0 +1,74 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/JoinHashTable/HashTable.h"
+
+/**
+ * Sorted index used for range joins. The buffer starts with a header holding the
+ * entry count and the minimal and maximal difference between the companion and
+ * the key columns (see RangeJoinHashTable). The header is followed by entry_count
+ * sorted 64-bit keys and entry_count 32-bit row ids of the inner table, so that
+ * rows matching a range of keys form a contiguous interval of the row id array.
+ */
+class RangeHashTable : public HashTable {
+ public:
+  enum HeaderSlot { kEntryCount = 0, kMinDiff, kMaxDiff, kHeaderSize };
+
+  RangeHashTable(const size_t entry_count, const int64_t min_diff, const int64_t max_diff)
+      : entry_count_(entry_count)
+      , buff_size_(rowIdsBufferOff(entry_count) + entry_count * sizeof(int32_t)) {
+    cpu_buff_.reset(new int8_t[buff_size_]);
+    auto header = reinterpret_cast<int64_t*>(cpu_buff_.get());
+    header[kEntryCount] = static_cast<int64_t>(entry_count);
+    header[kMinDiff] = min_diff;
+    header[kMaxDiff] = max_diff;
+  }
+
+  size_t getHashTableBufferSize(const ExecutorDeviceType device_type) const override {
+    CHECK(device_type == ExecutorDeviceType::CPU);
+    return buff_size_;
+  }
+
+  HashType getLayout() const override { return HashType::Range; }
+
+  int8_t* getCpuBuffer() override { return cpu_buff_.get(); }
+
+  int8_t* getGpuBuffer() const override { return nullptr; }
+
+  size_t getEntryCount() const override { return entry_count_; }
+
+  size_t getEmittedKeysCount() const override { return entry_count_; }
+
+  int64_t* getKeys() const {
+    return reinterpret_cast<int64_t*>(cpu_buff_.get()) + kHeaderSize;
+  }
+
+  int32_t* getRowIds() const {
+    return reinterpret_cast<int32_t*>(cpu_buff_.get() + rowIdsBufferOff(entry_count_));
+  }
+
+  static size_t rowIdsBufferOff(const size_t entry_count) {
+    return (kHeaderSize + entry_count) * sizeof(int64_t);
+  }
+
+ private:
+  size_t entry_count_;
+  size_t buff_size_;
+  std::unique_ptr<int8_t[]> cpu_buff_;
+};
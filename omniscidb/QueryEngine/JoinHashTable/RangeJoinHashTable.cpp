@@ -0,0 +1,450 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/RangeJoinHashTable.h"
+
+#include <tbb/parallel_sort.h>
+
+#include <chrono>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinColumnIterator.h"
+#include "QueryEngine/RangeTableIndexVisitor.h"
+#include "QueryEngine/RuntimeFunctions.h"
+
+namespace {
+
+// Join condition normalized to the form `inner_col op outer_expr`.
+struct RangeQual {
+  std::shared_ptr<const hdk::ir::BinOper> qual;
+  const hdk::ir::ColumnVar* inner_col;
+  const hdk::ir::Expr* outer_expr;
+  bool is_lower;
+};
+
+bool is_range_join_type(const hdk::ir::Type* type) {
+  return (type->isInteger() || type->isDecimal() || type->isDateTime()) &&
+         get_join_column_type_kind(type) == Signed;
+}
+
+bool same_type(const hdk::ir::Type* lhs, const hdk::ir::Type* rhs) {
+  return lhs->withNullable(false)->equal(rhs->withNullable(false));
+}
+
+std::optional<RangeQual> normalize_range_qual(const hdk::ir::ExprPtr& qual,
+                                              const int inner_rte_idx) {
+  auto bin_oper = std::dynamic_pointer_cast<const hdk::ir::BinOper>(qual);
+  if (!bin_oper || bin_oper->qualifier() != hdk::ir::Qualifier::kOne) {
+    return std::nullopt;
+  }
+  auto op_type = bin_oper->opType();
+  if (!bin_oper->isLt() && !bin_oper->isLe() && !bin_oper->isGt() && !bin_oper->isGe()) {
+    return std::nullopt;
+  }
+  auto inner_col = dynamic_cast<const hdk::ir::ColumnVar*>(bin_oper->leftOperand());
+  auto outer_expr = bin_oper->rightOperand();
+  if (!inner_col || inner_col->rteIdx() != inner_rte_idx) {
+    inner_col = dynamic_cast<const hdk::ir::ColumnVar*>(bin_oper->rightOperand());
+    outer_expr = bin_oper->leftOperand();
+    op_type = hdk::ir::commuteComparison(op_type);
+  }
+  if (!inner_col || inner_col->rteIdx() != inner_rte_idx || inner_col->isVirtual()) {
+    return std::nullopt;
+  }
+  if (MaxRangeTableIndexCollector::collect(outer_expr) >= inner_rte_idx) {
+    return std::nullopt;
+  }
+  if (!is_range_join_type(inner_col->type()) ||
+      !same_type(inner_col->type(), outer_expr->type())) {
+    return std::nullopt;
+  }
+  const bool is_lower =
+      op_type == hdk::ir::OpType::kGt || op_type == hdk::ir::OpType::kGe;
+  return RangeQual{bin_oper, inner_col, outer_expr, is_lower};
+}
+
+std::vector<int64_t> decode_join_column(const JoinColumn& join_column,
+                                        const hdk::ir::Type* type) {
+  JoinColumnTypeInfo type_info{static_cast<size_t>(type->size()),
+                               0,
+                               0,
+                               inline_fixed_encoding_null_value(type),
+                               false,
+                               0,
+                               get_join_column_type_kind(type)};
+  std::vector<int64_t> values(join_column.num_elems);
+  JoinColumnTyped col{&join_column, &type_info};
+  for (auto item : col.slice(0, 1)) {
+    values[item.index] = item.element;
+  }
+  return values;
+}
+
+}  // namespace
+
+std::shared_ptr<RangeJoinHashTable> RangeJoinHashTable::getInstance(
+    const std::list<hdk::ir::ExprPtr>& quals,
+    const std::vector<InputTableInfo>& query_infos,
+    const JoinType join_type,
+    DataProvider* data_provider,
+    ColumnCacheMap& column_cache,
+    Executor* executor) {
+  int inner_rte_idx = 0;
+  for (const auto& qual : quals) {
+    inner_rte_idx =
+        std::max(inner_rte_idx, MaxRangeTableIndexCollector::collect(qual.get()));
+  }
+  std::vector<RangeQual> range_quals;
+  for (const auto& qual : quals) {
+    if (auto range_qual = normalize_range_qual(qual, inner_rte_idx)) {
+      range_quals.push_back(*range_qual);
+    }
+  }
+  if (!inner_rte_idx || range_quals.empty()) {
+    throw HashJoinFail("No range join expression found");
+  }
+
+  auto to_bound = [](const RangeQual* range_qual) -> std::optional<RangeBound> {
+    if (!range_qual) {
+      return std::nullopt;
+    }
+    return RangeBound{range_qual->qual, range_qual->inner_col, range_qual->outer_expr};
+  };
+  auto find_bound = [&range_quals](const hdk::ir::ColumnVar* col,
+                                   const bool is_lower) -> const RangeQual* {
+    for (const auto& range_qual : range_quals) {
+      if (range_qual.is_lower == is_lower &&
+          range_qual.inner_col->columnId() == col->columnId()) {
+        return &range_qual;
+      }
+    }
+    return nullptr;
+  };
+
+  // Prefer a column bounded from both sides (band join), then a pair of columns
+  // bounded from different sides (interval join) and then a single bound.
+  const hdk::ir::ColumnVar* key_col = nullptr;
+  const RangeQual* lower = nullptr;
+  const RangeQual* upper = nullptr;
+  for (const auto& range_qual : range_quals) {
+    lower = find_bound(range_qual.inner_col, true);
+    upper = find_bound(range_qual.inner_col, false);
+    if (lower && upper) {
+      key_col = range_qual.inner_col;
+      break;
+    }
+  }
+  if (!key_col) {
+    lower = nullptr;
+    upper = nullptr;
+    for (const auto& upper_qual : range_quals) {
+      if (upper_qual.is_lower) {
+        continue;
+      }
+      for (const auto& lower_qual : range_quals) {
+        if (lower_qual.is_lower &&
+            lower_qual.inner_col->columnId() != upper_qual.inner_col->columnId() &&
+            same_type(lower_qual.inner_col->type(), upper_qual.inner_col->type())) {
+          key_col = upper_qual.inner_col;
+          lower = &lower_qual;
+          upper = &upper_qual;
+          break;
+        }
+      }
+      if (key_col) {
+        break;
+      }
+    }
+  }
+  if (!key_col) {
+    const auto& range_qual = range_quals.front();
+    key_col = range_qual.inner_col;
+    lower = range_qual.is_lower ? &range_qual : nullptr;
+    upper = range_qual.is_lower ? nullptr : &range_qual;
+  }
+
+  decltype(std::chrono::steady_clock::now()) ts1, ts2;
+  if (VLOGGING(1)) {
+    ts1 = std::chrono::steady_clock::now();
+  }
+  auto join_hash_table =
+      std::shared_ptr<RangeJoinHashTable>(new RangeJoinHashTable(key_col,
+                                                                 to_bound(lower),
+                                                                 to_bound(upper),
+                                                                 query_infos,
+                                                                 data_provider,
+                                                                 column_cache,
+                                                                 executor));
+  try {
+    join_hash_table->reify();
+  } catch (const HashJoinFail& e) {
+    join_hash_table->freeHashBufferMemory();
+    throw HashJoinFail(std::string("Could not build a range join table | ") + e.what());
+  } catch (const ColumnarConversionNotSupported& e) {
+    throw HashJoinFail(std::string("Could not build a range join table | ") + e.what());
+  } catch (const OutOfMemory& e) {
+    throw HashJoinFail(
+        std::string("Ran out of memory while building a range join table | ") +
+        e.what());
+  } catch (const std::exception& e) {
+    throw std::runtime_error(
+        std::string("Fatal error while attempting to build a range join table: ") +
+        e.what());
+  }
+  if (VLOGGING(1)) {
+    ts2 = std::chrono::steady_clock::now();
+    VLOG(1) << "Built range join table for "
+            << join_hash_table->getRangeQual()->toString() << " in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count()
+            << " ms";
+  }
+  return join_hash_table;
+}
+
+void RangeJoinHashTable::reify() {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& query_info =
+      get_inner_query_info(getInnerDbId(), getInnerTableId(), query_infos_).info;
+  if (query_info.getNumTuplesUpperBound() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw HashJoinFail("Range join tables with more than 2B entries not supported yet");
+  }
+
+  std::vector<int64_t> keys;
+  std::vector<int64_t> companions;
+  if (!query_info.fragments.empty()) {
+    std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+    std::vector<std::shared_ptr<void>> malloc_owner;
+    auto fetch_column = [&](const hdk::ir::ColumnVar* col) {
+      auto join_column = fetchJoinColumn(col,
+                                         query_info.fragments,
+                                         Data_Namespace::CPU_LEVEL,
+                                         0,
+                                         chunks_owner,
+                                         nullptr,
+                                         malloc_owner,
+                                         executor_,
+                                         &column_cache_);
+      return decode_join_column(join_column, col->type());
+    };
+    keys = fetch_column(key_col_.get());
+    if (auto companion_col = getCompanionCol()) {
+      companions = fetch_column(companion_col);
+      CHECK_EQ(keys.size(), companions.size());
+    }
+  }
+
+  // Rows with null keys never match and are not included into the table.
+  const auto key_null = inline_fixed_encoding_null_value(key_col_->type());
+  const auto companion_col = getCompanionCol();
+  const auto companion_null =
+      companion_col ? inline_fixed_encoding_null_value(companion_col->type()) : 0;
+  std::vector<std::pair<int64_t, int32_t>> entries;
+  entries.reserve(keys.size());
+  int64_t min_diff = std::numeric_limits<int64_t>::max();
+  int64_t max_diff = std::numeric_limits<int64_t>::min();
+  for (size_t row_id = 0; row_id < keys.size(); ++row_id) {
+    if (keys[row_id] == key_null) {
+      continue;
+    }
+    if (!companions.empty()) {
+      if (companions[row_id] == companion_null) {
+        continue;
+      }
+      int64_t diff;
+      if (__builtin_sub_overflow(companions[row_id], keys[row_id], &diff)) {
+        throw HashJoinFail("Overflow in the range join columns difference");
+      }
+      min_diff = std::min(min_diff, diff);
+      max_diff = std::max(max_diff, diff);
+    }
+    entries.emplace_back(keys[row_id], static_cast<int32_t>(row_id));
+  }
+  if (entries.empty() || companions.empty()) {
+    min_diff = 0;
+    max_diff = 0;
+  }
+  tbb::parallel_sort(entries.begin(), entries.end());
+
+  auto hash_table = std::make_shared<RangeHashTable>(entries.size(), min_diff, max_diff);
+  auto keys_buff = hash_table->getKeys();
+  auto row_ids_buff = hash_table->getRowIds();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    keys_buff[i] = entries[i].first;
+    row_ids_buff[i] = entries[i].second;
+  }
+  hash_tables_for_device_[0] = hash_table;
+}
+
+const hdk::ir::ColumnVar* RangeJoinHashTable::getCompanionCol() const {
+  for (const auto& bound : {lower_, upper_}) {
+    if (bound && bound->inner_col->columnId() != key_col_->columnId()) {
+      return bound->inner_col;
+    }
+  }
+  return nullptr;
+}
+
+RangeHashTable* RangeJoinHashTable::getRangeHashTable() const {
+  CHECK_EQ(hash_tables_for_device_.size(), size_t(1));
+  auto hash_table = dynamic_cast<RangeHashTable*>(hash_tables_for_device_[0].get());
+  CHECK(hash_table);
+  return hash_table;
+}
+
+llvm::Value* RangeJoinHashTable::codegenSlot(const CompilationOptions&, const size_t) {
+  UNREACHABLE() << "Range join tables are always probed for a set of rows";
+  return nullptr;
+}
+
+HashJoinMatchingSet RangeJoinHashTable::codegenMatchingSet(const CompilationOptions& co,
+                                                           const size_t index) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  auto cgen_state = executor_->cgen_state_.get();
+  auto& builder = cgen_state->ir_builder_;
+  auto i32_type = llvm::Type::getInt32Ty(cgen_state->context_);
+  auto i64_type = llvm::Type::getInt64Ty(cgen_state->context_);
+
+  auto hash_ptr = HashJoin::codegenHashTableLoad(index, executor_);
+  if (!hash_ptr->getType()->isIntegerTy(64)) {
+    CHECK(hash_ptr->getType()->isPointerTy());
+    hash_ptr = builder.CreatePtrToInt(hash_ptr, i64_type);
+  }
+  // The entry count and the companion column differences are read from the table
+  // header, so the generated code doesn't depend on the inner table contents.
+  auto header_ptr =
+      builder.CreateIntToPtr(hash_ptr, llvm::Type::getInt64PtrTy(cgen_state->context_));
+  auto load_header_slot = [&](const RangeHashTable::HeaderSlot slot) {
+    auto slot_ptr =
+        builder.CreateGEP(i64_type, header_ptr, cgen_state->llInt(int64_t(slot)));
+    return builder.CreateLoad(i64_type, slot_ptr);
+  };
+  auto entry_count = load_header_slot(RangeHashTable::kEntryCount);
+  auto keys_ptr = builder.CreateGEP(
+      i64_type, header_ptr, cgen_state->llInt(int64_t(RangeHashTable::kHeaderSize)));
+
+  // A lower bound on the companion column C gives the lower bound on the key K as
+  // C - K <= max_diff. The same way an upper bound is shifted by min_diff.
+  const auto companion_col = getCompanionCol();
+  auto bound_delta = [&](const RangeBound& bound, const bool is_lower) -> llvm::Value* {
+    if (bound.inner_col != companion_col) {
+      return cgen_state->llInt(int64_t(0));
+    }
+    return load_header_slot(is_lower ? RangeHashTable::kMaxDiff
+                                     : RangeHashTable::kMinDiff);
+  };
+  auto begin = lower_ ? codegenBound(*lower_,
+                                     true,
+                                     keys_ptr,
+                                     entry_count,
+                                     bound_delta(*lower_, true),
+                                     co)
+                      : cgen_state->llInt(int64_t(0));
+  auto end = upper_ ? codegenBound(*upper_,
+                                   false,
+                                   keys_ptr,
+                                   entry_count,
+                                   bound_delta(*upper_, false),
+                                   co)
+                    : entry_count;
+  auto count = builder.CreateSelect(builder.CreateICmpSGT(end, begin),
+                                    builder.CreateSub(end, begin),
+                                    cgen_state->llInt(int64_t(0)));
+  auto row_ids_ptr =
+      builder.CreateBitCast(builder.CreateGEP(i64_type, keys_ptr, entry_count),
+                            llvm::Type::getInt32PtrTy(cgen_state->context_));
+  auto elements = builder.CreateGEP(i32_type, row_ids_ptr, begin);
+  return {elements, count, begin};
+}
+
+llvm::Value* RangeJoinHashTable::codegenBound(const RangeBound& bound,
+                                              const bool is_lower,
+                                              llvm::Value* keys_ptr,
+                                              llvm::Value* entry_count,
+                                              llvm::Value* delta,
+                                              const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  auto cgen_state = executor_->cgen_state_.get();
+  CodeGenerator code_generator(executor_, co.codegen_traits_desc);
+  const auto value_lvs = code_generator.codegen(bound.outer_expr, true, co);
+  CHECK_EQ(size_t(1), value_lvs.size());
+  auto value_lv = cgen_state->castToTypeIn(value_lvs.front(), 64);
+
+  // Bounds derived from the companion column are not exact, so only bounds on the
+  // key column itself can exclude keys equal to the bound.
+  const bool is_strict = bound.inner_col->columnId() == key_col_->columnId() &&
+                         (bound.qual->isLt() || bound.qual->isGt());
+  const auto fname =
+      is_lower == is_strict ? "range_join_upper_bound" : "range_join_lower_bound";
+  llvm::Value* idx_lv =
+      cgen_state->emitCall(fname, {keys_ptr, entry_count, value_lv, delta});
+
+  auto outer_type = bound.outer_expr->type();
+  if (outer_type->nullable()) {
+    auto is_null = cgen_state->ir_builder_.CreateICmpEQ(
+        value_lv,
+        cgen_state->llInt(inline_fixed_encoding_null_value(outer_type->canonicalize())));
+    idx_lv = cgen_state->ir_builder_.CreateSelect(
+        is_null, is_lower ? entry_count : cgen_state->llInt(int64_t(0)), idx_lv);
+  }
+  return idx_lv;
+}
+
+size_t RangeJoinHashTable::payloadBufferOff() const noexcept {
+  auto hash_table = hash_tables_for_device_.front();
+  return RangeHashTable::rowIdsBufferOff(hash_table ? hash_table->getEntryCount() : 0);
+}
+
+std::string RangeJoinHashTable::toString(const ExecutorDeviceType device_type,
+                                         const int device_id,
+                                         bool raw) const {
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  CHECK_EQ(device_id, 0);
+  auto hash_table = getRangeHashTable();
+  std::ostringstream oss;
+  oss << "| range | keys";
+  for (size_t i = 0; i < hash_table->getEntryCount(); ++i) {
+    oss << " " << hash_table->getKeys()[i];
+  }
+  oss << " | payloads";
+  for (size_t i = 0; i < hash_table->getEntryCount(); ++i) {
+    oss << " " << hash_table->getRowIds()[i];
+  }
+  oss << " |";
+  return oss.str();
+}
+
+DecodedJoinHashBufferSet RangeJoinHashTable::toSet(const ExecutorDeviceType device_type,
+                                                   const int device_id) const {
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  CHECK_EQ(device_id, 0);
+  auto hash_table = getRangeHashTable();
+  std::map<int64_t, std::set<int32_t>> row_ids_by_key;
+  for (size_t i = 0; i < hash_table->getEntryCount(); ++i) {
+    row_ids_by_key[hash_table->getKeys()[i]].insert(hash_table->getRowIds()[i]);
+  }
+  DecodedJoinHashBufferSet res;
+  for (auto& [key, row_ids] : row_ids_by_key) {
+    res.insert(DecodedJoinHashBufferEntry{{key}, std::move(row_ids)});
+  }
+  return res;
+}
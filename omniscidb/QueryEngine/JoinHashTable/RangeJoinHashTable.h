@@ -0,0 +1,143 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Range join for join conditions consisting of inequalities only, e.g. band
+ * joins (a.x BETWEEN b.x - 5 AND b.x + 5) and interval joins
+ * (a.ts BETWEEN b.start AND b.end).
+ *
+ * Inner table rows are sorted by a key column and a probe finds the interval
+ * of rows whose key is within the bounds computed from the outer row. For an
+ * interval join bounds for the key column (start) are derived from bounds for
+ * another inner column (end) using the minimal and maximal difference between
+ * the two columns. The resulting set of rows is a superset of the matching
+ * rows and join conditions are still evaluated for each of them.
+ */
+
+#pragma once
+
+#include "IR/Expr.h"
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/JoinHashTable/RangeHashTable.h"
+
+#include <llvm/IR/Value.h>
+
+#include <list>
+#include <memory>
+#include <optional>
+
+class RangeJoinHashTable : public HashJoin {
+ public:
+  //! Make a range join table for the given join conditions of a nesting level.
+  static std::shared_ptr<RangeJoinHashTable> getInstance(
+      const std::list<hdk::ir::ExprPtr>& quals,
+      const std::vector<InputTableInfo>& query_infos,
+      const JoinType join_type,
+      DataProvider* data_provider,
+      ColumnCacheMap& column_cache,
+      Executor* executor);
+
+  std::string toString(const ExecutorDeviceType device_type,
+                       const int device_id = 0,
+                       bool raw = false) const override;
+
+  DecodedJoinHashBufferSet toSet(const ExecutorDeviceType device_type,
+                                 const int device_id) const override;
+
+  llvm::Value* codegenSlot(const CompilationOptions&, const size_t) override;
+
+  HashJoinMatchingSet codegenMatchingSet(const CompilationOptions&,
+                                         const size_t) override;
+
+  int getInnerDbId() const noexcept override { return key_col_->dbId(); }
+
+  int getInnerTableId() const noexcept override { return key_col_->tableId(); }
+
+  int getInnerTableRteIdx() const noexcept override { return key_col_->rteIdx(); }
+
+  HashType getHashType() const noexcept override { return HashType::Range; }
+
+  Data_Namespace::MemoryLevel getMemoryLevel() const noexcept override {
+    return Data_Namespace::CPU_LEVEL;
+  }
+
+  int getDeviceCount() const noexcept override { return 1; }
+
+  size_t offsetBufferOff() const noexcept override { return 0; }
+
+  size_t countBufferOff() const noexcept override { return 0; }
+
+  size_t payloadBufferOff() const noexcept override;
+
+  std::string getHashJoinType() const final { return "Range"; }
+
+  bool isBitwiseEq() const override { return false; }
+
+  //! Join condition used to build the table.
+  std::shared_ptr<const hdk::ir::BinOper> getRangeQual() const {
+    return lower_ ? lower_->qual : upper_->qual;
+  }
+
+  virtual ~RangeJoinHashTable() {}
+
+ private:
+  // Bound for the key column in the form of `inner_col op outer_expr`. If inner_col
+  // is not the key column, then the bound is shifted by the difference between
+  // inner_col and the key column.
+  struct RangeBound {
+    std::shared_ptr<const hdk::ir::BinOper> qual;
+    const hdk::ir::ColumnVar* inner_col;
+    const hdk::ir::Expr* outer_expr;
+  };
+
+  RangeJoinHashTable(const hdk::ir::ColumnVar* key_col,
+                     std::optional<RangeBound> lower,
+                     std::optional<RangeBound> upper,
+                     const std::vector<InputTableInfo>& query_infos,
+                     DataProvider* data_provider,
+                     ColumnCacheMap& column_cache,
+                     Executor* executor)
+      : HashJoin(data_provider)
+      , key_col_(std::dynamic_pointer_cast<const hdk::ir::ColumnVar>(key_col->shared()))
+      , lower_(std::move(lower))
+      , upper_(std::move(upper))
+      , query_infos_(query_infos)
+      , column_cache_(column_cache)
+      , executor_(executor) {
+    hash_tables_for_device_.resize(1);
+  }
+
+  void reify();
+
+  const hdk::ir::ColumnVar* getCompanionCol() const;
+
+  llvm::Value* codegenBound(const RangeBound& bound,
+                            const bool is_lower,
+                            llvm::Value* keys_ptr,
+                            llvm::Value* entry_count,
+                            llvm::Value* delta,
+                            const CompilationOptions& co);
+
+  size_t getComponentBufferSize() const noexcept override { return 0; }
+
+  RangeHashTable* getRangeHashTable() const;
+
+  std::shared_ptr<const hdk::ir::ColumnVar> key_col_;
+  std::optional<RangeBound> lower_;
+  std::optional<RangeBound> upper_;
+  const std::vector<InputTableInfo>& query_infos_;
+  ColumnCacheMap& column_cache_;
+  Executor* executor_;
+};
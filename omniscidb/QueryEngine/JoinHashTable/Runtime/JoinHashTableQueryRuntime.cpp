@@ -169,3 +169,87 @@ get_composite_key_index_64(GENERIC_ADDR_SPACE const int64_t* key,
   return get_composite_key_index_impl(
       key, key_component_count, composite_key_dict, entry_count);
 }
+
+#if !defined(__CUDACC__) && !defined(L0_RUNTIME_ENABLED)
+
+// Software prefetch helpers used by the CPU probe code to request hash table
+// entries for a key a few rows ahead of the currently probed one. They never
+// dereference the hash table, so a stale or out of range key is harmless.
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE void hash_join_prefetch(
+    int64_t hash_buff,
+    const int64_t key,
+    const int64_t min_key,
+    const int64_t max_key,
+    const int64_t count_buff_off) {
+  if (key >= min_key && key <= max_key) {
+    const auto slot = reinterpret_cast<const int8_t*>(hash_buff) +
+                      (key - min_key) * sizeof(int32_t);
+    __builtin_prefetch(slot);
+    if (count_buff_off) {
+      __builtin_prefetch(slot + count_buff_off);
+    }
+  }
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE void baseline_hash_join_prefetch(
+    const int8_t* hash_buff,
+    const int8_t* key,
+    const size_t key_bytes,
+    const size_t entry_bytes,
+    const size_t entry_count) {
+  if (entry_count) {
+    const uint32_t h = MurmurHash1(key, key_bytes, 0) % entry_count;
+    __builtin_prefetch(hash_buff + h * entry_bytes);
+  }
+}
+
+// Binary search over sorted keys of a range join table. Return the position of the
+// first key which is not less than (lower bound) or greater than (upper bound) the
+// value shifted by delta.
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
+range_join_lower_bound(const int64_t* keys,
+                       const int64_t entry_count,
+                       const int64_t value,
+                       const int64_t delta) {
+  int64_t bound;
+  if (__builtin_sub_overflow(value, delta, &bound)) {
+    return delta > 0 ? 0 : entry_count;
+  }
+  int64_t lo = 0;
+  int64_t hi = entry_count;
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] < bound) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
+range_join_upper_bound(const int64_t* keys,
+                       const int64_t entry_count,
+                       const int64_t value,
+                       const int64_t delta) {
+  int64_t bound;
+  if (__builtin_sub_overflow(value, delta, &bound)) {
+    return delta > 0 ? 0 : entry_count;
+  }
+  int64_t lo = 0;
+  int64_t hi = entry_count;
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] <= bound) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/ColRangeInfo.h"
 #include "QueryEngine/OutputBufferInitialization.h"
+#include "QueryEngine/StreamingTopN.h"
 #include "QueryEngine/UsedColumnsCollector.h"
 #include "ResultSet/HyperLogLog.h"
 
@@ -415,6 +416,24 @@ KeylessInfo get_keyless_info(const RelAlgExecutionUnit& ra_exe_unit,
   };
 }
 
+// Roaring bitmaps are used for value ranges which fit 32 bits when dense bitmaps
+// cannot be used or all dense bitmaps of the groups buffer would take too much memory.
+bool use_roaring_count_distinct(const int64_t bitmap_sz_bits,
+                                const size_t group_by_slots_count,
+                                const CountDistinctImplType dense_impl_type,
+                                const Config& config) {
+  if (!config.exec.group_by.enable_roaring_count_distinct || bitmap_sz_bits <= 0 ||
+      bitmap_sz_bits > (int64_t(1) << 32)) {
+    return false;
+  }
+  if (dense_impl_type == CountDistinctImplType::HashSet) {
+    return true;
+  }
+  const size_t dense_bitmap_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
+  return dense_bitmap_bytes > config.exec.group_by.roaring_count_distinct_threshold /
+                                  std::max(group_by_slots_count, size_t(1));
+}
+
 CountDistinctDescriptors init_count_distinct_descriptors(
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
@@ -429,16 +448,28 @@ CountDistinctDescriptors init_count_distinct_descriptors(
     if (is_distinct_target(agg_info)) {
       CHECK(agg_info.is_agg);
       CHECK(agg_info.agg_kind == hdk::ir::AggType::kCount ||
-            agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct);
+            hdk::ir::isHll(agg_info.agg_kind));
       const auto agg_expr = static_cast<const hdk::ir::AggExpr*>(target_expr);
       auto arg_type = agg_expr->arg()->type();
       if (arg_type->isText()) {
         throw std::runtime_error(
             "Strings must be dictionary-encoded for COUNT(DISTINCT).");
       }
-      if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct &&
-          arg_type->isBuffer()) {
-        throw std::runtime_error("APPROX_COUNT_DISTINCT on arrays not supported yet");
+      if (agg_info.agg_kind == hdk::ir::AggType::kHllMerge ||
+          agg_info.agg_kind == hdk::ir::AggType::kHllMergeCount) {
+        // Merged sketches are not hashed, so the argument range doesn't matter.
+        count_distinct_descriptors.emplace_back(CountDistinctDescriptor{
+            CountDistinctImplType::Bitmap,
+            0,
+            get_hll_precision_bits(agg_expr, executor->getConfig()),
+            true,
+            device_type,
+            1});
+        continue;
+      }
+      if (hdk::ir::isHll(agg_info.agg_kind) && arg_type->isBuffer()) {
+        throw std::runtime_error(toString(agg_info.agg_kind) +
+                                 " on arrays not supported yet");
       }
       ColRangeInfo no_range_info{QueryDescriptionType::Projection, 0, 0, 0, false};
       auto arg_range_info =
@@ -447,23 +478,15 @@ CountDistinctDescriptors init_count_distinct_descriptors(
               : get_expr_range_info(ra_exe_unit, query_infos, agg_expr->arg(), executor);
       CountDistinctImplType count_distinct_impl_type{CountDistinctImplType::HashSet};
       int64_t bitmap_sz_bits{0};
-      if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct) {
-        const auto error_rate =
-            agg_expr->arg1() ? agg_expr->arg1()->as<hdk::ir::Constant>() : nullptr;
-        if (error_rate) {
-          CHECK(error_rate->type()->isInt32());
-          CHECK_GE(error_rate->value().intval, 1);
-          bitmap_sz_bits = hll_size_for_rate(error_rate->value().smallintval);
-        } else {
-          bitmap_sz_bits = executor->getConfig().exec.group_by.hll_precision_bits;
-        }
+      if (hdk::ir::isHll(agg_info.agg_kind)) {
+        bitmap_sz_bits = get_hll_precision_bits(agg_expr, executor->getConfig());
       }
       if (arg_range_info.isEmpty()) {
         count_distinct_descriptors.emplace_back(CountDistinctDescriptor{
             CountDistinctImplType::Bitmap,
             0,
-            64,
-            agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct,
+            hdk::ir::isHll(agg_info.agg_kind) ? bitmap_sz_bits : 64,
+            hdk::ir::isHll(agg_info.agg_kind),
             device_type,
             1});
         continue;
@@ -490,7 +513,16 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           }
         }
       }
-      if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct &&
+      if (agg_info.agg_kind == hdk::ir::AggType::kCount &&
+          arg_range_info.hash_type_ == QueryDescriptionType::GroupByPerfectHash &&
+          !arg_type->isBuffer() && device_type == ExecutorDeviceType::CPU &&
+          use_roaring_count_distinct(bitmap_sz_bits,
+                                     group_by_slots_count,
+                                     count_distinct_impl_type,
+                                     executor->getConfig())) {
+        count_distinct_impl_type = CountDistinctImplType::RoaringBitmap;
+      }
+      if (hdk::ir::isHll(agg_info.agg_kind) &&
           count_distinct_impl_type == CountDistinctImplType::HashSet &&
           !arg_type->isArray()) {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
@@ -506,7 +538,7 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           count_distinct_impl_type,
           arg_range_info.min,
           bitmap_sz_bits,
-          agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct,
+          hdk::ir::isHll(agg_info.agg_kind),
           device_type,
           sub_bitmap_count});
     } else {
@@ -691,7 +723,8 @@ int8_t pick_baseline_key_width(const RelAlgExecutionUnit& ra_exe_unit,
 
 bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
                          const bool output_columnar,
-                         bool streaming_topn_max) {
+                         const ExecutorDeviceType device_type,
+                         size_t streaming_topn_max) {
   for (const auto target_expr : ra_exe_unit.target_exprs) {
     if (dynamic_cast<const hdk::ir::AggExpr*>(target_expr)) {
       return false;
@@ -702,23 +735,27 @@ bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
   }
 
   // TODO: Allow streaming top n for columnar output
-  if (!output_columnar && ra_exe_unit.sort_info.order_entries.size() == 1 &&
-      ra_exe_unit.sort_info.limit &&
-      ra_exe_unit.sort_info.algorithm == SortAlgorithm::StreamingTopN) {
-    const auto only_order_entry = ra_exe_unit.sort_info.order_entries.front();
-    CHECK_GT(only_order_entry.tle_no, int(0));
-    CHECK_LE(static_cast<size_t>(only_order_entry.tle_no),
-             ra_exe_unit.target_exprs.size());
-    const auto order_entry_expr = ra_exe_unit.target_exprs[only_order_entry.tle_no - 1];
-    const auto n = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
-    if ((order_entry_expr->type()->isNumber() ||
-         order_entry_expr->type()->isDateTime()) &&
-        n <= streaming_topn_max) {
-      return true;
+  if (output_columnar || ra_exe_unit.sort_info.order_entries.empty() ||
+      !ra_exe_unit.sort_info.limit ||
+      ra_exe_unit.sort_info.algorithm != SortAlgorithm::StreamingTopN) {
+    return false;
+  }
+  const auto n = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
+  if (n > streaming_topn_max) {
+    return false;
+  }
+  for (const auto& order_entry : ra_exe_unit.sort_info.order_entries) {
+    CHECK_GT(order_entry.tle_no, int(0));
+    CHECK_LE(static_cast<size_t>(order_entry.tle_no), ra_exe_unit.target_exprs.size());
+    auto type = ra_exe_unit.target_exprs[order_entry.tle_no - 1]->type();
+    if (!type->isNumber() && !type->isDateTime() &&
+        !(type->isString() && device_type == ExecutorDeviceType::CPU)) {
+      return false;
     }
   }
-
-  return false;
+  // Composite heap keys are supported on CPU only.
+  return device_type == ExecutorDeviceType::CPU ||
+         !use_composite_streaming_top_n_key(ra_exe_unit);
 }
 
 std::vector<int64_t> target_expr_group_by_indices(
@@ -943,6 +980,7 @@ std::unique_ptr<QueryMemoryDescriptor> build_query_memory_descriptor(
       if (streaming_top_n_hint &&
           use_streaming_top_n(ra_exe_unit,
                               output_columnar,
+                              device_type,
                               executor->getConfig().exec.streaming_topn_max) &&
           streaming_top_n_supported_by_platform) {
         streaming_top_n = true;
@@ -967,7 +1005,9 @@ std::unique_ptr<QueryMemoryDescriptor> build_query_memory_descriptor(
   }
 
   auto approx_quantile =
-      anyOf(ra_exe_unit.target_exprs, hdk::ir::AggType::kApproxQuantile);
+      anyOf(ra_exe_unit.target_exprs, hdk::ir::AggType::kApproxQuantile) ||
+      anyOf(ra_exe_unit.target_exprs, hdk::ir::AggType::kPercentileCont) ||
+      anyOf(ra_exe_unit.target_exprs, hdk::ir::AggType::kPercentileDisc);
   return std::make_unique<QueryMemoryDescriptor>(executor->getDataMgr(),
                                                  executor->getConfigPtr(),
                                                  query_infos,
@@ -1086,7 +1126,7 @@ bool gpu_can_handle_order_entries(const RelAlgExecutionUnit& ra_exe_unit,
     if (agg_expr->isDistinct() || agg_expr->aggType() == hdk::ir::AggType::kAvg ||
         agg_expr->aggType() == hdk::ir::AggType::kMin ||
         agg_expr->aggType() == hdk::ir::AggType::kMax ||
-        agg_expr->aggType() == hdk::ir::AggType::kApproxCountDistinct) {
+        hdk::ir::isHll(agg_expr->aggType())) {
       return false;
     }
     if (agg_expr->arg()) {
@@ -1277,3 +1317,20 @@ size_t MemoryLayoutBuilder::gpuSharedMemorySize(
   }
   return 0;
 }
+
+int64_t get_hll_precision_bits(const hdk::ir::AggExpr* agg_expr, const Config& config) {
+  CHECK(hdk::ir::isHll(agg_expr->aggType()));
+  const auto arg1 =
+      agg_expr->arg1() ? agg_expr->arg1()->as<hdk::ir::Constant>() : nullptr;
+  if (!arg1) {
+    return config.exec.group_by.hll_precision_bits;
+  }
+  CHECK(arg1->type()->isInt32());
+  if (agg_expr->aggType() == hdk::ir::AggType::kApproxCountDistinct) {
+    CHECK_GE(arg1->value().intval, 1);
+    return hll_size_for_rate(arg1->value().intval);
+  }
+  CHECK_GE(arg1->value().intval, kMinHllPrecisionBits);
+  CHECK_LE(arg1->value().intval, kMaxHllPrecisionBits);
+  return arg1->value().intval;
+}
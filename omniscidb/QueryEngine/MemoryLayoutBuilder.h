@@ -27,6 +27,7 @@
 #include "ResultSet/QueryMemoryDescriptor.h"
 
 class Executor;
+struct Config;
 
 /**
  * @brief Determines memory layout for a given RelAlgExecutionUnit and builds
@@ -69,3 +70,8 @@ inline size_t get_count_distinct_sub_bitmap_count(const size_t bitmap_sz_bits,
              ? 64  // NB: must be a power of 2 to keep runtime offset computations cheap
              : 1;
 }
+
+// Returns the number of bits indexing HyperLogLog registers for an approximate count
+// distinct or a sketch aggregate. The second aggregate argument is the error rate in
+// percents for APPROX_COUNT_DISTINCT and the precision itself for sketch aggregates.
+int64_t get_hll_precision_bits(const hdk::ir::AggExpr* agg_expr, const Config& config);
@@ -64,6 +64,8 @@ static_assert(false, "LLVM Version >= 12 is required.");
 #include "QueryEngine/NvidiaKernel.h"
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/QueryTemplateGenerator.h"
+#include "QueryEngine/TierUpWorker.h"
+#include "QueryEngine/VectorizedInterpreter.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
 #include "StreamingTopN.h"
@@ -206,6 +208,41 @@ CodeCacheKey get_code_cache_key(llvm::Function* query_func, CgenState* cgen_stat
   return key;
 }
 
+std::unique_ptr<TierUpInfo> make_tier_up_info(
+    llvm::Function* query_func,
+    llvm::Function* multifrag_query_func,
+    const std::unordered_set<llvm::Function*>& live_funcs) {
+  auto info = std::make_unique<TierUpInfo>();
+  llvm::raw_string_ostream os(info->bitcode);
+  llvm::WriteBitcodeToFile(*query_func->getParent(), os);
+  os.flush();
+  info->query_func = query_func->getName().str();
+  info->multifrag_query_func = multifrag_query_func->getName().str();
+  for (auto func : live_funcs) {
+    info->live_funcs.push_back(func->getName().str());
+  }
+  return info;
+}
+
+// Count uses of a kernel compiled by the baseline tier and schedule its optimized
+// recompilation when it becomes hot. The optimized kernel replaces the baseline one
+// in the code cache, queries which already use the baseline kernel keep it alive.
+void maybe_tier_up(const CodeCacheKey& key,
+                   const std::shared_ptr<CpuCompilationContext>& code,
+                   size_t threshold) {
+  auto info = code->tierUpInfo();
+  if (!info || info->use_count++ < threshold || info->scheduled.exchange(true)) {
+    return;
+  }
+  TierUpWorker::instance().submit([key, code]() {
+    auto optimized_code = compiler::CPUBackend::generateOptimizedCPUCode(
+        *code->tierUpInfo());
+    if (Executor::cpu_code_accessor->replace(key, code, optimized_code)) {
+      VLOG(1) << "Replaced baseline kernel with optimized one.";
+    }
+  });
+}
+
 }  // namespace
 
 std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
@@ -214,17 +251,30 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
     std::shared_ptr<compiler::Backend> backend,
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co) {
+  const auto& codegen_config = getConfig().exec.codegen;
   auto key = get_code_cache_key(query_func, cgen_state_.get());
   auto cached_code = cpu_code_accessor->get_value(key);
   if (cached_code) {
+    maybe_tier_up(key, cached_code, codegen_config.tier_up_threshold);
     return cached_code;
   }
 
+  std::unique_ptr<TierUpInfo> tier_up_info;
+  auto co_native = co;
+  if (codegen_config.enable_tiered_compilation &&
+      co.opt_level == ExecutorOptLevel::Default) {
+    // Bitcode is taken before optimizations modify the module.
+    tier_up_info = make_tier_up_info(query_func, multifrag_query_func, live_funcs);
+    co_native.opt_level = ExecutorOptLevel::Baseline;
+  }
+
   std::shared_ptr<CpuCompilationContext> cpu_compilation_context =
       std::dynamic_pointer_cast<CpuCompilationContext>(
-          backend->generateNativeCode(query_func, nullptr, live_funcs, co));
+          backend->generateNativeCode(query_func, nullptr, live_funcs, co_native));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  cpu_compilation_context->setTierUpInfo(std::move(tier_up_info));
   cpu_code_accessor->put(key, cpu_compilation_context);
+  maybe_tier_up(key, cpu_compilation_context, codegen_config.tier_up_threshold);
   return std::dynamic_pointer_cast<CompilationContext>(cpu_compilation_context);
 }
 
@@ -432,6 +482,7 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
+         func->getName() == "fixed_width_packed_int_decode" ||
          func->getName() == "record_error_code" || func->getName() == "get_error_code" ||
          func->getName() == "pos_start_impl" || func->getName() == "pos_step_impl" ||
          func->getName() == "group_buff_idx_impl" ||
@@ -439,6 +490,13 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "init_shared_mem_nop" || func->getName() == "write_back_nop";
 }
 
+// Generated code relies on inlining of runtime functions marked with ALWAYS_INLINE,
+// e.g. aggregation and decoding helpers called for each row.
+bool CodeGenerator::inlineRuntimeFunction(const llvm::Function* func) {
+  return alwaysCloneRuntimeFunction(func) ||
+         func->hasFnAttribute(llvm::Attribute::AlwaysInline);
+}
+
 std::unique_ptr<llvm::Module> read_llvm_module_from_bc_file(
     const std::string& bc_filename,
     llvm::LLVMContext& context) {
@@ -773,11 +831,20 @@ std::vector<std::string> get_agg_fnames(
         break;
       }
       case hdk::ir::AggType::kApproxCountDistinct:
+      case hdk::ir::AggType::kHllSketch:
         result.emplace_back("agg_approximate_count_distinct");
         break;
+      case hdk::ir::AggType::kHllMerge:
+      case hdk::ir::AggType::kHllMergeCount:
+        result.emplace_back("agg_hll_merge");
+        break;
       case hdk::ir::AggType::kApproxQuantile:
         result.emplace_back("agg_approx_quantile");
         break;
+      case hdk::ir::AggType::kPercentileCont:
+      case hdk::ir::AggType::kPercentileDisc:
+        result.emplace_back("agg_quantile");
+        break;
       default:
         CHECK(false);
     }
@@ -1476,6 +1543,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::HashSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::RoaringBitmap ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals)) {
         throw QueryMustRunOnCpu();
@@ -1483,6 +1551,24 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
     }
   }
 
+  // Small non-grouped aggregations are executed by the interpreter to avoid the JIT
+  // compilation latency.
+  if (co.device_type == ExecutorDeviceType::CPU &&
+      config_->exec.codegen.enable_interpreter && !eo.just_explain) {
+    plan_state_->preparePackedColumns(ra_exe_unit, co.device_type);
+    auto interpreted_ctx = InterpretedCompilationContext::create(
+        ra_exe_unit, *query_mem_desc, query_infos, *plan_state_, *config_);
+    if (interpreted_ctx) {
+      plan_state_->allocateLocalColumnIds(ra_exe_unit.input_col_descs);
+      return std::make_tuple(CompilationResult{interpreted_ctx,
+                                               {},
+                                               output_columnar,
+                                               /*llvm_ir=*/"",
+                                               std::move(gpu_smem_context)},
+                             std::move(query_mem_desc));
+    }
+  }
+
   auto is_gpu = co.device_type == ExecutorDeviceType::GPU;
   auto is_l0 = is_gpu && gpu_mgr->getPlatform() == GpuMgrPlatform::L0;
 
@@ -1492,6 +1578,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   CHECK(cgen_state_->module_ == nullptr);
   cgen_state_->set_module_shallow_copy(getExtensionModuleContext()->getRTModule(is_l0),
                                        /*always_clone=*/true);
+  cgen_state_->use_runtime_dylib_ = !is_gpu && config_->exec.codegen.enable_runtime_dylib;
 
   CompilationOptions co_codegen_traits = co;
   co_codegen_traits.codegen_traits_desc = backend->traitsDesc();
@@ -1575,6 +1662,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   cgen_state_->current_func_ = cgen_state_->row_func_;
   cgen_state_->ir_builder_.SetInsertPoint(cgen_state_->row_func_bb_);
 
+  plan_state_->preparePackedColumns(ra_exe_unit, co.device_type);
   preloadFragOffsets(ra_exe_unit.input_descs, query_infos);
   RelAlgExecutionUnit body_execution_unit = ra_exe_unit;
   const auto join_loops = buildJoinLoops(body_execution_unit,
@@ -162,9 +162,15 @@ int64_t get_agg_initial_val(hdk::ir::AggType agg,
     case hdk::ir::AggType::kAvg:
     case hdk::ir::AggType::kCount:
     case hdk::ir::AggType::kApproxCountDistinct:
+    case hdk::ir::AggType::kHllSketch:
+    case hdk::ir::AggType::kHllMerge:
+    case hdk::ir::AggType::kHllMergeCount:
       return 0;
     case hdk::ir::AggType::kApproxQuantile:
       return {};  // Init value is a quantile::TDigest* set elsewhere.
+    case hdk::ir::AggType::kPercentileCont:
+    case hdk::ir::AggType::kPercentileDisc:
+      return {};  // Init value is an ExactQuantile* set elsewhere.
     case hdk::ir::AggType::kMin: {
       switch (byte_width) {
         case 1: {
@@ -275,7 +281,7 @@ std::vector<int64_t> init_agg_val_vec(const std::vector<const hdk::ir::Expr*>& t
            target.agg_kind == hdk::ir::AggType::kMax ||
            target.agg_kind == hdk::ir::AggType::kSum ||
            target.agg_kind == hdk::ir::AggType::kAvg ||
-           target.agg_kind == hdk::ir::AggType::kApproxQuantile)) {
+           hdk::ir::isQuantile(target.agg_kind))) {
         set_notnull(target, false);
       } else if (constrained_not_null(arg_expr, quals)) {
         set_notnull(target, true);
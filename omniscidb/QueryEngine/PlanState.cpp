@@ -16,6 +16,7 @@
 
 #include "PlanState.h"
 #include "Execute.h"
+#include "ExprByPredicateCollector.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 
 bool PlanState::isLazyFetchColumn(const hdk::ir::Expr* target_expr) const {
@@ -31,7 +32,7 @@ bool PlanState::isLazyFetchColumn(const hdk::ir::Expr* target_expr) const {
                                                     do_not_fetch_column->tableId(),
                                                     do_not_fetch_column->columnId());
   CHECK(col_info);
-  if (col_info->is_rowid) {
+  if (col_info->is_rowid || isPackedColumn(do_not_fetch_column)) {
     return false;
   }
   InputColDescriptorSet intersect;
@@ -72,6 +73,51 @@ int PlanState::getLocalColumnId(const hdk::ir::ColumnVar* col_var,
   return it->second;
 }
 
+void PlanState::preparePackedColumns(const RelAlgExecutionUnit& ra_exe_unit,
+                                     const ExecutorDeviceType device_type) {
+  packed_columns_.clear();
+  // Packed chunks are decoded by CPU code only. Union and window function
+  // units read input columns bypassing the column decoders, so skip them.
+  if (device_type != ExecutorDeviceType::CPU || ra_exe_unit.union_all ||
+      query_infos_.empty()) {
+    return;
+  }
+  // Window functions can be nested into target expressions.
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    if (!ExprByPredicateCollector::collect(target_expr, hdk::ir::isWindowFunctionExpr)
+             .empty()) {
+      return;
+    }
+  }
+
+  const auto& fragments = query_infos_.front().info.fragments;
+  for (const auto& col_desc : ra_exe_unit.input_col_descs) {
+    if (col_desc->getNestLevel() != 0 || col_desc->isVirtual()) {
+      continue;
+    }
+    // All fragments have to be packed to use a single decoder.
+    bool packed = false;
+    for (const auto& frag : fragments) {
+      if (frag.isEmptyPhysicalFragment()) {
+        continue;
+      }
+      auto meta_it = frag.getChunkMetadataMap().find(col_desc->getColId());
+      packed = meta_it != frag.getChunkMetadataMap().end() && meta_it->second->isPacked();
+      if (!packed) {
+        break;
+      }
+    }
+    if (packed) {
+      packed_columns_.insert(*col_desc);
+    }
+  }
+}
+
+bool PlanState::isPackedColumn(const hdk::ir::ColumnVar* col_var) const {
+  return col_var->rteIdx() <= 0 &&
+         packed_columns_.count(column_var_to_descriptor(col_var));
+}
+
 void PlanState::addNonHashtableQualForLeftJoin(size_t idx, hdk::ir::ExprPtr expr) {
   auto it = left_join_non_hashtable_quals_.find(idx);
   if (it == left_join_non_hashtable_quals_.end()) {
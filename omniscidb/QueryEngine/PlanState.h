@@ -19,10 +19,12 @@
 #include <unordered_set>
 
 #include "IR/Expr.h"
+#include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/Descriptors/InputDescriptors.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 
 class Executor;
+struct RelAlgExecutionUnit;
 
 struct JoinInfo {
   JoinInfo(
@@ -67,6 +69,8 @@ struct PlanState {
   std::unordered_map<InputColDescriptor, size_t> global_to_local_col_ids_;
   InputColDescriptorSet columns_to_fetch_;
   InputColDescriptorSet columns_to_not_fetch_;
+  // Outer table columns fetched in the bit-packed layout.
+  InputColDescriptorSet packed_columns_;
   std::unordered_map<size_t, std::vector<hdk::ir::ExprPtr>>
       left_join_non_hashtable_quals_;
   bool allow_lazy_fetch_;
@@ -80,6 +84,11 @@ struct PlanState {
 
   int getLocalColumnId(const hdk::ir::ColumnVar* col_var, const bool fetch_column);
 
+  void preparePackedColumns(const RelAlgExecutionUnit& ra_exe_unit,
+                            const ExecutorDeviceType device_type);
+
+  bool isPackedColumn(const hdk::ir::ColumnVar* col_var) const;
+
   bool isLazyFetchColumn(const hdk::ir::Expr* target_expr) const;
 
   bool isLazyFetchColumn(const InputColDescriptor& col_desc) {
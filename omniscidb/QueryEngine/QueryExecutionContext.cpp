@@ -27,6 +27,7 @@
 #include "ResultSetReduction.h"
 #include "SpeculativeTopN.h"
 #include "StreamingTopN.h"
+#include "VectorizedInterpreter.h"
 
 #include "ResultSet/QueryMemoryDescriptor.h"
 #include "ResultSet/ResultSet.h"
@@ -735,6 +736,35 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
   return out_vec;
 }
 
+std::vector<int64_t*> QueryExecutionContext::launchInterpretedCode(
+    const InterpretedCompilationContext* interpreted_ctx,
+    const std::vector<std::vector<const int8_t*>>& col_buffers,
+    const std::vector<std::vector<int64_t>>& num_rows,
+    const uint32_t start_rowid,
+    const int64_t num_rows_to_process) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(query_buffers_);
+  CHECK(interpreted_ctx);
+  CHECK(!query_mem_desc_.isGroupBy());
+  CHECK_EQ(num_rows.size(), col_buffers.size());
+  const auto& init_agg_vals = query_buffers_->init_agg_vals_;
+  std::vector<int64_t*> out_vec;
+  for (size_t i = 0; i < init_agg_vals.size(); ++i) {
+    out_vec.push_back(new int64_t[col_buffers.size()]);
+  }
+  // Kernel subtasks process a range of rows of a single fragment.
+  auto subtask_num_rows = num_rows;
+  if (num_rows_to_process > 0) {
+    CHECK_EQ(subtask_num_rows.size(), size_t(1));
+    subtask_num_rows[0][0] = num_rows_to_process;
+  } else {
+    CHECK_EQ(start_rowid, uint32_t(0));
+  }
+  interpreted_ctx->run(
+      col_buffers, subtask_num_rows, start_rowid, init_agg_vals, out_vec);
+  return out_vec;
+}
+
 std::vector<int8_t*> QueryExecutionContext::prepareKernelParams(
     const std::vector<std::vector<const int8_t*>>& col_buffers,
     const std::vector<int8_t>& literal_buff,
@@ -27,6 +27,7 @@
 #include <vector>
 
 class CpuCompilationContext;
+class InterpretedCompilationContext;
 
 struct RelAlgExecutionUnit;
 class QueryMemoryDescriptor;
@@ -106,6 +107,16 @@ class QueryExecutionContext : boost::noncopyable {
       const std::vector<int64_t>& join_hash_tables,
       const int64_t num_rows_to_process = -1);
 
+  // Runs a non-grouped aggregation without generated code, see
+  // InterpretedCompilationContext. The output has the same layout as for
+  // launchCpuCode.
+  std::vector<int64_t*> launchInterpretedCode(
+      const InterpretedCompilationContext* interpreted_ctx,
+      const std::vector<std::vector<const int8_t*>>& col_buffers,
+      const std::vector<std::vector<int64_t>>& num_rows,
+      const uint32_t start_rowid,
+      const int64_t num_rows_to_process);
+
   int64_t getAggInitValForIndex(const size_t index) const;
 
  private:
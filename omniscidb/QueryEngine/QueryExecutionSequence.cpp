@@ -28,6 +28,10 @@ class CoalesceSecondaryProjectVisitor : public ScalarExprVisitor<bool> {
     if (auto agg_node = dynamic_cast<const hdk::ir::Aggregate*>(col_ref->node())) {
       return col_ref->index() == 0 && agg_node->getGroupByCount() > 0;
     }
+    // Look through projections merged into the same execution step.
+    if (auto proj_node = dynamic_cast<const hdk::ir::Project*>(col_ref->node())) {
+      return visit(proj_node->getExpr(col_ref->index()).get());
+    }
     return false;
   }
 
@@ -157,45 +161,63 @@ class QueryExecutionSequenceImpl {
     }
   }
 
-  void mergeExecutionPointsWithSimpleProject() {
-    std::vector<const ir::Node*> simple_projects;
-    for (auto input : execution_points_) {
-      if (boost::in_degree(node_to_vertex_[input], graph_) != 1) {
-        continue;
+  bool isSimpleProject(const ir::Node* node, const ir::Node* input) {
+    auto proj = node->as<ir::Project>();
+    if (!proj || proj->hasWindowFunctionExpr()) {
+      return false;
+    }
+    // In case of aggregation we allow only 'simple' projections which
+    // don't have complex expressions referencing aggregate exprs.
+    if (input->is<ir::Aggregate>()) {
+      for (auto& expr : proj->getExprs()) {
+        if (!expr->is<ir::ColumnRef>()) {
+          CoalesceSecondaryProjectVisitor visitor;
+          if (!visitor.visit(expr.get())) {
+            return false;
+          }
+        }
       }
+    }
+    return true;
+  }
 
-      // Only aggregations and joins can now be merged with a following
-      // projection.
-      // TODO: Use recursive search to cover multiple consequent projections?
+  void mergeExecutionPointsWithSimpleProject() {
+    std::vector<std::pair<const ir::Node*, const ir::Node*>> to_merge;
+    for (auto input : execution_points_) {
+      // Only aggregations and joins can now be merged with following
+      // projections.
       if (!input->is<ir::Aggregate>() && !input->is<ir::Join>()) {
         continue;
       }
 
-      auto [start, end] = boost::in_edges(node_to_vertex_[input], graph_);
-      CHECK(start != end);
-      auto node = graph_[start->m_source];
-
-      if (node->is<ir::Project>() && !node->as<ir::Project>()->hasWindowFunctionExpr()) {
-        // In case of aggregation we allow only 'simple' projections which
-        // don't have complex expressions referencing aggregate exprs.
-        bool is_simple = true;
-        for (auto& expr : node->as<ir::Project>()->getExprs()) {
-          if (!expr->is<ir::ColumnRef>() && input->is<ir::Aggregate>()) {
-            CoalesceSecondaryProjectVisitor visitor;
-            if (!visitor.visit(expr.get())) {
-              is_simple = false;
-              break;
-            }
-          }
-        }
-        if (is_simple) {
-          simple_projects.push_back(node);
+      // Follow the chain of simple projections having a single user each, so
+      // the whole chain is executed as a part of the input's step instead of
+      // materializing each projection. The chain stops at the projection which
+      // is an execution point on its own, e.g. the root node or a node with
+      // multiple users.
+      const ir::Node* last_proj = nullptr;
+      const ir::Node* node = input;
+      while (boost::in_degree(node_to_vertex_[node], graph_) == 1 &&
+             (node == input || !execution_points_.count(node))) {
+        auto [start, end] = boost::in_edges(node_to_vertex_[node], graph_);
+        CHECK(start != end);
+        auto user = graph_[start->m_source];
+        if (!isSimpleProject(user, input)) {
+          break;
         }
+        last_proj = user;
+        node = user;
+      }
+      if (last_proj) {
+        to_merge.emplace_back(last_proj, input);
       }
     }
-    for (auto node : simple_projects) {
-      execution_points_.insert(node);
-      execution_points_.erase(node->getInput(0));
+    for (auto [proj, input] : to_merge) {
+      execution_points_.insert(proj);
+      for (auto node = proj->getInput(0); node != input; node = node->getInput(0)) {
+        execution_points_.erase(node);
+      }
+      execution_points_.erase(input);
     }
   }
 
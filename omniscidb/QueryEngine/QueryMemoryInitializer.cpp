@@ -26,6 +26,7 @@
 #include "Logger/Logger.h"
 #include "ResultSet/ResultSet.h"
 #include "Shared/checked_alloc.h"
+#include "Shared/huge_pages.h"
 #include "ThirdParty/robin_hood.h"
 
 #ifndef _MSC_VER
@@ -43,6 +44,10 @@ int64_t g_bitmap_memory_limit{8LL * 1000 * 1000 * 1000};
 
 namespace {
 
+// Deferred count distinct buffer sizes are positive for dense bitmaps, -1 is used
+// for hash sets and -2 for roaring bitmaps.
+constexpr int64_t kRoaringBitmapSize = -2;
+
 inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
   const int32_t groups_buffer_entry_count = query_mem_desc.getEntryCount();
   checked_int64_t total_bytes_per_group = 0;
@@ -70,10 +75,59 @@ inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_des
   }
 }
 
+void prepare_group_by_buffer_memory(int8_t* buffer,
+                                    const size_t numBytes,
+                                    const CpuMemoryConfig& config) {
+  // Large hash tables are accessed randomly, so TLB misses and page faults on the
+  // first touch take a noticeable part of the group by time.
+  if (numBytes >= config.huge_pages_buffer_threshold) {
+    if (config.enable_huge_pages) {
+      huge_pages::advise(buffer, numBytes);
+    }
+    if (config.enable_prefault) {
+      huge_pages::prefault(buffer, numBytes);
+    }
+  }
+}
+
 int64_t* alloc_group_by_buffer(const size_t numBytes,
                                const size_t thread_idx,
-                               RowSetMemoryOwner* mem_owner) {
-  return reinterpret_cast<int64_t*>(mem_owner->allocate(numBytes, thread_idx));
+                               RowSetMemoryOwner* mem_owner,
+                               const CpuMemoryConfig& config) {
+  auto buffer = mem_owner->allocate(numBytes, thread_idx);
+  prepare_group_by_buffer_memory(buffer, numBytes, config);
+  return reinterpret_cast<int64_t*>(buffer);
+}
+
+// Group by buffers are reused through the pool only when their initial content is
+// defined by the memory descriptor and initial values. Count distinct and quantile
+// targets put pointers to objects owned by the query into buffers.
+bool can_use_buffer_pool(const RelAlgExecutionUnit& ra_exe_unit,
+                         const QueryMemoryDescriptor& query_mem_desc,
+                         const ExecutorDeviceType device_type,
+                         const Config& config) {
+  if (!config.exec.group_by.enable_buffer_pool ||
+      device_type != ExecutorDeviceType::CPU || query_mem_desc.useStreamingTopN()) {
+    return false;
+  }
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    if (is_distinct_target(
+            get_target_info(target_expr, config.exec.group_by.bigint_count))) {
+      return false;
+    }
+    auto agg_expr = dynamic_cast<const hdk::ir::AggExpr*>(target_expr);
+    if (agg_expr && hdk::ir::isQuantile(agg_expr->aggType())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string get_buffer_pool_layout(const QueryMemoryDescriptor& query_mem_desc,
+                                   const std::vector<int64_t>& init_vals,
+                                   const size_t buffer_size) {
+  return query_mem_desc.toString() + "\tBuffer Size: " + std::to_string(buffer_size) +
+         "\n\tInit Values: " + ::toString(init_vals) + "\n";
 }
 
 inline int64_t get_consistent_frag_size(const std::vector<uint64_t>& frag_offsets) {
@@ -281,7 +335,7 @@ QueryMemoryInitializer::QueryMemoryInitializer(
 
   if (!query_mem_desc.isGroupBy()) {
     allocateCountDistinctBuffers(query_mem_desc, false, executor);
-    allocateTDigests(query_mem_desc, false, executor);
+    allocateQuantiles(query_mem_desc, false, executor);
   }
 
   if (ra_exe_unit.estimator) {
@@ -299,16 +353,24 @@ QueryMemoryInitializer::QueryMemoryInitializer(
 
   const auto group_buffers_count = !query_mem_desc.isGroupBy() ? 1 : num_buffers_;
   int64_t* group_by_buffer_template{nullptr};
-  if (!query_mem_desc.lazyInitGroups(device_type) && group_buffers_count > 1) {
-    group_by_buffer_template = reinterpret_cast<int64_t*>(
-        row_set_mem_owner_->allocate(group_buffer_size, thread_idx_));
-    initGroupByBuffer(group_by_buffer_template,
-                      ra_exe_unit,
-                      query_mem_desc,
-                      device_type,
-                      output_columnar,
-                      executor);
-  }
+  auto init_group_by_buffer = [&](int64_t* buffer) {
+    if (group_buffers_count > 1 && !group_by_buffer_template) {
+      group_by_buffer_template = reinterpret_cast<int64_t*>(
+          row_set_mem_owner_->allocate(group_buffer_size, thread_idx_));
+      initGroupByBuffer(group_by_buffer_template,
+                        ra_exe_unit,
+                        query_mem_desc,
+                        device_type,
+                        output_columnar,
+                        executor);
+    }
+    if (group_by_buffer_template) {
+      memcpy(buffer, group_by_buffer_template, group_buffer_size);
+    } else {
+      initGroupByBuffer(
+          buffer, ra_exe_unit, query_mem_desc, device_type, output_columnar, executor);
+    }
+  };
 
   if (query_mem_desc.interleavedBins(device_type)) {
     CHECK(query_mem_desc.hasKeylessHash());
@@ -337,24 +399,47 @@ QueryMemoryInitializer::QueryMemoryInitializer(
     group_by_buffers_.push_back(varlen_output_buffer);
   }
 
+  const auto use_buffer_pool = can_use_buffer_pool(
+      ra_exe_unit, query_mem_desc, device_type, executor->getConfig());
+  const auto buffer_pool_layout =
+      use_buffer_pool
+          ? get_buffer_pool_layout(query_mem_desc, init_agg_vals_, group_buffer_size)
+          : std::string();
+  // CPU projections don't initialize columnar output buffers, so pooled buffers are
+  // reused without keeping their content.
+  const auto init_pooled_buffers =
+      !output_columnar ||
+      query_mem_desc.getQueryDescriptionType() != QueryDescriptionType::Projection;
+
   for (size_t i = 0; i < group_buffers_count; i += step) {
-    auto group_by_buffer = alloc_group_by_buffer(
-        actual_group_buffer_size, thread_idx_, row_set_mem_owner_.get());
-
-    if (!query_mem_desc.lazyInitGroups(device_type)) {
-      if (group_by_buffer_template) {
-        memcpy(group_by_buffer + index_buffer_qw,
-               group_by_buffer_template,
-               group_buffer_size);
-      } else {
-        initGroupByBuffer(group_by_buffer + index_buffer_qw,
-                          ra_exe_unit,
-                          query_mem_desc,
-                          device_type,
-                          output_columnar,
-                          executor);
+    std::unique_ptr<GroupByBufferPool::Buffer> pooled_buffer;
+    if (use_buffer_pool) {
+      pooled_buffer = executor->getGroupByBufferPool().acquire(
+          actual_group_buffer_size, buffer_pool_layout, thread_idx_);
+      // Reused buffers got the same memory options on their first use.
+      if (pooled_buffer && pooled_buffer->isAllocated()) {
+        prepare_group_by_buffer_memory(pooled_buffer->data(),
+                                       actual_group_buffer_size,
+                                       executor->getConfig().mem.cpu);
+      }
+    }
+    auto group_by_buffer =
+        pooled_buffer ? reinterpret_cast<int64_t*>(pooled_buffer->data())
+                      : alloc_group_by_buffer(actual_group_buffer_size,
+                                              thread_idx_,
+                                              row_set_mem_owner_.get(),
+                                              executor->getConfig().mem.cpu);
+
+    if (!query_mem_desc.lazyInitGroups(device_type) &&
+        !(pooled_buffer && pooled_buffer->isInitialized())) {
+      init_group_by_buffer(group_by_buffer + index_buffer_qw);
+      if (pooled_buffer && init_pooled_buffers) {
+        pooled_buffer->setInitialized();
       }
     }
+    if (pooled_buffer) {
+      row_set_mem_owner_->addPooledBuffer(std::move(pooled_buffer));
+    }
 
     if (query_mem_desc.getQueryDescriptionType() ==
             QueryDescriptionType::GroupByBaselineHash &&
@@ -463,14 +548,14 @@ void QueryMemoryInitializer::initRowGroups(const QueryMemoryDescriptor& query_me
   const size_t col_base_off{query_mem_desc.getColOffInBytes(0)};
 
   auto agg_bitmap_size = allocateCountDistinctBuffers(query_mem_desc, true, executor);
-  auto quantile_params = allocateTDigests(query_mem_desc, true, executor);
+  auto quantile_params = allocateQuantiles(query_mem_desc, true, executor);
   auto buffer_ptr = reinterpret_cast<int8_t*>(groups_buffer);
 
   const auto query_mem_desc_fixedup =
       ResultSet::fixupQueryMemoryDescriptor(query_mem_desc);
 
   auto const is_true = [](auto const& x) { return static_cast<bool>(x); };
-  // not COUNT DISTINCT / APPROX_COUNT_DISTINCT / APPROX_QUANTILE
+  // not COUNT DISTINCT / APPROX_COUNT_DISTINCT / APPROX_QUANTILE / PERCENTILE_*
   // we fallback to default implementation in that cases
   if (!std::any_of(agg_bitmap_size.begin(), agg_bitmap_size.end(), is_true) &&
       !std::any_of(quantile_params.begin(), quantile_params.end(), is_true) &&
@@ -635,13 +720,17 @@ void QueryMemoryInitializer::initColumnsPerRow(
       // COUNT DISTINCT / APPROX_COUNT_DISTINCT
       CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                sizeof(int64_t));
-      init_val =
-          bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+      if (bm_sz > 0) {
+        init_val = allocateCountDistinctBitmap(bm_sz);
+      } else if (bm_sz == kRoaringBitmapSize) {
+        init_val = allocateCountDistinctRoaringBitmap();
+      } else {
+        init_val = allocateCountDistinctSet();
+      }
       ++init_vec_idx;
     } else if (query_mem_desc.isGroupBy() && quantile_params[col_idx]) {
-      auto const q = *quantile_params[col_idx];
-      // allocate for APPROX_QUANTILE only when slot is used
-      init_val = reinterpret_cast<int64_t>(row_set_mem_owner_->nullTDigest(q));
+      // allocate for quantiles only when slot is used
+      init_val = allocateQuantile(quantile_params[col_idx]);
       ++init_vec_idx;
     } else {
       if (query_mem_desc.getPaddedSlotWidthBytes(col_idx) > 0) {
@@ -718,7 +807,7 @@ std::vector<int64_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
     if (is_distinct_target(agg_info)) {
       CHECK(agg_info.is_agg &&
             (agg_info.agg_kind == hdk::ir::AggType::kCount ||
-             agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct));
+             hdk::ir::isHll(agg_info.agg_kind)));
       CHECK(!agg_info.type->isString() && !agg_info.type->isArray());
 
       const size_t agg_col_idx = query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
@@ -736,6 +825,12 @@ std::vector<int64_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
         }
+      } else if (count_distinct_desc.impl_type_ == CountDistinctImplType::RoaringBitmap) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = kRoaringBitmapSize;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctRoaringBitmap();
+        }
       } else {
         CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
         if (deferred) {
@@ -769,10 +864,16 @@ int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
+int64_t QueryMemoryInitializer::allocateCountDistinctRoaringBitmap() {
+  auto count_distinct_bitmap = new RoaringBitmap();
+  row_set_mem_owner_->addCountDistinctRoaringBitmap(count_distinct_bitmap);
+  return reinterpret_cast<int64_t>(count_distinct_bitmap);
+}
+
 std::vector<QueryMemoryInitializer::QuantileParam>
-QueryMemoryInitializer::allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
-                                         const bool deferred,
-                                         const Executor* executor) {
+QueryMemoryInitializer::allocateQuantiles(const QueryMemoryDescriptor& query_mem_desc,
+                                          const bool deferred,
+                                          const Executor* executor) {
   size_t const slot_count = query_mem_desc.getSlotCount();
   size_t const ntargets = executor->plan_state_->target_exprs_.size();
   CHECK_GE(slot_count, ntargets);
@@ -781,19 +882,19 @@ QueryMemoryInitializer::allocateTDigests(const QueryMemoryDescriptor& query_mem_
   for (size_t target_idx = 0; target_idx < ntargets; ++target_idx) {
     auto const target_expr = executor->plan_state_->target_exprs_[target_idx];
     if (auto const agg_expr = dynamic_cast<const hdk::ir::AggExpr*>(target_expr)) {
-      if (agg_expr->aggType() == hdk::ir::AggType::kApproxQuantile) {
+      if (hdk::ir::isQuantile(agg_expr->aggType())) {
         size_t const agg_col_idx =
             query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
         CHECK_LT(agg_col_idx, slot_count);
         CHECK_EQ(query_mem_desc.getLogicalSlotWidthBytes(agg_col_idx),
                  static_cast<int8_t>(sizeof(int64_t)));
         auto const q = agg_expr->arg1()->as<hdk::ir::Constant>()->value().doubleval;
+        QuantileParam param{std::make_pair(agg_expr->aggType(), q)};
         if (deferred) {
-          quantile_params[agg_col_idx] = q;
+          quantile_params[agg_col_idx] = param;
         } else {
-          // allocate for APPROX_QUANTILE only when slot is used
-          init_agg_vals_[agg_col_idx] =
-              reinterpret_cast<int64_t>(row_set_mem_owner_->nullTDigest(q));
+          // allocate for quantiles only when slot is used
+          init_agg_vals_[agg_col_idx] = allocateQuantile(param);
         }
       }
     }
@@ -801,6 +902,17 @@ QueryMemoryInitializer::allocateTDigests(const QueryMemoryDescriptor& query_mem_
   return quantile_params;
 }
 
+int64_t QueryMemoryInitializer::allocateQuantile(const QuantileParam& param) {
+  CHECK(param);
+  auto const [agg_kind, q] = *param;
+  if (hdk::ir::isExactQuantile(agg_kind)) {
+    bool const interpolate = agg_kind == hdk::ir::AggType::kPercentileCont;
+    return reinterpret_cast<int64_t>(
+        row_set_mem_owner_->nullExactQuantile(q, interpolate));
+  }
+  return reinterpret_cast<int64_t>(row_set_mem_owner_->nullTDigest(q));
+}
+
 GpuGroupByBuffers QueryMemoryInitializer::prepareTopNHeapsDevBuffer(
     const QueryMemoryDescriptor& query_mem_desc,
     const int8_t* init_agg_vals_dev_ptr,
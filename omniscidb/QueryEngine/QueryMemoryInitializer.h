@@ -121,7 +121,9 @@ class QueryMemoryInitializer {
                           const std::vector<int64_t>& init_vals,
                           const Executor* executor);
 
-  using QuantileParam = std::optional<double>;
+  // Aggregate kind and quantile for APPROX_QUANTILE, PERCENTILE_CONT and
+  // PERCENTILE_DISC slots.
+  using QuantileParam = std::optional<std::pair<hdk::ir::AggType, double>>;
   void initColumnsPerRow(const QueryMemoryDescriptor& query_mem_desc,
                          int8_t* row_ptr,
                          const std::vector<int64_t>& init_vals,
@@ -139,9 +141,14 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
-  std::vector<QuantileParam> allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
-                                              const bool deferred,
-                                              const Executor* executor);
+  int64_t allocateCountDistinctRoaringBitmap();
+
+  std::vector<QuantileParam> allocateQuantiles(
+      const QueryMemoryDescriptor& query_mem_desc,
+      const bool deferred,
+      const Executor* executor);
+
+  int64_t allocateQuantile(const QuantileParam& param);
 
   GpuGroupByBuffers prepareTopNHeapsDevBuffer(const QueryMemoryDescriptor& query_mem_desc,
                                               const int8_t* init_agg_vals_dev_ptr,
@@ -233,6 +233,8 @@ RelAlgExecutionUnit QueryRewriter::rewriteAggregateOnGroupByColumn(
               break;
             }
             case hdk::ir::AggType::kApproxQuantile:
+            case hdk::ir::AggType::kPercentileCont:
+            case hdk::ir::AggType::kPercentileDisc:
             case hdk::ir::AggType::kAvg:
             case hdk::ir::AggType::kSample:
             case hdk::ir::AggType::kMax:
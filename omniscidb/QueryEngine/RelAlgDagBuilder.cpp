@@ -27,6 +27,7 @@
 #include "JsonAccessors.h"
 #include "RelAlgDagBuilder.h"
 #include "RelAlgOptimizer.h"
+#include "ResultSet/HyperLogLog.h"
 #include "ResultSetRegistry/ResultSetRegistry.h"
 #include "ScalarExprVisitor.h"
 #include "Shared/sqldefs.h"
@@ -1305,6 +1306,16 @@ bool isAggSupportedForType(hdk::ir::AggType agg_kind, const hdk::ir::Type* arg_t
       !(arg_type->isNumber() || arg_type->isBoolean() || arg_type->isDateTime())) {
     return false;
   }
+  // Sketches are stored as TINYINT arrays of HyperLogLog registers.
+  if ((agg_kind == hdk::ir::AggType::kHllMerge ||
+       agg_kind == hdk::ir::AggType::kHllMergeCount) &&
+      !(arg_type->isArray() &&
+        arg_type->as<hdk::ir::ArrayBaseType>()->elemType()->isInt8())) {
+    return false;
+  }
+  if (agg_kind == hdk::ir::AggType::kHllSketch && arg_type->isBuffer()) {
+    return false;
+  }
 
   return true;
 }
@@ -1321,8 +1332,8 @@ hdk::ir::ExprPtr parseAggregateExpr(const rapidjson::Value& json_expr,
   auto is_distinct = json_bool(field(json_expr, "distinct"));
   auto operands = indices_from_json_array(field(json_expr, "operands"));
   if (operands.size() > 1 &&
-      (operands.size() != 2 || (agg_kind != hdk::ir::AggType::kApproxCountDistinct &&
-                                agg_kind != hdk::ir::AggType::kApproxQuantile))) {
+      (operands.size() != 2 ||
+       (!hdk::ir::isHll(agg_kind) && !hdk::ir::isQuantile(agg_kind)))) {
     throw hdk::ir::QueryNotSupported(
         "Multiple arguments for aggregates aren't supported");
   }
@@ -1343,11 +1354,27 @@ hdk::ir::ExprPtr parseAggregateExpr(const rapidjson::Value& json_expr,
             "APPROX_COUNT_DISTINCT's second parameter should be SMALLINT literal between "
             "1 and 100");
       }
-    } else if (agg_kind == hdk::ir::AggType::kApproxQuantile) {
-      // If second parameter is not given then APPROX_MEDIAN is assumed.
+    } else if (hdk::ir::isHll(agg_kind) && operands.size() == 2) {
+      arg1 = std::dynamic_pointer_cast<const hdk::ir::Constant>(sources[operands[1]]);
+      if (!arg1 || !arg1->type()->isInt32() ||
+          arg1->value().intval < kMinHllPrecisionBits ||
+          arg1->value().intval > kMaxHllPrecisionBits) {
+        throw std::runtime_error(agg_str +
+                                 "'s second parameter should be an integer literal "
+                                 "between " +
+                                 std::to_string(kMinHllPrecisionBits) + " and " +
+                                 std::to_string(kMaxHllPrecisionBits));
+      }
+    } else if (hdk::ir::isQuantile(agg_kind)) {
+      // If second parameter is not given then APPROX_MEDIAN or MEDIAN is assumed.
       if (operands.size() == 2) {
         arg1 = std::dynamic_pointer_cast<const hdk::ir::Constant>(
             sources[operands[1]]->cast(ctx.fp64()));
+        if (!arg1 || arg1->value().doubleval < 0.0 || arg1->value().doubleval > 1.0) {
+          throw std::runtime_error(agg_str +
+                                   "'s second parameter should be a literal between "
+                                   "0 and 1");
+        }
       } else {
         Datum median;
         median.doubleval = 0.5;
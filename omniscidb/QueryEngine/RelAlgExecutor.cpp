@@ -39,6 +39,7 @@
 #include "QueryEngine/WorkUnitBuilder.h"
 #include "QueryOptimizer/CanonicalizeQuery.h"
 #include "ResultSet/ColRangeInfo.h"
+#include "ResultSet/ExactQuantile.h"
 #include "ResultSet/HyperLogLog.h"
 #include "ResultSetRegistry/ResultSetRegistry.h"
 #include "SchemaMgr/SchemaMgr.h"
@@ -94,6 +95,49 @@ bool is_extracted_dag_valid(ExtractedPlanDag& dag) {
          dag.extracted_dag.compare(EMPTY_QUERY_PLAN) != 0;
 }
 
+// Returns EMPTY_HASHED_PLAN_DAG_KEY if the step result shouldn't be recycled.
+QueryPlanHash get_resultset_cache_key(const RelAlgExecutionUnit& ra_exe_unit,
+                                      const ExecutionOptions& eo,
+                                      const Config& config) {
+  if (!config.cache.enable_data_recycler || !config.cache.use_query_resultset_cache ||
+      eo.just_explain || eo.just_validate || eo.executor_type != ExecutorType::Native ||
+      ra_exe_unit.query_plan_dag.compare(EMPTY_QUERY_PLAN) == 0) {
+    return EMPTY_HASHED_PLAN_DAG_KEY;
+  }
+  // Options below affect the layout of the resulting table.
+  auto key = boost::hash_value(ra_exe_unit.query_plan_dag);
+  boost::hash_combine(key, eo.multifrag_result);
+  boost::hash_combine(key, eo.preserve_order);
+  return key;
+}
+
+QueryPlanHash get_cardinality_cache_key(const RelAlgExecutionUnit& ra_exe_unit,
+                                        CacheItemType item_type) {
+  if (ra_exe_unit.query_plan_dag.compare(EMPTY_QUERY_PLAN) != 0) {
+    return boost::hash_value(ra_exe_unit.query_plan_dag);
+  }
+  // NDV estimation is used as a hint for the groups buffer size only, so it can be
+  // keyed by the execution unit description when the query plan DAG is not available.
+  if (item_type == CacheItemType::NDV_CARD_EST) {
+    return boost::hash_value(ra_exec_unit_desc_for_caching(ra_exe_unit));
+  }
+  return EMPTY_HASHED_PLAN_DAG_KEY;
+}
+
+// Returns true if the execution unit reads a single physical table directly, so
+// the number of rows in its result is the number of rows selected by its filters.
+bool is_single_table_scan(const RelAlgExecutionUnit& ra_exe_unit,
+                          const hdk::ir::Node* body) {
+  if (ra_exe_unit.input_descs.size() != 1 || !ra_exe_unit.join_quals.empty()) {
+    return false;
+  }
+  const auto phys_table_ids = get_physical_table_inputs(body);
+  const auto& input_desc = ra_exe_unit.input_descs.front();
+  return phys_table_ids.size() == 1 &&
+         *phys_table_ids.begin() ==
+             std::make_pair(input_desc.getDatabaseId(), input_desc.getTableId());
+}
+
 }  // namespace
 
 RelAlgExecutor::RelAlgExecutor(Executor* executor, SchemaProviderPtr schema_provider)
@@ -135,6 +179,11 @@ RelAlgExecutor::RelAlgExecutor(Executor* executor,
 }
 
 RelAlgExecutor::~RelAlgExecutor() {
+  // Speculative compilation tasks refer to the query nodes and temporary tables.
+  for (auto& pr : speculative_compilations_) {
+    pr.second.wait();
+  }
+
   // We don't need temporary tables anymore. On desctruction we are going to lose
   // all tokens and have ResultSets removed from the ResultSetRegistry. But some
   // zero-copy Buffers might still live DataMgr and hold ResultSets alive. Here
@@ -412,6 +461,8 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
   // this join info needs to be maintained throughout an entire query runtime
   for (size_t i = 0; i < exec_desc_count; i++) {
     VLOG(1) << "Executing query step " << i;
+    collectSpeculativeCompilation(seq.step(i));
+    speculateStepsCompilation(seq, i + 1, co, eo);
     // When we execute the last step, we expect the result to consist of a single
     // ResultSet unless said otherwise by the config. Also, check if following steps
     // can consume multifrag input.
@@ -447,6 +498,8 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
     } catch (const RequestPartitionedAggregation& e) {
       executeStepWithPartitionedAggregation(
           seq.step(i), co, eo, e.estimatedBufferSize(), queue_time_ms);
+    } catch (const RequestTwoPhaseCountDistinct&) {
+      executeStepWithTwoPhaseCountDistinct(seq.step(i), co, eo, queue_time_ms);
     }
   }
 
@@ -656,6 +709,33 @@ bool shouldMaterializeShuffleInput(const hdk::ir::Node* node) {
   return !proj->isSimple() || shouldMaterializeShuffleInput(proj->getInput(0));
 }
 
+// Returns the aggregation of the step if it can be executed in two phases: grouped
+// aggregation which computes exact COUNT(DISTINCT) of a single input column only.
+const hdk::ir::Aggregate* get_two_phase_count_distinct_agg(
+    const hdk::ir::Node* step_root) {
+  auto sort = step_root->as<hdk::ir::Sort>();
+  auto agg = sort ? sort->getInput(0)->as<hdk::ir::Aggregate>()
+                  : step_root->as<hdk::ir::Aggregate>();
+  if (!agg || agg->isPartitioned() || !agg->getGroupByCount() || !agg->getAggsCount()) {
+    return nullptr;
+  }
+  std::optional<unsigned> arg_idx;
+  for (auto& expr : agg->getAggs()) {
+    auto agg_expr = expr->as<hdk::ir::AggExpr>();
+    if (!agg_expr || agg_expr->aggType() != hdk::ir::AggType::kCount ||
+        !agg_expr->isDistinct() || !agg_expr->arg()) {
+      return nullptr;
+    }
+    auto col_ref = agg_expr->arg()->as<hdk::ir::ColumnRef>();
+    if (!col_ref || col_ref->index() < agg->getGroupByCount() ||
+        (arg_idx && *arg_idx != col_ref->index())) {
+      return nullptr;
+    }
+    arg_idx = col_ref->index();
+  }
+  return agg;
+}
+
 }  // namespace
 
 hdk::ir::ExprPtr set_transient_dict(const hdk::ir::ExprPtr expr) {
@@ -838,6 +918,76 @@ void RelAlgExecutor::executeStepWithPartitionedAggregation(const hdk::ir::Node*
   temporary_tables_.erase(-new_root->getId());
 }
 
+void RelAlgExecutor::executeStepWithTwoPhaseCountDistinct(
+    const hdk::ir::Node* step_root,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const int64_t queue_time_ms) {
+  auto sort = step_root->as<hdk::ir::Sort>();
+  auto agg = get_two_phase_count_distinct_agg(step_root);
+  CHECK(agg);
+  ++two_phase_count_distinct_steps_;
+  const auto groupby_count = static_cast<unsigned>(agg->getGroupByCount());
+  const auto arg_idx =
+      agg->getAgg(0)->as<hdk::ir::AggExpr>()->arg()->as<hdk::ir::ColumnRef>()->index();
+
+  auto execute_step = [&](const hdk::ir::Node* node) {
+    try {
+      executeStep(node, co, eo, queue_time_ms);
+    } catch (const RequestPartitionedAggregation& e) {
+      executeStepWithPartitionedAggregation(
+          node, co, eo, e.estimatedBufferSize(), queue_time_ms);
+    }
+  };
+
+  // The first phase removes duplicated (keys, value) pairs. It is a regular group by
+  // which can use partitioned aggregation when the number of pairs is big.
+  auto agg_input = const_cast<hdk::ir::Aggregate*>(agg)->getAndOwnInput(0);
+  hdk::ir::ExprPtrVector exprs;
+  std::vector<std::string> fields;
+  for (unsigned i = 0; i < groupby_count; ++i) {
+    exprs.push_back(hdk::ir::getNodeColumnRef(agg_input.get(), i));
+    fields.push_back(agg_input->getFieldName(i));
+  }
+  exprs.push_back(hdk::ir::getNodeColumnRef(agg_input.get(), arg_idx));
+  fields.push_back(agg_input->getFieldName(arg_idx));
+  auto proj = std::make_shared<hdk::ir::Project>(std::move(exprs), fields, agg_input);
+  auto distinct_agg = std::make_shared<hdk::ir::Aggregate>(
+      groupby_count + 1, hdk::ir::ExprPtrVector(), std::move(fields), proj);
+  VLOG(1) << "Execute distinct aggregation for two-phase COUNT(DISTINCT).";
+  {
+    auto timer = DEBUG_TIMER("Two-phase COUNT(DISTINCT) distinct aggregation");
+    execute_step(distinct_agg.get());
+  }
+
+  // The second phase counts non-null values in each group.
+  auto value_ref = hdk::ir::getNodeColumnRef(distinct_agg.get(), groupby_count);
+  hdk::ir::ExprPtrVector count_aggs;
+  for (auto& agg_expr : agg->getAggs()) {
+    count_aggs.push_back(hdk::ir::makeExpr<hdk::ir::AggExpr>(
+        agg_expr->type(), hdk::ir::AggType::kCount, value_ref, false, nullptr));
+  }
+  auto count_agg = std::make_shared<hdk::ir::Aggregate>(
+      groupby_count, std::move(count_aggs), agg->getFields(), distinct_agg);
+  hdk::ir::NodePtr new_root = count_agg;
+  if (sort) {
+    new_root = sort->deepCopy();
+    new_root->replaceInput(new_root->getAndOwnInput(0), count_agg);
+  }
+  VLOG(1) << "Execute COUNT for two-phase COUNT(DISTINCT).";
+  {
+    auto timer = DEBUG_TIMER("Two-phase COUNT(DISTINCT) count");
+    execute_step(new_root.get());
+  }
+
+  // Register result as a temporary table for the original node.
+  addTemporaryTable(-step_root->getId(), new_root->getResult()->getToken());
+  step_root->setResult(new_root->getResult());
+  // Remove temporary tables we don't need anymore.
+  temporary_tables_.erase(-distinct_agg->getId());
+  temporary_tables_.erase(-new_root->getId());
+}
+
 void RelAlgExecutor::executeStep(const hdk::ir::Node* step_root,
                                  const CompilationOptions& co,
                                  const ExecutionOptions& eo,
@@ -875,6 +1025,46 @@ ExecutionResult RelAlgExecutor::executeStep(const hdk::ir::Node* step_root,
 
   WorkUnit work_unit = createWorkUnit(step_root, co, eo, allow_speculative_sort);
 
+  // Reuse the result of the same step computed for previous queries if its input
+  // tables haven't changed since then.
+  auto resultset_cache_key = get_resultset_cache_key(work_unit.exe_unit, eo, config_);
+  std::optional<ResultSetCacheMetaInfo> resultset_cache_meta_info;
+  if (resultset_cache_key != EMPTY_HASHED_PLAN_DAG_KEY) {
+    resultset_cache_meta_info = ResultSetCacheMetaInfo{
+        executor_->computeTableGenerations(get_physical_table_inputs(step_root))};
+    auto cached_token = executor_->getResultSetRecycler().getItemFromCache(
+        resultset_cache_key,
+        CacheItemType::ROW_RS,
+        RESULTSET_CACHE_DEVICE_IDENTIFIER,
+        resultset_cache_meta_info);
+    if (cached_token) {
+      VLOG(1) << "Reuse cached result for the step: " << cached_token->toString();
+      return {cached_token, step_root->getOutputMetainfo()};
+    }
+  }
+
+  auto clock_begin = timer_start();
+  auto res = executeStepWorkUnit(step_root, work_unit, co, eo, queue_time_ms);
+  if (resultset_cache_key != EMPTY_HASHED_PLAN_DAG_KEY && !res.empty() &&
+      !res.isFilterPushDownEnabled()) {
+    auto token = res.getToken();
+    executor_->getResultSetRecycler().putItemToCache(
+        resultset_cache_key,
+        token,
+        CacheItemType::ROW_RS,
+        RESULTSET_CACHE_DEVICE_IDENTIFIER,
+        ResultSetRecycler::getResultSetTableSize(*token),
+        timer_stop(clock_begin),
+        resultset_cache_meta_info);
+  }
+  return res;
+}
+
+ExecutionResult RelAlgExecutor::executeStepWorkUnit(const hdk::ir::Node* step_root,
+                                                    WorkUnit& work_unit,
+                                                    const CompilationOptions& co,
+                                                    const ExecutionOptions& eo,
+                                                    const int64_t queue_time_ms) {
   auto sort = step_root->as<hdk::ir::Sort>();
   ExecutionOptions eo_with_limit =
       eo.with_just_validate(eo.just_validate || (sort && sort->isEmptyResult()));
@@ -1227,16 +1417,8 @@ RelAlgExecutionUnit decide_approx_count_distinct_implementation(
     const auto bitmap_sz_bits = arg_range.getIntMax() - arg_range.getIntMin() + 1;
     const auto sub_bitmap_count =
         get_count_distinct_sub_bitmap_count(bitmap_sz_bits, ra_exe_unit, device_type);
-    int64_t approx_bitmap_sz_bits{0};
-    const auto error_rate =
-        agg_expr->arg1() ? agg_expr->arg1()->as<hdk::ir::Constant>() : nullptr;
-    if (error_rate) {
-      CHECK(error_rate->type()->isInt32());
-      CHECK_GE(error_rate->value().intval, 1);
-      approx_bitmap_sz_bits = hll_size_for_rate(error_rate->value().intval);
-    } else {
-      approx_bitmap_sz_bits = executor->getConfig().exec.group_by.hll_precision_bits;
-    }
+    const auto approx_bitmap_sz_bits =
+        get_hll_precision_bits(agg_expr, executor->getConfig());
     CountDistinctDescriptor approx_count_distinct_desc{CountDistinctImplType::Bitmap,
                                                        arg_range.getIntMin(),
                                                        approx_bitmap_sz_bits,
@@ -1314,6 +1496,12 @@ void maybeRequestPartitionedAggregation(const RelAlgExecutionUnit& ra_exe_unit,
     if (!expr->is<hdk::ir::ColumnVar>()) {
       entry_size += expr->type()->canonicalSize();
     }
+    // Exact quantiles allocate a values collector per group. Count it in to request
+    // partitioning earlier, which also avoids reduction copying collected values.
+    auto agg = expr->as<hdk::ir::AggExpr>();
+    if (agg && hdk::ir::isExactQuantile(agg->aggType())) {
+      entry_size += sizeof(ExactQuantile);
+    }
   }
   if (estimated_buffer_entries * entry_size <
       config.exec.group_by.partitioning_buffer_size_threshold) {
@@ -1348,6 +1536,170 @@ void maybeRequestPartitionedAggregation(const RelAlgExecutionUnit& ra_exe_unit,
           << config.exec.group_by.partitioning_group_size_threshold;
 }
 
+// Grouped COUNT(DISTINCT) falls back to a hash set per group when the value range
+// doesn't fit a dense or a roaring bitmap. For big inputs it's replaced with a
+// distinct aggregation on (keys, value) followed by COUNT of the value.
+void maybeRequestTwoPhaseCountDistinct(const RelAlgExecutionUnit& ra_exe_unit,
+                                       const hdk::ir::Node* step_root,
+                                       const std::vector<InputTableInfo>& table_infos,
+                                       const Executor* executor,
+                                       const Config& config) {
+  if (!config.exec.group_by.enable_two_phase_count_distinct ||
+      ra_exe_unit.partitioned_aggregation || table_infos.empty() ||
+      !get_two_phase_count_distinct_agg(step_root)) {
+    return;
+  }
+  if (table_infos.front().info.getNumTuplesUpperBound() <
+      config.exec.group_by.two_phase_count_distinct_threshold) {
+    return;
+  }
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    auto agg_expr = target_expr->as<hdk::ir::AggExpr>();
+    if (!agg_expr || !agg_expr->isDistinct()) {
+      continue;
+    }
+    auto arg_type = agg_expr->arg()->type();
+    if (!(arg_type->isNumber() || arg_type->isBoolean() || arg_type->isDateTime() ||
+          arg_type->isExtDictionary())) {
+      return;
+    }
+    const auto arg_range = getExpressionRange(agg_expr->arg(), table_infos, executor);
+    if (config.exec.group_by.enable_roaring_count_distinct &&
+        arg_range.getType() == ExpressionRangeType::Integer &&
+        arg_range.getIntMax() - arg_range.getIntMin() < (int64_t(1) << 32)) {
+      return;
+    }
+  }
+  LOG(INFO) << "Requesting two-phase COUNT(DISTINCT) (rows="
+            << table_infos.front().info.getNumTuplesUpperBound() << ")";
+  throw RequestTwoPhaseCountDistinct();
+}
+
+template <typename T>
+std::optional<Datum> find_top_n_threshold(const TableFragmentsInfo& fragments_info,
+                                          int col_id,
+                                          const hdk::ir::Type* col_type,
+                                          bool is_desc,
+                                          bool nulls_first,
+                                          size_t n) {
+  auto get_value = [col_type](const Datum& datum) -> T {
+    if constexpr (std::is_floating_point_v<T>) {
+      return extract_fp_type_from_datum(datum, col_type);
+    } else {
+      return extract_int_type_from_datum(datum, col_type);
+    }
+  };
+  // Every non-null value of a fragment is not worse than its worst stats value
+  // (min for descending order and max for ascending order).
+  std::vector<std::pair<Datum, size_t>> bounds;
+  for (auto& frag : fragments_info.fragments) {
+    auto meta_it = frag.getChunkMetadataMap().find(col_id);
+    if (meta_it == frag.getChunkMetadataMap().end()) {
+      return std::nullopt;
+    }
+    auto& meta = meta_it->second;
+    if (!meta->numElements()) {
+      continue;
+    }
+    auto& stats = meta->chunkStats();
+    if (stats.has_nulls) {
+      // Nulls might beat the threshold and would be filtered out by the
+      // threshold qual. Otherwise, we don't know how many rows in the fragment
+      // are not null, so they are not counted.
+      if (nulls_first) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    if (get_value(stats.min) > get_value(stats.max)) {
+      // invalid metadata range
+      return std::nullopt;
+    }
+    bounds.emplace_back(is_desc ? stats.min : stats.max, meta->numElements());
+  }
+  std::sort(bounds.begin(), bounds.end(), [&](const auto& lhs, const auto& rhs) {
+    return is_desc ? get_value(lhs.first) > get_value(rhs.first)
+                   : get_value(lhs.first) < get_value(rhs.first);
+  });
+  size_t rows = 0;
+  for (auto& [bound, num_elems] : bounds) {
+    rows += num_elems;
+    if (rows >= n) {
+      return bound;
+    }
+  }
+  return std::nullopt;
+}
+
+// For ORDER BY ... LIMIT n projections of a single table, chunk stats can prove
+// that at least n rows have the first order key not worse than some threshold
+// value. Rows with a worse key cannot get into the result, so a simple qual
+// comparing the key with the threshold is added to the execution unit. The qual
+// filters rows within fragments and allows fragment skipping to prune fragments
+// whose stats cannot beat the threshold. Only the first order key is used, so
+// any number of order keys is supported.
+RelAlgExecutionUnit add_top_n_threshold_qual(
+    const RelAlgExecutionUnit& ra_exe_unit_in,
+    const std::vector<InputTableInfo>& table_infos) {
+  const auto& sort_info = ra_exe_unit_in.sort_info;
+  if (!sort_info.limit || sort_info.order_entries.empty() ||
+      ra_exe_unit_in.input_descs.size() != 1 || table_infos.size() != 1 ||
+      exe_unit_has_quals(ra_exe_unit_in) || ra_exe_unit_in.groupby_exprs.size() != 1 ||
+      ra_exe_unit_in.groupby_exprs.front() || ra_exe_unit_in.estimator ||
+      ra_exe_unit_in.union_all || ra_exe_unit_in.shuffle_fn) {
+    return ra_exe_unit_in;
+  }
+  for (auto target_expr : ra_exe_unit_in.target_exprs) {
+    if (target_expr->is<hdk::ir::AggExpr>() ||
+        target_expr->is<hdk::ir::WindowFunction>()) {
+      return ra_exe_unit_in;
+    }
+  }
+
+  const auto& oe = sort_info.order_entries.front();
+  CHECK_GT(oe.tle_no, 0);
+  CHECK_LE(static_cast<size_t>(oe.tle_no), ra_exe_unit_in.target_exprs.size());
+  auto col_var = ra_exe_unit_in.target_exprs[oe.tle_no - 1]->as<hdk::ir::ColumnVar>();
+  if (!col_var || col_var->rteIdx() != 0 || col_var->isVirtual() ||
+      col_var->tableId() != ra_exe_unit_in.input_descs.front().getTableId()) {
+    return ra_exe_unit_in;
+  }
+  auto col_type = col_var->type();
+  const auto n = sort_info.limit + sort_info.offset;
+  std::optional<Datum> threshold;
+  if (col_type->isInteger() || col_type->isTimestamp()) {
+    threshold = find_top_n_threshold<int64_t>(table_infos.front().info,
+                                              col_var->columnId(),
+                                              col_type,
+                                              oe.is_desc,
+                                              oe.nulls_first,
+                                              n);
+  } else if (col_type->isFloatingPoint()) {
+    threshold = find_top_n_threshold<double>(table_infos.front().info,
+                                             col_var->columnId(),
+                                             col_type,
+                                             oe.is_desc,
+                                             oe.nulls_first,
+                                             n);
+  }
+  if (!threshold) {
+    return ra_exe_unit_in;
+  }
+
+  auto threshold_expr = hdk::ir::makeExpr<hdk::ir::Constant>(
+      col_type->withNullable(false), false, *threshold);
+  auto qual = hdk::ir::makeExpr<hdk::ir::BinOper>(
+      col_type->ctx().boolean(col_type->nullable()),
+      oe.is_desc ? hdk::ir::OpType::kGe : hdk::ir::OpType::kLe,
+      hdk::ir::Qualifier::kOne,
+      col_var->shared(),
+      threshold_expr);
+  VLOG(1) << "Use top-N threshold qual: " << qual->toString();
+  RelAlgExecutionUnit ra_exe_unit = ra_exe_unit_in;
+  ra_exe_unit.simple_quals.push_back(qual);
+  return ra_exe_unit;
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeWorkUnit(
@@ -1386,6 +1738,10 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   auto ra_exe_unit = decide_approx_count_distinct_implementation(
       work_unit.exe_unit, table_infos, executor_, co.device_type, target_exprs_owned_);
 
+  if (is_agg && !eo.just_explain && !eo.just_validate) {
+    maybeRequestTwoPhaseCountDistinct(ra_exe_unit, body, table_infos, executor_, config_);
+  }
+
   auto max_groups_buffer_entry_guess = work_unit.max_groups_buffer_entry_guess;
   if (is_window_execution_unit(ra_exe_unit)) {
     CHECK_EQ(table_infos.size(), size_t(1));
@@ -1408,6 +1764,10 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   }
 
+  if (config_.exec.enable_top_n_fragment_pruning && !eo.just_explain) {
+    ra_exe_unit = add_top_n_threshold_qual(ra_exe_unit, table_infos);
+  }
+
   if (g_columnar_large_projections) {
     const auto prefer_columnar = should_output_columnar(ra_exe_unit);
     if (prefer_columnar) {
@@ -1454,13 +1814,13 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   };
 
-  auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   try {
-    auto cached_cardinality = executor_->getCachedCardinality(cache_key);
-    auto card = cached_cardinality.second;
-    if (cached_cardinality.first && card >= 0) {
-      result = execute_and_handle_errors(
-          card, /*has_cardinality_estimation=*/true, /*has_ndv_estimation=*/false);
+    auto cached_cardinality =
+        getCachedCardinality(ra_exe_unit, body, CacheItemType::NDV_CARD_EST);
+    if (cached_cardinality) {
+      result = execute_and_handle_errors(*cached_cardinality,
+                                         /*has_cardinality_estimation=*/true,
+                                         /*has_ndv_estimation=*/false);
     } else {
       result = execute_and_handle_errors(
           max_groups_buffer_entry_guess,
@@ -1476,10 +1836,11 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   } catch (const CardinalityEstimationRequired& e) {
     // check the cardinality cache
-    auto cached_cardinality = executor_->getCachedCardinality(cache_key);
-    auto card = cached_cardinality.second;
-    if (cached_cardinality.first && card >= 0) {
-      result = execute_and_handle_errors(card, true, /*has_ndv_estimation=*/true);
+    auto cached_cardinality =
+        getCachedCardinality(ra_exe_unit, body, CacheItemType::NDV_CARD_EST);
+    if (cached_cardinality) {
+      result = execute_and_handle_errors(
+          *cached_cardinality, true, /*has_ndv_estimation=*/true);
     } else {
       const auto ndv_groups_estimation =
           getNDVEstimation(work_unit, e.range(), is_agg, co, eo);
@@ -1493,18 +1854,247 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       result = execute_and_handle_errors(
           estimated_groups_buffer_entry_guess, true, /*has_ndv_estimation=*/true);
       if (!(eo.just_validate || eo.just_explain)) {
-        executor_->addToCardinalityCache(cache_key, estimated_groups_buffer_entry_guess);
+        addToCardinalityCache(ra_exe_unit,
+                              body,
+                              CacheItemType::NDV_CARD_EST,
+                              estimated_groups_buffer_entry_guess);
       }
     }
   }
 
+  // Number of rows passed through filters of a projection is an exact filtered
+  // count for later executions of the same step, so we can skip the pre-flight
+  // count query.
+  if (compute_output_buffer_size(work_unit.exe_unit) && !work_unit.exe_unit.scan_limit &&
+      !ra_exe_unit.sort_info.limit && !ra_exe_unit.sort_info.offset &&
+      !(eo.just_validate || eo.just_explain) && !result.empty() &&
+      !is_window_execution_unit(ra_exe_unit) && is_single_table_scan(ra_exe_unit, body)) {
+    addToCardinalityCache(
+        ra_exe_unit, body, CacheItemType::FILTER_SEL, result.getToken()->rowCount());
+  }
+
   return result;
 }
 
+namespace {
+
+// Returns true if the step reads a single physical table or a result of an already
+// executed step through projections, filters and aggregations. Compilation of joins,
+// unions and window functions requires input data, so they are not considered.
+bool has_available_input(const hdk::ir::Node* node,
+                         const std::unordered_set<const hdk::ir::Node*>& steps,
+                         bool is_step_root) {
+  if (!is_step_root) {
+    if (node->getResult()) {
+      // Projections of a sorted result take the scan limit from its row count.
+      return !node->is<hdk::ir::Sort>();
+    }
+    if (steps.count(node)) {
+      return false;
+    }
+  }
+  if (node->is<hdk::ir::Scan>()) {
+    return true;
+  }
+  if (node->inputCount() != 1 ||
+      !(node->is<hdk::ir::Project>() || node->is<hdk::ir::Filter>() ||
+        node->is<hdk::ir::Aggregate>() || node->is<hdk::ir::Sort>())) {
+    return false;
+  }
+  if (auto project = node->as<hdk::ir::Project>()) {
+    if (project->hasWindowFunctionExpr()) {
+      return false;
+    }
+  }
+  return has_available_input(node->getInput(0), steps, false);
+}
+
+}  // namespace
+
+void RelAlgExecutor::speculateStepsCompilation(const hdk::QueryExecutionSequence& seq,
+                                               size_t first_step,
+                                               const CompilationOptions& co,
+                                               const ExecutionOptions& eo) {
+  if (!config_.exec.codegen.enable_speculative_compilation ||
+      co.device_type != ExecutorDeviceType::CPU ||
+      eo.executor_type != ::ExecutorType::Native || eo.just_explain ||
+      eo.just_validate || eo.find_push_down_candidates) {
+    return;
+  }
+  std::unordered_set<const hdk::ir::Node*> steps(seq.steps().begin(),
+                                                 seq.steps().end());
+  for (size_t i = first_step; i < seq.size(); ++i) {
+    auto step_root = seq.step(i);
+    if (step_root->getResult() || speculative_compilations_.count(step_root) ||
+        !has_available_input(step_root, steps, true)) {
+      continue;
+    }
+    speculateStepCompilation(step_root, co, eo);
+  }
+}
+
+void RelAlgExecutor::speculateStepCompilation(const hdk::ir::Node* step_root,
+                                              const CompilationOptions& co,
+                                              const ExecutionOptions& eo) {
+  auto timer = DEBUG_TIMER(__func__);
+  // Prepare the execution unit the same way executeStep does, so the generated code
+  // matches and is found in the code cache. Steps which would require a query
+  // execution to prepare (e.g. a filtered count for the output buffer size) are
+  // skipped.
+  try {
+    auto sort = step_root->as<hdk::ir::Sort>();
+    if (sort && sort->isEmptyResult()) {
+      return;
+    }
+    auto work_unit = std::make_shared<WorkUnit>(createWorkUnit(step_root, co, eo, true));
+    auto step_eo = eo;
+    if (sort) {
+      step_eo.multifrag_result = false;
+    }
+
+    auto table_infos = get_table_infos(work_unit->exe_unit, executor_);
+    auto ra_exe_unit = decide_approx_count_distinct_implementation(
+        work_unit->exe_unit, table_infos, executor_, co.device_type, target_exprs_owned_);
+    if (is_agg_step(step_root)) {
+      maybeRequestTwoPhaseCountDistinct(
+          ra_exe_unit, step_root, table_infos, executor_, config_);
+    }
+    if (compute_output_buffer_size(ra_exe_unit) && !isRowidLookup(*work_unit)) {
+      std::optional<size_t> filtered_count;
+      for (auto item_type :
+           {CacheItemType::COUNTALL_CARD_EST, CacheItemType::FILTER_SEL}) {
+        if (!filtered_count) {
+          filtered_count =
+              getCachedCardinality(work_unit->exe_unit, step_root, item_type);
+        }
+      }
+      if (!filtered_count) {
+        return;
+      }
+      ra_exe_unit.scan_limit = std::max(*filtered_count, size_t(1));
+    }
+    if (config_.exec.enable_top_n_fragment_pruning) {
+      ra_exe_unit = add_top_n_threshold_qual(ra_exe_unit, table_infos);
+    }
+    if (g_columnar_large_projections && should_output_columnar(ra_exe_unit)) {
+      step_eo.output_columnar_hint = true;
+    }
+
+    auto max_groups_buffer_entry_guess = work_unit->max_groups_buffer_entry_guess;
+    bool has_cardinality_estimation = ra_exe_unit.partitioned_aggregation ||
+                                      groups_approx_upper_bound(table_infos) <=
+                                          config_.exec.group_by.big_group_threshold;
+    auto cached_cardinality =
+        getCachedCardinality(ra_exe_unit, step_root, CacheItemType::NDV_CARD_EST);
+    if (cached_cardinality) {
+      max_groups_buffer_entry_guess = *cached_cardinality;
+      has_cardinality_estimation = true;
+    }
+
+    VLOG(1) << "Starting speculative compilation of the step:\n"
+            << treeToString(step_root, true);
+    speculative_compilations_[step_root] = std::async(
+        std::launch::async,
+        [this,
+         work_unit,
+         ra_exe_unit,
+         target_exprs_owned = target_exprs_owned_,
+         table_infos = std::move(table_infos),
+         temporary_tables = temporary_tables_,
+         agg_col_range = executor_->agg_col_range_cache_,
+         string_dictionary_generations = executor_->string_dictionary_generations_,
+         table_generations = executor_->table_generations_,
+         co,
+         step_eo,
+         max_groups_buffer_entry_guess,
+         has_cardinality_estimation]() {
+          try {
+            auto executor_and_lock = executor_->acquireSpeculativeExecutor();
+            auto executor = executor_and_lock.first;
+            ScopeGuard reset_executor_state = [executor] {
+              executor->row_set_mem_owner_ = nullptr;
+              executor->temporary_tables_ = nullptr;
+              executor->clearMetaInfoCache();
+            };
+            executor->setSchemaProvider(schema_provider_);
+            executor->temporary_tables_ = &temporary_tables;
+            executor->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>(
+                data_provider_, Executor::getArenaBlockSize(), cpu_threads());
+            executor->agg_col_range_cache_ = agg_col_range;
+            executor->string_dictionary_generations_ = string_dictionary_generations;
+            executor->table_generations_ = table_generations;
+            executor->compileWorkUnitForCache(table_infos,
+                                              ra_exe_unit,
+                                              co,
+                                              step_eo,
+                                              max_groups_buffer_entry_guess,
+                                              has_cardinality_estimation,
+                                              data_provider_);
+          } catch (const std::exception& e) {
+            VLOG(1) << "Speculative compilation failed: " << e.what();
+          }
+        });
+  } catch (const std::exception& e) {
+    VLOG(1) << "Skipped speculative compilation of the step: " << e.what();
+  }
+}
+
+void RelAlgExecutor::collectSpeculativeCompilation(const hdk::ir::Node* step_root) {
+  auto it = speculative_compilations_.find(step_root);
+  // An unfinished compilation is kept until the executor is destroyed. The step is
+  // compiled as usual meanwhile, the code cache makes it wait only if the same code
+  // is being generated right now.
+  if (it != speculative_compilations_.end() &&
+      it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    speculative_compilations_.erase(it);
+  }
+}
+
+std::optional<size_t> RelAlgExecutor::getCachedCardinality(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const hdk::ir::Node* body,
+    CacheItemType item_type) {
+  if (!config_.cache.enable_data_recycler || !config_.cache.use_estimator_result_cache) {
+    return std::nullopt;
+  }
+  auto key = get_cardinality_cache_key(ra_exe_unit, item_type);
+  if (key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return std::nullopt;
+  }
+  CardinalityCacheMetaInfo meta_info{
+      executor_->computeTableGenerations(get_physical_table_inputs(body))};
+  return executor_->getCardinalityRecycler().getItemFromCache(
+      key, item_type, CARDINALITY_CACHE_DEVICE_IDENTIFIER, meta_info);
+}
+
+void RelAlgExecutor::addToCardinalityCache(const RelAlgExecutionUnit& ra_exe_unit,
+                                           const hdk::ir::Node* body,
+                                           CacheItemType item_type,
+                                           size_t value) {
+  if (!config_.cache.enable_data_recycler || !config_.cache.use_estimator_result_cache) {
+    return;
+  }
+  auto key = get_cardinality_cache_key(ra_exe_unit, item_type);
+  if (key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  CardinalityCacheMetaInfo meta_info{
+      executor_->computeTableGenerations(get_physical_table_inputs(body))};
+  executor_->getCardinalityRecycler().putItemToCache(
+      key, value, item_type, CARDINALITY_CACHE_DEVICE_IDENTIFIER, 0, 0, meta_info);
+}
+
 std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_unit,
                                                           const bool is_agg,
                                                           const CompilationOptions& co,
                                                           const ExecutionOptions& eo) {
+  for (auto item_type : {CacheItemType::COUNTALL_CARD_EST, CacheItemType::FILTER_SEL}) {
+    auto cached_count =
+        getCachedCardinality(work_unit.exe_unit, work_unit.body, item_type);
+    if (cached_count) {
+      return std::max(*cached_count, size_t(1));
+    }
+  }
   const auto count = hdk::ir::makeExpr<hdk::ir::AggExpr>(
       hdk::ir::Context::defaultCtx().integer(config_.exec.group_by.bigint_count ? 8 : 4),
       hdk::ir::AggType::kCount,
@@ -1544,6 +2134,12 @@ std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_u
   CHECK(count_ptr);
   CHECK_GE(*count_ptr, 0);
   auto count_upper_bound = static_cast<size_t>(*count_ptr);
+  if (!(eo.just_validate || eo.just_explain)) {
+    addToCardinalityCache(work_unit.exe_unit,
+                          work_unit.body,
+                          CacheItemType::COUNTALL_CARD_EST,
+                          count_upper_bound);
+  }
   return std::max(count_upper_bound, size_t(1));
 }
 
@@ -1747,6 +2343,9 @@ ErrorInfo getErrorDescription(const int32_t error_code) {
     case Executor::ERR_WIDTH_BUCKET_INVALID_ARGUMENT:
       return {"ERR_WIDTH_BUCKET_INVALID_ARGUMENT",
               "Arguments of WIDTH_BUCKET function does not satisfy the condition"};
+    case Executor::ERR_HLL_SKETCH_PRECISION:
+      return {"ERR_HLL_SKETCH_PRECISION",
+              "HyperLogLog sketch has a lower precision than requested for the merge"};
     default:
       return {nullptr, nullptr};
   }
@@ -32,6 +32,7 @@
 #include "Shared/scope.h"
 
 #include <ctime>
+#include <future>
 #include <sstream>
 
 enum class MergeType { Union, Reduce };
@@ -115,6 +116,9 @@ class RelAlgExecutor {
     return speculative_topn_blacklist_;
   }
 
+  // Number of steps executed as two-phase COUNT(DISTINCT).
+  size_t getTwoPhaseCountDistinctSteps() const { return two_phase_count_distinct_steps_; }
+
  private:
   RelAlgExecutor(Executor* executor, SchemaProviderPtr schema_provider);
 
@@ -131,6 +135,10 @@ class RelAlgExecutor {
                                              const ExecutionOptions& eo,
                                              size_t estimated_buffer_size,
                                              const int64_t queue_time_ms);
+  void executeStepWithTwoPhaseCountDistinct(const hdk::ir::Node* step_root,
+                                            const CompilationOptions& co,
+                                            const ExecutionOptions& eo,
+                                            const int64_t queue_time_ms);
   ExecutionResult executeStep(const hdk::ir::Node* step_root,
                               const CompilationOptions& co,
                               const ExecutionOptions& eo,
@@ -157,6 +165,19 @@ class RelAlgExecutor {
   ExecutionResult executeLogicalValues(const hdk::ir::LogicalValues*,
                                        const ExecutionOptions&);
 
+  // Starts background compilation of later steps which inputs are already available,
+  // so their code is taken from the code cache when they are executed.
+  void speculateStepsCompilation(const hdk::QueryExecutionSequence& seq,
+                                 size_t first_step,
+                                 const CompilationOptions& co,
+                                 const ExecutionOptions& eo);
+  void speculateStepCompilation(const hdk::ir::Node* step_root,
+                                const CompilationOptions& co,
+                                const ExecutionOptions& eo);
+  // Drops the speculative compilation of the step if it is finished. Never waits for
+  // it, so the step execution is not delayed.
+  void collectSpeculativeCompilation(const hdk::ir::Node* step_root);
+
   // TODO(alex): just move max_groups_buffer_entry_guess to RelAlgExecutionUnit once
   //             we deprecate the plan-based executor paths and remove WorkUnit
   struct WorkUnit {
@@ -168,6 +189,12 @@ class RelAlgExecutor {
     const std::vector<size_t> left_deep_join_input_sizes;
   };
 
+  ExecutionResult executeStepWorkUnit(const hdk::ir::Node* step_root,
+                                      WorkUnit& work_unit,
+                                      const CompilationOptions& co,
+                                      const ExecutionOptions& eo,
+                                      const int64_t queue_time_ms);
+
   ExecutionResult executeWorkUnit(
       const WorkUnit& work_unit,
       const std::vector<hdk::ir::TargetMetaInfo>& targets_meta,
@@ -188,6 +215,15 @@ class RelAlgExecutor {
                                             const CompilationOptions& co,
                                             const ExecutionOptions& eo);
 
+  std::optional<size_t> getCachedCardinality(const RelAlgExecutionUnit& ra_exe_unit,
+                                             const hdk::ir::Node* body,
+                                             CacheItemType item_type);
+
+  void addToCardinalityCache(const RelAlgExecutionUnit& ra_exe_unit,
+                             const hdk::ir::Node* body,
+                             CacheItemType item_type,
+                             size_t value);
+
   FilterSelectivity getFilterSelectivity(
       const std::vector<hdk::ir::ExprPtr>& filter_expressions,
       const CompilationOptions& co,
@@ -258,6 +294,10 @@ class RelAlgExecutor {
 
   TemplateAggregationVisitor templVisitor;
 
+  std::unordered_map<const hdk::ir::Node*, std::future<void>> speculative_compilations_;
+
+  size_t two_phase_count_distinct_steps_ = 0;
+
   friend class PendingExecutionClosure;
 };
 
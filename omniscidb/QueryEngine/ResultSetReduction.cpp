@@ -30,6 +30,7 @@
 #include "RuntimeFunctions.h"
 
 #include "ResultSet/CountDistinct.h"
+#include "ResultSet/ExactQuantile.h"
 #include "ResultSet/ResultSet.h"
 #include "Shared/SqlTypesLayout.h"
 #include "Shared/likely.h"
@@ -1261,7 +1262,10 @@ void ResultSetReduction::reduceOneSlot(
   } else if (target_info.is_agg && target_info.agg_kind != hdk::ir::AggType::kSample) {
     switch (target_info.agg_kind) {
       case hdk::ir::AggType::kCount:
-      case hdk::ir::AggType::kApproxCountDistinct: {
+      case hdk::ir::AggType::kApproxCountDistinct:
+      case hdk::ir::AggType::kHllSketch:
+      case hdk::ir::AggType::kHllMerge:
+      case hdk::ir::AggType::kHllMergeCount: {
         if (is_distinct_target(target_info)) {
           CHECK_EQ(static_cast<size_t>(chosen_bytes), sizeof(int64_t));
           reduceOneCountDistinctSlot(
@@ -1309,6 +1313,11 @@ void ResultSetReduction::reduceOneSlot(
         reduceOneApproxQuantileSlot(
             query_mem_desc, this_ptr1, that_ptr1, target_logical_idx);
         break;
+      case hdk::ir::AggType::kPercentileCont:
+      case hdk::ir::AggType::kPercentileDisc:
+        CHECK_EQ(static_cast<int8_t>(sizeof(int64_t)), chosen_bytes);
+        reduceOneExactQuantileSlot(this_ptr1, that_ptr1);
+        break;
       default:
         UNREACHABLE() << toString(target_info.agg_kind);
     }
@@ -1398,6 +1407,18 @@ void ResultSetReduction::reduceOneApproxQuantileSlot(
   }
 }
 
+void ResultSetReduction::reduceOneExactQuantileSlot(int8_t* this_ptr1,
+                                                    const int8_t* that_ptr1) {
+  static_assert(sizeof(int64_t) == sizeof(ExactQuantile*));
+  auto* incoming = *reinterpret_cast<ExactQuantile* const*>(that_ptr1);
+  auto* accumulator = *reinterpret_cast<ExactQuantile**>(this_ptr1);
+  CHECK(incoming);
+  CHECK(accumulator);
+  if (incoming != accumulator) {
+    accumulator->merge(*incoming);
+  }
+}
+
 void ResultSetReduction::reduceOneCountDistinctSlot(const ResultSetStorage& this_,
                                                     const ResultSetStorage& that,
                                                     int8_t* this_ptr1,
@@ -1452,7 +1473,7 @@ bool ResultSetReduction::reduceSingleRow(const int8_t* row_ptr,
         CHECK_EQ(int8_t(1), warp_count);
         CHECK(agg_info.is_agg &&
               (agg_info.agg_kind == hdk::ir::AggType::kCount ||
-               agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct));
+               hdk::ir::isHll(agg_info.agg_kind)));
         partial_bin_val = count_distinct_set_size(
             partial_bin_val, query_mem_desc.getCountDistinctDescriptor(target_idx));
         if (replace_bitmap_ptr_with_bitmap_sz) {
@@ -1492,6 +1513,9 @@ bool ResultSetReduction::reduceSingleRow(const int8_t* row_ptr,
           switch (agg_info.agg_kind) {
             case hdk::ir::AggType::kCount:
             case hdk::ir::AggType::kApproxCountDistinct:
+            case hdk::ir::AggType::kHllSketch:
+            case hdk::ir::AggType::kHllMerge:
+            case hdk::ir::AggType::kHllMergeCount:
               AGGREGATE_ONE_NULLABLE_COUNT(
                   reinterpret_cast<int8_t*>(&agg_vals[agg_col_idx]),
                   reinterpret_cast<int8_t*>(&partial_agg_vals[agg_col_idx]),
@@ -100,6 +100,7 @@ class ResultSetReduction {
                                           int8_t* this_ptr1,
                                           const int8_t* that_ptr1,
                                           const size_t target_logical_idx);
+  static void reduceOneExactQuantileSlot(int8_t* this_ptr1, const int8_t* that_ptr1);
   static void reduceOneCountDistinctSlot(const ResultSetStorage& this_,
                                          const ResultSetStorage& that,
                                          int8_t* this_ptr1,
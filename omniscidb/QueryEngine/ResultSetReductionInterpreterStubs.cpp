@@ -212,6 +212,8 @@ StubGenerator::Stub StubGenerator::generateStub(const std::string& name,
   auto cgen_state = executor->getCgenStatePtr();
   cgen_state->set_module_shallow_copy(
       executor->getExtensionModuleContext()->getRTModule(/*is_l0=*/false));
+  cgen_state->use_runtime_dylib_ =
+      executor->getConfig().exec.codegen.enable_runtime_dylib;
   const auto function = create_stub_function(stub_name, cgen_state);
   CHECK(function);
   auto& ctx = cgen_state->context_;
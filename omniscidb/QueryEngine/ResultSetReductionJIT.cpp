@@ -25,6 +25,7 @@
 #include "LLVMFunctionAttributesUtil.h"
 
 #include "ResultSet/CountDistinct.h"
+#include "ResultSet/ExactQuantile.h"
 #include "Shared/likely.h"
 #include "Shared/quantile.h"
 
@@ -470,6 +471,15 @@ extern "C" RUNTIME_EXPORT void approx_quantile_jit_rt(const int64_t new_set_hand
   }
 }
 
+extern "C" RUNTIME_EXPORT void exact_quantile_jit_rt(const int64_t new_set_handle,
+                                                     const int64_t old_set_handle) {
+  auto* incoming = reinterpret_cast<ExactQuantile*>(new_set_handle);
+  auto* accumulator = reinterpret_cast<ExactQuantile*>(old_set_handle);
+  if (incoming != accumulator) {
+    accumulator->merge(*incoming);
+  }
+}
+
 extern "C" RUNTIME_EXPORT void get_group_value_reduction_rt(
     int8_t* groups_buffer,
     const int8_t* key,
@@ -608,6 +618,8 @@ ReductionCode ResultSetReductionJIT::codegen() const {
   auto cgen_state = reduction_code.cgen_state = cgen_state_.get();
   cgen_state->set_module_shallow_copy(
       executor_->getExtensionModuleContext()->getRTModule(/*is_l0=*/false));
+  cgen_state->use_runtime_dylib_ =
+      executor_->getConfig().exec.codegen.enable_runtime_dylib;
   reduction_code.module = cgen_state->module_;
 
   AUTOMATIC_IR_METADATA(cgen_state);
@@ -1153,7 +1165,10 @@ void ResultSetReductionJIT::reduceOneAggregateSlot(Value* this_ptr1,
                                                    Function* ir_reduce_one_entry) const {
   switch (target_info.agg_kind) {
     case hdk::ir::AggType::kCount:
-    case hdk::ir::AggType::kApproxCountDistinct: {
+    case hdk::ir::AggType::kApproxCountDistinct:
+    case hdk::ir::AggType::kHllSketch:
+    case hdk::ir::AggType::kHllMerge:
+    case hdk::ir::AggType::kHllMergeCount: {
       if (is_distinct_target(target_info)) {
         CHECK_EQ(static_cast<size_t>(chosen_bytes), sizeof(int64_t));
         reduceOneCountDistinctSlot(
@@ -1169,6 +1184,11 @@ void ResultSetReductionJIT::reduceOneAggregateSlot(Value* this_ptr1,
       reduceOneApproxQuantileSlot(
           this_ptr1, that_ptr1, target_logical_idx, ir_reduce_one_entry);
       break;
+    case hdk::ir::AggType::kPercentileCont:
+    case hdk::ir::AggType::kPercentileDisc:
+      CHECK_EQ(chosen_bytes, static_cast<int8_t>(sizeof(int64_t)));
+      reduceOneExactQuantileSlot(this_ptr1, that_ptr1, ir_reduce_one_entry);
+      break;
     case hdk::ir::AggType::kAvg: {
       // Ignore float argument compaction for count component for fear of its overflow
       emit_aggregate_one_count(this_ptr2,
@@ -1256,6 +1276,19 @@ void ResultSetReductionJIT::reduceOneApproxQuantileSlot(
       "");
 }
 
+void ResultSetReductionJIT::reduceOneExactQuantileSlot(
+    Value* this_ptr1,
+    Value* that_ptr1,
+    Function* ir_reduce_one_entry) const {
+  const auto old_set_handle = emit_load_i64(this_ptr1, ir_reduce_one_entry);
+  const auto new_set_handle = emit_load_i64(that_ptr1, ir_reduce_one_entry);
+  ir_reduce_one_entry->add<ExternalCall>(
+      "exact_quantile_jit_rt",
+      Type::Void,
+      std::vector<const Value*>{new_set_handle, old_set_handle},
+      "");
+}
+
 void ResultSetReductionJIT::finalizeReductionCode(
     ReductionCode& reduction_code,
     const llvm::Function* ir_is_empty,
@@ -125,6 +125,10 @@ class ResultSetReductionJIT {
                                    const size_t target_logical_idx,
                                    Function* ir_reduce_one_entry) const;
 
+  void reduceOneExactQuantileSlot(Value* this_ptr1,
+                                  Value* that_ptr1,
+                                  Function* ir_reduce_one_entry) const;
+
   void finalizeReductionCode(ReductionCode& reduction_code,
                              const llvm::Function* ir_is_empty,
                              const llvm::Function* ir_reduce_one_entry,
@@ -243,8 +243,8 @@ ApproxQuantileBuffers
 ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeApproxQuantileColumns() const {
   ApproxQuantileBuffers approx_quantile_materialized_buffers;
   for (const auto& order_entry : order_entries_) {
-    if (result_set_->getTargetInfos()[order_entry.tle_no - 1].agg_kind ==
-        hdk::ir::AggType::kApproxQuantile) {
+    if (hdk::ir::isQuantile(
+            result_set_->getTargetInfos()[order_entry.tle_no - 1].agg_kind)) {
       approx_quantile_materialized_buffers.emplace_back(
           materializeApproxQuantileColumn(order_entry));
     }
@@ -299,6 +299,8 @@ ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeApproxQuantileColumn(
   ApproxQuantileBuffers::value_type materialized_buffer(
       result_set_->getQueryMemDesc().getEntryCount());
   const size_t size = permutation_.size();
+  const bool is_exact = hdk::ir::isExactQuantile(
+      result_set_->getTargetInfos()[order_entry.tle_no - 1].agg_kind);
   const auto work = [&, query_id = logger::query_id()](const size_t start,
                                                        const size_t end) {
     auto qid_scope_guard = logger::set_thread_local_query_id(query_id);
@@ -311,10 +313,15 @@ ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeApproxQuantileColumn(
                                                        off,
                                                        order_entry.tle_no - 1,
                                                        storage_lookup_result);
-      materialized_buffer[permuted_idx] =
-          value.i1 ? ResultSet::calculateQuantile(
-                         reinterpret_cast<quantile::TDigest*>(value.i1))
-                   : NULL_DOUBLE;
+      if (!value.i1) {
+        materialized_buffer[permuted_idx] = NULL_DOUBLE;
+      } else if (is_exact) {
+        materialized_buffer[permuted_idx] = ResultSet::calculateQuantile(
+            reinterpret_cast<const ExactQuantile*>(value.i1));
+      } else {
+        materialized_buffer[permuted_idx] = ResultSet::calculateQuantile(
+            reinterpret_cast<quantile::TDigest*>(value.i1));
+      }
     }
   };
   if (single_threaded_) {
@@ -378,7 +385,7 @@ bool ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
         continue;
       }
       return (lhs_sz < rhs_sz) != order_entry.is_desc;
-    } else if (UNLIKELY(agg_info.agg_kind == hdk::ir::AggType::kApproxQuantile)) {
+    } else if (UNLIKELY(hdk::ir::isQuantile(agg_info.agg_kind))) {
       CHECK_LT(materialized_approx_quantile_buffer_idx,
                approx_quantile_materialized_buffers_.size());
       const auto& approx_quantile_materialized_buffer =
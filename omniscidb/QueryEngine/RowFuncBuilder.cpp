@@ -44,7 +44,9 @@
 #include "QueryEngine/TargetExprBuilder.h"
 #include "QueryEngine/TopKSort.h"
 #include "QueryEngine/WindowContext.h"
+#include "ResultSet/ExactQuantile.h"
 #include "ResultSet/QueryMemoryDescriptor.h"
+#include "ResultSet/RoaringBitmap.h"
 #include "Shared/MathUtils.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
@@ -273,6 +275,9 @@ llvm::Value* RowFuncBuilder::codegenOutputSlot(
                                     : query_mem_desc.getRowSize() / sizeof(int64_t);
   CodeGenerator code_generator(executor_, co.codegen_traits_desc);
   if (query_mem_desc.useStreamingTopN()) {
+    if (use_composite_streaming_top_n_key(ra_exe_unit_)) {
+      return codegenCompositeTopNOutputSlot(groups_buffer, query_mem_desc, co);
+    }
     const auto& only_order_entry = ra_exe_unit_.sort_info.order_entries.front();
     CHECK_GE(only_order_entry.tle_no, int(1));
     const size_t target_idx = only_order_entry.tle_no - 1;
@@ -341,6 +346,109 @@ llvm::Value* RowFuncBuilder::codegenOutputSlot(
   }
 }
 
+llvm::Value* RowFuncBuilder::codegenCompositeTopNOutputSlot(
+    llvm::Value* groups_buffer,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  CHECK(!query_mem_desc.didOutputColumnar());
+  const auto& order_entries = ra_exe_unit_.sort_info.order_entries;
+  const uint32_t key_count = order_entries.size();
+  // each key component is passed as a pair of values: slot bits (or a string
+  // payload pointer) and a string length
+  auto keys_lv = LL_BUILDER.CreateAlloca(llvm::Type::getInt64Ty(LL_CONTEXT),
+                                         LL_INT(static_cast<int32_t>(2 * key_count)));
+  auto store_key_value = [&](llvm::Value* val, const int32_t idx) {
+    LL_BUILDER.CreateStore(
+        val,
+        LL_BUILDER.CreateGEP(llvm::Type::getInt64Ty(LL_CONTEXT), keys_lv, LL_INT(idx)));
+  };
+  CodeGenerator code_generator(executor_, co.codegen_traits_desc);
+  std::vector<streaming_top_n::CompositeKeyDesc> descs;
+  for (size_t key_idx = 0; key_idx < order_entries.size(); ++key_idx) {
+    const auto& order_entry = order_entries[key_idx];
+    CHECK_GE(order_entry.tle_no, int(1));
+    const size_t target_idx = order_entry.tle_no - 1;
+    CHECK_LT(target_idx, ra_exe_unit_.target_exprs.size());
+    const auto order_entry_expr = ra_exe_unit_.target_exprs[target_idx];
+    const auto oe_type = order_entry_expr->type();
+    const auto slot_idx = get_heap_key_slot_index(
+        ra_exe_unit_.target_exprs, target_idx, config_.exec.group_by.bigint_count);
+    CHECK_LE(query_mem_desc.getColOffInBytes(slot_idx),
+             std::numeric_limits<uint32_t>::max());
+    streaming_top_n::CompositeKeyDesc desc{};
+    desc.offset = static_cast<uint32_t>(query_mem_desc.getColOffInBytes(slot_idx));
+    desc.width = query_mem_desc.getPaddedSlotWidthBytes(slot_idx);
+    desc.is_desc = order_entry.is_desc;
+    desc.nulls_first = order_entry.nulls_first;
+    const auto order_entry_lvs = code_generator.codegen(order_entry_expr, true, co);
+    llvm::Value* key_lv = nullptr;
+    llvm::Value* len_lv = LL_INT(int64_t(0));
+    if (oe_type->isString()) {
+      CHECK_EQ(order_entry_lvs.size(), size_t(3));
+      desc.kind = streaming_top_n::KeyKind::kString;
+      desc.len_offset =
+          static_cast<uint32_t>(query_mem_desc.getColOffInBytes(slot_idx + 1));
+      desc.len_width = query_mem_desc.getPaddedSlotWidthBytes(slot_idx + 1);
+      key_lv = LL_BUILDER.CreatePtrToInt(order_entry_lvs[1],
+                                         llvm::Type::getInt64Ty(LL_CONTEXT));
+      len_lv = executor_->cgen_state_->castToTypeIn(order_entry_lvs[2], 64);
+    } else {
+      auto order_entry_lv = executor_->cgen_state_->castToTypeIn(
+          order_entry_lvs.front(), desc.width * 8);
+      if (oe_type->isFloatingPoint()) {
+        if (order_entry_lv->getType()->isDoubleTy()) {
+          desc.kind = streaming_top_n::KeyKind::kDouble;
+          const double null_val = inline_fp_null_value(oe_type);
+          desc.null_bits = *reinterpret_cast<const int64_t*>(&null_val);
+          key_lv = LL_BUILDER.CreateBitCast(order_entry_lv,
+                                            llvm::Type::getInt64Ty(LL_CONTEXT));
+        } else {
+          desc.kind = streaming_top_n::KeyKind::kFloat;
+          const float null_val = inline_fp_null_value(oe_type);
+          desc.null_bits = *reinterpret_cast<const int32_t*>(&null_val);
+          key_lv = LL_BUILDER.CreateSExt(
+              LL_BUILDER.CreateBitCast(order_entry_lv,
+                                       llvm::Type::getInt32Ty(LL_CONTEXT)),
+              llvm::Type::getInt64Ty(LL_CONTEXT));
+        }
+      } else {
+        CHECK(oe_type->isInteger() || oe_type->isDecimal() || oe_type->isDateTime());
+        desc.kind = streaming_top_n::KeyKind::kInteger;
+        desc.null_bits = inline_int_null_value(oe_type);
+        key_lv = executor_->cgen_state_->castToTypeIn(order_entry_lv, 64);
+      }
+    }
+    store_key_value(key_lv, 2 * key_idx);
+    store_key_value(len_lv, 2 * key_idx + 1);
+    descs.push_back(desc);
+  }
+  // key descriptors are passed to the runtime as a constant byte array
+  std::vector<uint8_t> descs_bytes(descs.size() *
+                                   sizeof(streaming_top_n::CompositeKeyDesc));
+  std::memcpy(descs_bytes.data(), descs.data(), descs_bytes.size());
+  auto descs_arr = llvm::ConstantDataArray::get(LL_CONTEXT, descs_bytes);
+  CHECK(executor_->cgen_state_->module_);
+  auto descs_global =
+      new llvm::GlobalVariable(*executor_->cgen_state_->module_,
+                               descs_arr->getType(),
+                               true,
+                               llvm::GlobalValue::LinkageTypes::InternalLinkage,
+                               descs_arr);
+  descs_global->setAlignment(LLVM_ALIGN(8));
+  const uint32_t n = ra_exe_unit_.sort_info.offset + ra_exe_unit_.sort_info.limit;
+  const int32_t row_size_quad = query_mem_desc.getRowSize() / sizeof(int64_t);
+  return emitCall("get_bin_from_k_heap_composite",
+                  {groups_buffer,
+                   LL_INT(n),
+                   LL_INT(static_cast<uint32_t>(row_size_quad)),
+                   LL_BUILDER.CreatePointerCast(descs_global,
+                                                llvm::Type::getInt8PtrTy(LL_CONTEXT)),
+                   LL_INT(key_count),
+                   keys_lv});
+}
+
 std::tuple<llvm::Value*, llvm::Value*> RowFuncBuilder::codegenGroupBy(
     const QueryMemoryDescriptor& query_mem_desc,
     const CompilationOptions& co,
@@ -782,7 +890,7 @@ llvm::Value* RowFuncBuilder::convertNullIfAny(const hdk::ir::Type* arg_type,
       }
     } else {
       CHECK(agg_info.agg_kind == hdk::ir::AggType::kCount ||
-            agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct);
+            hdk::ir::isHll(agg_info.agg_kind));
       return target;
     }
   } else {
@@ -1175,12 +1283,32 @@ extern "C" RUNTIME_EXPORT void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" RUNTIME_EXPORT void agg_count_distinct_roaring(int64_t* agg,
+                                                          const int64_t val,
+                                                          const int64_t min_val) {
+  reinterpret_cast<RoaringBitmap*>(*agg)->add(static_cast<uint32_t>(val - min_val));
+}
+
+extern "C" RUNTIME_EXPORT void agg_count_distinct_roaring_skip_val(
+    int64_t* agg,
+    const int64_t val,
+    const int64_t min_val,
+    const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_count_distinct_roaring(agg, val, min_val);
+  }
+}
+
 extern "C" RUNTIME_EXPORT void agg_approx_quantile(int64_t* agg, const double val) {
   auto* t_digest = reinterpret_cast<quantile::TDigest*>(*agg);
   t_digest->allocate();
   t_digest->add(val);
 }
 
+extern "C" RUNTIME_EXPORT void agg_quantile(int64_t* agg, const double val) {
+  reinterpret_cast<ExactQuantile*>(*agg)->add(val);
+}
+
 void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
                                           const hdk::ir::Expr* target_expr,
                                           std::vector<llvm::Value*>& agg_args,
@@ -1196,7 +1324,7 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
   const auto& count_distinct_descriptor =
       query_mem_desc.getCountDistinctDescriptor(target_idx);
   CHECK(count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid);
-  if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct) {
+  if (hdk::ir::isHll(agg_info.agg_kind)) {
     CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap);
     agg_args.push_back(LL_INT(int32_t(count_distinct_descriptor.bitmap_sz_bits)));
     if (device_type == ExecutorDeviceType::GPU) {
@@ -1214,6 +1342,10 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
   if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap) {
     agg_fname += "_bitmap";
     agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
+  } else if (count_distinct_descriptor.impl_type_ ==
+             CountDistinctImplType::RoaringBitmap) {
+    agg_fname += "_roaring";
+    agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
   }
   if (agg_info.skip_null_val) {
     auto null_lv = executor_->cgen_state_->castToTypeIn(
@@ -1249,17 +1381,41 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
   }
 }
 
-void RowFuncBuilder::codegenApproxQuantile(const size_t target_idx,
-                                           const hdk::ir::Expr* target_expr,
-                                           std::vector<llvm::Value*>& agg_args,
-                                           const QueryMemoryDescriptor& query_mem_desc,
-                                           const ExecutorDeviceType device_type) {
+void RowFuncBuilder::codegenHllMerge(const size_t target_idx,
+                                     llvm::Value* agg_col_ptr,
+                                     llvm::Value* sketch_lv,
+                                     llvm::Value* pos_lv,
+                                     const QueryMemoryDescriptor& query_mem_desc,
+                                     const ExecutorDeviceType device_type) {
+  if (device_type == ExecutorDeviceType::GPU) {
+    throw QueryMustRunOnCpu();
+  }
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  const auto& count_distinct_descriptor =
+      query_mem_desc.getCountDistinctDescriptor(target_idx);
+  CHECK(count_distinct_descriptor.approximate);
+  auto ret = executor_->cgen_state_->emitExternalCall(
+      "agg_hll_merge",
+      get_int_type(32, LL_CONTEXT),
+      {executor_->castToIntPtrTyIn(agg_col_ptr, 64),
+       sketch_lv,
+       pos_lv,
+       LL_INT(int32_t(count_distinct_descriptor.bitmap_sz_bits))});
+  checkErrorCode(ret);
+}
+
+void RowFuncBuilder::codegenQuantile(const size_t target_idx,
+                                     const hdk::ir::Expr* target_expr,
+                                     std::vector<llvm::Value*>& agg_args,
+                                     const QueryMemoryDescriptor& query_mem_desc,
+                                     const ExecutorDeviceType device_type) {
   if (device_type == ExecutorDeviceType::GPU) {
     throw QueryMustRunOnCpu();
   }
   llvm::BasicBlock *calc, *skip;
   AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
-  auto arg_type = static_cast<const hdk::ir::AggExpr*>(target_expr)->arg()->type();
+  auto agg_expr = static_cast<const hdk::ir::AggExpr*>(target_expr);
+  auto arg_type = agg_expr->arg()->type();
   bool const nullable = arg_type->nullable();
 
   auto* cs = executor_->cgen_state_.get();
@@ -1269,8 +1425,8 @@ void RowFuncBuilder::codegenApproxQuantile(const size_t target_idx,
     auto* const skip_cond = arg_type->isFloatingPoint()
                                 ? irb.CreateFCmpOEQ(agg_args.back(), null_value)
                                 : irb.CreateICmpEQ(agg_args.back(), null_value);
-    calc = llvm::BasicBlock::Create(cs->context_, "calc_approx_quantile");
-    skip = llvm::BasicBlock::Create(cs->context_, "skip_approx_quantile");
+    calc = llvm::BasicBlock::Create(cs->context_, "calc_quantile");
+    skip = llvm::BasicBlock::Create(cs->context_, "skip_quantile");
     irb.CreateCondBr(skip_cond, skip, calc);
     cs->current_func_->getBasicBlockList().push_back(calc);
     irb.SetInsertPoint(calc);
@@ -1280,8 +1436,9 @@ void RowFuncBuilder::codegenApproxQuantile(const size_t target_idx,
         get_target_info(target_expr, config_.exec.group_by.bigint_count);
     agg_args.back() = executor_->castToFP(agg_args.back(), arg_type, agg_info.type);
   }
-  cs->emitExternalCall(
-      "agg_approx_quantile", llvm::Type::getVoidTy(cs->context_), agg_args);
+  auto agg_fname = hdk::ir::isExactQuantile(agg_expr->aggType()) ? "agg_quantile"
+                                                                  : "agg_approx_quantile";
+  cs->emitExternalCall(agg_fname, llvm::Type::getVoidTy(cs->context_), agg_args);
   if (nullable) {
     irb.CreateBr(skip);
     cs->current_func_->getBasicBlockList().push_back(skip);
@@ -1315,7 +1472,7 @@ std::vector<llvm::Value*> RowFuncBuilder::codegenAggArg(const hdk::ir::Expr* tar
   CodeGenerator code_generator(executor_, co.codegen_traits_desc);
   if (target_expr) {
     auto target_type = target_expr->type();
-    if (target_type->isBuffer() &&
+    if (target_type->isBuffer() && !(agg_expr && hdk::ir::isHll(agg_expr->aggType())) &&
         !executor_->plan_state_->isLazyFetchColumn(target_expr)) {
       const auto target_lvs =
           agg_expr ? code_generator.codegen(agg_expr->arg(), true, co)
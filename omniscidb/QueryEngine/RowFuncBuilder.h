@@ -56,6 +56,12 @@ class RowFuncBuilder {
                                  const CompilationOptions& co,
                                  DiamondCodegen& diamond_codegen);
 
+  // Streaming top-N output slot for heaps keyed on several order entries or on
+  // a none-encoded string. CPU only.
+  llvm::Value* codegenCompositeTopNOutputSlot(llvm::Value* groups_buffer,
+                                              const QueryMemoryDescriptor& query_mem_desc,
+                                              const CompilationOptions& co);
+
   std::tuple<llvm::Value*, llvm::Value*> codegenGroupBy(
       const QueryMemoryDescriptor& query_mem_desc,
       const CompilationOptions& co,
@@ -136,11 +142,19 @@ class RowFuncBuilder {
                             const QueryMemoryDescriptor&,
                             const ExecutorDeviceType);
 
-  void codegenApproxQuantile(const size_t target_idx,
-                             const hdk::ir::Expr* target_expr,
-                             std::vector<llvm::Value*>& agg_args,
-                             const QueryMemoryDescriptor& query_mem_desc,
-                             const ExecutorDeviceType device_type);
+  // Merge HyperLogLog registers of a stored sketch into the group sketch.
+  void codegenHllMerge(const size_t target_idx,
+                       llvm::Value* agg_col_ptr,
+                       llvm::Value* sketch_lv,
+                       llvm::Value* pos_lv,
+                       const QueryMemoryDescriptor& query_mem_desc,
+                       const ExecutorDeviceType device_type);
+
+  void codegenQuantile(const size_t target_idx,
+                       const hdk::ir::Expr* target_expr,
+                       std::vector<llvm::Value*>& agg_args,
+                       const QueryMemoryDescriptor& query_mem_desc,
+                       const ExecutorDeviceType device_type);
 
   llvm::Value* getAdditionalLiteral(const int32_t off);
 
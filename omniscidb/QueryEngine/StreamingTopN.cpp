@@ -29,6 +29,16 @@ size_t get_heap_key_slot_index(const std::vector<const hdk::ir::Expr*>& target_e
   return slot_idx;
 }
 
+bool use_composite_streaming_top_n_key(const RelAlgExecutionUnit& ra_exe_unit) {
+  const auto& order_entries = ra_exe_unit.sort_info.order_entries;
+  CHECK(!order_entries.empty());
+  if (order_entries.size() > 1) {
+    return true;
+  }
+  const auto target_idx = order_entries.front().tle_no - 1;
+  return ra_exe_unit.target_exprs[target_idx]->type()->isString();
+}
+
 #ifdef HAVE_CUDA
 std::vector<int8_t> pick_top_n_rows_from_dev_heaps(
     BufferProvider* buffer_provider,
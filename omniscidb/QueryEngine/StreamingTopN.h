@@ -43,6 +43,10 @@ size_t get_heap_key_slot_index(const std::vector<const hdk::ir::Expr*>& target_e
                                const size_t target_idx,
                                bool bigint_count);
 
+// Returns true if the heap of the streaming top-N projection is keyed on several
+// order entries or on a string and therefore uses composite keys.
+bool use_composite_streaming_top_n_key(const RelAlgExecutionUnit& ra_exe_unit);
+
 #ifdef HAVE_CUDA
 namespace Data_Namespace {
 
@@ -23,6 +23,10 @@
 struct TableGeneration {
   int64_t tuple_count;
   int64_t start_rowid;
+
+  bool operator==(const TableGeneration& other) const {
+    return tuple_count == other.tuple_count && start_rowid == other.start_rowid;
+  }
 };
 
 class TableGenerations {
@@ -35,6 +39,10 @@ class TableGenerations {
 
   void clear();
 
+  bool operator==(const TableGenerations& other) const {
+    return id_to_generation_ == other.id_to_generation_;
+  }
+
  private:
   std::unordered_map<uint32_t, TableGeneration> id_to_generation_;
 };
@@ -61,9 +61,16 @@ std::vector<std::string> agg_fn_base_names(const TargetInfo& target_info) {
     case hdk::ir::AggType::kSum:
       return {"agg_sum"};
     case hdk::ir::AggType::kApproxCountDistinct:
+    case hdk::ir::AggType::kHllSketch:
       return {"agg_approximate_count_distinct"};
+    case hdk::ir::AggType::kHllMerge:
+    case hdk::ir::AggType::kHllMergeCount:
+      return {"agg_hll_merge"};
     case hdk::ir::AggType::kApproxQuantile:
       return {"agg_approx_quantile"};
+    case hdk::ir::AggType::kPercentileCont:
+    case hdk::ir::AggType::kPercentileDisc:
+      return {"agg_quantile"};
     case hdk::ir::AggType::kSingleValue:
       return {"checked_single_agg_id"};
     case hdk::ir::AggType::kSample:
@@ -321,6 +328,29 @@ void TargetExprCodegen::codegenAggregate(
       continue;
     }
 
+    if (target_info.agg_kind == hdk::ir::AggType::kHllMerge ||
+        target_info.agg_kind == hdk::ir::AggType::kHllMergeCount) {
+      CHECK(arg_expr->type()->isArray());
+      auto agg_col_ptr =
+          is_group_by ? row_func_builder->codegenAggColumnPtr(output_buffer_byte_stream,
+                                                              out_row_idx,
+                                                              agg_out_ptr_w_idx,
+                                                              query_mem_desc,
+                                                              sizeof(int64_t),
+                                                              slot_index,
+                                                              target_idx)
+                      : agg_out_vec[slot_index];
+      row_func_builder->codegenHllMerge(target_idx,
+                                        agg_col_ptr,
+                                        target_lvs[target_lv_idx],
+                                        code_generator.posArg(arg_expr),
+                                        query_mem_desc,
+                                        co.device_type);
+      ++slot_index;
+      ++target_lv_idx;
+      continue;
+    }
+
     llvm::Value* agg_col_ptr{nullptr};
     const auto chosen_bytes =
         static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(slot_index));
@@ -414,9 +444,9 @@ void TargetExprCodegen::codegenAggregate(
       CHECK(!chosen_type->isFloatingPoint());
       row_func_builder->codegenCountDistinct(
           target_idx, target_expr, agg_args, query_mem_desc, co.device_type);
-    } else if (target_info.agg_kind == hdk::ir::AggType::kApproxQuantile) {
+    } else if (hdk::ir::isQuantile(target_info.agg_kind)) {
       CHECK_EQ(agg_chosen_bytes, sizeof(int64_t));
-      row_func_builder->codegenApproxQuantile(
+      row_func_builder->codegenQuantile(
           target_idx, target_expr, agg_args, query_mem_desc, co.device_type);
     } else {
       auto arg_type = target_info.agg_arg_type;
@@ -535,7 +565,7 @@ void TargetExprCodegenBuilder::operator()(const hdk::ir::Expr* target_expr,
   if (arg_expr) {
     if (target_info.agg_kind == hdk::ir::AggType::kSingleValue ||
         target_info.agg_kind == hdk::ir::AggType::kSample ||
-        target_info.agg_kind == hdk::ir::AggType::kApproxQuantile) {
+        hdk::ir::isQuantile(target_info.agg_kind)) {
       target_info.skip_null_val = false;
     } else if (query_mem_desc.getQueryDescriptionType() ==
                    QueryDescriptionType::NonGroupedAggregate &&
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "TierUpWorker.h"
+
+#include "Logger/Logger.h"
+
+TierUpWorker& TierUpWorker::instance() {
+  // Created on the first use, so it is destroyed before code caches.
+  static TierUpWorker worker;
+  return worker;
+}
+
+TierUpWorker::TierUpWorker() : thread_([this]() { run(); }) {}
+
+TierUpWorker::~TierUpWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    tasks_.clear();
+  }
+  task_cv_.notify_all();
+  thread_.join();
+}
+
+void TierUpWorker::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  task_cv_.notify_one();
+}
+
+void TierUpWorker::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cv_.wait(lock, [this]() { return tasks_.empty() && !busy_; });
+}
+
+void TierUpWorker::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    task_cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+    if (stop_) {
+      break;
+    }
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    try {
+      task();
+    } catch (const std::exception& e) {
+      // The kernel keeps running the baseline code.
+      LOG(WARNING) << "Optimized kernel recompilation failed: " << e.what();
+    }
+    lock.lock();
+    busy_ = false;
+    if (tasks_.empty()) {
+      idle_cv_.notify_all();
+    }
+  }
+  busy_ = false;
+  idle_cv_.notify_all();
+}
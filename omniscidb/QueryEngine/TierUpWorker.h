@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Runs optimized recompilation of reused kernels compiled by the baseline tier.
+// Tasks are executed one by one on a single background thread, so tier-up never
+// takes more than one core from query execution. Tasks which are still queued on
+// exit are dropped.
+class TierUpWorker {
+ public:
+  static TierUpWorker& instance();
+
+  ~TierUpWorker();
+
+  TierUpWorker(const TierUpWorker& other) = delete;
+  TierUpWorker& operator=(const TierUpWorker& other) = delete;
+
+  void submit(std::function<void()> task);
+
+  // Wait until all submitted tasks are done.
+  void wait();
+
+ private:
+  TierUpWorker();
+
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable task_cv_;
+  std::condition_variable idle_cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool busy_{false};
+  bool stop_{false};
+  std::thread thread_;
+};
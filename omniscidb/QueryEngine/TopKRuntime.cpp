@@ -21,6 +21,7 @@
  *
  * Copyright (c) 2017 MapD Technologies, Inc.  All rights reserved.
  */
+#include "../ResultSet/StreamingTopN.h"
 #include "../Shared/funcannotations.h"
 
 enum class HeapOrdering { MIN, MAX };
@@ -80,11 +81,23 @@ struct KeyComparator {
 };
 
 template <typename KeyT = int64_t, typename NodeT = int64_t>
+struct KeyNodeComparator {
+  DEVICE KeyNodeComparator(const KeyComparator<KeyT>& key_compare,
+                           const KeyAccessor<KeyT, NodeT>& key_accessor)
+      : compare(key_compare), accessor(key_accessor) {}
+  ALWAYS_INLINE DEVICE bool operator()(const NodeT lhs, const NodeT rhs) const {
+    return compare(accessor.get(lhs), accessor.get(rhs));
+  }
+
+  const KeyComparator<KeyT>& compare;
+  const KeyAccessor<KeyT, NodeT>& accessor;
+};
+
+template <typename NodeT, typename NodeComparator>
 ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
                                     const size_t heap_size,
                                     const NodeT curr_idx,
-                                    const KeyComparator<KeyT>& compare,
-                                    const KeyAccessor<KeyT, NodeT>& accessor) {
+                                    const NodeComparator& compare) {
   for (NodeT i = curr_idx, last = static_cast<NodeT>(heap_size); i < last;) {
 #ifdef __CUDACC__
     const auto left_child = min(2 * i + 1, last);
@@ -96,9 +109,8 @@ ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
     auto candidate_idx = last;
     if (left_child < last) {
       if (right_child < last) {
-        const auto left_key = accessor.get(heap[left_child]);
-        const auto right_key = accessor.get(heap[right_child]);
-        candidate_idx = compare(left_key, right_key) ? left_child : right_child;
+        candidate_idx =
+            compare(heap[left_child], heap[right_child]) ? left_child : right_child;
       } else {
         candidate_idx = left_child;
       }
@@ -108,9 +120,7 @@ ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
     if (candidate_idx >= last) {
       break;
     }
-    const auto curr_key = accessor.get(heap[i]);
-    const auto candidate_key = accessor.get(heap[candidate_idx]);
-    if (compare(curr_key, candidate_key)) {
+    if (compare(heap[i], heap[candidate_idx])) {
       break;
     }
     auto temp_id = heap[i];
@@ -120,16 +130,13 @@ ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
   }
 }
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+template <typename NodeT, typename NodeComparator>
 ALWAYS_INLINE DEVICE void sift_up(NodeT* heap,
                                   const NodeT curr_idx,
-                                  const KeyComparator<KeyT>& compare,
-                                  const KeyAccessor<KeyT, NodeT>& accessor) {
+                                  const NodeComparator& compare) {
   for (NodeT i = curr_idx; i > 0 && (i - 1) < i;) {
     const auto parent = (i - 1) / 2;
-    const auto curr_key = accessor.get(heap[i]);
-    const auto parent_key = accessor.get(heap[parent]);
-    if (compare(parent_key, curr_key)) {
+    if (compare(heap[parent], heap[i])) {
       break;
     }
     auto temp_id = heap[i];
@@ -154,7 +161,8 @@ ALWAYS_INLINE DEVICE void push_heap(int64_t* heap_ptr,
   auto key_ptr = reinterpret_cast<KeyT*>(row_ptr + key_offset);
   *key_ptr = curr_key;
   // sift up
-  sift_up<KeyT, NodeT>(heap_ptr, bin_index, comparator, accessor);
+  sift_up<NodeT>(
+      heap_ptr, bin_index, KeyNodeComparator<KeyT, NodeT>(comparator, accessor));
 }
 
 template <typename KeyT = int64_t, typename NodeT = int64_t>
@@ -175,7 +183,8 @@ ALWAYS_INLINE DEVICE bool pop_and_push_heap(int64_t* heap_ptr,
   // kick out
   *top_key = curr_key;
   // sift down
-  sift_down<KeyT, NodeT>(heap_ptr, node_count, 0, compare, accessor);
+  sift_down<NodeT>(
+      heap_ptr, node_count, 0, KeyNodeComparator<KeyT, NodeT>(compare, accessor));
   return true;
 }
 
@@ -261,3 +270,200 @@ DEF_GET_BIN_FROM_K_HEAP(int32_t)
 DEF_GET_BIN_FROM_K_HEAP(int64_t)
 DEF_GET_BIN_FROM_K_HEAP(float)
 DEF_GET_BIN_FROM_K_HEAP(double)
+
+#ifndef __CUDACC__
+
+namespace {
+
+using streaming_top_n::CompositeKeyDesc;
+using streaming_top_n::KeyKind;
+
+ALWAYS_INLINE int64_t read_key_slot(const int8_t* ptr, const int8_t width) {
+  switch (width) {
+    case 1:
+      return *ptr;
+    case 2:
+      return *reinterpret_cast<const int16_t*>(ptr);
+    case 4:
+      return *reinterpret_cast<const int32_t*>(ptr);
+    default:
+      return *reinterpret_cast<const int64_t*>(ptr);
+  }
+}
+
+ALWAYS_INLINE void write_key_slot(int8_t* ptr, const int8_t width, const int64_t val) {
+  switch (width) {
+    case 1:
+      *ptr = static_cast<int8_t>(val);
+      break;
+    case 2:
+      *reinterpret_cast<int16_t*>(ptr) = static_cast<int16_t>(val);
+      break;
+    case 4:
+      *reinterpret_cast<int32_t*>(ptr) = static_cast<int32_t>(val);
+      break;
+    default:
+      *reinterpret_cast<int64_t*>(ptr) = val;
+  }
+}
+
+// Compares key component values in the output order: returns a negative value if
+// lhs goes first, a positive value if rhs goes first and zero for equal values.
+ALWAYS_INLINE int32_t compare_key_component(const CompositeKeyDesc& desc,
+                                            const int64_t lhs,
+                                            const int64_t lhs_len,
+                                            const int64_t rhs,
+                                            const int64_t rhs_len) {
+  const bool lhs_null = desc.kind == KeyKind::kString ? !lhs : lhs == desc.null_bits;
+  const bool rhs_null = desc.kind == KeyKind::kString ? !rhs : rhs == desc.null_bits;
+  if (lhs_null || rhs_null) {
+    if (lhs_null && rhs_null) {
+      return 0;
+    }
+    return (lhs_null == desc.nulls_first) ? -1 : 1;
+  }
+  int32_t res = 0;
+  switch (desc.kind) {
+    case KeyKind::kInteger:
+      res = lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+      break;
+    case KeyKind::kFloat: {
+      const auto lhs_val = *reinterpret_cast<const float*>(&lhs);
+      const auto rhs_val = *reinterpret_cast<const float*>(&rhs);
+      res = lhs_val < rhs_val ? -1 : (lhs_val > rhs_val ? 1 : 0);
+      break;
+    }
+    case KeyKind::kDouble: {
+      const auto lhs_val = *reinterpret_cast<const double*>(&lhs);
+      const auto rhs_val = *reinterpret_cast<const double*>(&rhs);
+      res = lhs_val < rhs_val ? -1 : (lhs_val > rhs_val ? 1 : 0);
+      break;
+    }
+    case KeyKind::kString: {
+      const auto lhs_str = reinterpret_cast<const uint8_t*>(lhs);
+      const auto rhs_str = reinterpret_cast<const uint8_t*>(rhs);
+      const auto common_len = lhs_len < rhs_len ? lhs_len : rhs_len;
+      for (int64_t i = 0; i < common_len && !res; ++i) {
+        res = lhs_str[i] < rhs_str[i] ? -1 : (lhs_str[i] > rhs_str[i] ? 1 : 0);
+      }
+      if (!res) {
+        res = lhs_len < rhs_len ? -1 : (lhs_len > rhs_len ? 1 : 0);
+      }
+      break;
+    }
+  }
+  return desc.is_desc ? -res : res;
+}
+
+// Keys of rows in the heap are read from their slots and the key of the current row
+// is passed as an array holding two values (value or pointer and length) per
+// component.
+struct CompositeKeyRowComparator {
+  ALWAYS_INLINE int32_t compareRows(const int8_t* lhs_row,
+                                    const int8_t* rhs_row) const {
+    for (uint32_t i = 0; i < key_count; ++i) {
+      const auto& desc = key_descs[i];
+      const auto lhs = read_key_slot(lhs_row + desc.offset, desc.width);
+      const auto rhs = read_key_slot(rhs_row + desc.offset, desc.width);
+      int64_t lhs_len = 0;
+      int64_t rhs_len = 0;
+      if (desc.kind == KeyKind::kString) {
+        lhs_len = read_key_slot(lhs_row + desc.len_offset, desc.len_width);
+        rhs_len = read_key_slot(rhs_row + desc.len_offset, desc.len_width);
+      }
+      const auto res = compare_key_component(desc, lhs, lhs_len, rhs, rhs_len);
+      if (res) {
+        return res;
+      }
+    }
+    return 0;
+  }
+
+  ALWAYS_INLINE int32_t compareWithRow(const int64_t* keys, const int8_t* row) const {
+    for (uint32_t i = 0; i < key_count; ++i) {
+      const auto& desc = key_descs[i];
+      const auto val = read_key_slot(row + desc.offset, desc.width);
+      const auto len = desc.kind == KeyKind::kString
+                           ? read_key_slot(row + desc.len_offset, desc.len_width)
+                           : 0;
+      const auto res =
+          compare_key_component(desc, keys[2 * i], keys[2 * i + 1], val, len);
+      if (res) {
+        return res;
+      }
+    }
+    return 0;
+  }
+
+  // The heap keeps the worst row on top, so a node is "less" than another one when
+  // its row goes after the other row in the output.
+  ALWAYS_INLINE bool operator()(const int64_t lhs, const int64_t rhs) const {
+    return compareRows(rows + lhs * row_size, rows + rhs * row_size) > 0;
+  }
+
+  const CompositeKeyDesc* key_descs;
+  const uint32_t key_count;
+  const int8_t* rows;
+  const size_t row_size;
+};
+
+ALWAYS_INLINE void write_composite_key(const CompositeKeyDesc* key_descs,
+                                       const uint32_t key_count,
+                                       const int64_t* keys,
+                                       int8_t* row) {
+  for (uint32_t i = 0; i < key_count; ++i) {
+    const auto& desc = key_descs[i];
+    write_key_slot(row + desc.offset, desc.width, keys[2 * i]);
+    if (desc.kind == KeyKind::kString) {
+      write_key_slot(row + desc.len_offset, desc.len_width, keys[2 * i + 1]);
+    }
+  }
+}
+
+}  // namespace
+
+// Same as get_bin_from_k_heap_* but orders rows by several key components stored in
+// different slots. Supports string components. CPU only.
+extern "C" RUNTIME_EXPORT NEVER_INLINE int64_t* get_bin_from_k_heap_composite(
+    int64_t* heaps,
+    const uint32_t k,
+    const uint32_t row_size_quad,
+    const int8_t* key_descs,
+    const uint32_t key_count,
+    const int64_t* curr_keys) {
+  const int32_t thread_global_index = pos_start_impl(nullptr);
+  const int32_t thread_count = pos_step_impl();
+  int64_t& node_count = heaps[thread_global_index];
+  int64_t* heap_ptr = heaps + thread_count + thread_global_index * k;
+  int64_t* rows_ptr =
+      heaps + thread_count + thread_count * k + thread_global_index * row_size_quad * k;
+  const auto descs = reinterpret_cast<const CompositeKeyDesc*>(key_descs);
+  CompositeKeyRowComparator compare{descs,
+                                    key_count,
+                                    reinterpret_cast<const int8_t*>(rows_ptr),
+                                    row_size_quad * sizeof(int64_t)};
+  int64_t bin_idx;
+  if (node_count < static_cast<int64_t>(k)) {
+    bin_idx = node_count++;
+    heap_ptr[bin_idx] = bin_idx;
+    write_composite_key(descs,
+                        key_count,
+                        curr_keys,
+                        reinterpret_cast<int8_t*>(rows_ptr + bin_idx * row_size_quad));
+    sift_up<int64_t>(heap_ptr, bin_idx, compare);
+  } else {
+    bin_idx = heap_ptr[0];
+    auto top_row = reinterpret_cast<int8_t*>(rows_ptr + bin_idx * row_size_quad);
+    // ties are accepted like in the single key heap
+    if (compare.compareWithRow(curr_keys, top_row) > 0) {
+      return nullptr;
+    }
+    write_composite_key(descs, key_count, curr_keys, top_row);
+    sift_down<int64_t>(heap_ptr, node_count, 0, compare);
+  }
+  auto row_ptr = rows_ptr + bin_idx * row_size_quad;
+  row_ptr[0] = bin_idx;
+  return row_ptr + 1;
+}
+
+#endif  // __CUDACC__
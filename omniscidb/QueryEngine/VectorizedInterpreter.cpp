@@ -0,0 +1,486 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "VectorizedInterpreter.h"
+
+#include "Logger/Logger.h"
+#include "QueryEngine/PlanState.h"
+#include "ResultSet/QueryMemoryDescriptor.h"
+#include "Shared/InlineNullValues.h"
+#include "Shared/TargetInfo.h"
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+using ColumnKind = InterpretedCompilationContext::ColumnKind;
+using ColumnRef = InterpretedCompilationContext::ColumnRef;
+using Filter = InterpretedCompilationContext::Filter;
+using Aggregate = InterpretedCompilationContext::Aggregate;
+
+constexpr size_t kBatchSize = 1024;
+
+std::optional<ColumnKind> get_column_kind(const hdk::ir::Type* type) {
+  if (type->isInteger()) {
+    switch (type->size()) {
+      case 1:
+        return ColumnKind::kInt8;
+      case 2:
+        return ColumnKind::kInt16;
+      case 4:
+        return ColumnKind::kInt32;
+      case 8:
+        return ColumnKind::kInt64;
+      default:
+        return std::nullopt;
+    }
+  }
+  if (type->isFp32()) {
+    return ColumnKind::kFloat;
+  }
+  if (type->isFp64()) {
+    return ColumnKind::kDouble;
+  }
+  return std::nullopt;
+}
+
+bool is_fp(ColumnKind kind) {
+  return kind == ColumnKind::kFloat || kind == ColumnKind::kDouble;
+}
+
+std::optional<ColumnRef> get_column_ref(const hdk::ir::Expr* expr,
+                                        const RelAlgExecutionUnit& ra_exe_unit,
+                                        const PlanState& plan_state) {
+  auto col_var = dynamic_cast<const hdk::ir::ColumnVar*>(expr);
+  if (!col_var || col_var->is<hdk::ir::Var>() || col_var->rteIdx() != 0 ||
+      col_var->isVirtual() || plan_state.isPackedColumn(col_var)) {
+    return std::nullopt;
+  }
+  auto kind = get_column_kind(col_var->type());
+  if (!kind) {
+    return std::nullopt;
+  }
+  // Local column ids follow the order of input column descriptors.
+  InputColDescriptor col_desc(col_var->columnInfo(), col_var->rteIdx());
+  size_t local_id = 0;
+  for (auto& input_col_desc : ra_exe_unit.input_col_descs) {
+    if (*input_col_desc == col_desc) {
+      return ColumnRef{local_id, *kind, col_var->type()->nullable()};
+    }
+    ++local_id;
+  }
+  return std::nullopt;
+}
+
+hdk::ir::OpType flip_comparison(hdk::ir::OpType op) {
+  switch (op) {
+    case hdk::ir::OpType::kLt:
+      return hdk::ir::OpType::kGt;
+    case hdk::ir::OpType::kGt:
+      return hdk::ir::OpType::kLt;
+    case hdk::ir::OpType::kLe:
+      return hdk::ir::OpType::kGe;
+    case hdk::ir::OpType::kGe:
+      return hdk::ir::OpType::kLe;
+    default:
+      return op;
+  }
+}
+
+bool add_filters(const hdk::ir::Expr* qual,
+                 const RelAlgExecutionUnit& ra_exe_unit,
+                 const PlanState& plan_state,
+                 std::vector<Filter>& filters) {
+  auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(qual);
+  if (!bin_oper || bin_oper->qualifier() != hdk::ir::Qualifier::kOne) {
+    return false;
+  }
+  if (bin_oper->isAnd()) {
+    return add_filters(bin_oper->leftOperand(), ra_exe_unit, plan_state, filters) &&
+           add_filters(bin_oper->rightOperand(), ra_exe_unit, plan_state, filters);
+  }
+  if (!bin_oper->isComparison() || bin_oper->isBwEq()) {
+    return false;
+  }
+
+  auto op = bin_oper->opType();
+  auto lhs = bin_oper->leftOperand();
+  auto rhs = bin_oper->rightOperand();
+  if (lhs->is<hdk::ir::Constant>()) {
+    std::swap(lhs, rhs);
+    op = flip_comparison(op);
+  }
+  auto column = get_column_ref(lhs, ra_exe_unit, plan_state);
+  auto constant = dynamic_cast<const hdk::ir::Constant*>(rhs);
+  if (!column || !constant || constant->isNull() ||
+      get_column_kind(constant->type()) != column->kind) {
+    return false;
+  }
+
+  Filter filter{*column, op, 0, 0.0};
+  auto value = constant->value();
+  switch (column->kind) {
+    case ColumnKind::kInt8:
+      filter.int_val = value.tinyintval;
+      break;
+    case ColumnKind::kInt16:
+      filter.int_val = value.smallintval;
+      break;
+    case ColumnKind::kInt32:
+      filter.int_val = value.intval;
+      break;
+    case ColumnKind::kInt64:
+      filter.int_val = value.bigintval;
+      break;
+    case ColumnKind::kFloat:
+      filter.fp_val = value.floatval;
+      break;
+    case ColumnKind::kDouble:
+      filter.fp_val = value.doubleval;
+      break;
+  }
+  filters.push_back(filter);
+  return true;
+}
+
+template <typename T>
+T null_value() {
+  if constexpr (std::is_floating_point_v<T>) {
+    return inline_fp_null_value<T>();
+  } else {
+    return static_cast<T>(inline_int_null_value<T>());
+  }
+}
+
+template <typename F>
+void dispatch_column(ColumnKind kind, const int8_t* buffer, F&& f) {
+  switch (kind) {
+    case ColumnKind::kInt8:
+      f(reinterpret_cast<const int8_t*>(buffer));
+      break;
+    case ColumnKind::kInt16:
+      f(reinterpret_cast<const int16_t*>(buffer));
+      break;
+    case ColumnKind::kInt32:
+      f(reinterpret_cast<const int32_t*>(buffer));
+      break;
+    case ColumnKind::kInt64:
+      f(reinterpret_cast<const int64_t*>(buffer));
+      break;
+    case ColumnKind::kFloat:
+      f(reinterpret_cast<const float*>(buffer));
+      break;
+    case ColumnKind::kDouble:
+      f(reinterpret_cast<const double*>(buffer));
+      break;
+  }
+}
+
+// Keep selected rows which pass the comparison. NULL values never pass.
+template <typename T, typename Cmp>
+size_t refine_selection(const T* values,
+                        T val,
+                        bool nullable,
+                        Cmp cmp,
+                        uint32_t* sel,
+                        size_t size) {
+  const T null_val = null_value<T>();
+  size_t res = 0;
+  for (size_t i = 0; i < size; ++i) {
+    auto idx = sel[i];
+    auto v = values[idx];
+    sel[res] = idx;
+    res += cmp(v, val) & (!nullable | (v != null_val));
+  }
+  return res;
+}
+
+template <typename T>
+size_t apply_filter(const Filter& filter, const T* values, uint32_t* sel, size_t size) {
+  const T val = std::is_floating_point_v<T> ? static_cast<T>(filter.fp_val)
+                                            : static_cast<T>(filter.int_val);
+  const bool nullable = filter.column.nullable;
+  switch (filter.op) {
+    case hdk::ir::OpType::kEq:
+      return refine_selection(values, val, nullable, std::equal_to<T>(), sel, size);
+    case hdk::ir::OpType::kNe:
+      return refine_selection(values, val, nullable, std::not_equal_to<T>(), sel, size);
+    case hdk::ir::OpType::kLt:
+      return refine_selection(values, val, nullable, std::less<T>(), sel, size);
+    case hdk::ir::OpType::kLe:
+      return refine_selection(values, val, nullable, std::less_equal<T>(), sel, size);
+    case hdk::ir::OpType::kGt:
+      return refine_selection(values, val, nullable, std::greater<T>(), sel, size);
+    case hdk::ir::OpType::kGe:
+      return refine_selection(values, val, nullable, std::greater_equal<T>(), sel, size);
+    default:
+      CHECK(false) << "Unexpected filter: " << filter.op;
+  }
+  return 0;
+}
+
+// Accumulated value of an aggregate for a fragment. Only the member matching the
+// argument type is used.
+struct AggState {
+  int64_t count{0};
+  int64_t int_val{0};
+  float float_val{0};
+  double double_val{0};
+
+  void init(hdk::ir::AggType kind) {
+    if (kind == hdk::ir::AggType::kMin) {
+      int_val = std::numeric_limits<int64_t>::max();
+      float_val = std::numeric_limits<float>::infinity();
+      double_val = std::numeric_limits<double>::infinity();
+    } else if (kind == hdk::ir::AggType::kMax) {
+      int_val = std::numeric_limits<int64_t>::min();
+      float_val = -std::numeric_limits<float>::infinity();
+      double_val = -std::numeric_limits<double>::infinity();
+    }
+  }
+
+  template <typename T>
+  auto& value() {
+    if constexpr (std::is_same_v<T, float>) {
+      return float_val;
+    } else if constexpr (std::is_same_v<T, double>) {
+      return double_val;
+    } else {
+      return int_val;
+    }
+  }
+};
+
+// Values are accumulated in the same types and order as the generated code does,
+// so results match the compiled kernel. Integer sums wrap around on overflow.
+template <typename T>
+void accumulate(const Aggregate& agg,
+                const T* values,
+                const uint32_t* sel,
+                size_t size,
+                AggState& state) {
+  using AccT = std::remove_reference_t<decltype(state.value<T>())>;
+  const T null_val = null_value<T>();
+  const bool nullable = agg.arg->nullable;
+  int64_t count = 0;
+  AccT acc = state.value<T>();
+  switch (agg.kind) {
+    case hdk::ir::AggType::kCount:
+      for (size_t i = 0; i < size; ++i) {
+        count += !nullable | (values[sel[i]] != null_val);
+      }
+      break;
+    case hdk::ir::AggType::kSum:
+    case hdk::ir::AggType::kAvg:
+      for (size_t i = 0; i < size; ++i) {
+        auto v = values[sel[i]];
+        bool valid = !nullable | (v != null_val);
+        count += valid;
+        if constexpr (std::is_integral_v<AccT>) {
+          acc = static_cast<int64_t>(static_cast<uint64_t>(acc) +
+                                     static_cast<uint64_t>(valid ? v : 0));
+        } else {
+          acc += valid ? v : AccT(0);
+        }
+      }
+      break;
+    case hdk::ir::AggType::kMin:
+      for (size_t i = 0; i < size; ++i) {
+        auto v = values[sel[i]];
+        bool valid = !nullable | (v != null_val);
+        count += valid;
+        acc = std::min(acc, valid ? static_cast<AccT>(v) : acc);
+      }
+      break;
+    case hdk::ir::AggType::kMax:
+      for (size_t i = 0; i < size; ++i) {
+        auto v = values[sel[i]];
+        bool valid = !nullable | (v != null_val);
+        count += valid;
+        acc = std::max(acc, valid ? static_cast<AccT>(v) : acc);
+      }
+      break;
+    default:
+      CHECK(false) << "Unexpected aggregate: " << agg.kind;
+  }
+  state.count += count;
+  state.value<T>() = acc;
+}
+
+// The generated code updates the low bytes of a slot initialized with the init value.
+int64_t make_slot_value(int64_t init_val, int64_t val, size_t bytes) {
+  int64_t res = init_val;
+  std::memcpy(&res, &val, bytes);
+  return res;
+}
+
+int64_t get_value_bits(ColumnKind kind, const AggState& state) {
+  int64_t bits = 0;
+  if (kind == ColumnKind::kFloat) {
+    std::memcpy(&bits, &state.float_val, sizeof(float));
+  } else if (kind == ColumnKind::kDouble) {
+    std::memcpy(&bits, &state.double_val, sizeof(double));
+  } else {
+    bits = state.int_val;
+  }
+  return bits;
+}
+
+}  // namespace
+
+std::shared_ptr<InterpretedCompilationContext> InterpretedCompilationContext::create(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const std::vector<InputTableInfo>& query_infos,
+    const PlanState& plan_state,
+    const Config& config) {
+  if (query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::NonGroupedAggregate ||
+      ra_exe_unit.input_descs.size() != 1 || query_infos.size() != 1 ||
+      !ra_exe_unit.join_quals.empty() || !ra_exe_unit.groupby_exprs.empty() ||
+      ra_exe_unit.estimator || ra_exe_unit.union_all || ra_exe_unit.shuffle_fn) {
+    return nullptr;
+  }
+  if (query_infos.front().info.getNumTuplesUpperBound() >
+      config.exec.codegen.interpreter_max_input_rows) {
+    return nullptr;
+  }
+
+  std::vector<Filter> filters;
+  for (auto quals : {&ra_exe_unit.simple_quals, &ra_exe_unit.quals}) {
+    for (auto& qual : *quals) {
+      if (!add_filters(qual.get(), ra_exe_unit, plan_state, filters)) {
+        return nullptr;
+      }
+    }
+  }
+
+  std::vector<Aggregate> aggregates;
+  size_t slot = 0;
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    auto agg_expr = dynamic_cast<const hdk::ir::AggExpr*>(target_expr);
+    if (!agg_expr || agg_expr->isDistinct()) {
+      return nullptr;
+    }
+    auto kind = agg_expr->aggType();
+    if (kind != hdk::ir::AggType::kCount && kind != hdk::ir::AggType::kSum &&
+        kind != hdk::ir::AggType::kMin && kind != hdk::ir::AggType::kMax &&
+        kind != hdk::ir::AggType::kAvg) {
+      return nullptr;
+    }
+    std::optional<ColumnRef> arg;
+    if (agg_expr->arg()) {
+      arg = get_column_ref(agg_expr->arg(), ra_exe_unit, plan_state);
+      if (!arg) {
+        return nullptr;
+      }
+    } else if (kind != hdk::ir::AggType::kCount) {
+      return nullptr;
+    }
+
+    auto agg_info = get_target_info(target_expr, config.exec.group_by.bigint_count);
+    const bool is_avg = kind == hdk::ir::AggType::kAvg;
+    if (slot + (is_avg ? 2 : 1) > query_mem_desc.getSlotCount()) {
+      return nullptr;
+    }
+    size_t slot_bytes = takes_float_argument(agg_info)
+                            ? sizeof(float)
+                            : query_mem_desc.getPaddedSlotWidthBytes(slot);
+    size_t count_slot_bytes =
+        is_avg ? query_mem_desc.getPaddedSlotWidthBytes(slot + 1) : size_t(0);
+    // Floating point values are never stored in compacted integer slots.
+    if (arg && is_fp(arg->kind) && kind != hdk::ir::AggType::kCount &&
+        slot_bytes != (arg->kind == ColumnKind::kFloat ? sizeof(float)
+                                                       : sizeof(double))) {
+      return nullptr;
+    }
+    aggregates.push_back(Aggregate{kind, arg, slot, slot_bytes, count_slot_bytes});
+    slot += is_avg ? 2 : 1;
+  }
+  if (aggregates.empty() || slot != query_mem_desc.getSlotCount()) {
+    return nullptr;
+  }
+
+  VLOG(1) << "Interpreting execution unit with " << filters.size() << " filters and "
+          << aggregates.size() << " aggregates.";
+  return std::shared_ptr<InterpretedCompilationContext>(
+      new InterpretedCompilationContext(std::move(filters), std::move(aggregates)));
+}
+
+void InterpretedCompilationContext::run(
+    const std::vector<std::vector<const int8_t*>>& col_buffers,
+    const std::vector<std::vector<int64_t>>& num_rows,
+    size_t start_row,
+    const std::vector<int64_t>& init_agg_vals,
+    const std::vector<int64_t*>& out) const {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK_EQ(col_buffers.size(), num_rows.size());
+  CHECK_EQ(init_agg_vals.size(), out.size());
+  std::vector<uint32_t> sel(kBatchSize);
+  std::vector<AggState> states(aggregates_.size());
+  for (size_t frag_idx = 0; frag_idx < col_buffers.size(); ++frag_idx) {
+    const auto& frag_buffers = col_buffers[frag_idx];
+    CHECK(!num_rows[frag_idx].empty());
+    const size_t frag_rows = num_rows[frag_idx].front();
+    for (size_t agg_idx = 0; agg_idx < aggregates_.size(); ++agg_idx) {
+      states[agg_idx] = AggState();
+      states[agg_idx].init(aggregates_[agg_idx].kind);
+    }
+
+    for (size_t batch_start = start_row; batch_start < frag_rows;
+         batch_start += kBatchSize) {
+      size_t size = std::min(kBatchSize, frag_rows - batch_start);
+      std::iota(sel.begin(), sel.begin() + size, static_cast<uint32_t>(batch_start));
+      for (auto& filter : filters_) {
+        if (!size) {
+          break;
+        }
+        dispatch_column(filter.column.kind,
+                        frag_buffers[filter.column.local_id],
+                        [&](auto values) {
+                          size = apply_filter(filter, values, sel.data(), size);
+                        });
+      }
+      if (!size) {
+        continue;
+      }
+      for (size_t agg_idx = 0; agg_idx < aggregates_.size(); ++agg_idx) {
+        auto& agg = aggregates_[agg_idx];
+        if (!agg.arg) {
+          states[agg_idx].count += size;
+          continue;
+        }
+        dispatch_column(
+            agg.arg->kind, frag_buffers[agg.arg->local_id], [&](auto values) {
+              accumulate(agg, values, sel.data(), size, states[agg_idx]);
+            });
+      }
+    }
+
+    for (size_t agg_idx = 0; agg_idx < aggregates_.size(); ++agg_idx) {
+      auto& agg = aggregates_[agg_idx];
+      auto& state = states[agg_idx];
+      auto init_val = init_agg_vals[agg.slot];
+      int64_t res;
+      if (agg.kind == hdk::ir::AggType::kCount) {
+        res = make_slot_value(init_val, state.count, agg.slot_bytes);
+      } else if (!state.count) {
+        res = init_val;
+      } else {
+        res = make_slot_value(
+            init_val, get_value_bits(agg.arg->kind, state), agg.slot_bytes);
+      }
+      out[agg.slot][frag_idx] = res;
+      if (agg.kind == hdk::ir::AggType::kAvg) {
+        out[agg.slot + 1][frag_idx] = make_slot_value(
+            init_agg_vals[agg.slot + 1], state.count, agg.count_slot_bytes);
+      }
+    }
+  }
+}
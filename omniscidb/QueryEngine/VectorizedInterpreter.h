@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "IR/OpType.h"
+#include "QueryEngine/CompilationContext.h"
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "Shared/Config.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+class PlanState;
+class QueryMemoryDescriptor;
+
+// Executes non-grouped aggregation over a single table scan without code
+// generation. It is used for small inputs, where JIT compilation would take much
+// longer than the execution itself. Rows are processed in batches: filters are
+// evaluated by branch-free loops which produce a selection vector, and aggregates
+// are accumulated over selected rows by type specialized loops. Only comparisons
+// of fixed width numeric columns with constants and COUNT, SUM, MIN, MAX and AVG
+// aggregates are supported, other units are compiled as usual.
+class InterpretedCompilationContext : public CompilationContext {
+ public:
+  enum class ColumnKind { kInt8, kInt16, kInt32, kInt64, kFloat, kDouble };
+
+  struct ColumnRef {
+    size_t local_id;
+    ColumnKind kind;
+    bool nullable;
+  };
+
+  struct Filter {
+    ColumnRef column;
+    hdk::ir::OpType op;
+    int64_t int_val;
+    double fp_val;
+  };
+
+  struct Aggregate {
+    hdk::ir::AggType kind;
+    // Not set for COUNT(*).
+    std::optional<ColumnRef> arg;
+    size_t slot;
+    // Bytes of the slot updated by the generated code. AVG also uses the next slot
+    // for the count.
+    size_t slot_bytes;
+    size_t count_slot_bytes;
+  };
+
+  // Returns nullptr if the unit cannot be interpreted.
+  static std::shared_ptr<InterpretedCompilationContext> create(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const QueryMemoryDescriptor& query_mem_desc,
+      const std::vector<InputTableInfo>& query_infos,
+      const PlanState& plan_state,
+      const Config& config);
+
+  // Follows the contract of the generated non-grouped aggregation kernel: the value
+  // of each slot computed for a fragment is written to out[slot][frag_idx]. Rows
+  // of each fragment before start_row are skipped, which is used by kernel
+  // subtasks.
+  void run(const std::vector<std::vector<const int8_t*>>& col_buffers,
+           const std::vector<std::vector<int64_t>>& num_rows,
+           size_t start_row,
+           const std::vector<int64_t>& init_agg_vals,
+           const std::vector<int64_t*>& out) const;
+
+ private:
+  InterpretedCompilationContext(std::vector<Filter> filters,
+                                std::vector<Aggregate> aggregates)
+      : filters_(std::move(filters)), aggregates_(std::move(aggregates)) {}
+
+  std::vector<Filter> filters_;
+  std::vector<Aggregate> aggregates_;
+};
@@ -285,6 +285,8 @@ class ArrowResultSetConverter {
   std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
   std::shared_ptr<arrow::Table> convertToArrowTable() const;
 
+  std::shared_ptr<arrow::Schema> makeSchema() const;
+
  private:
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
       const std::shared_ptr<arrow::Schema>& schema) const;
@@ -293,7 +295,6 @@ class ArrowResultSetConverter {
 
   std::shared_ptr<arrow::Field> makeField(const std::string name,
                                           const hdk::ir::Type* target_type) const;
-  std::shared_ptr<arrow::Schema> makeSchema() const;
 
   struct SerializedArrowOutput {
     std::shared_ptr<arrow::Buffer> schema;
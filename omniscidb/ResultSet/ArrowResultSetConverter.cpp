@@ -472,6 +472,23 @@ void convert_column(const hdk::ir::Type* physical_type,
   }
 }
 
+// Converts a column referring result set buffers directly. Columns stored as integers
+// of the same width, e.g. timestamps, are then viewed as the target Arrow type.
+void convert_column_zero_copy(const ArrowResultSetConverter::ColumnBuilder& builder,
+                              ResultSetPtr results,
+                              size_t col_idx,
+                              size_t entry_count,
+                              std::shared_ptr<arrow::ChunkedArray>& out) {
+  auto physical_type = builder.physical_type;
+  if (physical_type->isTimestamp()) {
+    physical_type = physical_type->ctx().integer(physical_type->size());
+  }
+  convert_column(physical_type, results, col_idx, entry_count, out);
+  if (!out->type()->Equals(builder.field->type())) {
+    ARROW_ASSIGN_OR_THROW(out, out->View(builder.field->type()));
+  }
+}
+
 #ifndef _MSC_VER
 std::pair<key_t, void*> get_shm(size_t shmsz) {
   if (!shmsz) {
@@ -1399,10 +1416,15 @@ std::shared_ptr<arrow::Table> ArrowResultSetConverter::getArrowTable(
 
       // Some types are not supported by columnar converter.
       switch (builders[col_idx].physical_type->id()) {
+        case hdk::ir::Type::kTimestamp:
+          // 64-bit timestamps have the same layout as Arrow timestamps.
+          if (builders[col_idx].physical_type->size() != 8) {
+            use_columnar_conversion = false;
+          }
+          break;
         case hdk::ir::Type::kBoolean:
         case hdk::ir::Type::kTime:
         case hdk::ir::Type::kDate:
-        case hdk::ir::Type::kTimestamp:
         case hdk::ir::Type::kText:
         case hdk::ir::Type::kVarChar:
         case hdk::ir::Type::kVarLenArray:
@@ -1428,11 +1450,11 @@ std::shared_ptr<arrow::Table> ArrowResultSetConverter::getArrowTable(
                       [&](tbb::blocked_range<size_t> br) {
                         for (size_t col_idx = br.begin(); col_idx < br.end(); ++col_idx) {
                           if (columnar_conversion_flags[col_idx]) {
-                            convert_column(builders[col_idx].physical_type,
-                                           results_,
-                                           col_idx,
-                                           entry_count,
-                                           result_columns[col_idx]);
+                            convert_column_zero_copy(builders[col_idx],
+                                                     results_,
+                                                     col_idx,
+                                                     entry_count,
+                                                     result_columns[col_idx]);
                           }
                         }
                       });
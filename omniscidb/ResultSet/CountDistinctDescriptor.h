@@ -40,7 +40,7 @@ inline size_t bitmap_bits_to_bytes(const size_t bitmap_sz) {
   return bitmap_byte_sz;
 }
 
-enum class CountDistinctImplType { Invalid, Bitmap, HashSet };
+enum class CountDistinctImplType { Invalid, Bitmap, HashSet, RoaringBitmap };
 
 struct CountDistinctDescriptor {
   CountDistinctImplType impl_type_;
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ExactQuantile.h"
+
+#include "Logger/Logger.h"
+#include "Shared/thread_count.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+constexpr size_t kPivotSampleSize = 1024;
+
+}  // namespace
+
+void ExactQuantile::allocateBlock() {
+  size_t capacity = blocks_.empty()
+                        ? kMinBlockSize
+                        : std::min(blocks_.back().capacity() * 2, kMaxBlockSize);
+  blocks_.emplace_back().reserve(capacity);
+}
+
+void ExactQuantile::merge(ExactQuantile& other) {
+  blocks_.reserve(blocks_.size() + other.blocks_.size());
+  std::move(other.blocks_.begin(), other.blocks_.end(), std::back_inserter(blocks_));
+  size_ += other.size_;
+  other.blocks_.clear();
+  other.size_ = 0;
+}
+
+double ExactQuantile::quantile() const {
+  if (!size_) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  std::vector<double> values;
+  auto fill_values = [&]() {
+    values.clear();
+    values.reserve(size_);
+    for (auto& block : blocks_) {
+      values.insert(values.end(), block.begin(), block.end());
+    }
+  };
+  fill_values();
+
+  if (!interpolate_) {
+    auto pos = static_cast<size_t>(std::ceil(q_ * size_));
+    return select(values, std::min(pos ? pos - 1 : 0, size_ - 1));
+  }
+
+  double pos = q_ * (size_ - 1);
+  auto lo = std::min(static_cast<size_t>(pos), size_ - 1);
+  double frac = pos - lo;
+  if (frac == 0.0) {
+    return select(values, lo);
+  }
+
+  double lo_val;
+  double hi_val;
+  if (size_ <= kParallelSelectThreshold) {
+    // All values after the selected one are not less than it, so the next order
+    // statistic is the minimum of the tail.
+    std::nth_element(values.begin(), values.begin() + lo, values.end());
+    lo_val = values[lo];
+    hi_val = *std::min_element(values.begin() + lo + 1, values.end());
+  } else {
+    lo_val = select(values, lo);
+    fill_values();
+    hi_val = select(values, lo + 1);
+  }
+  return lo_val + frac * (hi_val - lo_val);
+}
+
+double ExactQuantile::select(std::vector<double>& values, size_t k) {
+  CHECK_LT(k, values.size());
+  std::vector<double> buffer;
+  // Each round picks a pivot close to the searched value using a sample, counts
+  // values less than and equal to the pivot and keeps only the part holding the
+  // k-th value. Rounds stop when the rest is small enough for std::nth_element.
+  while (values.size() > kParallelSelectThreshold) {
+    const size_t n = values.size();
+    std::vector<double> sample(kPivotSampleSize);
+    for (size_t i = 0; i < kPivotSampleSize; ++i) {
+      sample[i] = values[i * (n / kPivotSampleSize)];
+    }
+    auto sample_pos = std::min(k / (n / kPivotSampleSize), kPivotSampleSize - 1);
+    std::nth_element(sample.begin(), sample.begin() + sample_pos, sample.end());
+    const double pivot = sample[sample_pos];
+
+    const size_t chunk_count = static_cast<size_t>(cpu_threads()) * 4;
+    const size_t chunk_size = (n + chunk_count - 1) / chunk_count;
+    std::vector<size_t> less(chunk_count, 0);
+    std::vector<size_t> equal(chunk_count, 0);
+    tbb::parallel_for(size_t(0), chunk_count, [&](size_t chunk) {
+      auto end = std::min(n, (chunk + 1) * chunk_size);
+      size_t chunk_less = 0;
+      size_t chunk_equal = 0;
+      for (size_t i = chunk * chunk_size; i < end; ++i) {
+        chunk_less += values[i] < pivot;
+        chunk_equal += values[i] == pivot;
+      }
+      less[chunk] = chunk_less;
+      equal[chunk] = chunk_equal;
+    });
+
+    size_t total_less = 0;
+    size_t total_equal = 0;
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      total_less += less[chunk];
+      total_equal += equal[chunk];
+    }
+    if (k >= total_less && k < total_less + total_equal) {
+      return pivot;
+    }
+
+    const bool keep_less = k < total_less;
+    if (!keep_less) {
+      k -= total_less + total_equal;
+    }
+    std::vector<size_t> offsets(chunk_count + 1, 0);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      auto begin = std::min(n, chunk * chunk_size);
+      auto end = std::min(n, (chunk + 1) * chunk_size);
+      auto greater = end - begin - less[chunk] - equal[chunk];
+      offsets[chunk + 1] = offsets[chunk] + (keep_less ? less[chunk] : greater);
+    }
+    buffer.resize(offsets.back());
+    tbb::parallel_for(size_t(0), chunk_count, [&](size_t chunk) {
+      auto end = std::min(n, (chunk + 1) * chunk_size);
+      auto out = buffer.data() + offsets[chunk];
+      for (size_t i = chunk * chunk_size; i < end; ++i) {
+        if (keep_less ? values[i] < pivot : values[i] > pivot) {
+          *out++ = values[i];
+        }
+      }
+    });
+    values.swap(buffer);
+  }
+
+  std::nth_element(values.begin(), values.begin() + k, values.end());
+  return values[k];
+}
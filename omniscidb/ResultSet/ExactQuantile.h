@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Collects all values of a group to compute an exact quantile for PERCENTILE_CONT,
+// PERCENTILE_DISC and MEDIAN aggregates. Values are appended to blocks of
+// growing size owned by the accumulator, so there is no per-value allocation and
+// no shared allocator lock on the aggregation path. The quantile is computed by
+// selection, which runs in parallel for big groups.
+class ExactQuantile {
+ public:
+  ExactQuantile(double q, bool interpolate) : q_(q), interpolate_(interpolate) {}
+
+  void add(double value) {
+    if (blocks_.empty() || blocks_.back().size() == blocks_.back().capacity()) {
+      allocateBlock();
+    }
+    blocks_.back().push_back(value);
+    ++size_;
+  }
+
+  // Take all values collected by another accumulator. Its blocks are moved without
+  // copying, so other is left empty.
+  void merge(ExactQuantile& other);
+
+  size_t size() const { return size_; }
+
+  // For PERCENTILE_CONT (interpolate is true) the result is linearly interpolated
+  // between two closest values. For PERCENTILE_DISC it is the first value whose
+  // cumulative distribution is not less than the quantile. Returns NaN for empty
+  // groups.
+  double quantile() const;
+
+  // Select the k-th smallest value. The content of values is modified.
+  static double select(std::vector<double>& values, size_t k);
+
+ private:
+  static constexpr size_t kMinBlockSize = 32;
+  static constexpr size_t kMaxBlockSize = 1 << 16;
+  // Groups bigger than that use parallel selection.
+  static constexpr size_t kParallelSelectThreshold = 1 << 20;
+
+  void allocateBlock();
+
+  double const q_;
+  bool const interpolate_;
+  std::vector<std::vector<double>> blocks_;
+  size_t size_{0};
+};
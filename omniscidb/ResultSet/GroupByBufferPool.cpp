@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ResultSet/GroupByBufferPool.h"
+
+#include "Shared/checked_alloc.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Buffers are compared with initial contents by blocks. Blocks which were not
+// modified by the previous query are only read.
+constexpr size_t kRestoreBlockSize = 4096;
+
+size_t get_bucket_capacity(size_t size) {
+  size_t capacity = kRestoreBlockSize;
+  while (capacity < size) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+}  // namespace
+
+GroupByBufferPool::Buffer::Buffer(std::weak_ptr<GroupByBufferPool> pool,
+                                  int8_t* data,
+                                  size_t capacity,
+                                  size_t size,
+                                  const std::string& layout,
+                                  size_t shard,
+                                  bool allocated,
+                                  bool initialized)
+    : pool_(std::move(pool))
+    , data_(data)
+    , capacity_(capacity)
+    , size_(size)
+    , layout_(layout)
+    , shard_(shard)
+    , allocated_(allocated)
+    , initialized_(initialized) {}
+
+GroupByBufferPool::Buffer::~Buffer() {
+  if (auto pool = pool_.lock()) {
+    pool->release(*this);
+  } else {
+    free(data_);
+  }
+}
+
+void GroupByBufferPool::Buffer::setInitialized() {
+  initialized_ = true;
+  if (auto pool = pool_.lock()) {
+    pool->saveInitialContent(*this);
+  }
+}
+
+GroupByBufferPool::GroupByBufferPool(size_t max_size,
+                                     size_t max_buffer_size,
+                                     size_t num_shards)
+    : max_size_(max_size)
+    , max_buffer_size_(max_buffer_size)
+    , shards_(std::max(num_shards, size_t(1))) {}
+
+GroupByBufferPool::~GroupByBufferPool() {
+  clear();
+}
+
+std::unique_ptr<GroupByBufferPool::Buffer> GroupByBufferPool::acquire(
+    size_t size,
+    const std::string& layout,
+    size_t thread_idx) {
+  if (size > max_buffer_size_ || size > max_size_ / 2) {
+    return nullptr;
+  }
+  const auto capacity = get_bucket_capacity(size);
+  const auto shard_idx = thread_idx % shards_.size();
+  auto& shard = shards_[shard_idx];
+
+  Entry entry{nullptr, ""};
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto bucket_it = shard.free_buffers.find(capacity);
+    if (bucket_it != shard.free_buffers.end() && !bucket_it->second.empty()) {
+      auto& bucket = bucket_it->second;
+      // Prefer a buffer of the same layout, it doesn't need a full initialization.
+      auto it = std::find_if(bucket.begin(), bucket.end(), [&layout](const Entry& e) {
+        return e.layout == layout;
+      });
+      if (it == bucket.end()) {
+        it = bucket.begin();
+      }
+      entry = std::move(*it);
+      bucket.erase(it);
+      idle_bytes_ -= capacity;
+    }
+  }
+
+  bool allocated = false;
+  bool initialized = false;
+  if (entry.data) {
+    ++hits_;
+    if (entry.layout == layout) {
+      initialized = restoreInitialContent(entry.data, size, layout);
+    }
+  } else {
+    ++misses_;
+    entry.data = reinterpret_cast<int8_t*>(checked_malloc(capacity));
+    allocated = true;
+  }
+  return std::unique_ptr<Buffer>(new Buffer(weak_from_this(),
+                                            entry.data,
+                                            capacity,
+                                            size,
+                                            layout,
+                                            shard_idx,
+                                            allocated,
+                                            initialized));
+}
+
+GroupByBufferPool::Stats GroupByBufferPool::getStats() const {
+  return {hits_.load(), misses_.load(), restored_bytes_.load(), idle_bytes_.load()};
+}
+
+void GroupByBufferPool::clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto& [capacity, bucket] : shard.free_buffers) {
+      for (auto& entry : bucket) {
+        free(entry.data);
+        idle_bytes_ -= capacity;
+      }
+    }
+    shard.free_buffers.clear();
+  }
+  std::lock_guard<std::mutex> lock(initial_contents_mutex_);
+  initial_contents_.clear();
+  initial_contents_bytes_ = 0;
+}
+
+void GroupByBufferPool::release(Buffer& buffer) {
+  // Shards are locked separately, so the buffer is charged before it is inserted to
+  // keep concurrent releases within the limit.
+  auto idle_bytes = idle_bytes_.fetch_add(buffer.capacity_) + buffer.capacity_;
+  if (idle_bytes + initial_contents_bytes_ > max_size_) {
+    idle_bytes_ -= buffer.capacity_;
+    free(buffer.data_);
+    return;
+  }
+  auto& shard = shards_[buffer.shard_];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  // Content of a buffer which wasn't initialized by the pool's user is unknown.
+  shard.free_buffers[buffer.capacity_].push_front(
+      Entry{buffer.data_, buffer.initialized_ ? buffer.layout_ : ""});
+}
+
+void GroupByBufferPool::saveInitialContent(const Buffer& buffer) {
+  std::lock_guard<std::mutex> lock(initial_contents_mutex_);
+  auto it = initial_contents_.find(buffer.layout_);
+  if (it != initial_contents_.end()) {
+    if (it->second->size() == buffer.size_) {
+      return;
+    }
+    initial_contents_bytes_ -= it->second->size();
+    initial_contents_.erase(it);
+  }
+  if (initial_contents_bytes_ + buffer.size_ > max_size_ / 2) {
+    initial_contents_.clear();
+    initial_contents_bytes_ = 0;
+  }
+  initial_contents_[buffer.layout_] = std::make_shared<const std::vector<int8_t>>(
+      buffer.data_, buffer.data_ + buffer.size_);
+  initial_contents_bytes_ += buffer.size_;
+}
+
+bool GroupByBufferPool::restoreInitialContent(int8_t* data,
+                                              size_t size,
+                                              const std::string& layout) {
+  std::shared_ptr<const std::vector<int8_t>> initial_content;
+  {
+    std::lock_guard<std::mutex> lock(initial_contents_mutex_);
+    auto it = initial_contents_.find(layout);
+    if (it == initial_contents_.end() || it->second->size() != size) {
+      return false;
+    }
+    initial_content = it->second;
+  }
+  auto src = initial_content->data();
+  size_t restored_bytes = 0;
+  for (size_t offs = 0; offs < size; offs += kRestoreBlockSize) {
+    auto block_size = std::min(kRestoreBlockSize, size - offs);
+    if (memcmp(data + offs, src + offs, block_size)) {
+      memcpy(data + offs, src + offs, block_size);
+      restored_bytes += block_size;
+    }
+  }
+  restored_bytes_ += restored_bytes;
+  return true;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Keeps group by buffers of finished queries to reuse them in next queries instead of
+ * allocating, page faulting and initializing new buffers. Idle buffers are grouped by
+ * power-of-two capacity in per-thread shards. Each buffer remembers the layout it was
+ * initialized for. When it is reused for the same layout, only blocks which differ
+ * from the initial content of the layout are restored.
+ */
+class GroupByBufferPool : public std::enable_shared_from_this<GroupByBufferPool> {
+ public:
+  // Buffer leased from the pool. It is returned to the pool on destruction.
+  class Buffer {
+   public:
+    ~Buffer();
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    int8_t* data() const { return data_; }
+
+    // Returns true if the buffer memory was allocated for this request and wasn't
+    // touched yet.
+    bool isAllocated() const { return allocated_; }
+
+    // Returns true if the buffer already holds the initial content of its layout.
+    bool isInitialized() const { return initialized_; }
+
+    // Should be called when the buffer is initialized for its layout by the caller.
+    void setInitialized();
+
+   private:
+    friend class GroupByBufferPool;
+
+    Buffer(std::weak_ptr<GroupByBufferPool> pool,
+           int8_t* data,
+           size_t capacity,
+           size_t size,
+           const std::string& layout,
+           size_t shard,
+           bool allocated,
+           bool initialized);
+
+    std::weak_ptr<GroupByBufferPool> pool_;
+    int8_t* data_;
+    size_t capacity_;
+    size_t size_;
+    std::string layout_;
+    size_t shard_;
+    bool allocated_;
+    bool initialized_;
+  };
+
+  struct Stats {
+    size_t hits;
+    size_t misses;
+    size_t restored_bytes;
+    size_t idle_bytes;
+  };
+
+  // The pool keeps up to max_size bytes of idle buffers and initial contents of
+  // layouts, initial contents take at most a half of it. Buffers bigger than
+  // max_buffer_size are not pooled.
+  GroupByBufferPool(size_t max_size, size_t max_buffer_size, size_t num_shards);
+  ~GroupByBufferPool();
+
+  // Returns a buffer of at least size bytes or nullptr if the size is too big for
+  // the pool. Layout is a key identifying the initial content of the buffer.
+  std::unique_ptr<Buffer> acquire(size_t size,
+                                  const std::string& layout,
+                                  size_t thread_idx);
+
+  Stats getStats() const;
+
+  // Frees all idle buffers and initial contents.
+  void clear();
+
+ private:
+  struct Entry {
+    int8_t* data;
+    // Layout the buffer was initialized for or an empty string.
+    std::string layout;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<size_t, std::list<Entry>> free_buffers;
+  };
+
+  void release(Buffer& buffer);
+  void saveInitialContent(const Buffer& buffer);
+  bool restoreInitialContent(int8_t* data, size_t size, const std::string& layout);
+
+  const size_t max_size_;
+  const size_t max_buffer_size_;
+  std::vector<Shard> shards_;
+  std::atomic<size_t> idle_bytes_{0};
+
+  mutable std::mutex initial_contents_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const std::vector<int8_t>>>
+      initial_contents_;
+  std::atomic<size_t> initial_contents_bytes_{0};
+
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+  std::atomic<size_t> restored_bytes_{0};
+};
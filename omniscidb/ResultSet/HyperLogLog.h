@@ -29,6 +29,11 @@
 
 #include <cmath>
 
+// Bounds for the number of bits used to index HyperLogLog registers. 4 is the minimum
+// for which we have an alpha adjustment factor in get_alpha().
+constexpr int kMinHllPrecisionBits = 4;
+constexpr int kMaxHllPrecisionBits = 16;
+
 inline double get_alpha(const size_t m) {
   switch (m) {
     case 16:
@@ -112,12 +117,45 @@ inline void hll_unify(T1* lhs, T2* rhs, const size_t m) {
   }
 }
 
+// Merges a sketch of 2^src_bits registers into 2^dst_bits registers, where
+// dst_bits <= src_bits. When the sketch is more precise, its extra index bits are the
+// leading bits of the hash part whose rank the destination register holds, so ranks
+// are recomputed for the folded registers.
+template <class T>
+inline void hll_merge_sketch(T* M,
+                             const uint32_t dst_bits,
+                             const int8_t* sketch,
+                             const uint32_t src_bits) {
+  if (src_bits == dst_bits) {
+    for (size_t r = 0; r < (size_t(1) << dst_bits); ++r) {
+      M[r] = std::max(static_cast<int8_t>(M[r]), sketch[r]);
+    }
+    return;
+  }
+  const uint32_t extra_bits = src_bits - dst_bits;
+  const size_t extra_mask = (size_t(1) << extra_bits) - 1;
+  for (size_t r = 0; r < (size_t(1) << src_bits); ++r) {
+    if (!sketch[r]) {
+      continue;
+    }
+    int8_t rank = extra_bits + sketch[r];
+    if (const auto extra = r & extra_mask) {
+      uint32_t extra_width = 0;
+      for (auto v = extra; v; v >>= 1) {
+        ++extra_width;
+      }
+      rank = extra_bits - extra_width + 1;
+    }
+    auto& reg = M[r >> extra_bits];
+    reg = std::max(static_cast<int8_t>(reg), rank);
+  }
+}
+
 inline int hll_size_for_rate(const int err_percent) {
   double err_rate{static_cast<double>(err_percent) / 100.0};
   double k = ceil(2 * log2(1.04 / err_rate));
-  // On the next line, 4 is the minimum for which we have an alpha adjustment factor in
-  // get_alpha()
-  return std::min(16, std::max(static_cast<int>(k), 4));
+  return std::min(kMaxHllPrecisionBits,
+                  std::max(static_cast<int>(k), kMinHllPrecisionBits));
 }
 
 #endif  // QUERYENGINE_HYPERLOGLOG_H
@@ -450,9 +450,14 @@ const hdk::ir::Type* ResultSet::colType(const size_t col_idx) const {
     return hdk::ir::Context::defaultCtx().text();
   }
   CHECK_LT(col_idx, targets_.size());
-  return targets_[col_idx].agg_kind == hdk::ir::AggType::kAvg
-             ? hdk::ir::Context::defaultCtx().fp64()
-             : targets_[col_idx].type;
+  auto& ctx = hdk::ir::Context::defaultCtx();
+  if (targets_[col_idx].agg_kind == hdk::ir::AggType::kAvg) {
+    return ctx.fp64();
+  }
+  if (targets_[col_idx].is_agg && hdk::ir::isHllSketch(targets_[col_idx].agg_kind)) {
+    return ctx.arrayVarLen(ctx.int8(false), 4, false);
+  }
+  return targets_[col_idx].type;
 }
 
 void ResultSet::setColNames(std::vector<std::string> fields) {
@@ -874,6 +879,13 @@ double ResultSet::calculateQuantile(quantile::TDigest* const t_digest) {
   return boost::math::isnan(quantile) ? NULL_DOUBLE : quantile;
 }
 
+double ResultSet::calculateQuantile(const ExactQuantile* const exact_quantile) {
+  static_assert(sizeof(int64_t) == sizeof(ExactQuantile*));
+  CHECK(exact_quantile);
+  double const quantile = exact_quantile->quantile();
+  return boost::math::isnan(quantile) ? NULL_DOUBLE : quantile;
+}
+
 size_t ResultSet::getLimit() const {
   return keep_first_;
 }
@@ -1178,7 +1190,7 @@ std::tuple<std::vector<bool>, size_t> ResultSet::getSupportedSingleSlotTargetBit
     const auto& target = targets_[target_idx];
     if (single_slot_targets[target_idx] &&
         (is_distinct_target(target) ||
-         target.agg_kind == hdk::ir::AggType::kApproxQuantile ||
+         hdk::ir::isQuantile(target.agg_kind) ||
          (target.is_agg && target.agg_kind == hdk::ir::AggType::kSample &&
           target.type->isFp32()))) {
       single_slot_targets[target_idx] = false;
@@ -28,6 +28,7 @@
 #include "BufferProvider/BufferProvider.h"
 #include "DataMgr/Chunk/Chunk.h"
 #include "IR/CardinalityEstimator.h"
+#include "ResultSet/ExactQuantile.h"
 #include "ResultSet/ResultSetBufferAccessors.h"
 #include "ResultSet/ResultSetStorage.h"
 #include "ResultSet/TargetValue.h"
@@ -525,6 +526,8 @@ class ResultSet {
 
   static double calculateQuantile(quantile::TDigest* const t_digest);
 
+  static double calculateQuantile(const ExactQuantile* const exact_quantile);
+
   void translateDictEncodedColumns(std::vector<TargetInfo> const&,
                                    size_t const start_idx);
 
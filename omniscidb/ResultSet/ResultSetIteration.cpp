@@ -31,6 +31,7 @@
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -791,6 +792,34 @@ TargetValue build_string_array_target_value(
   return ArrayTargetValue(values);
 }
 
+// HyperLogLog registers of a sketch aggregate are returned as a TINYINT array
+// regardless of the device the registers were built on.
+TargetValue build_hll_sketch_target_value(
+    const int64_t set_handle,
+    const CountDistinctDescriptor& count_distinct_desc,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) {
+  CHECK(count_distinct_desc.approximate);
+  const size_t register_count = size_t(1) << count_distinct_desc.bitmap_sz_bits;
+  if (!set_handle) {
+    std::vector<int8_t> empty_registers(register_count, 0);
+    return build_array_target_value<int8_t>(
+        empty_registers.data(), register_count, row_set_mem_owner);
+  }
+  if (count_distinct_desc.device_type == ExecutorDeviceType::GPU) {
+    // Registers built on GPU are 32-bit, ranks always fit the declared element type.
+    const auto gpu_registers = reinterpret_cast<const int32_t*>(set_handle);
+    std::vector<int8_t> registers(register_count);
+    std::transform(gpu_registers,
+                   gpu_registers + register_count,
+                   registers.begin(),
+                   [](const int32_t rank) { return static_cast<int8_t>(rank); });
+    return build_array_target_value<int8_t>(
+        registers.data(), register_count, row_set_mem_owner);
+  }
+  const auto registers = reinterpret_cast<const int8_t*>(set_handle);
+  return build_array_target_value<int8_t>(registers, register_count, row_set_mem_owner);
+}
+
 TargetValue build_array_target_value(const hdk::ir::Type* array_type,
                                      const int8_t* buff,
                                      const size_t buff_sz,
@@ -1242,6 +1271,11 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
                  ? NULL_DOUBLE  // sql_validate / just_validate
                  : calculateQuantile(*reinterpret_cast<quantile::TDigest* const*>(ptr));
     }
+    if (hdk::ir::isExactQuantile(target_info.agg_kind)) {
+      return *reinterpret_cast<double const*>(ptr) == NULL_DOUBLE
+                 ? NULL_DOUBLE  // sql_validate / just_validate
+                 : calculateQuantile(*reinterpret_cast<ExactQuantile* const*>(ptr));
+    }
     switch (actual_compact_sz) {
       case 8: {
         const auto dval = *reinterpret_cast<const double*>(ptr);
@@ -1259,8 +1293,13 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
   if (chosen_type->isInteger() | chosen_type->isBoolean() || chosen_type->isDateTime() ||
       chosen_type->isInterval()) {
     if (is_distinct_target(target_info)) {
-      return TargetValue(count_distinct_set_size(
-          ival, query_mem_desc_.getCountDistinctDescriptor(target_logical_idx)));
+      const auto& count_distinct_desc =
+          query_mem_desc_.getCountDistinctDescriptor(target_logical_idx);
+      if (hdk::ir::isHllSketch(target_info.agg_kind)) {
+        return build_hll_sketch_target_value(
+            ival, count_distinct_desc, row_set_mem_owner_);
+      }
+      return TargetValue(count_distinct_set_size(ival, count_distinct_desc));
     }
     // TODO(alex): remove int_resize_cast, make read_int_from_buff return the
     // right type instead
@@ -175,7 +175,7 @@ std::vector<int64_t> result_set::initialize_target_values_for_storage(
   std::vector<int64_t> target_init_vals;
   for (const auto& target_info : targets) {
     if (target_info.agg_kind == hdk::ir::AggType::kCount ||
-        target_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct) {
+        hdk::ir::isHll(target_info.agg_kind)) {
       target_init_vals.push_back(0);
       continue;
     }
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "RoaringBitmap.h"
+
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+
+bool RoaringBitmap::add(const uint32_t val) {
+  auto& container = getOrAddContainer(static_cast<uint16_t>(val >> 16));
+  if (container.add(static_cast<uint16_t>(val & 0xFFFF))) {
+    ++cardinality_;
+    return true;
+  }
+  return false;
+}
+
+bool RoaringBitmap::contains(const uint32_t val) const {
+  const auto key = static_cast<uint16_t>(val >> 16);
+  auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+  if (it == keys_.end() || *it != key) {
+    return false;
+  }
+  return containers_[it - keys_.begin()].contains(static_cast<uint16_t>(val & 0xFFFF));
+}
+
+void RoaringBitmap::unionWith(const RoaringBitmap& other) {
+  if (other.keys_.empty()) {
+    return;
+  }
+  std::vector<uint16_t> keys;
+  std::vector<Container> containers;
+  keys.reserve(keys_.size() + other.keys_.size());
+  containers.reserve(keys_.size() + other.keys_.size());
+  size_t idx = 0;
+  size_t other_idx = 0;
+  while (idx < keys_.size() || other_idx < other.keys_.size()) {
+    if (other_idx == other.keys_.size() ||
+        (idx < keys_.size() && keys_[idx] < other.keys_[other_idx])) {
+      keys.push_back(keys_[idx]);
+      containers.push_back(std::move(containers_[idx++]));
+    } else if (idx == keys_.size() || other.keys_[other_idx] < keys_[idx]) {
+      keys.push_back(other.keys_[other_idx]);
+      containers.push_back(other.containers_[other_idx++]);
+    } else {
+      containers_[idx].unionWith(other.containers_[other_idx++]);
+      keys.push_back(keys_[idx]);
+      containers.push_back(std::move(containers_[idx++]));
+    }
+  }
+  keys_ = std::move(keys);
+  containers_ = std::move(containers);
+  cardinality_ = 0;
+  for (auto& container : containers_) {
+    cardinality_ += container.cardinality;
+  }
+  last_container_idx_ = 0;
+}
+
+size_t RoaringBitmap::memoryUsage() const {
+  size_t res = sizeof(RoaringBitmap) + keys_.capacity() * sizeof(uint16_t) +
+               containers_.capacity() * sizeof(Container);
+  for (auto& container : containers_) {
+    res += container.array.capacity() * sizeof(uint16_t) +
+           container.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return res;
+}
+
+RoaringBitmap::Container& RoaringBitmap::getOrAddContainer(const uint16_t key) {
+  if (last_container_idx_ < keys_.size() && keys_[last_container_idx_] == key) {
+    return containers_[last_container_idx_];
+  }
+  auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+  const size_t idx = it - keys_.begin();
+  if (it == keys_.end() || *it != key) {
+    keys_.insert(it, key);
+    containers_.emplace(containers_.begin() + idx);
+  }
+  last_container_idx_ = idx;
+  return containers_[idx];
+}
+
+bool RoaringBitmap::Container::add(const uint16_t val) {
+  if (isBitmap()) {
+    auto& word = bitmap[val >> 6];
+    const uint64_t mask = uint64_t(1) << (val & 63);
+    if (word & mask) {
+      return false;
+    }
+    word |= mask;
+    ++cardinality;
+    return true;
+  }
+  auto it = std::lower_bound(array.begin(), array.end(), val);
+  if (it != array.end() && *it == val) {
+    return false;
+  }
+  if (array.size() >= kMaxArrayContainerSize) {
+    convertToBitmap();
+    return add(val);
+  }
+  array.insert(it, val);
+  ++cardinality;
+  return true;
+}
+
+bool RoaringBitmap::Container::contains(const uint16_t val) const {
+  if (isBitmap()) {
+    return bitmap[val >> 6] & (uint64_t(1) << (val & 63));
+  }
+  return std::binary_search(array.begin(), array.end(), val);
+}
+
+void RoaringBitmap::Container::unionWith(const Container& other) {
+  if (other.isBitmap()) {
+    if (!isBitmap()) {
+      convertToBitmap();
+    }
+    cardinality = 0;
+    for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+      bitmap[i] |= other.bitmap[i];
+      cardinality += std::bitset<64>(bitmap[i]).count();
+    }
+    return;
+  }
+  if (isBitmap()) {
+    for (auto val : other.array) {
+      add(val);
+    }
+    return;
+  }
+  std::vector<uint16_t> merged;
+  merged.reserve(array.size() + other.array.size());
+  std::set_union(array.begin(),
+                 array.end(),
+                 other.array.begin(),
+                 other.array.end(),
+                 std::back_inserter(merged));
+  array = std::move(merged);
+  cardinality = static_cast<uint32_t>(array.size());
+  if (array.size() > kMaxArrayContainerSize) {
+    convertToBitmap();
+  }
+}
+
+void RoaringBitmap::Container::convertToBitmap() {
+  bitmap.assign(kBitmapContainerWords, 0);
+  for (auto val : array) {
+    bitmap[val >> 6] |= uint64_t(1) << (val & 63);
+  }
+  array.clear();
+  array.shrink_to_fit();
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A compressed set of 32-bit values used for exact COUNT(DISTINCT) when the value
+// range is too wide for a dense bitmap per group. Values are split by the high 16
+// bits into containers. A container keeps the low 16 bits in a sorted array while
+// it is sparse and switches to a 2^16 bit bitmap when it has more than 4096 values,
+// so each value takes at most 2 bytes and empty sets take almost no memory.
+class RoaringBitmap {
+ public:
+  // Returns true if the value was not in the set.
+  bool add(const uint32_t val);
+
+  bool contains(const uint32_t val) const;
+
+  size_t cardinality() const { return cardinality_; }
+
+  void unionWith(const RoaringBitmap& other);
+
+  size_t memoryUsage() const;
+
+ private:
+  static constexpr size_t kMaxArrayContainerSize = 4096;
+  static constexpr size_t kBitmapContainerWords = (1 << 16) / 64;
+
+  struct Container {
+    // Sorted low bits of values for sparse containers.
+    std::vector<uint16_t> array;
+    // Non-empty for dense containers only.
+    std::vector<uint64_t> bitmap;
+    uint32_t cardinality = 0;
+
+    bool isBitmap() const { return !bitmap.empty(); }
+    bool add(const uint16_t val);
+    bool contains(const uint16_t val) const;
+    void unionWith(const Container& other);
+    void convertToBitmap();
+  };
+
+  Container& getOrAddContainer(const uint16_t key);
+
+  std::vector<uint16_t> keys_;
+  std::vector<Container> containers_;
+  size_t cardinality_ = 0;
+  // Index of the last accessed container. Values coming from a fragment are often
+  // clustered, so it allows to skip the container search.
+  size_t last_container_idx_ = 0;
+};
@@ -29,6 +29,9 @@
 #include "DataMgr/DataMgr.h"
 #include "DataProvider/DataProvider.h"
 #include "Logger/Logger.h"
+#include "ResultSet/ExactQuantile.h"
+#include "ResultSet/GroupByBufferPool.h"
+#include "ResultSet/RoaringBitmap.h"
 #include "Shared/quantile.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 #include "ThirdParty/robin_hood.h"
@@ -87,11 +90,22 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     count_distinct_sets_.push_back(count_distinct_set);
   }
 
+  void addCountDistinctRoaringBitmap(RoaringBitmap* count_distinct_bitmap) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    count_distinct_roaring_bitmaps_.push_back(count_distinct_bitmap);
+  }
+
   void addGroupByBuffer(int64_t* group_by_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     group_by_buffers_.push_back(group_by_buffer);
   }
 
+  // The buffer is returned to its pool when the owner is destroyed.
+  void addPooledBuffer(std::unique_ptr<GroupByBufferPool::Buffer> buffer) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    pooled_buffers_.push_back(std::move(buffer));
+  }
+
   void addVarlenBuffer(void* varlen_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     varlen_buffers_.push_back(varlen_buffer);
@@ -209,6 +223,9 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     for (auto count_distinct_set : count_distinct_sets_) {
       delete count_distinct_set;
     }
+    for (auto count_distinct_bitmap : count_distinct_roaring_bitmaps_) {
+      delete count_distinct_bitmap;
+    }
     for (auto group_by_buffer : group_by_buffers_) {
       free(group_by_buffer);
     }
@@ -234,6 +251,8 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
 
   quantile::TDigest* nullTDigest(double const q);
 
+  ExactQuantile* nullExactQuantile(double const q, bool const interpolate);
+
  private:
   struct CountDistinctBitmapBuffer {
     int8_t* ptr;
@@ -243,7 +262,9 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
   std::vector<robin_hood::unordered_set<int64_t>*> count_distinct_sets_;
+  std::vector<RoaringBitmap*> count_distinct_roaring_bitmaps_;
   std::vector<int64_t*> group_by_buffers_;
+  std::vector<std::unique_ptr<GroupByBufferPool::Buffer>> pooled_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
   std::list<std::vector<int64_t>> arrays_;
@@ -256,6 +277,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   std::vector<void*> col_buffers_;
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
   std::vector<std::unique_ptr<quantile::TDigest>> t_digests_;
+  std::vector<std::unique_ptr<ExactQuantile>> exact_quantiles_;
 
   DataProvider* data_provider_;  // for metadata lookups
   size_t arena_block_size_;      // for cloning
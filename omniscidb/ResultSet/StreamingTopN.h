@@ -13,6 +13,23 @@
 
 namespace streaming_top_n {
 
+enum class KeyKind : int8_t { kInteger, kFloat, kDouble, kString };
+
+// Describes a component of a composite top-N heap key. Key values are passed to
+// the heap runtime and compared as raw slot bits sign-extended to 64 bits.
+// Strings use two slots holding the payload pointer and the length. Null strings
+// have a null payload pointer.
+struct CompositeKeyDesc {
+  int64_t null_bits;
+  uint32_t offset;
+  uint32_t len_offset;
+  int8_t width;
+  int8_t len_width;
+  KeyKind kind;
+  bool is_desc;
+  bool nulls_first;
+};
+
 size_t get_heap_size(const size_t row_size, const size_t n, const size_t thread_count);
 
 size_t get_rows_offset_of_heaps(const size_t n, const size_t thread_count);
@@ -10,8 +10,64 @@
 #include "ResultSet/ArrowResultSet.h"
 #include "Shared/ArrowUtil.h"
 
+#include <tbb/parallel_for.h>
+
 namespace hdk {
 
+namespace {
+
+class ResultSetTableReader : public arrow::RecordBatchReader {
+ public:
+  ResultSetTableReader(ResultSetTableTokenPtr token, int64_t max_chunk_size)
+      : token_(std::move(token)), max_chunk_size_(max_chunk_size) {
+    auto first_rs = token_->resultSet(0);
+    for (size_t col_idx = 0; col_idx < first_rs->colCount(); ++col_idx) {
+      col_names_.push_back(first_rs->colName(col_idx));
+    }
+    schema_ = ArrowResultSetConverter(first_rs, col_names_, -1).makeSchema();
+  }
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    while (true) {
+      if (fragment_reader_) {
+        ARROW_RETURN_NOT_OK(fragment_reader_->ReadNext(batch));
+        if (*batch) {
+          return arrow::Status::OK();
+        }
+        // release the converted fragment before the next one is converted
+        fragment_reader_.reset();
+      }
+      if (next_rs_idx_ == token_->resultSetCount()) {
+        batch->reset();
+        return arrow::Status::OK();
+      }
+      try {
+        ArrowResultSetConverter converter(
+            token_->resultSet(next_rs_idx_++), col_names_, -1);
+        fragment_reader_ =
+            std::make_unique<arrow::TableBatchReader>(converter.convertToArrowTable());
+      } catch (const std::exception& e) {
+        return arrow::Status::ExecutionError(e.what());
+      }
+      if (max_chunk_size_ > 0) {
+        fragment_reader_->set_chunksize(max_chunk_size_);
+      }
+    }
+  }
+
+ private:
+  ResultSetTableTokenPtr token_;
+  int64_t max_chunk_size_;
+  std::vector<std::string> col_names_;
+  std::shared_ptr<arrow::Schema> schema_;
+  size_t next_rs_idx_ = 0;
+  std::unique_ptr<arrow::TableBatchReader> fragment_reader_;
+};
+
+}  // namespace
+
 ResultSetTableToken::ResultSetTableToken(TableInfoPtr tinfo,
                                          size_t row_count,
                                          std::shared_ptr<ResultSetRegistry> registry)
@@ -46,25 +102,62 @@ ResultSetTableTokenPtr ResultSetTableToken::tail(size_t n) const {
   return registry_->tail(*this, n);
 }
 
+ResultSetTableTokenPtr ResultSetTableToken::shallowCopy() const {
+  std::vector<ResultSetPtr> results;
+  results.reserve(resultSetCount());
+  for (size_t rs_idx = 0; rs_idx < resultSetCount(); ++rs_idx) {
+    results.push_back(resultSet(rs_idx)->shallowCopy());
+  }
+  return registry_->put({std::move(results)});
+}
+
 std::shared_ptr<arrow::Table> ResultSetTableToken::toArrow() const {
-  auto first_rs = resultSet(0);
+  std::vector<ResultSetPtr> result_sets;
+  for (size_t rs_idx = 0; rs_idx < resultSetCount(); ++rs_idx) {
+    result_sets.push_back(resultSet(rs_idx));
+  }
+  auto& first_rs = result_sets.front();
   std::vector<std::string> col_names;
   for (size_t col_idx = 0; col_idx < first_rs->colCount(); ++col_idx) {
     col_names.push_back(first_rs->colName(col_idx));
   }
 
-  std::vector<std::shared_ptr<arrow::Table>> converted_tables;
-  for (size_t rs_idx = 0; rs_idx < resultSetCount(); ++rs_idx) {
-    ArrowResultSetConverter converter(resultSet(rs_idx), col_names, -1);
-    converted_tables.push_back(converter.convertToArrowTable());
-  }
+  // Fragments are converted independently. Converted columns refer to columnar
+  // result buffers directly when possible, so no data is copied to assemble the
+  // resulting table.
+  std::vector<std::shared_ptr<arrow::Table>> converted_tables(result_sets.size());
+  tbb::parallel_for(size_t(0), result_sets.size(), [&](size_t rs_idx) {
+    ArrowResultSetConverter converter(result_sets[rs_idx], col_names, -1);
+    converted_tables[rs_idx] = converter.convertToArrowTable();
+  });
 
   if (converted_tables.size() == (size_t)1) {
     return converted_tables.front();
   }
 
-  ARROW_ASSIGN_OR_THROW(auto res, arrow::ConcatenateTables(converted_tables));
-  return res;
+  auto schema = converted_tables.front()->schema();
+  int64_t num_rows = 0;
+  for (auto& table : converted_tables) {
+    num_rows += table->num_rows();
+  }
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  columns.reserve(schema->num_fields());
+  for (int col_idx = 0; col_idx < schema->num_fields(); ++col_idx) {
+    arrow::ArrayVector chunks;
+    for (auto& table : converted_tables) {
+      auto& column_chunks = table->column(col_idx)->chunks();
+      chunks.insert(chunks.end(), column_chunks.begin(), column_chunks.end());
+    }
+    ARROW_ASSIGN_OR_THROW(
+        auto column, arrow::ChunkedArray::Make(chunks, schema->field(col_idx)->type()));
+    columns.emplace_back(std::move(column));
+  }
+  return arrow::Table::Make(schema, columns, num_rows);
+}
+
+std::shared_ptr<arrow::RecordBatchReader> ResultSetTableToken::toArrowReader(
+    int64_t max_chunk_size) const {
+  return std::make_shared<ResultSetTableReader>(shared_from_this(), max_chunk_size);
 }
 
 std::vector<TargetValue> ResultSetTableToken::row(size_t row_idx,
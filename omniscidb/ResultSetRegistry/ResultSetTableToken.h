@@ -56,8 +56,17 @@ class ResultSetTableToken : public std::enable_shared_from_this<ResultSetTableTo
 
   ResultSetTableTokenPtr head(size_t n) const;
   ResultSetTableTokenPtr tail(size_t n) const;
+  // New table with result sets sharing data with the original ones but having
+  // their own iteration state.
+  ResultSetTableTokenPtr shallowCopy() const;
 
   std::shared_ptr<arrow::Table> toArrow() const;
+  // Result set fragments are converted lazily while batches are read, so only
+  // one converted fragment is held at a time. Batches are limited to
+  // max_chunk_size rows when it is positive. The reader holds a reference to
+  // the token, so the token has to be owned by a shared pointer.
+  std::shared_ptr<arrow::RecordBatchReader> toArrowReader(
+      int64_t max_chunk_size = 0) const;
 
   std::vector<TargetValue> row(size_t row_idx,
                                bool translate_strings,
@@ -66,6 +66,9 @@ struct TableInfo : public TableRef {
   size_t fragments;
   size_t row_count;
   bool is_stream;
+  // Incremented on each data modification. Used to distinguish data cached
+  // for different versions of the table.
+  size_t data_version = 0;
 
   std::string toString() const {
     return name + "(db_id=" + std::to_string(db_id) +
@@ -26,8 +26,9 @@ struct WatchdogConfig {
 };
 
 struct CpuSubTasksConfig {
-  bool enable = false;
+  bool enable = true;
   size_t sub_task_size = 500'000;
+  size_t min_sub_task_size = 65'536;
 };
 
 struct JoinConfig {
@@ -35,6 +36,10 @@ struct JoinConfig {
   unsigned trivial_loop_join_threshold = 1'000;
   size_t huge_join_hash_threshold = 1'000'000;
   size_t huge_join_hash_min_load = 10;
+  bool enable_probe_prefetch = true;
+  size_t probe_prefetch_threshold = 0;
+  size_t probe_prefetch_distance = 16;
+  bool enable_range_join = true;
 };
 
 struct GroupByConfig {
@@ -57,6 +62,13 @@ struct GroupByConfig {
   size_t min_partitions = 0;
   size_t max_partitions = 1024;
   size_t partitioning_buffer_target_size = 32 << 20;
+  bool enable_roaring_count_distinct = true;
+  size_t roaring_count_distinct_threshold = 256 << 20;
+  bool enable_two_phase_count_distinct = true;
+  size_t two_phase_count_distinct_threshold = 10'000'000;
+  bool enable_buffer_pool = false;
+  size_t buffer_pool_size = 1ULL << 30;
+  size_t buffer_pool_max_buffer_size = 16ULL << 20;
 };
 
 struct WindowFunctionsConfig {
@@ -89,6 +101,12 @@ struct CodegenConfig {
   bool null_mod_by_zero = false;
   bool hoist_literals = true;
   bool enable_filter_function = true;
+  bool enable_tiered_compilation = false;
+  size_t tier_up_threshold = 3;
+  bool enable_interpreter = false;
+  size_t interpreter_max_input_rows = 100'000;
+  bool enable_speculative_compilation = false;
+  bool enable_runtime_dylib = true;
 };
 
 struct ExecutionConfig {
@@ -103,6 +121,7 @@ struct ExecutionConfig {
 
   size_t streaming_topn_max = 100'000;
   size_t parallel_top_min = 100'000;
+  bool enable_top_n_fragment_pruning = true;
   bool enable_experimental_string_functions = false;
   bool enable_interop = false;
   size_t parallel_linearization_threshold = 10'000;
@@ -117,6 +136,7 @@ struct ExecutionConfig {
   std::string initialize_with_gpu_vendor = "";
 
   bool enable_cost_model = false;
+  bool enable_numa_affinity = false;
 };
 
 struct FilterPushdownConfig {
@@ -156,6 +176,13 @@ struct CpuMemoryConfig {
   size_t max_size = 0;
   size_t min_slab_size = 256ULL << 20;
   size_t max_slab_size = 4ULL << 30;
+  std::string eviction_policy = "lru";
+  // Comma-separated list of <db_id>:<table_id> pairs.
+  std::string priority_tables = "";
+  bool enable_huge_pages = false;
+  bool enable_prefault = false;
+  // Query buffers smaller than this size don't use huge pages and prefaulting.
+  size_t huge_pages_buffer_threshold = 64ULL << 20;
 };
 
 struct MemoryConfig {
@@ -169,9 +196,13 @@ struct CacheConfig {
   bool use_hashtable_cache = true;
   size_t hashtable_cache_total_bytes = 1ULL << 32;
   size_t max_cacheable_hashtable_size_bytes = 1ULL << 31;
+  bool use_query_resultset_cache = false;
+  size_t query_resultset_cache_total_bytes = 1ULL << 31;
+  size_t max_query_resultset_size_bytes = 1ULL << 29;
   double gpu_fraction_code_cache_to_evict = 0.2;
   size_t dag_cache_size = 1'000'000'000;
   size_t code_cache_size = 1'000;
+  size_t cardinality_cache_size = 10'000;
 };
 
 struct DebugConfig {
@@ -185,6 +216,9 @@ struct DebugConfig {
 struct StorageConfig {
   bool enable_lazy_dict_materialization = false;
   bool enable_non_lazy_data_import = false;
+  bool enable_streaming_import = false;
+  size_t streaming_import_blocks = 4;
+  bool enable_column_compression = false;
 };
 
 struct Config {
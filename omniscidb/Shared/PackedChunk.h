@@ -0,0 +1,63 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Layout of packed fixed-width integer chunks.
+ *
+ * A packed chunk starts with PackedChunkHeader followed by bit-packed codes.
+ * Code of a value is its difference with the frame of reference (base).
+ * Codes are stored with bit_width bits each in little-endian bit order. If
+ * the chunk has nulls, then the maximum code (all bit_width bits set) is
+ * reserved for nulls. Packed data is padded so that any code can be read
+ * with a single 8-byte load.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "funcannotations.h"
+
+struct PackedChunkHeader {
+  int64_t base;
+  int32_t bit_width;
+  int32_t has_nulls;
+};
+
+// Maximum number of bits per value supported by the packed layout. Limited
+// to allow a single 8-byte load for any value with an arbitrary bit offset.
+constexpr int32_t kMaxPackedBitWidth = 32;
+
+inline DEVICE size_t packed_chunk_size(const size_t num_elems,
+                                       const int32_t bit_width) {
+  return sizeof(PackedChunkHeader) + (num_elems * bit_width + 7) / 8 + sizeof(uint64_t);
+}
+
+inline DEVICE int32_t packed_bit_width(const int64_t min,
+                                       const int64_t max,
+                                       const bool has_nulls) {
+  uint64_t max_code = static_cast<uint64_t>(max) - static_cast<uint64_t>(min) +
+                      static_cast<uint64_t>(has_nulls);
+  // Overflow means we need all 64 bits.
+  if (has_nulls && max_code == 0) {
+    return 64;
+  }
+  int32_t res = 0;
+  while (max_code) {
+    ++res;
+    max_code >>= 1;
+  }
+  return res;
+}
@@ -117,13 +117,21 @@ inline TargetInfo get_target_info(const PointerType target_expr,
         is_distinct};
   }
 
+  auto target_type = agg_expr->type();
+  if (agg_type == hdk::ir::AggType::kCount) {
+    target_type = ctx.integer((is_distinct || bigint_count) ? 8 : 4, nullable);
+  } else if (hdk::ir::isHllSketch(agg_type)) {
+    // Sketch aggregates keep a pointer to HyperLogLog registers in the slot, the same
+    // way as approximate count distinct does. Registers are converted to an array
+    // when the value is fetched from the result set.
+    target_type = ctx.int64(false);
+  }
+
   return {true,
           agg_expr->aggType(),
-          agg_type == hdk::ir::AggType::kCount
-              ? ctx.integer((is_distinct || bigint_count) ? 8 : 4, nullable)
-              : agg_expr->type(),
+          target_type,
           agg_arg_type,
-          agg_type == hdk::ir::AggType::kCount &&
+          (agg_type == hdk::ir::AggType::kCount || hdk::ir::isHll(agg_type)) &&
                   (agg_arg_type->isString() || agg_arg_type->isArray())
               ? false
               : agg_arg_type->nullable(),
@@ -131,8 +139,7 @@ inline TargetInfo get_target_info(const PointerType target_expr,
 }
 
 inline bool is_distinct_target(const TargetInfo& target_info) {
-  return target_info.is_distinct ||
-         target_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct;
+  return target_info.is_distinct || hdk::ir::isHll(target_info.agg_kind);
 }
 
 inline bool takes_float_argument(const TargetInfo& target_info) {
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Shared/huge_pages.h"
+
+#include "Logger/Logger.h"
+
+#include <sys/mman.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+namespace huge_pages {
+
+namespace {
+
+constexpr uintptr_t kHugePageSize = 2ULL << 20;
+
+}  // namespace
+
+void advise(void* ptr, size_t size) {
+#ifdef MADV_HUGEPAGE
+  auto start = (reinterpret_cast<uintptr_t>(ptr) + kHugePageSize - 1) &
+               ~(kHugePageSize - 1);
+  auto end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(kHugePageSize - 1);
+  if (start >= end) {
+    return;
+  }
+  if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE)) {
+    LOG(WARNING) << "Cannot use huge pages for " << size
+                 << " bytes: " << strerror(errno);
+  }
+#endif
+}
+
+void prefault(void* ptr, size_t size) {
+  if (!size) {
+    return;
+  }
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  auto start = reinterpret_cast<uintptr_t>(ptr);
+  auto first_page = start & ~(page_size - 1);
+  auto num_pages = (start + size - first_page + page_size - 1) / page_size;
+  // Atomic read-modify-write causes a single write fault. A plain read followed by
+  // a write would map the shared zero page first and then copy it on write.
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, num_pages, 512),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t i = r.begin(); i < r.end(); ++i) {
+                        auto addr = std::max(first_page + i * page_size, start);
+                        __atomic_fetch_or(
+                            reinterpret_cast<int8_t*>(addr), 0, __ATOMIC_RELAXED);
+                      }
+                    });
+}
+
+}  // namespace huge_pages
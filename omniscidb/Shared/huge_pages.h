@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace huge_pages {
+
+// Asks the kernel to back the memory range with transparent huge pages. Only whole
+// 2MB pages within the range are advised, so small ranges are left untouched.
+void advise(void* ptr, size_t size);
+
+// Touches every page of the memory range in parallel to take page faults before the
+// memory is used. The content of the range is preserved.
+void prefault(void* ptr, size_t size);
+
+}  // namespace huge_pages
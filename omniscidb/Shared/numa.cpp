@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Shared/numa.h"
+
+#include "Logger/Logger.h"
+
+#include <tbb/info.h>
+
+#ifdef HAVE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace numa {
+
+namespace {
+
+thread_local int thread_node = -1;
+
+}  // namespace
+
+int num_nodes() {
+#ifdef HAVE_NUMA
+  static const int nodes =
+      numa_available() < 0 ? 1 : std::max(numa_num_configured_nodes(), 1);
+  return nodes;
+#else
+  return 1;
+#endif
+}
+
+int current_node() {
+  return thread_node;
+}
+
+NodeScope::NodeScope(int node) : prev_node_(thread_node) {
+  thread_node = node;
+}
+
+NodeScope::~NodeScope() {
+  thread_node = prev_node_;
+}
+
+tbb::task_arena& get_node_arena(int node) {
+  static std::once_flag init_flag;
+  static std::vector<std::unique_ptr<tbb::task_arena>> arenas;
+  std::call_once(init_flag, []() {
+    // TBB knows NUMA topology only when its hwloc binding is available. Otherwise
+    // arenas are not constrained, but still keep fragment to node affinity.
+    auto tbb_nodes = tbb::info::numa_nodes();
+    for (int i = 0; i < num_nodes(); ++i) {
+      tbb::task_arena::constraints constraints;
+      if (static_cast<size_t>(i) < tbb_nodes.size() &&
+          tbb_nodes[i] != tbb::task_arena::automatic) {
+        constraints.set_numa_id(tbb_nodes[i]);
+      }
+      arenas.emplace_back(std::make_unique<tbb::task_arena>(constraints));
+    }
+  });
+  CHECK_GE(node, 0);
+  CHECK_LT(static_cast<size_t>(node), arenas.size());
+  return *arenas[node];
+}
+
+void bind_to_node(void* ptr, size_t size, int node) {
+#ifdef HAVE_NUMA
+  if (num_nodes() <= 1 || node < 0 || !size) {
+    return;
+  }
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  auto start = reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1);
+  auto end = reinterpret_cast<uintptr_t>(ptr) + size;
+  auto mask = numa_allocate_nodemask();
+  numa_bitmask_setbit(mask, node);
+  // MPOL_PREFERRED falls back to other nodes instead of failing when the node runs
+  // out of memory.
+  if (mbind(reinterpret_cast<void*>(start),
+            end - start,
+            MPOL_PREFERRED,
+            mask->maskp,
+            mask->size + 1,
+            MPOL_MF_MOVE)) {
+    LOG(WARNING) << "Cannot bind " << size << " bytes to NUMA node " << node << ": "
+                 << strerror(errno);
+  }
+  numa_bitmask_free(mask);
+#endif
+}
+
+}  // namespace numa
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <tbb/task_arena.h>
+
+#include <cstddef>
+
+namespace numa {
+
+// Returns the number of NUMA nodes in the system. Returns 1 if the library is built
+// without libnuma or the system doesn't provide NUMA information.
+int num_nodes();
+
+// Returns the node the current thread works for or -1 if the thread is not assigned
+// to any node.
+int current_node();
+
+// Assigns the current thread to the node for the lifetime of the object.
+class NodeScope {
+ public:
+  explicit NodeScope(int node);
+  ~NodeScope();
+
+  NodeScope(const NodeScope&) = delete;
+  NodeScope& operator=(const NodeScope&) = delete;
+
+ private:
+  int prev_node_;
+};
+
+// Returns a TBB arena whose threads are constrained to the node's cores. Arenas are
+// created on the first request and live until the process exits.
+tbb::task_arena& get_node_arena(int node);
+
+// Makes the node preferred for pages of the memory range and moves pages which
+// are already allocated. Does nothing if there is a single node.
+void bind_to_node(void* ptr, size_t size, int node);
+
+}  // namespace numa
@@ -65,7 +65,7 @@ inline bool is_column_key(const ChunkKey& key) {
 }
 
 inline bool is_varlen_key(const ChunkKey& key) {
-  return key.size() == 5;
+  return key.size() == 5 && (key[4] == 1 || key[4] == 2);
 }
 
 inline bool is_varlen_data_key(const ChunkKey& key) {
@@ -76,6 +76,11 @@ inline bool is_varlen_index_key(const ChunkKey& key) {
   return key.size() == 5 && key[4] == 2;
 }
 
+// Key of a fixed-width chunk in the bit-packed layout (see Shared/PackedChunk.h).
+inline bool is_packed_data_key(const ChunkKey& key) {
+  return key.size() == 5 && key[4] == 3;
+}
+
 inline bool in_same_table(const ChunkKey& left_key, const ChunkKey& right_key) {
   CHECK(has_table_prefix(left_key));
   CHECK(has_table_prefix(right_key));
@@ -20,6 +20,7 @@
 
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
+#include "QueryEngine/TierUpWorker.h"
 #include "ResultSet/ArrowResultSet.h"
 #include "Shared/scope.h"
 
@@ -3959,6 +3960,64 @@ TEST_F(Select, ApproxPercentileValidate) {
   EXPECT_EQ(NULL_DOUBLE, v<double>(crt_row[0]));
 }
 
+TEST_F(Select, ExactPercentile) {
+  auto const dt = ExecutorDeviceType::CPU;
+  // clang-format off
+  double cont_tests[][2]{{0.0, 2.2}, {0.25, 2.2}, {0.5, 2.3}, {0.75, 2.45},
+                         {0.9, 2.6}, {1.0, 2.6}};
+  double disc_tests[][2]{{0.0, 2.2}, {0.5, 2.2}, {0.55, 2.4}, {0.75, 2.4},
+                         {0.8, 2.6}, {1.0, 2.6}};
+  // clang-format on
+  for (auto test : cont_tests) {
+    std::stringstream query;
+    query << "SELECT PERCENTILE_CONT(d," << test[0] << ") FROM test;";
+    EXPECT_DOUBLE_EQ(test[1], v<double>(run_simple_agg(query.str(), dt)));
+  }
+  for (auto test : disc_tests) {
+    std::stringstream query;
+    query << "SELECT PERCENTILE_DISC(d," << test[0] << ") FROM test;";
+    EXPECT_DOUBLE_EQ(test[1], v<double>(run_simple_agg(query.str(), dt)));
+  }
+  EXPECT_DOUBLE_EQ(2.3, v<double>(run_simple_agg("SELECT MEDIAN(d) FROM test;", dt)));
+  EXPECT_DOUBLE_EQ(7.0, v<double>(run_simple_agg("SELECT MEDIAN(x) FROM test;", dt)));
+  EXPECT_DOUBLE_EQ(
+      8.0, v<double>(run_simple_agg("SELECT PERCENTILE_CONT(x, 0.8) FROM test;", dt)));
+  EXPECT_DOUBLE_EQ(
+      7.0, v<double>(run_simple_agg("SELECT PERCENTILE_DISC(x, 0.75) FROM test;", dt)));
+  // Nulls are ignored.
+  EXPECT_DOUBLE_EQ(
+      -2002.4,
+      v<double>(run_simple_agg("SELECT PERCENTILE_DISC(dn, 0.5) FROM test;", dt)));
+  EXPECT_DOUBLE_EQ(
+      -220.6, v<double>(run_simple_agg("SELECT PERCENTILE_CONT(dn, 1) FROM test;", dt)));
+  EXPECT_THROW(run_simple_agg("SELECT PERCENTILE_CONT(d, 1.5) FROM test;", dt),
+               std::runtime_error);
+}
+
+TEST_F(Select, ExactPercentileGroupBy) {
+  auto const dt = ExecutorDeviceType::CPU;
+  auto rows = run_multiple_agg(
+      "SELECT x, MEDIAN(d), PERCENTILE_CONT(y, 0.5), PERCENTILE_DISC(w, 0.1) FROM test "
+      "GROUP BY x ORDER BY x;",
+      dt);
+  ASSERT_EQ(rows->rowCount(), size_t(2));
+  auto row = rows->getNextRow(true, true);
+  EXPECT_EQ(7, v<int64_t>(row[0]));
+  EXPECT_DOUBLE_EQ(2.2, v<double>(row[1]));
+  EXPECT_DOUBLE_EQ(42.0, v<double>(row[2]));
+  EXPECT_DOUBLE_EQ(-8.0, v<double>(row[3]));
+  row = rows->getNextRow(true, true);
+  EXPECT_EQ(8, v<int64_t>(row[0]));
+  EXPECT_DOUBLE_EQ(2.4, v<double>(row[1]));
+  EXPECT_DOUBLE_EQ(43.0, v<double>(row[2]));
+  EXPECT_DOUBLE_EQ(-7.0, v<double>(row[3]));
+  // Sort by exact quantile.
+  rows = run_multiple_agg(
+      "SELECT x, MEDIAN(d) AS m FROM test GROUP BY x ORDER BY m DESC;", dt);
+  ASSERT_EQ(rows->rowCount(), size_t(2));
+  EXPECT_EQ(8, v<int64_t>(rows->getNextRow(true, true)[0]));
+}
+
 TEST_F(Select, ScanNoAggregation) {
   for (auto dt : testedDevices()) {
     c("SELECT * FROM test ORDER BY x ASC, y ASC;", dt);
@@ -7172,6 +7231,63 @@ TEST_F(Select, ReturnInfFromDivByZero) {
   }
 }
 
+TEST_F(Select, TieredCompilation) {
+  auto old_config = config().exec.codegen;
+  ScopeGuard sg = [old_config] { config().exec.codegen = old_config; };
+  config().exec.codegen.enable_tiered_compilation = true;
+  config().exec.codegen.tier_up_threshold = 1;
+  // Kernels compiled by previous tests are optimized already.
+  Executor::cpu_code_accessor->clear();
+
+  std::vector<std::string> queries = {
+      "SELECT COUNT(*) FROM test WHERE x > 6 AND x < 8;",
+      "SELECT x, SUM(y), AVG(f) FROM test GROUP BY x ORDER BY x;",
+      "SELECT y, COUNT(*) FROM test WHERE z > 100 GROUP BY y ORDER BY y;"};
+  // Baseline kernels, then cache hits which schedule recompilation, then optimized
+  // kernels from the cache.
+  std::vector<int64_t> replaced;
+  for (int iter = 0; iter < 3; ++iter) {
+    auto overwrite_count = Executor::cpu_code_accessor->get_overwrite_count();
+    for (auto& query : queries) {
+      c(query, ExecutorDeviceType::CPU);
+    }
+    TierUpWorker::instance().wait();
+    replaced.push_back(Executor::cpu_code_accessor->get_overwrite_count() -
+                       overwrite_count);
+  }
+  // Every kernel is replaced with the optimized one once, after its first reuse.
+  // Optimized kernels are not recompiled anymore.
+  EXPECT_EQ(replaced[0], 0);
+  EXPECT_GE(replaced[1], static_cast<int64_t>(queries.size()));
+  EXPECT_EQ(replaced[2], 0);
+}
+
+TEST_F(Select, InterpretedAggregates) {
+  auto old_config = config().exec.codegen;
+  ScopeGuard sg = [old_config] { config().exec.codegen = old_config; };
+  config().exec.codegen.enable_interpreter = true;
+
+  c("SELECT COUNT(*) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT COUNT(*) FROM test WHERE x > 7;", ExecutorDeviceType::CPU);
+  c("SELECT COUNT(*) FROM test WHERE 7 < x AND y <= 43;", ExecutorDeviceType::CPU);
+  c("SELECT COUNT(*) FROM test WHERE x = 100;", ExecutorDeviceType::CPU);
+  c("SELECT COUNT(y), COUNT(ofd), COUNT(fn) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT SUM(x), SUM(w), SUM(z), SUM(t) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT SUM(ofd), SUM(ofq) FROM test WHERE x <> 8;", ExecutorDeviceType::CPU);
+  c("SELECT MIN(x), MAX(x), MIN(t), MAX(t) FROM test WHERE y > 41;",
+    ExecutorDeviceType::CPU);
+  c("SELECT MIN(ofd), MAX(ofd), MIN(ofq), MAX(ofq) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT MIN(f), MAX(f), MIN(d), MAX(d) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT MIN(fn), MAX(fn), MIN(dn), MAX(dn) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT AVG(x), AVG(y), AVG(ofd) FROM test WHERE z >= 101;",
+    ExecutorDeviceType::CPU);
+  c("SELECT AVG(f), AVG(d), AVG(dn) FROM test WHERE x < 8;", ExecutorDeviceType::CPU);
+  c("SELECT SUM(x), MIN(y), AVG(t) FROM test WHERE x > 100;", ExecutorDeviceType::CPU);
+  // Units which are not supported by the interpreter are compiled.
+  c("SELECT COUNT(DISTINCT x) FROM test;", ExecutorDeviceType::CPU);
+  c("SELECT SUM(x + y) FROM test WHERE x + y > 50;", ExecutorDeviceType::CPU);
+}
+
 TEST_F(Select, ConstantFolding) {
   for (auto dt : testedDevices()) {
     c("SELECT 1 + 2 FROM test limit 1;", dt);
@@ -8609,6 +8725,64 @@ TEST_F(Select, SpeculativeTopNSort) {
   }
 }
 
+TEST_F(Select, TopNFragmentPruning) {
+  ScopeGuard reset = [orig = config().exec.enable_top_n_fragment_pruning] {
+    config().exec.enable_top_n_fragment_pruning = orig;
+    dropTable("top_n_prune");
+  };
+  // Ten fragments with disjoint value ranges, so a single fragment holds enough
+  // rows for any of the tested limits.
+  createTable("top_n_prune",
+              {{"v", ctx().int32()}, {"w", ctx().int32()}},
+              ArrowStorage::TableOptions{100});
+  std::stringstream values;
+  for (int i = 0; i < 1000; ++i) {
+    values << i << "," << (i % 7) << "\n";
+  }
+  insertCsvValues("top_n_prune", values.str());
+
+  auto table_id = getStorage()->getTableInfo(TEST_DB_ID, "top_n_prune")->table_id;
+  auto count_chunk_requests = [table_id]() {
+    auto mem_info = getDataMgr()->getMemoryInfo(Data_Namespace::MemoryLevel::CPU_LEVEL);
+    CHECK_EQ(mem_info.size(), (size_t)1);
+    for (auto& stats : mem_info.front().tableStats) {
+      if (stats.db_id == TEST_DB_ID && stats.table_id == table_id) {
+        return stats.hits + stats.misses;
+      }
+    }
+    return size_t(0);
+  };
+  auto run_query = [&](const std::string& query, bool enable_pruning) {
+    config().exec.enable_top_n_fragment_pruning = enable_pruning;
+    clearCpuMemory();
+    auto requests_before = count_chunk_requests();
+    auto rows = run_multiple_agg(query, ExecutorDeviceType::CPU);
+    std::vector<int64_t> res;
+    for (auto row = rows->getNextRow(true, true); !row.empty();
+         row = rows->getNextRow(true, true)) {
+      res.push_back(v<int64_t>(row[0]));
+    }
+    return std::make_pair(res, count_chunk_requests() - requests_before);
+  };
+
+  const std::vector<std::pair<std::string, std::vector<int64_t>>> queries = {
+      {"SELECT v FROM top_n_prune ORDER BY v DESC LIMIT 5;", {999, 998, 997, 996, 995}},
+      {"SELECT v FROM top_n_prune ORDER BY v LIMIT 3 OFFSET 2;", {2, 3, 4}},
+      {"SELECT v FROM top_n_prune ORDER BY v DESC, w LIMIT 2;", {999, 998}}};
+  for (auto& [query, expected] : queries) {
+    SCOPED_TRACE(query);
+    auto [full_res, full_requests] = run_query(query, false);
+    auto [pruned_res, pruned_requests] = run_query(query, true);
+    EXPECT_EQ(full_res, expected);
+    EXPECT_EQ(pruned_res, expected);
+    // Each processed fragment requests the same number of chunks, only one of ten
+    // fragments is processed with pruning.
+    ASSERT_GT(pruned_requests, size_t(0));
+    ASSERT_EQ(full_requests % 10, size_t(0));
+    EXPECT_EQ(pruned_requests, full_requests / 10);
+  }
+}
+
 TEST_F(Select, TopNSortWithWatchdogOn) {
   ScopeGuard reset = [top_min = config().exec.parallel_top_min,
                       top_max = config().exec.watchdog.parallel_top_max,
@@ -10517,6 +10691,110 @@ TEST_F(Select, Joins_MultiCompositeColumns) {
   }
 }
 
+TEST_F(Select, Joins_ProbePrefetch) {
+  const auto prefetch_threshold = config().exec.join.probe_prefetch_threshold;
+  const auto prefetch_distance = config().exec.join.probe_prefetch_distance;
+  const auto enable_prefetch = config().exec.join.enable_probe_prefetch;
+  ScopeGuard reset = [prefetch_threshold, prefetch_distance, enable_prefetch] {
+    config().exec.join.probe_prefetch_threshold = prefetch_threshold;
+    config().exec.join.probe_prefetch_distance = prefetch_distance;
+    config().exec.join.enable_probe_prefetch = enable_prefetch;
+  };
+  // Force prefetching for all hash tables and use a distance that crosses
+  // fragment boundaries.
+  config().exec.join.probe_prefetch_threshold = 1;
+  config().exec.join.probe_prefetch_distance = 3;
+
+  for (auto dt : testedDevices()) {
+    c("SELECT COUNT(*) FROM test JOIN test_inner ON test.x = test_inner.x;", dt);
+    c("SELECT a.y, z FROM test a JOIN test_inner b ON a.x = b.x order by a.y;", dt);
+    c("SELECT COUNT(*) FROM test a JOIN join_test b ON a.str = b.dup_str;", dt);
+    c("SELECT a.x FROM test_inner_x a JOIN test_x b ON a.x = b.x ORDER BY a.x;", dt);
+    c("SELECT COUNT(*) FROM test a JOIN hash_join_test b ON a.x = b.x;", dt);
+    c("SELECT a.z, b.str FROM test a JOIN join_test b ON a.y = b.y AND a.x = b.x ORDER "
+      "BY a.z, b.str;",
+      dt);
+    c("SELECT a.x, b.str FROM test AS a JOIN join_test AS b ON a.str = b.str AND a.x = "
+      "b.x ORDER BY a.x, b.str;",
+      dt);
+    c("SELECT COUNT(*) FROM test a LEFT JOIN test_inner b ON a.x = b.x;", dt);
+  }
+
+  // Outer fragments are much longer than the prefetch distance, so most rows
+  // prefetch entries of other rows. Hash tables have hundreds of entries.
+  config().exec.join.probe_prefetch_distance = 16;
+  createTable("prefetch_outer",
+              {{"k1", ctx().int32()}, {"k2", ctx().int32()}},
+              ArrowStorage::TableOptions{256});
+  createTable("prefetch_inner", {{"k1", ctx().int32()}, {"k2", ctx().int32()}});
+  ScopeGuard drop_tables = [] {
+    dropTable("prefetch_outer");
+    dropTable("prefetch_inner");
+  };
+  std::stringstream outer_values;
+  for (int i = 0; i < 1000; ++i) {
+    outer_values << (i % 600) << "," << (i % 600) * 2 << "\n";
+  }
+  insertCsvValues("prefetch_outer", outer_values.str());
+  std::stringstream inner_values;
+  for (int i = 0; i < 500; ++i) {
+    inner_values << i << "," << i * 2 << "\n";
+  }
+  insertCsvValues("prefetch_inner", inner_values.str());
+
+  auto optimized_ir = [](const std::string& query) {
+    auto co = getCompilationOptions(ExecutorDeviceType::CPU);
+    co.explain_type = ExecutorExplainType::Optimized;
+    const auto rows = runSqlQuery(query, co, getExecutionOptions(false, true)).getRows();
+    const auto row = rows->getNextRow(true, true);
+    return boost::get<std::string>(v<NullableString>(row[0]));
+  };
+  // Keys 0-499 of the first 600 rows and keys 0-399 of the remaining rows match.
+  const std::vector<std::string> queries = {
+      "SELECT COUNT(*) FROM prefetch_outer a JOIN prefetch_inner b ON a.k1 = b.k1;",
+      "SELECT COUNT(*) FROM prefetch_outer a JOIN prefetch_inner b ON a.k1 = b.k1 AND "
+      "a.k2 = b.k2;"};
+  for (bool enable_prefetch : {true, false}) {
+    config().exec.join.enable_probe_prefetch = enable_prefetch;
+    for (const auto& query : queries) {
+      SCOPED_TRACE(query);
+      EXPECT_EQ(int64_t(900), v<int64_t>(run_simple_agg(query, ExecutorDeviceType::CPU)));
+      EXPECT_EQ(enable_prefetch,
+                optimized_ir(query).find("@llvm.prefetch") != std::string::npos);
+    }
+  }
+}
+
+TEST_F(Select, Joins_RangeJoin) {
+  const auto trivial_join_loop_state = config().exec.join.trivial_loop_join_threshold;
+  const auto enable_range_join = config().exec.join.enable_range_join;
+  ScopeGuard reset = [&] {
+    config().exec.join.trivial_loop_join_threshold = trivial_join_loop_state;
+    config().exec.join.enable_range_join = enable_range_join;
+  };
+  // disable loop joins, inequality joins should use range join tables
+  config().exec.join.trivial_loop_join_threshold = 1;
+
+  const auto dt = ExecutorDeviceType::CPU;
+  const std::vector<std::string> queries = {
+      "SELECT COUNT(*) FROM test a JOIN test_inner b ON a.x < b.x;",
+      "SELECT COUNT(*) FROM test a JOIN test_inner b ON b.y >= a.y;",
+      "SELECT a.x, b.x FROM join_test a JOIN test b ON b.x BETWEEN a.x - 1 AND a.x + 1 "
+      "ORDER BY a.x, b.x;",
+      "SELECT COUNT(*) FROM hash_join_test a JOIN test b ON b.t > a.t - 10 AND b.t < "
+      "a.t + 10;",
+      "SELECT COUNT(*) FROM test a JOIN test_inner b ON a.y > b.x AND a.y <= b.y;",
+      "SELECT COUNT(*) FROM test a JOIN test_inner b ON a.x <= b.x AND a.y <> b.y;",
+      "SELECT COUNT(*), COUNT(b.x) FROM test a LEFT JOIN join_test b ON b.x > a.x;"};
+  for (const auto& query : queries) {
+    EXPECT_NO_THROW(run_multiple_agg(query, dt, false)) << query;
+    c(query, dt);
+  }
+
+  config().exec.join.enable_range_join = false;
+  EXPECT_ANY_THROW(run_multiple_agg(queries.front(), dt, false));
+}
+
 TEST_F(Select, Joins_BuildHashTable) {
   for (auto dt : testedDevices()) {
     c("SELECT COUNT(*) FROM test, join_test WHERE test.str = join_test.dup_str;", dt);
@@ -16806,6 +17084,74 @@ TEST_F(Select, FilterNodeCoalesce) {
   }
 }
 
+TEST_F(Select, BufferPoolTableStats) {
+  auto table_id = getStorage()->getTableInfo(TEST_DB_ID, "test")->table_id;
+  auto get_stats = [table_id]() {
+    auto mem_info = getDataMgr()->getMemoryInfo(Data_Namespace::MemoryLevel::CPU_LEVEL);
+    CHECK_EQ(mem_info.size(), (size_t)1);
+    for (auto& stats : mem_info.front().tableStats) {
+      if (stats.db_id == TEST_DB_ID && stats.table_id == table_id) {
+        return stats;
+      }
+    }
+    return Buffer_Namespace::TableBufferStats{TEST_DB_ID, table_id};
+  };
+
+  clearCpuMemory();
+  auto stats_before = get_stats();
+  c("SELECT COUNT(*) FROM test WHERE x > 7;", ExecutorDeviceType::CPU);
+  c("SELECT COUNT(*) FROM test WHERE x > 7;", ExecutorDeviceType::CPU);
+  auto stats_after = get_stats();
+  ASSERT_GT(stats_after.misses, stats_before.misses);
+  ASSERT_GE(stats_after.hits + stats_after.misses,
+            stats_before.hits + stats_before.misses + 2);
+}
+
+TEST_F(Select, GroupByBufferPool) {
+  const auto enable_buffer_pool = config().exec.group_by.enable_buffer_pool;
+  ScopeGuard reset_enable_buffer_pool = [&enable_buffer_pool] {
+    config().exec.group_by.enable_buffer_pool = enable_buffer_pool;
+  };
+  config().exec.group_by.enable_buffer_pool = true;
+
+  auto& pool = getExecutor()->getGroupByBufferPool();
+  auto stats_before = pool.getStats();
+  // Reused buffers should be restored to initial values of the same layout and fully
+  // initialized for a different one.
+  for (size_t i = 0; i < 3; ++i) {
+    c("SELECT x, COUNT(*) AS n FROM test GROUP BY x ORDER BY x;",
+      ExecutorDeviceType::CPU);
+    c("SELECT x, MIN(y), MAX(z) FROM test GROUP BY x ORDER BY x;",
+      ExecutorDeviceType::CPU);
+    c("SELECT x, y, SUM(z) FROM test GROUP BY x, y ORDER BY x, y;",
+      ExecutorDeviceType::CPU);
+  }
+  auto stats_after = pool.getStats();
+  ASSERT_GT(stats_after.hits, stats_before.hits);
+}
+
+TEST_F(Select, CpuSubTasks) {
+  const auto sub_tasks = config().exec.sub_tasks;
+  ScopeGuard reset_sub_tasks = [&sub_tasks] { config().exec.sub_tasks = sub_tasks; };
+  config().exec.sub_tasks.enable = true;
+  // Process each row of two-row fragments in a separate sub-task.
+  config().exec.sub_tasks.sub_task_size = 1;
+  config().exec.sub_tasks.min_sub_task_size = 1;
+
+  auto sub_tasks_before = getExecutor()->getSubTasksCount();
+  c("SELECT x, COUNT(*) AS n FROM test GROUP BY x ORDER BY x;", ExecutorDeviceType::CPU);
+  EXPECT_GT(getExecutor()->getSubTasksCount() - sub_tasks_before, size_t(1));
+
+  sub_tasks_before = getExecutor()->getSubTasksCount();
+  c("SELECT x, SUM(y), MIN(z), MAX(t) FROM test WHERE y > 41 GROUP BY x ORDER BY x;",
+    ExecutorDeviceType::CPU);
+  EXPECT_GT(getExecutor()->getSubTasksCount() - sub_tasks_before, size_t(1));
+
+  c("SELECT str, AVG(ff) FROM test GROUP BY str ORDER BY str;", ExecutorDeviceType::CPU);
+  c("SELECT y, COUNT(*) FROM test WHERE x < 8 GROUP BY y ORDER BY y;",
+    ExecutorDeviceType::CPU);
+}
+
 TEST_F(Select, EmptyString) {
   for (auto dt : testedDevices()) {
     EXPECT_THROW(run_multiple_agg("", dt), std::exception);
@@ -17232,6 +17578,48 @@ TEST_F(Select, UnionAll) {
   }
 }
 
+// Uses tables from import_union_all_tests().
+TEST_F(Select, SpeculativeCompilation) {
+  auto old_config = config().exec.codegen;
+  ScopeGuard sg = [old_config] { config().exec.codegen = old_config; };
+  config().exec.codegen.enable_speculative_compilation = true;
+
+  // Union branches are independent steps, so the second one is compiled while the
+  // first one is executed. Repeat queries to use speculatively compiled code.
+  for (int iter = 0; iter < 2; ++iter) {
+    c("SELECT a0, COUNT(*) FROM union_all_a WHERE a0 < 116 GROUP BY a0"
+      " UNION ALL"
+      " SELECT b0, COUNT(*) FROM union_all_b WHERE b0 < 216 GROUP BY b0"
+      " ORDER BY a0;",
+      ExecutorDeviceType::CPU);
+    c("SELECT a0, a1, a2, a3 FROM union_all_a"
+      " UNION ALL"
+      " SELECT b0, b1, b2, b3 FROM union_all_b"
+      " WHERE b0 < 216"
+      " ORDER BY a0;",
+      ExecutorDeviceType::CPU);
+    c("SELECT COUNT(*) FROM (SELECT a1, SUM(a2) AS s FROM union_all_a GROUP BY a1)"
+      " WHERE s > 0;",
+      ExecutorDeviceType::CPU);
+  }
+
+  // The speculatively compiled branch is taken from the code cache. If its
+  // compilation has not finished in time, the step is compiled as usual and the
+  // speculative compilation finds the code in the cache instead.
+  const std::string query =
+      "SELECT a0, COUNT(*) FROM union_all_a WHERE a0 < 116 GROUP BY a0"
+      " UNION ALL"
+      " SELECT b0, COUNT(*) FROM union_all_b WHERE b0 < 216 GROUP BY b0;";
+  auto count_cache_hits = [&query](bool speculate) {
+    config().exec.codegen.enable_speculative_compilation = speculate;
+    Executor::cpu_code_accessor->clear();
+    auto found_count = Executor::cpu_code_accessor->get_found_count();
+    run_multiple_agg(query, ExecutorDeviceType::CPU);
+    return Executor::cpu_code_accessor->get_found_count() - found_count;
+  };
+  EXPECT_GT(count_cache_hits(true), count_cache_hits(false));
+}
+
 TEST_F(Select, VariableLengthAggs) {
   for (auto dt : testedDevices()) {
     // non-encoded strings:
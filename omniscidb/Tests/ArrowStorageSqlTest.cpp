@@ -18,6 +18,7 @@
 #include "DataMgr/DataMgrDataProvider.h"
 #include "QueryEngine/RelAlgExecutor.h"
 #include "ResultSet/ArrowResultSet.h"
+#include "Shared/scope.h"
 
 #include "ArrowSQLRunner/ArrowSQLRunner.h"
 
@@ -124,10 +125,297 @@ TEST_P(ArrowStorageSqlTest, GroupByDict) {
                    std::vector<std::string>({"s0"s, "s1"s, "s2"s, "s3"s}));
 }
 
+TEST_P(ArrowStorageSqlTest, TopNCompositeKey) {
+  auto res = runSqlQuery("SELECT col1, col4 FROM "s + GetParam() +
+                         " ORDER BY col1 DESC, col4 LIMIT 3;");
+  compare_res_data(res,
+                   std::vector<int32_t>({20, 20, 20}),
+                   std::vector<std::string>({"dd1"s, "dd3"s, "dd5"s}));
+  res = runSqlQuery("SELECT col2 FROM "s + GetParam() + " ORDER BY col4 DESC LIMIT 2;");
+  compare_res_data(res, std::vector<float>({9.0f, 8.0f}));
+  res = runSqlQuery("SELECT col2 FROM "s + GetParam() +
+                    " ORDER BY col1, col2 DESC LIMIT 2 OFFSET 1;");
+  compare_res_data(res, std::vector<float>({6.0f, 4.0f}));
+}
+
 INSTANTIATE_TEST_SUITE_P(ArrowStorageSqlTest,
                          ArrowStorageSqlTest,
                          testing::Values("mixed_data"s, "mixed_data_multifrag"s));
 
+class ArrowStoragePackedSqlTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    ArrowStorage::TableOptions small_frag_opts;
+    small_frag_opts.fragment_size = 3;
+    config().storage.enable_column_compression = true;
+    getStorage()->importCsvFile(getFilePath("mixed_data.csv"),
+                                "mixed_data_packed",
+                                {{"col1", ctx().int64()},
+                                 {"col2", ctx().fp32()},
+                                 {"col3", ctx().extDict(ctx().text(), 0)},
+                                 {"col4", ctx().text()}},
+                                small_frag_opts);
+    config().storage.enable_column_compression = false;
+  }
+
+  static void TearDownTestSuite() { getStorage()->dropTable("mixed_data_packed"); }
+};
+
+TEST_F(ArrowStoragePackedSqlTest, SelectWithFilter) {
+  auto res = runSqlQuery(
+      "SELECT col1, col2 FROM mixed_data_packed WHERE col1 > 15 ORDER BY col2;");
+  compare_res_data(res,
+                   std::vector<int64_t>({20, 20, 20, 20, 20}),
+                   std::vector<float>({1.0f, 3.0f, 5.0f, 7.0f, 9.0f}));
+}
+
+TEST_F(ArrowStoragePackedSqlTest, GroupBy) {
+  auto res = runSqlQuery(
+      "SELECT col1, SUM(col2) FROM mixed_data_packed GROUP BY col1 ORDER BY col1;");
+  compare_res_data(
+      res, std::vector<int64_t>({10, 20}), std::vector<float>({20.0f, 25.0f}));
+}
+
+TEST_F(ArrowStoragePackedSqlTest, Aggregate) {
+  auto res = runSqlQuery("SELECT SUM(col1), MIN(col1), MAX(col1) FROM mixed_data_packed;");
+  compare_res_data(res,
+                   std::vector<int64_t>({150}),
+                   std::vector<int64_t>({10}),
+                   std::vector<int64_t>({20}));
+}
+
+TEST_F(ArrowStoragePackedSqlTest, NestedWindowFunction) {
+  auto res = runSqlQuery(
+      "SELECT col1 + ROW_NUMBER() OVER (ORDER BY col2) AS v FROM mixed_data_packed "
+      "ORDER BY v;");
+  compare_res_data(res,
+                   std::vector<int64_t>({11, 13, 15, 17, 19, 22, 24, 26, 28, 30}));
+}
+
+TEST_F(ArrowStoragePackedSqlTest, AppendToCachedFragment) {
+  config().storage.enable_column_compression = true;
+  createTable("packed_append", {{"val", ctx().int64()}}, {3});
+  ScopeGuard reset = [] {
+    config().storage.enable_column_compression = false;
+    dropTable("packed_append");
+  };
+
+  insertCsvValues("packed_append", "10\n11");
+  compare_res_data(runSqlQuery("SELECT val FROM packed_append ORDER BY val;"),
+                   std::vector<int64_t>({10, 11}));
+  auto tinfo = getStorage()->getTableInfo(TEST_DB_ID, "packed_append");
+  auto col_info = getStorage()->getColumnInfo(*tinfo, "val");
+  auto meta = getStorage()->getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  ChunkKey packed_key{
+      TEST_DB_ID, tinfo->table_id, col_info->column_id, meta.fragments[0].fragmentId, 3};
+  ASSERT_TRUE(getDataMgr()->isBufferOnDevice(
+      packed_key, Data_Namespace::MemoryLevel::CPU_LEVEL, 0));
+
+  // The fragment is packed again with another base but with the same packed size,
+  // so the cached chunk must not be reused.
+  insertCsvValues("packed_append", "9");
+  ASSERT_FALSE(getDataMgr()->isBufferOnDevice(
+      packed_key, Data_Namespace::MemoryLevel::CPU_LEVEL, 0));
+  compare_res_data(runSqlQuery("SELECT val FROM packed_append ORDER BY val;"),
+                   std::vector<int64_t>({9, 10, 11}));
+  compare_res_data(runSqlQuery("SELECT SUM(val) FROM packed_append;"),
+                   std::vector<int64_t>({30}));
+}
+
+class ArrowStorageModifySqlTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("modify_fact",
+                {{"id", ctx().int32()},
+                 {"val", ctx().int64()},
+                 {"name", ctx().extDict(ctx().text(), 0)}},
+                {2});
+    insertCsvValues("modify_fact", "1,10,a\n2,20,b\n3,30,c\n4,40,d\n5,50,e");
+    createTable("modify_dim", {{"id", ctx().int32()}, {"w", ctx().int64()}}, {2});
+    insertCsvValues("modify_dim", "1,100\n2,200\n3,300\n4,400\n5,500");
+  }
+
+  void TearDown() override {
+    dropTable("modify_fact");
+    dropTable("modify_dim");
+  }
+
+  static std::shared_ptr<arrow::Table> parseValues(const std::string& table_name,
+                                                   const std::string& col_name,
+                                                   const std::string& csv) {
+    ArrowStorage::CsvParseOptions parse_options;
+    parse_options.header = false;
+    auto tinfo = getStorage()->getTableInfo(getStorage()->dbId(), table_name);
+    return getStorage()->parseCsvData(
+        csv, parse_options, {getStorage()->getColumnInfo(*tinfo, col_name)});
+  }
+};
+
+TEST_F(ArrowStorageModifySqlTest, DeleteRows) {
+  auto res = runSqlQuery("SELECT COUNT(*), MIN(val), MAX(val) FROM modify_fact;");
+  compare_res_data(res,
+                   std::vector<int32_t>({5}),
+                   std::vector<int64_t>({10}),
+                   std::vector<int64_t>({50}));
+
+  getStorage()->deleteRows("modify_fact", {0, 4});
+  res = runSqlQuery("SELECT COUNT(*), MIN(val), MAX(val) FROM modify_fact;");
+  compare_res_data(res,
+                   std::vector<int32_t>({3}),
+                   std::vector<int64_t>({20}),
+                   std::vector<int64_t>({40}));
+  res = runSqlQuery("SELECT id, name FROM modify_fact ORDER BY id;");
+  compare_res_data(res,
+                   std::vector<int32_t>({2, 3, 4}),
+                   std::vector<std::string>({"b"s, "c"s, "d"s}));
+}
+
+TEST_F(ArrowStorageModifySqlTest, UpdateRows) {
+  getStorage()->updateRows(parseValues("modify_fact", "val", "200"), {1}, "modify_fact");
+  getStorage()->updateRows(
+      parseValues("modify_fact", "name", "z\nb"), {3, 0}, "modify_fact");
+  auto res = runSqlQuery("SELECT id, val, name FROM modify_fact ORDER BY id;");
+  compare_res_data(res,
+                   std::vector<int32_t>({1, 2, 3, 4, 5}),
+                   std::vector<int64_t>({10, 200, 30, 40, 50}),
+                   std::vector<std::string>({"b"s, "b"s, "c"s, "z"s, "e"s}));
+  res = runSqlQuery("SELECT MAX(val) FROM modify_fact;");
+  compare_res_data(res, std::vector<int64_t>({200}));
+}
+
+TEST_F(ArrowStorageModifySqlTest, JoinAfterModification) {
+  const std::string query =
+      "SELECT SUM(w) FROM modify_fact f JOIN modify_dim d ON f.id = d.id;";
+  auto res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int64_t>({1500}));
+
+  // Hash table built for the previous table version must not be reused.
+  getStorage()->updateRows(parseValues("modify_dim", "id", "6"), {0}, "modify_dim");
+  res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int64_t>({1400}));
+
+  getStorage()->deleteRows("modify_dim", {3});
+  res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int64_t>({1000}));
+}
+
+TEST_F(ArrowStorageModifySqlTest, RecycleResultSet) {
+  const auto use_resultset_cache = config().cache.use_query_resultset_cache;
+  auto& recycler = getExecutor()->getResultSetRecycler();
+  ScopeGuard reset = [&] {
+    config().cache.use_query_resultset_cache = use_resultset_cache;
+    recycler.clearCache();
+  };
+  config().cache.use_query_resultset_cache = true;
+  recycler.clearCache();
+  auto num_cached_items = [&recycler]() {
+    return recycler.getCurrentNumCachedItems(CacheItemType::ROW_RS,
+                                             RESULTSET_CACHE_DEVICE_IDENTIFIER);
+  };
+
+  const std::string query = "SELECT SUM(val) FROM modify_fact;";
+  auto res1 = runSqlQuery(query);
+  compare_res_data(res1, std::vector<int64_t>({150}));
+  EXPECT_EQ(num_cached_items(), size_t(1));
+
+  auto res2 = runSqlQuery(query);
+  compare_res_data(res2, std::vector<int64_t>({150}));
+  EXPECT_EQ(num_cached_items(), size_t(1));
+  // The cached data is shared, but each consumer iterates own result sets.
+  auto rs1 = res1.getToken()->resultSet(0);
+  auto rs2 = res2.getToken()->resultSet(0);
+  EXPECT_NE(rs1, rs2);
+  EXPECT_EQ(rs1->getStorage(), rs2->getStorage());
+  rs1->moveToBegin();
+  rs2->moveToBegin();
+  EXPECT_EQ(rs1->getNextRow(false, false).size(), size_t(1));
+  EXPECT_EQ(rs1->getNextRow(false, false).size(), size_t(0));
+  EXPECT_EQ(rs2->getNextRow(false, false).size(), size_t(1));
+
+  // Appended rows invalidate the cached result.
+  insertCsvValues("modify_fact", "6,60,f");
+  auto res3 = runSqlQuery(query);
+  compare_res_data(res3, std::vector<int64_t>({210}));
+  EXPECT_NE(res1.getToken(), res3.getToken());
+  EXPECT_EQ(num_cached_items(), size_t(1));
+
+  // Modified rows change the query plan.
+  getStorage()->updateRows(parseValues("modify_fact", "val", "100"), {0}, "modify_fact");
+  auto res4 = runSqlQuery(query);
+  compare_res_data(res4, std::vector<int64_t>({300}));
+  EXPECT_NE(res3.getToken(), res4.getToken());
+
+  config().cache.use_query_resultset_cache = false;
+  auto res5 = runSqlQuery(query);
+  compare_res_data(res5, std::vector<int64_t>({300}));
+  EXPECT_NE(res4.getToken(), res5.getToken());
+}
+
+TEST_F(ArrowStorageModifySqlTest, RecycleFilteredCount) {
+  auto& recycler = getExecutor()->getCardinalityRecycler();
+  recycler.clearCache();
+  auto num_cached_items = [&recycler](CacheItemType item_type) {
+    return recycler.getCurrentNumCachedItems(item_type,
+                                             CARDINALITY_CACHE_DEVICE_IDENTIFIER);
+  };
+
+  const std::string query = "SELECT id FROM modify_fact WHERE val > 20 ORDER BY id;";
+  auto res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int32_t>({3, 4, 5}));
+  EXPECT_EQ(num_cached_items(CacheItemType::COUNTALL_CARD_EST), size_t(1));
+  EXPECT_EQ(num_cached_items(CacheItemType::FILTER_SEL), size_t(1));
+
+  res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int32_t>({3, 4, 5}));
+
+  // Appended rows change the cache key, so the count is recorded again and then
+  // reused.
+  insertCsvValues("modify_fact", "6,60,f\n7,70,g");
+  res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int32_t>({3, 4, 5, 6, 7}));
+  EXPECT_EQ(num_cached_items(CacheItemType::COUNTALL_CARD_EST), size_t(2));
+  EXPECT_EQ(num_cached_items(CacheItemType::FILTER_SEL), size_t(2));
+  // Without cached COUNT(*) results the pre-flight count query is skipped only if
+  // the recorded filtered count is hit.
+  recycler
+      .getCachedItemContainer(CacheItemType::COUNTALL_CARD_EST,
+                              CARDINALITY_CACHE_DEVICE_IDENTIFIER)
+      ->clear();
+  res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int32_t>({3, 4, 5, 6, 7}));
+  EXPECT_EQ(num_cached_items(CacheItemType::COUNTALL_CARD_EST), size_t(0));
+  EXPECT_EQ(num_cached_items(CacheItemType::FILTER_SEL), size_t(2));
+
+  // The oldest entries are evicted when the cache is full.
+  ScopeGuard reset_cache_size = [orig = config().cache.cardinality_cache_size]() {
+    config().cache.cardinality_cache_size = orig;
+  };
+  config().cache.cardinality_cache_size = 2;
+
+  getStorage()->updateRows(parseValues("modify_fact", "val", "100"), {0}, "modify_fact");
+  res = runSqlQuery(query);
+  compare_res_data(res, std::vector<int32_t>({1, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(num_cached_items(CacheItemType::FILTER_SEL), size_t(2));
+  recycler.clearCache();
+}
+
+TEST_F(ArrowStorageModifySqlTest, TopNThreshold) {
+  // Fragments: (10, 20), (30, 40), (50, 30), (NULL).
+  insertCsvValues("modify_fact", "6,30,f\n7,,g");
+  auto res =
+      runSqlQuery("SELECT id FROM modify_fact ORDER BY val DESC NULLS LAST, id LIMIT 3;");
+  compare_res_data(res, std::vector<int32_t>({5, 4, 3}));
+  res = runSqlQuery("SELECT id FROM modify_fact ORDER BY val DESC NULLS FIRST LIMIT 2;");
+  compare_res_data(res, std::vector<int32_t>({7, 5}));
+  res = runSqlQuery(
+      "SELECT id FROM modify_fact ORDER BY val NULLS LAST, id LIMIT 2 OFFSET 1;");
+  compare_res_data(res, std::vector<int32_t>({2, 3}));
+  // Not enough rows to compute the threshold.
+  res = runSqlQuery(
+      "SELECT id FROM modify_fact ORDER BY val DESC NULLS LAST, id LIMIT 10;");
+  compare_res_data(res, std::vector<int32_t>({5, 4, 3, 6, 2, 1, 7}));
+}
+
 class ArrowStorageTaxiTest : public ::testing::Test {
  protected:
   static void SetUpTestSuite() {
@@ -14,6 +14,7 @@
 
 #include "ArrowStorage/ArrowStorage.h"
 #include "Shared/ArrowUtil.h"
+#include "Shared/PackedChunk.h"
 
 #include "TestHelpers.h"
 
@@ -1742,6 +1743,465 @@ TEST_F(ArrowStorageTest, AppendJsonData_DecimalArrays) {
                  std::vector<int64_t>({101010, 202020, inline_null_value<int64_t>()})}));
 }
 
+ConfigPtr getStreamingImportConfig(size_t blocks) {
+  auto config = std::make_shared<Config>();
+  config->storage.enable_streaming_import = true;
+  config->storage.streaming_import_blocks = blocks;
+  return config;
+}
+
+TEST_F(ArrowStorageTest, StreamingImportCsv_Numbers) {
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.block_size = 20;
+  for (size_t blocks : {1, 2, 100}) {
+    auto config = getStreamingImportConfig(blocks);
+    Test_ImportCsv_Numbers("numbers_header.csv", parse_options, config, true);
+    Test_ImportCsv_Numbers("numbers_header.csv", parse_options, config, true, 2);
+    Test_ImportCsv_Numbers("numbers_header.csv", parse_options, config, false);
+    Test_ImportCsv_Numbers("numbers_header.csv", parse_options, config, false, 5);
+  }
+}
+
+TEST_F(ArrowStorageTest, StreamingAppendCsv_Numbers) {
+  auto config = getStreamingImportConfig(1);
+  Test_AppendCsv_Numbers(100, config);
+  Test_AppendCsv_Numbers(5, config);
+  Test_AppendCsv_Numbers(1, config);
+}
+
+TEST_F(ArrowStorageTest, StreamingImportCsv_Strings) {
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.block_size = 20;
+  auto config = getStreamingImportConfig(2);
+  Test_ImportCsv_Strings(true, true, parse_options, config);
+  Test_ImportCsv_Strings(false, true, parse_options, config, 3);
+}
+
+TEST_F(ArrowStorageTest, StreamingImportCsv_Dict) {
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.block_size = 20;
+  auto config = getStreamingImportConfig(2);
+  Test_ImportCsv_Dict(false, true, parse_options, config, 3);
+  Test_ImportCsv_Dict(true, true, parse_options, config, 2, 2);
+}
+
+TEST_F(ArrowStorageTest, StreamingAppendJsonData) {
+  auto config = getStreamingImportConfig(1);
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  ArrowStorage::TableOptions table_options(2);
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.fp32()}}, table_options);
+  ArrowStorage::JsonParseOptions parse_options;
+  parse_options.block_size = 64;
+  storage.appendJsonData(R"___({"col1": 1, "col2": 10.0}
+{"col1": 2, "col2": 20.0}
+{"col1": 3, "col2": 30.0}
+{"col1": 4, "col2": 40.0}
+{"col1": 5, "col2": 50.0})___",
+                         tinfo->table_id,
+                         parse_options);
+  checkData(storage, tinfo->table_id, 5, 2, range(5, (int32_t)1), range(5, 10.0f));
+}
+
+TEST_F(ArrowStorageTest, StreamingImportCsv_DropOnError) {
+  auto config = getStreamingImportConfig(1);
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  ArrowStorage::CsvParseOptions parse_options;
+  ASSERT_THROW(storage.importCsvFile(getFilePath("strings.csv"),
+                                     "table1",
+                                     {{"col1", ctx.int32()}, {"col2", ctx.int32()}},
+                                     ArrowStorage::TableOptions(),
+                                     parse_options),
+               std::runtime_error);
+  ASSERT_EQ(storage.getTableInfo(TEST_DB_ID, "table1"), nullptr);
+}
+
+template <typename T>
+void checkFragmentsData(ArrowStorage& storage,
+                        int table_id,
+                        int col_id,
+                        const std::vector<std::vector<T>>& expected) {
+  auto meta = storage.getTableMetadata(TEST_DB_ID, table_id);
+  CHECK_EQ(meta.fragments.size(), expected.size());
+  for (size_t frag_idx = 0; frag_idx < expected.size(); ++frag_idx) {
+    auto& frag = meta.fragments[frag_idx];
+    CHECK_EQ(frag.getNumTuples(), expected[frag_idx].size());
+    checkFetchedData(storage, table_id, col_id, frag.fragmentId, expected[frag_idx]);
+  }
+}
+
+std::vector<int> getFragmentIds(ArrowStorage& storage, int table_id) {
+  std::vector<int> res;
+  for (auto& frag : storage.getTableMetadata(TEST_DB_ID, table_id).fragments) {
+    res.push_back(frag.fragmentId);
+  }
+  return res;
+}
+
+ConfigPtr getColumnCompressionConfig() {
+  auto config = std::make_shared<Config>();
+  config->storage.enable_column_compression = true;
+  return config;
+}
+
+void checkPackedColumns(ArrowStorage& storage,
+                        int table_id,
+                        const std::vector<std::vector<bool>>& expected) {
+  auto meta = storage.getTableMetadata(TEST_DB_ID, table_id);
+  auto cols = storage.listColumns(TEST_DB_ID, table_id);
+  CHECK_EQ(meta.fragments.size(), expected.size());
+  for (size_t frag_idx = 0; frag_idx < expected.size(); ++frag_idx) {
+    auto& chunk_meta_map = meta.fragments[frag_idx].getChunkMetadataMap();
+    for (size_t col_idx = 0; col_idx < expected[frag_idx].size(); ++col_idx) {
+      CHECK_EQ(chunk_meta_map.at(cols[col_idx]->column_id)->isPacked(),
+               expected[frag_idx][col_idx])
+          << "fragment " << frag_idx << " column " << col_idx;
+    }
+  }
+}
+
+void checkPackedHeader(ArrowStorage& storage,
+                       int table_id,
+                       int col_id,
+                       size_t frag_idx,
+                       int64_t base,
+                       int32_t bit_width,
+                       bool has_nulls) {
+  auto meta = storage.getTableMetadata(TEST_DB_ID, table_id);
+  auto frag_id = meta.fragments[frag_idx].fragmentId;
+  auto& chunk_meta = meta.fragments[frag_idx].getChunkMetadataMap().at(col_id);
+  CHECK(chunk_meta->isPacked());
+  CHECK_EQ(chunk_meta->packedNumBytes(),
+           packed_chunk_size(chunk_meta->numElements(), bit_width));
+  TestBuffer dst(chunk_meta->packedNumBytes());
+  storage.fetchBuffer({TEST_DB_ID, table_id, col_id, frag_id, 3},
+                      &dst,
+                      chunk_meta->packedNumBytes());
+  auto header = reinterpret_cast<const PackedChunkHeader*>(dst.getMemoryPtr());
+  CHECK_EQ(header->base, base);
+  CHECK_EQ(header->bit_width, bit_width);
+  CHECK_EQ(header->has_nulls, static_cast<int32_t>(has_nulls));
+}
+
+TEST_F(ArrowStorageTest, ColumnCompression_Import) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, getColumnCompressionConfig());
+  ArrowStorage::TableOptions table_options(3);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable("table1",
+                                           {{"col1", ctx.int64()},
+                                            {"col2", ctx.int32()},
+                                            {"col3", ctx.int64()},
+                                            {"col4", ctx.fp64()},
+                                            {"col5", ctx.int64()}},
+                                           table_options);
+  storage.appendCsvData(
+      "1000,-5,7,0.5,1\n1001,-4,,1.5,10000000000\n1002,-3,9,2.5,3\n"
+      "1003,-2,10,3.5,4\n1004,-1,,4.5,5\n1005,0,12,5.5,6\n1006,1,13,6.5,7",
+      tinfo->table_id,
+      parse_options);
+  // Values range in the first fragment of col5 doesn't allow 32-bit packing.
+  checkPackedColumns(storage,
+                     tinfo->table_id,
+                     {{true, true, true, false, false},
+                      {true, true, true, false, true},
+                      {true, true, true, false, true}});
+  checkPackedHeader(storage, tinfo->table_id, 1000, 0, 1000, 2, false);
+  checkPackedHeader(storage, tinfo->table_id, 1001, 1, -2, 2, false);
+  checkPackedHeader(storage, tinfo->table_id, 1002, 0, 7, 2, true);
+  checkPackedHeader(storage, tinfo->table_id, 1002, 2, 13, 0, false);
+  checkData(storage,
+            tinfo->table_id,
+            7,
+            3,
+            std::vector<int64_t>({1000, 1001, 1002, 1003, 1004, 1005, 1006}),
+            std::vector<int32_t>({-5, -4, -3, -2, -1, 0, 1}),
+            std::vector<int64_t>({7,
+                                  inline_null_value<int64_t>(),
+                                  9,
+                                  10,
+                                  inline_null_value<int64_t>(),
+                                  12,
+                                  13}),
+            std::vector<double>({0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5}),
+            std::vector<int64_t>({1, 10000000000, 3, 4, 5, 6, 7}));
+}
+
+TEST_F(ArrowStorageTest, ColumnCompression_Append) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, getColumnCompressionConfig());
+  ArrowStorage::TableOptions table_options(3);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int64()}, {"col2", ctx.int32()}}, table_options);
+  storage.appendCsvData("1,10\n2,20\n3,30\n4,40", tinfo->table_id, parse_options);
+  checkPackedColumns(storage, tinfo->table_id, {{true, true}, {true, true}});
+  checkPackedHeader(storage, tinfo->table_id, 1000, 1, 4, 0, false);
+  auto frag_ids = getFragmentIds(storage, tinfo->table_id);
+
+  // The last fragment is extended and packed again with new parameters. It gets
+  // a new id, so that cached chunks with old packing are not reused.
+  storage.appendCsvData("5,50\n6,\n7,70", tinfo->table_id, parse_options);
+  checkPackedColumns(
+      storage, tinfo->table_id, {{true, true}, {true, true}, {true, true}});
+  checkPackedHeader(storage, tinfo->table_id, 1000, 1, 4, 2, false);
+  checkPackedHeader(storage, tinfo->table_id, 1001, 1, 40, 4, true);
+  auto new_frag_ids = getFragmentIds(storage, tinfo->table_id);
+  CHECK_EQ(new_frag_ids[0], frag_ids[0]);
+  CHECK_NE(new_frag_ids[1], frag_ids[1]);
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1000,
+                     std::vector<std::vector<int64_t>>{{1, 2, 3}, {4, 5, 6}, {7}});
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1001,
+                     std::vector<std::vector<int32_t>>{
+                         {10, 20, 30}, {40, 50, inline_null_value<int32_t>()}, {70}});
+}
+
+TEST_F(ArrowStorageTest, DeleteRows) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::TableOptions table_options(3);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.fp64()}}, table_options);
+  storage.appendCsvData("1,1.5\n2,2.5\n3,3.5\n4,4.5\n5,5.5\n6,6.5\n7,7.5",
+                        tinfo->table_id,
+                        parse_options);
+  auto version = tinfo->data_version;
+  auto frag_ids = getFragmentIds(storage, tinfo->table_id);
+
+  storage.deleteRows("table1", {5, 1, 4});
+  CHECK_EQ(tinfo->row_count, (size_t)4);
+  CHECK_EQ(tinfo->fragments, (size_t)3);
+  CHECK_GT(tinfo->data_version, version);
+  // Only fragments with deleted rows get new ids.
+  auto new_frag_ids = getFragmentIds(storage, tinfo->table_id);
+  CHECK_NE(new_frag_ids[0], frag_ids[0]);
+  CHECK_NE(new_frag_ids[1], frag_ids[1]);
+  CHECK_EQ(new_frag_ids[2], frag_ids[2]);
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1000,
+                     std::vector<std::vector<int32_t>>{{1, 3}, {4}, {7}});
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1001,
+                     std::vector<std::vector<double>>{{1.5, 3.5}, {4.5}, {7.5}});
+
+  auto meta = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  checkChunkMeta(meta.fragments[0].getChunkMetadataMap().at(1000),
+                 ctx.int32(),
+                 2,
+                 8,
+                 false,
+                 1,
+                 3);
+
+  // Fully deleted fragments are removed.
+  storage.deleteRows(tinfo->table_id, {2});
+  checkFragmentsData(
+      storage, tinfo->table_id, 1000, std::vector<std::vector<int32_t>>{{1, 3}, {7}});
+
+  // Appended rows go to the last fragment.
+  storage.appendCsvData("8,8.5", tinfo->table_id, parse_options);
+  checkFragmentsData(
+      storage, tinfo->table_id, 1000, std::vector<std::vector<int32_t>>{{1, 3}, {7, 8}});
+}
+
+TEST_F(ArrowStorageTest, DeleteRows_AllRows) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::TableOptions table_options(2);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.text()}}, table_options);
+  storage.appendCsvData("1,a\n2,b\n3,c", tinfo->table_id, parse_options);
+  storage.deleteRows(tinfo->table_id, {0, 1, 2});
+  CHECK_EQ(tinfo->row_count, (size_t)0);
+  CHECK_EQ(tinfo->fragments, (size_t)0);
+  auto meta = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  CHECK_EQ(meta.getNumTuples(), (size_t)0);
+
+  storage.appendCsvData("4,d", tinfo->table_id, parse_options);
+  checkFragmentsData(
+      storage, tinfo->table_id, 1000, std::vector<std::vector<int32_t>>{{4}});
+}
+
+TEST_F(ArrowStorageTest, DeleteRows_InvalidRowid) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable("table1", {{"col1", ctx.int32()}});
+  storage.appendCsvData("1\n2", tinfo->table_id, parse_options);
+  ASSERT_THROW(storage.deleteRows(tinfo->table_id, {2}), std::runtime_error);
+  ASSERT_THROW(storage.deleteRows(tinfo->table_id, {-1}), std::runtime_error);
+  ASSERT_THROW(storage.deleteRows("table2", {0}), std::runtime_error);
+}
+
+TEST_F(ArrowStorageTest, UpdateRows) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::TableOptions table_options(3);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.fp64()}}, table_options);
+  storage.appendCsvData("1,1.5\n2,2.5\n3,3.5\n4,4.5\n5,5.5\n6,6.5\n7,7.5",
+                        tinfo->table_id,
+                        parse_options);
+  auto version = tinfo->data_version;
+  auto frag_ids = getFragmentIds(storage, tinfo->table_id);
+
+  auto values = storage.parseCsvData(
+      "60,\n10,10.5",
+      parse_options,
+      {storage.getColumnInfo(*tinfo, "col1"), storage.getColumnInfo(*tinfo, "col2")});
+  storage.updateRows(values, {5, 0}, "table1");
+  CHECK_EQ(tinfo->row_count, (size_t)7);
+  CHECK_GT(tinfo->data_version, version);
+  auto new_frag_ids = getFragmentIds(storage, tinfo->table_id);
+  CHECK_NE(new_frag_ids[0], frag_ids[0]);
+  CHECK_NE(new_frag_ids[1], frag_ids[1]);
+  CHECK_EQ(new_frag_ids[2], frag_ids[2]);
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1000,
+                     std::vector<std::vector<int32_t>>{{10, 2, 3}, {4, 5, 60}, {7}});
+  checkFragmentsData(
+      storage,
+      tinfo->table_id,
+      1001,
+      std::vector<std::vector<double>>{
+          {10.5, 2.5, 3.5}, {4.5, 5.5, inline_null_value<double>()}, {7.5}});
+
+  auto meta = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  checkChunkMeta(meta.fragments[1].getChunkMetadataMap().at(1000),
+                 ctx.int32(),
+                 3,
+                 12,
+                 false,
+                 4,
+                 60);
+  CHECK(meta.fragments[1].getChunkMetadataMap().at(1001)->chunkStats().has_nulls);
+
+  // Update of a subset of columns.
+  values = storage.parseCsvData(
+      "100", parse_options, {storage.getColumnInfo(*tinfo, "col1")});
+  storage.updateRows(values, {6}, tinfo->table_id);
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1000,
+                     std::vector<std::vector<int32_t>>{{10, 2, 3}, {4, 5, 60}, {100}});
+  checkFragmentsData(
+      storage,
+      tinfo->table_id,
+      1001,
+      std::vector<std::vector<double>>{
+          {10.5, 2.5, 3.5}, {4.5, 5.5, inline_null_value<double>()}, {7.5}});
+}
+
+TEST_F(ArrowStorageTest, UpdateRows_Errors) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.int32(false)}});
+  storage.appendCsvData("1,1\n2,2", tinfo->table_id, parse_options);
+  auto col1_info = storage.getColumnInfo(*tinfo, "col1");
+  auto col2_info = storage.getColumnInfo(*tinfo, "col2");
+  // Mismatched rows count.
+  auto values = storage.parseCsvData("3\n4", parse_options, {col1_info});
+  ASSERT_THROW(storage.updateRows(values, {0}, tinfo->table_id), std::runtime_error);
+  // Invalid rowid.
+  ASSERT_THROW(storage.updateRows(values, {0, 2}, tinfo->table_id), std::runtime_error);
+  // Nulls in non-nullable column.
+  values = storage.parseCsvData("3,\n4,4", parse_options, {col1_info, col2_info});
+  ASSERT_THROW(storage.updateRows(values, {0, 1}, tinfo->table_id), std::runtime_error);
+  // Unknown column.
+  values = storage.parseCsvData("3\n4", parse_options, {col1_info});
+  values = values->RenameColumns({"col3"}).ValueOrDie();
+  ASSERT_THROW(storage.updateRows(values, {0, 1}, tinfo->table_id), std::runtime_error);
+  checkFragmentsData(
+      storage, tinfo->table_id, 1000, std::vector<std::vector<int32_t>>{{1, 2}});
+}
+
+TEST_F(ArrowStorageTest, UpdateRows_Packed) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, getColumnCompressionConfig());
+  ArrowStorage::TableOptions table_options(3);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int64()}, {"col2", ctx.int32()}}, table_options);
+  storage.appendCsvData("1,10\n2,20\n3,30\n4,40", tinfo->table_id, parse_options);
+  checkPackedColumns(storage, tinfo->table_id, {{true, true}, {true, true}});
+
+  // The updated fragment is packed again with a wider code.
+  auto values = storage.parseCsvData(
+      "1000", parse_options, {storage.getColumnInfo(*tinfo, "col1")});
+  storage.updateRows(values, {1}, tinfo->table_id);
+  checkPackedColumns(storage, tinfo->table_id, {{true, true}, {true, true}});
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1000,
+                     std::vector<std::vector<int64_t>>{{1, 1000, 3}, {4}});
+  checkFragmentsData(storage,
+                     tinfo->table_id,
+                     1001,
+                     std::vector<std::vector<int32_t>>{{10, 20, 30}, {40}});
+
+  storage.deleteRows(tinfo->table_id, {0, 3});
+  checkPackedColumns(storage, tinfo->table_id, {{true, true}});
+  checkFragmentsData(
+      storage, tinfo->table_id, 1000, std::vector<std::vector<int64_t>>{{1000, 3}});
+  checkFragmentsData(
+      storage, tinfo->table_id, 1001, std::vector<std::vector<int32_t>>{{20, 30}});
+}
+
+TEST_F(ArrowStorageTest, StreamingImportCsv_WidenInferredTypes) {
+  auto config = getStreamingImportConfig(1);
+  ArrowStorage::CsvParseOptions parse_options;
+  // The first block holds integers only, the last value is a float.
+  parse_options.block_size = 20;
+  std::vector<double> col2 = {10.0, 20.0, 30.0, 40.0, 50.0, 60.0, 70.0, 80.0, 90.5};
+  {
+    ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+    auto tinfo = storage.importCsvFile(getFilePath("int_then_float.csv"),
+                                       "table1",
+                                       ArrowStorage::TableOptions(),
+                                       parse_options);
+    checkData(storage, tinfo->table_id, 9, 32'000'000, range(9, (int64_t)1), col2);
+  }
+  {
+    ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+    auto tinfo = storage.importCsvFile(getFilePath("int_then_float.csv"),
+                                       "table1",
+                                       {{"col1", ctx.int32()}, {"col2", nullptr}},
+                                       ArrowStorage::TableOptions(3),
+                                       parse_options);
+    checkData(storage, tinfo->table_id, 9, 3, range(9, (int32_t)1), col2);
+  }
+}
+
+TEST_F(ArrowStorageTest, StreamingImportCsv_NoRetryOnOtherErrors) {
+  auto config = getStreamingImportConfig(1);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.block_size = 20;
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config);
+  auto tinfo = storage.createTable("table1", {{"col1", ctx.int32()}});
+  // Failures not related to the block conversion are reported as is and don't
+  // touch the existing table.
+  ASSERT_THROW(storage.importCsvFile(getFilePath("int_then_float.csv"),
+                                     "table1",
+                                     ArrowStorage::TableOptions(),
+                                     parse_options),
+               std::runtime_error);
+  ASSERT_EQ(storage.getTableInfo(TEST_DB_ID, "table1")->table_id, tinfo->table_id);
+  ASSERT_EQ(storage.getTableMetadata(TEST_DB_ID, tinfo->table_id).getNumTuples(),
+            (size_t)0);
+}
+
 TEST_F(ArrowStorageTest, ImportParquet) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID, config_);
   auto tinfo = storage.importParquetFile(getFilePath("int_float.parquet"), "table1");
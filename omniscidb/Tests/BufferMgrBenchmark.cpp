@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "BufferMgrTestHelpers.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+
+namespace {
+
+constexpr size_t kPageSize = 512;
+constexpr size_t kSlabSize = 64ULL << 20;
+constexpr size_t kPoolSize = 256ULL << 20;
+
+// Chunks have different sizes to fragment slabs the way columns of different
+// types do. The average chunk size is ~0.5MB.
+size_t chunk_size(int chunk_id) {
+  return (64ULL << 10) * (1 + chunk_id % 16);
+}
+
+TestHelpers::DummyDataProvider data_provider;
+std::unique_ptr<Buffer_Namespace::CpuBufferMgr> buffer_mgr;
+
+}  // namespace
+
+// Each thread fetches random chunks out of state.range(0) chunks and unpins them
+// right away. With 256 chunks all of them fit the pool and fetches are mostly
+// lookups of cached chunks, with 4096 chunks most fetches have to evict other
+// chunks first.
+static void BM_ChunkFetch(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    buffer_mgr = std::make_unique<Buffer_Namespace::CpuBufferMgr>(
+        0, kPoolSize, nullptr, kSlabSize, kSlabSize, kPageSize, &data_provider);
+  }
+
+  const int num_chunks = static_cast<int>(state.range(0));
+  std::mt19937 rand_generator(state.thread_index());
+  std::uniform_int_distribution<int> chunk_distribution(0, num_chunks - 1);
+  for (auto _ : state) {
+    auto chunk_id = chunk_distribution(rand_generator);
+    ChunkKey key{1, 1, 1, chunk_id};
+    auto buf = buffer_mgr->getBuffer(key, chunk_size(chunk_id));
+    auto ptr = buf->getMemoryPtr();
+    benchmark::DoNotOptimize(ptr);
+    buf->unPin();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    buffer_mgr.reset();
+  }
+}
+
+BENCHMARK(BM_ChunkFetch)
+    ->Arg(256)
+    ->Arg(4096)
+    ->ThreadRange(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "BufferMgrTestHelpers.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
+#include "DataMgr/DataMgr.h"
+#include "TestHelpers.h"
+
+#include <memory>
+
+using namespace Buffer_Namespace;
+
+namespace {
+
+constexpr size_t kPageSize = 512;
+constexpr size_t kChunkSize = 4096;
+// The pool is a single slab holding exactly four chunks, so fetching a fifth chunk
+// evicts one of the cached chunks.
+constexpr size_t kPoolSize = 4 * kChunkSize;
+
+ChunkKey chunk(int table_id, int frag_id) {
+  return {1, table_id, 1, frag_id};
+}
+
+}  // namespace
+
+class BufferMgrEvictionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    buffer_mgr_ = std::make_unique<CpuBufferMgr>(
+        0, kPoolSize, nullptr, kPoolSize, kPoolSize, kPageSize, &data_provider_);
+  }
+
+  void TearDown() override { buffer_mgr_.reset(); }
+
+  void fetch(const ChunkKey& key) {
+    auto buf = buffer_mgr_->getBuffer(key, kChunkSize);
+    buf->unPin();
+  }
+
+  // Returns fragments of the table which chunks are in the pool.
+  std::vector<int> cachedFragments(int table_id, int frag_count) {
+    std::vector<int> res;
+    for (int frag_id = 0; frag_id < frag_count; ++frag_id) {
+      if (buffer_mgr_->isBufferOnDevice(chunk(table_id, frag_id))) {
+        res.push_back(frag_id);
+      }
+    }
+    return res;
+  }
+
+  TestHelpers::DummyDataProvider data_provider_;
+  std::unique_ptr<CpuBufferMgr> buffer_mgr_;
+};
+
+TEST_F(BufferMgrEvictionTest, Lru) {
+  buffer_mgr_->setEvictionPolicy(EvictionPolicy::create("lru"));
+  for (int frag_id = 0; frag_id < 4; ++frag_id) {
+    fetch(chunk(1, frag_id));
+  }
+  fetch(chunk(1, 0));
+  fetch(chunk(1, 4));
+  EXPECT_EQ(cachedFragments(1, 5), std::vector<int>({0, 2, 3, 4}));
+  fetch(chunk(1, 5));
+  EXPECT_EQ(cachedFragments(1, 6), std::vector<int>({0, 3, 4, 5}));
+}
+
+TEST_F(BufferMgrEvictionTest, LruFetchBuffer) {
+  buffer_mgr_->setEvictionPolicy(EvictionPolicy::create("lru"));
+  for (int frag_id = 0; frag_id < 4; ++frag_id) {
+    fetch(chunk(1, frag_id));
+  }
+  // Copying a cached chunk to a child buffer pool is an access too.
+  CpuBufferMgr child_mgr(
+      1, kPoolSize, nullptr, kPoolSize, kPoolSize, kPageSize, &data_provider_);
+  auto dest = child_mgr.alloc(kChunkSize);
+  buffer_mgr_->fetchBuffer(chunk(1, 0), dest, kChunkSize);
+  child_mgr.free(dest);
+  fetch(chunk(1, 4));
+  EXPECT_EQ(cachedFragments(1, 5), std::vector<int>({0, 2, 3, 4}));
+}
+
+TEST_F(BufferMgrEvictionTest, LruScan) {
+  buffer_mgr_->setEvictionPolicy(EvictionPolicy::create("lru"));
+  // Fragments 0 and 1 are used repeatedly, then a scan reads fragments 2-7 once.
+  for (int frag_id : {0, 1, 0, 1, 2, 3, 4, 5, 6, 7}) {
+    fetch(chunk(1, frag_id));
+  }
+  EXPECT_EQ(cachedFragments(1, 8), std::vector<int>({4, 5, 6, 7}));
+}
+
+TEST_F(BufferMgrEvictionTest, Lru2Scan) {
+  buffer_mgr_->setEvictionPolicy(EvictionPolicy::create("lru2"));
+  // The scan evicts chunks it has read itself instead of the repeatedly used ones.
+  for (int frag_id : {0, 1, 0, 1, 2, 3, 4, 5, 6, 7}) {
+    fetch(chunk(1, frag_id));
+  }
+  EXPECT_EQ(cachedFragments(1, 8), std::vector<int>({0, 1, 6, 7}));
+
+  // Among repeatedly used chunks the one with the older penultimate access goes
+  // first.
+  for (int frag_id : {6, 7, 1, 0}) {
+    fetch(chunk(1, frag_id));
+  }
+  fetch(chunk(1, 8));
+  EXPECT_EQ(cachedFragments(1, 9), std::vector<int>({1, 6, 7, 8}));
+}
+
+class BufferMgrPriorityTablesTest : public BufferMgrEvictionTest,
+                                    public ::testing::WithParamInterface<std::string> {};
+
+TEST_P(BufferMgrPriorityTablesTest, PriorityTables) {
+  buffer_mgr_->setEvictionPolicy(EvictionPolicy::create(GetParam()));
+  buffer_mgr_->setPriorityTables({{1, 2}});
+  // The chunk of the priority table is the oldest one, but chunks of other tables
+  // are evicted first.
+  fetch(chunk(2, 0));
+  for (int frag_id = 0; frag_id < 8; ++frag_id) {
+    fetch(chunk(1, frag_id));
+  }
+  EXPECT_EQ(cachedFragments(2, 1), std::vector<int>({0}));
+  EXPECT_EQ(cachedFragments(1, 8), std::vector<int>({5, 6, 7}));
+}
+
+INSTANTIATE_TEST_SUITE_P(EvictionPolicies,
+                         BufferMgrPriorityTablesTest,
+                         ::testing::Values("lru", "lru2"));
+
+TEST_F(BufferMgrEvictionTest, NoPriorityTables) {
+  // Without priority tables the oldest chunk is evicted first.
+  fetch(chunk(2, 0));
+  for (int frag_id = 0; frag_id < 4; ++frag_id) {
+    fetch(chunk(1, frag_id));
+  }
+  EXPECT_EQ(cachedFragments(2, 1), std::vector<int>());
+  EXPECT_EQ(cachedFragments(1, 4), std::vector<int>({0, 1, 2, 3}));
+}
+
+TEST(BufferMgrConfigTest, ParsePriorityTables) {
+  using Data_Namespace::DataMgr;
+  using Tables = std::set<std::pair<int, int>>;
+  EXPECT_EQ(DataMgr::parsePriorityTables(""), Tables());
+  EXPECT_EQ(DataMgr::parsePriorityTables("1:2"), Tables({{1, 2}}));
+  EXPECT_EQ(DataMgr::parsePriorityTables(" 1:2, 3 : 4 ,, 1:2,"),
+            Tables({{1, 2}, {3, 4}}));
+  for (auto tables : {"1", "1:2:3", "a:2", "1:b", "1:2x", "1:", ":2", "1:2,3"}) {
+    SCOPED_TRACE(tables);
+    EXPECT_THROW(DataMgr::parsePriorityTables(tables), std::runtime_error);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
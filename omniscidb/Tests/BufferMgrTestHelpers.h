@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "DataMgr/AbstractDataProvider.h"
+
+#include <cstring>
+
+namespace TestHelpers {
+
+// Fills fetched buffers with a constant instead of reading real data.
+class DummyDataProvider : public AbstractDataProvider {
+ public:
+  void fetchBuffer(const ChunkKey& key,
+                   Data_Namespace::AbstractBuffer* dest,
+                   const size_t num_bytes) override {
+    dest->reserve(num_bytes);
+    memset(dest->getMemoryPtr(), key[CHUNK_KEY_FRAGMENT_IDX] & 0xFF, num_bytes);
+    dest->setSize(num_bytes);
+  }
+
+  TableFragmentsInfo getTableMetadata(int db_id, int table_id) const override {
+    UNREACHABLE();
+    return TableFragmentsInfo{};
+  }
+};
+
+}  // namespace TestHelpers
@@ -28,6 +28,7 @@
 #include "QueryEngine/Compiler/CodegenTraitsDescriptor.h"
 #include "QueryEngine/Compiler/HelperFunctions.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExecutionEngineWrapper.h"
 #include "QueryEngine/IRCodegenUtils.h"
 #include "QueryEngine/LLVMGlobalContext.h"
 #include "TestHelpers.h"
@@ -108,6 +109,105 @@ TEST(CodeGeneratorTest, IntegerConstant) {
   ASSERT_EQ(out, d.intval);
 }
 
+TEST(CodeGeneratorTest, SharedJitSession) {
+  auto executor = Executor::getExecutor(nullptr, nullptr);
+  CompilationOptions co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+  co.hoist_literals = false;
+  using FuncPtr = int (*)(int*);
+
+  auto make_generator = [&]() {
+    auto llvm_module = llvm::CloneModule(
+        *executor->getExtensionModuleContext()->getRTModule(/*is_l0=*/false));
+    return std::make_unique<ScalarCodeGenerator>(
+        executor->getConfig(), std::move(llvm_module), get_traits_desc());
+  };
+  auto compile_constant = [&](ScalarCodeGenerator& code_generator, int val) {
+    Datum d;
+    d.intval = val;
+    auto constant = hdk::ir::makeExpr<hdk::ir::Constant>(ctx.int32(), false, d);
+    const auto compiled_expr =
+        code_generator.compile(constant.get(), true, co, get_traits());
+    return reinterpret_cast<FuncPtr>(
+        code_generator.generateNativeCode(executor.get(), compiled_expr, co).front());
+  };
+
+  // Kernels share the JIT session but use own symbols and are released
+  // independently.
+  auto gen1 = make_generator();
+  auto func1 = compile_constant(*gen1, 42);
+  {
+    auto gen2 = make_generator();
+    auto func2 = compile_constant(*gen2, 7);
+    CHECK(func1 && func2);
+    ASSERT_NE(func1, func2);
+    int out;
+    ASSERT_EQ(func2(&out), 0);
+    ASSERT_EQ(out, 7);
+  }
+  int out;
+  ASSERT_EQ(func1(&out), 0);
+  ASSERT_EQ(out, 42);
+}
+
+TEST(CodeGeneratorTest, RuntimeDylib) {
+  auto executor = Executor::getExecutor(nullptr, nullptr);
+  if (!executor->getConfig().exec.codegen.enable_runtime_dylib) {
+    GTEST_SKIP() << "Runtime JITDylib is disabled";
+  }
+  auto& llvm_ctx = executor->getContext();
+  CgenState cgen_state(0, false, false, executor->getExtensionModuleContext(), llvm_ctx);
+  cgen_state.set_module_shallow_copy(
+      executor->getExtensionModuleContext()->getRTModule(/*is_l0=*/false));
+  cgen_state.use_runtime_dylib_ = true;
+
+  auto i64_type = llvm::Type::getInt64Ty(llvm_ctx);
+  auto i64_ptr_type = llvm::Type::getInt64PtrTy(llvm_ctx);
+  auto func_type = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(llvm_ctx), {i64_ptr_type, i64_ptr_type, i64_type}, false);
+  auto func = llvm::Function::Create(func_type,
+                                     llvm::Function::ExternalLinkage,
+                                     "runtime_dylib_test",
+                                     cgen_state.module_);
+  auto entry = llvm::BasicBlock::Create(llvm_ctx, "entry", func);
+  cgen_state.ir_builder_.SetInsertPoint(entry);
+  auto count_arg = func->arg_begin();
+  auto hll_arg = count_arg + 1;
+  auto key_arg = count_arg + 2;
+  cgen_state.emitCall("agg_count", {count_arg, key_arg});
+  cgen_state.emitCall("agg_approximate_count_distinct",
+                      {hll_arg, key_arg, cgen_state.llInt<int32_t>(4)});
+  cgen_state.ir_builder_.CreateRetVoid();
+  compiler::verify_function_ir(func);
+
+  // ALWAYS_INLINE helpers are cloned into the kernel module, other runtime
+  // functions are called in the shared runtime JITDylib.
+  ASSERT_TRUE(ORCJITSession::instance().hasRuntimeFunction("agg_count"));
+  ASSERT_TRUE(
+      ORCJITSession::instance().hasRuntimeFunction("agg_approximate_count_distinct"));
+#ifndef WITH_JIT_DEBUG
+  ASSERT_FALSE(cgen_state.module_->getFunction("agg_count")->isDeclaration());
+#endif
+  ASSERT_TRUE(cgen_state.module_->getFunction("agg_approximate_count_distinct")
+                  ->isDeclaration());
+
+  ExecutionEngineWrapper execution_engine(ORCJITSession::instance(), true);
+  execution_engine.addModule(std::unique_ptr<llvm::Module>(cgen_state.module_));
+  cgen_state.module_ = nullptr;
+  using FuncPtr = void (*)(int64_t*, int64_t*, int64_t);
+  auto func_ptr = reinterpret_cast<FuncPtr>(execution_engine.getPointerToFunction(func));
+  CHECK(func_ptr);
+
+  int64_t count = 0;
+  std::vector<int8_t> registers(1 << 4, 0);
+  int64_t hll = reinterpret_cast<int64_t>(registers.data());
+  func_ptr(&count, &hll, 42);
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(std::count_if(registers.begin(),
+                          registers.end(),
+                          [](int8_t reg) { return reg != 0; }),
+            1);
+}
+
 TEST(CodeGeneratorTest, IntegerAdd) {
   auto executor = Executor::getExecutor(nullptr, nullptr);
   auto llvm_module = llvm::CloneModule(
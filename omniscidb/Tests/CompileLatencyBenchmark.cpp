@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Measures latency of queries over a tiny table with an empty code cache, so the
+// time is dominated by code generation and JIT compilation. Run with
+// runtime_dylib:0 and runtime_dylib:1 to compare kernels which clone the whole
+// runtime with kernels linked against the runtime JITDylib.
+
+#include "TestHelpers.h"
+
+#include "ArrowSQLRunner/ArrowSQLRunner.h"
+#include "ConfigBuilder/ConfigBuilder.h"
+#include "QueryBuilder/QueryBuilder.h"
+#include "QueryEngine/Execute.h"
+#include "Shared/ArrowUtil.h"
+
+#include <arrow/api.h>
+#include <benchmark/benchmark.h>
+
+using namespace std::string_literals;
+using namespace TestHelpers::ArrowSQLRunner;
+using namespace hdk;
+
+namespace {
+
+constexpr int64_t kNumRows = 100;
+
+void create_table(const std::string& table_name) {
+  arrow::Int32Builder key_builder;
+  arrow::Int64Builder val_builder;
+  arrow::DoubleBuilder dbl_builder;
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    ARROW_THROW_NOT_OK(key_builder.Append(static_cast<int32_t>(i % 10)));
+    ARROW_THROW_NOT_OK(val_builder.Append(i));
+    ARROW_THROW_NOT_OK(dbl_builder.Append(i * 0.5));
+  }
+  std::shared_ptr<arrow::Array> keys, vals, dbls;
+  ARROW_THROW_NOT_OK(key_builder.Finish(&keys));
+  ARROW_THROW_NOT_OK(val_builder.Finish(&vals));
+  ARROW_THROW_NOT_OK(dbl_builder.Finish(&dbls));
+
+  auto schema = arrow::schema({arrow::field("k", arrow::int32()),
+                               arrow::field("v", arrow::int64()),
+                               arrow::field("d", arrow::float64())});
+  getStorage()->importArrowTable(arrow::Table::Make(schema, {keys, vals, dbls}),
+                                 table_name);
+}
+
+template <typename BuildDag>
+void run_compile_benchmark(benchmark::State& state, BuildDag build_dag) {
+  config().exec.codegen.enable_runtime_dylib = state.range(0);
+  QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+  for (auto _ : state) {
+    Executor::cpu_code_accessor->clear();
+    auto res = runQuery(build_dag(builder));
+    benchmark::DoNotOptimize(res);
+  }
+}
+
+}  // namespace
+
+// Filtered projection.
+static void BM_CompileProjection(benchmark::State& state) {
+  run_compile_benchmark(state, [](QueryBuilder& builder) {
+    auto scan = builder.scan("test");
+    return scan.filter(scan.ref("v").gt(10))
+        .proj({scan.ref("k"), (scan.ref("v") * 2).rename("v2")})
+        .finalize();
+  });
+}
+
+// Group by with several aggregates, including approximate count distinct which
+// calls a non-inlined runtime function.
+static void BM_CompileGroupBy(benchmark::State& state) {
+  run_compile_benchmark(state, [](QueryBuilder& builder) {
+    auto scan = builder.scan("test");
+    return scan
+        .agg({"k"s},
+             {"count"s, "sum(v)"s, "avg(d)"s, "min(d)"s, "approx_count_dist(v)"s})
+        .finalize();
+  });
+}
+
+BENCHMARK(BM_CompileProjection)
+    ->ArgName("runtime_dylib")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CompileGroupBy)
+    ->ArgName("runtime_dylib")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  benchmark::Initialize(&argc, argv);
+
+  ConfigBuilder builder;
+  builder.parseCommandLineArgs(argc, argv, true);
+  auto config = builder.config();
+  // Avoid Calcite initialization, queries are built with QueryBuilder.
+  config->debug.use_ra_cache = "dummy";
+  // The runtime JITDylib is built at executor creation, keep it available for
+  // runtime_dylib:1 runs.
+  config->exec.codegen.enable_runtime_dylib = true;
+
+  try {
+    init(config);
+    create_table("test");
+    benchmark::RunSpecifiedBenchmarks();
+    reset();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    return -1;
+  }
+  return 0;
+}
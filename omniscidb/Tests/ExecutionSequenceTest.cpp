@@ -398,6 +398,78 @@ TEST_F(ExecutionSequenceTest, AggSimpleProject) {
                    std::vector<int32_t>({2, 4, 2, 2}));
 }
 
+TEST_F(ExecutionSequenceTest, AggSimpleProjectChain) {
+  auto dag = std::make_unique<TestRelAlgDagBuilder>(getStorage(), configPtr());
+  auto scan = dag->addScan(TEST_DB_ID, "test2");
+  auto proj1 = dag->addProject(scan,
+                               {makeExpr<BinOper>(ctx().int32(),
+                                                  OpType::kPlus,
+                                                  Qualifier::kOne,
+                                                  getNodeColumnRef(scan.get(), 0),
+                                                  Constant::make(ctx().int32(), 1)),
+                                getNodeColumnRef(scan.get(), 1),
+                                makeExpr<BinOper>(ctx().int32(),
+                                                  OpType::kPlus,
+                                                  Qualifier::kOne,
+                                                  getNodeColumnRef(scan.get(), 2),
+                                                  Constant::make(ctx().int32(), 100)),
+                                getNodeColumnRef(scan.get(), 3)});
+  auto agg1 = dag->addAgg(
+      proj1, 2, {{AggType::kMax, ctx().int32(), 2}, {AggType::kSum, ctx().int64(), 3}});
+  auto proj2 = dag->addProject(agg1,
+                               {getNodeColumnRef(agg1.get(), 1),
+                                getNodeColumnRef(agg1.get(), 0),
+                                getNodeColumnRef(agg1.get(), 3),
+                                getNodeColumnRef(agg1.get(), 2)});
+  auto proj3 = dag->addProject(proj2,
+                               {makeExpr<BinOper>(ctx().int32(),
+                                                  OpType::kPlus,
+                                                  Qualifier::kOne,
+                                                  getNodeColumnRef(proj2.get(), 1),
+                                                  Constant::make(ctx().int32(), 10)),
+                                getNodeColumnRef(proj2.get(), 0),
+                                getNodeColumnRef(proj2.get(), 2),
+                                getNodeColumnRef(proj2.get(), 3)});
+  auto sort = dag->addSort(
+      proj3,
+      {{0, hdk::ir::SortDirection::Ascending, hdk::ir::NullSortedPosition::Last},
+       {1, hdk::ir::SortDirection::Ascending, hdk::ir::NullSortedPosition::Last}});
+  dag->finalize();
+
+  QueryExecutionSequence new_seq(dag->getRootNode(), configPtr());
+  CHECK_EQ(new_seq.size(), (size_t)1);
+
+  auto res = runQuery(std::move(dag));
+  compare_res_data(res,
+                   std::vector<int32_t>({12, 12, 13, 13}),
+                   std::vector<int32_t>({1, 2, 1, 2}),
+                   std::vector<int64_t>({45, 96, 51, 53}),
+                   std::vector<int32_t>({115, 117, 113, 119}));
+}
+
+TEST_F(ExecutionSequenceTest, AggComplexProjectChain) {
+  auto dag = std::make_unique<TestRelAlgDagBuilder>(getStorage(), configPtr());
+  auto scan = dag->addScan(TEST_DB_ID, "test2");
+  auto agg1 = dag->addAgg(scan, 1, {{AggType::kSum, ctx().int64(), 3}});
+  auto proj1 = dag->addProject(
+      agg1, {getNodeColumnRef(agg1.get(), 1), getNodeColumnRef(agg1.get(), 0)});
+  auto proj2 = dag->addProject(proj1,
+                               {getNodeColumnRef(proj1.get(), 1),
+                                makeExpr<BinOper>(ctx().int64(),
+                                                  OpType::kPlus,
+                                                  Qualifier::kOne,
+                                                  getNodeColumnRef(proj1.get(), 0),
+                                                  Constant::make(ctx().int64(), 1))});
+  dag->finalize();
+
+  // The second projection computes an expression over the aggregate, so only
+  // the first projection is merged with the aggregation.
+  QueryExecutionSequence new_seq(dag->getRootNode(), configPtr());
+  CHECK_EQ(new_seq.size(), (size_t)2);
+  CHECK(new_seq.step(0) == proj1.get());
+  CHECK(new_seq.step(1) == proj2.get());
+}
+
 TEST_F(ExecutionSequenceTest, AggScan1) {
   auto dag = std::make_unique<TestRelAlgDagBuilder>(getStorage(), configPtr());
   auto scan = dag->addScan(TEST_DB_ID, "test2");
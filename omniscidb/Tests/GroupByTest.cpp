@@ -17,16 +17,20 @@
 #include "TestHelpers.h"
 
 #include "ArrowSQLRunner/ArrowSQLRunner.h"
+#include "ArrowTestHelpers.h"
 #include "ConfigBuilder/ConfigBuilder.h"
 #include "DataMgr/DataMgrBufferProvider.h"
 #include "DataMgr/DataMgrDataProvider.h"
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/RelAlgExecutor.h"
+#include "ResultSet/RoaringBitmap.h"
 #include "Shared/scope.h"
 
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <set>
 
 EXTERN extern bool g_is_test_env;
 
@@ -368,6 +372,176 @@ TEST_F(BigCardinalityThresholdTest, EmptyFilters) {
   }
 }
 
+class CountDistinctTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("count_distinct",
+                {{"k", ctx().int32()},
+                 {"r", ctx().int32()},
+                 {"v", ctx().int64()},
+                 {"d", ctx().fp64()}},
+                {3});
+    insertCsvValues("count_distinct",
+                    "1,1,10,1.5\n"
+                    "1,1,10,1.5\n"
+                    "1,100000,20,2.5\n"
+                    "1,,,\n"
+                    "2,5,5000000000,3.5\n"
+                    "2,200000,70000,3.5\n"
+                    "2,5,70000,\n"
+                    "3,,,");
+  }
+
+  void TearDown() override { dropTable("count_distinct"); }
+};
+
+TEST_F(CountDistinctTest, RoaringBitmap) {
+  auto old_exec_groupby = config().exec.group_by;
+  ScopeGuard g([&old_exec_groupby]() { config().exec.group_by = old_exec_groupby; });
+  // Use roaring bitmaps regardless of the dense bitmap size.
+  config().exec.group_by.roaring_count_distinct_threshold = 0;
+
+  auto res = runSqlQuery(
+      "SELECT k, COUNT(DISTINCT r) FROM count_distinct GROUP BY k ORDER BY k;",
+      ExecutorDeviceType::CPU,
+      false);
+  ArrowTestHelpers::compare_res_data(
+      res, std::vector<int32_t>({1, 2, 3}), std::vector<int32_t>({2, 2, 0}));
+  res = runSqlQuery(
+      "SELECT COUNT(DISTINCT r) FROM count_distinct;", ExecutorDeviceType::CPU, false);
+  ArrowTestHelpers::compare_res_data(res, std::vector<int32_t>({4}));
+}
+
+// Runs the query and returns its result and the number of steps executed as
+// two-phase COUNT(DISTINCT).
+std::pair<ExecutionResult, size_t> runTwoPhaseCountDistinctQuery(
+    const std::string& query,
+    ExecutorDeviceType dt) {
+  auto ra_executor = makeRelAlgExecutor(query);
+  auto res = ra_executor->executeRelAlgQuery(
+      getCompilationOptions(dt), getExecutionOptions(false), false);
+  return {res, ra_executor->getTwoPhaseCountDistinctSteps()};
+}
+
+TEST_F(CountDistinctTest, TwoPhase) {
+  auto old_exec_groupby = config().exec.group_by;
+  ScopeGuard g([&old_exec_groupby]() { config().exec.group_by = old_exec_groupby; });
+  config().exec.group_by.two_phase_count_distinct_threshold = 0;
+
+  for (auto dt : testedDevices()) {
+    auto [res, steps] = runTwoPhaseCountDistinctQuery(
+        "SELECT k, COUNT(DISTINCT v) FROM count_distinct GROUP BY k ORDER BY k;", dt);
+    EXPECT_EQ(steps, (size_t)1);
+    ArrowTestHelpers::compare_res_data(
+        res, std::vector<int32_t>({1, 2, 3}), std::vector<int32_t>({2, 2, 0}));
+    std::tie(res, steps) = runTwoPhaseCountDistinctQuery(
+        "SELECT k, COUNT(DISTINCT d) AS cnt FROM count_distinct GROUP BY k ORDER BY cnt "
+        "DESC, k LIMIT 2;",
+        dt);
+    EXPECT_EQ(steps, (size_t)1);
+    ArrowTestHelpers::compare_res_data(
+        res, std::vector<int32_t>({1, 2}), std::vector<int32_t>({2, 1}));
+  }
+}
+
+TEST_F(CountDistinctTest, TwoPhaseDefault) {
+  auto old_exec_groupby = config().exec.group_by;
+  ScopeGuard g([&old_exec_groupby]() { config().exec.group_by = old_exec_groupby; });
+  // Two-phase COUNT(DISTINCT) is enabled by default and applies to inputs bigger
+  // than the threshold only.
+  ASSERT_TRUE(Config().exec.group_by.enable_two_phase_count_distinct);
+  config().exec.group_by.enable_two_phase_count_distinct =
+      Config().exec.group_by.enable_two_phase_count_distinct;
+  config().exec.group_by.two_phase_count_distinct_threshold = 8;
+
+  const std::string query =
+      "SELECT k, COUNT(DISTINCT v) FROM count_distinct GROUP BY k ORDER BY k;";
+  for (auto dt : testedDevices()) {
+    // The table has 8 rows.
+    auto [res, steps] = runTwoPhaseCountDistinctQuery(query, dt);
+    EXPECT_EQ(steps, (size_t)1);
+    ArrowTestHelpers::compare_res_data(
+        res, std::vector<int32_t>({1, 2, 3}), std::vector<int32_t>({2, 2, 0}));
+
+    config().exec.group_by.two_phase_count_distinct_threshold = 9;
+    std::tie(res, steps) = runTwoPhaseCountDistinctQuery(query, dt);
+    EXPECT_EQ(steps, (size_t)0);
+    ArrowTestHelpers::compare_res_data(
+        res, std::vector<int32_t>({1, 2, 3}), std::vector<int32_t>({2, 2, 0}));
+    config().exec.group_by.two_phase_count_distinct_threshold = 8;
+
+    // The range of r fits a roaring bitmap, so the step is not rewritten.
+    std::tie(res, steps) = runTwoPhaseCountDistinctQuery(
+        "SELECT k, COUNT(DISTINCT r) FROM count_distinct GROUP BY k ORDER BY k;", dt);
+    EXPECT_EQ(steps, (size_t)0);
+    ArrowTestHelpers::compare_res_data(
+        res, std::vector<int32_t>({1, 2, 3}), std::vector<int32_t>({2, 2, 0}));
+  }
+}
+
+TEST(RoaringBitmapTest, ArrayToBitmap) {
+  RoaringBitmap bitmap;
+  const uint32_t base = 7 << 16;
+  // Values of a single container, every third value is set.
+  for (uint32_t i = 0; i < 5000; ++i) {
+    ASSERT_TRUE(bitmap.add(base + i * 3));
+    ASSERT_FALSE(bitmap.add(base + i * 3));
+    ASSERT_EQ(bitmap.cardinality(), (size_t)i + 1);
+  }
+  // The array container would take 2 bytes per value, it is replaced with an 8KB
+  // bitmap above 4096 values.
+  ASSERT_GE(bitmap.memoryUsage(), (size_t)8192);
+  ASSERT_LT(bitmap.memoryUsage(), (size_t)8192 + 1024);
+  for (uint32_t i = 0; i < 15000; ++i) {
+    ASSERT_EQ(bitmap.contains(base + i), i % 3 == 0);
+  }
+  ASSERT_FALSE(bitmap.contains(base - 1));
+  ASSERT_FALSE(bitmap.contains(base + (1 << 16)));
+}
+
+TEST(RoaringBitmapTest, Union) {
+  std::set<uint32_t> expected;
+  RoaringBitmap bitmap1;
+  RoaringBitmap bitmap2;
+  auto add = [&expected](RoaringBitmap& bitmap, uint32_t val) {
+    bitmap.add(val);
+    expected.insert(val);
+  };
+  for (uint32_t i = 0; i < 3000; ++i) {
+    // Two array containers which are merged into a bitmap container.
+    add(bitmap1, i * 2);
+    add(bitmap2, i * 2 + 1);
+    // An array container merged into a bitmap container.
+    add(bitmap1, (1 << 16) + i);
+    add(bitmap2, (1 << 16) + 2000 + i * 5);
+    add(bitmap2, (1 << 16) + 30000 + i);
+    // Containers present in one of the bitmaps only.
+    add(bitmap1, (2 << 16) + i);
+    add(bitmap2, (5 << 16) + i * 7);
+  }
+  // Overlapping values.
+  add(bitmap2, 10);
+  add(bitmap2, (1 << 16) + 10);
+
+  RoaringBitmap empty;
+  bitmap1.unionWith(empty);
+  empty.unionWith(bitmap1);
+  ASSERT_EQ(empty.cardinality(), bitmap1.cardinality());
+
+  bitmap1.unionWith(bitmap2);
+  ASSERT_EQ(bitmap1.cardinality(), expected.size());
+  for (auto val : expected) {
+    ASSERT_TRUE(bitmap1.contains(val));
+  }
+  for (uint32_t val : {6001u, (1u << 16) + 3001u, (2u << 16) + 3000u, 3u << 16}) {
+    ASSERT_FALSE(bitmap1.contains(val));
+  }
+  // Adding to merged containers keeps the cardinality consistent.
+  ASSERT_FALSE(bitmap1.add(1));
+  ASSERT_TRUE(bitmap1.add(6001));
+  ASSERT_EQ(bitmap1.cardinality(), expected.size() + 1);
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Measures how huge pages affect random access to large group by buffers. Update
+// benchmarks report data TLB load misses per key when the kernel exposes hardware
+// counters. Without them results are labeled and only timings are available, which
+// don't show whether a difference comes from fewer TLB misses. In that case collect
+// the misses with `perf stat -e dTLB-load-misses`, using --benchmark_filter to run
+// the huge_pages:0 and huge_pages:1 cases separately.
+
+#include "Shared/huge_pages.h"
+
+#include <benchmark/benchmark.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kBufferBytes = 1ULL << 30;
+constexpr size_t kBufferAlignment = 2ULL << 20;
+constexpr size_t kNumKeys = 16ULL << 20;
+
+using BufferPtr = std::unique_ptr<int64_t, decltype(&std::free)>;
+
+BufferPtr allocate_buffer(bool use_huge_pages, bool prefault) {
+  BufferPtr buffer(
+      reinterpret_cast<int64_t*>(std::aligned_alloc(kBufferAlignment, kBufferBytes)),
+      &std::free);
+  if (use_huge_pages) {
+    huge_pages::advise(buffer.get(), kBufferBytes);
+  }
+  if (prefault) {
+    huge_pages::prefault(buffer.get(), kBufferBytes);
+  }
+  return buffer;
+}
+
+std::vector<int64_t> generate_keys(size_t max_key) {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int64_t> dist(0, max_key - 1);
+  std::vector<int64_t> keys(kNumKeys);
+  for (auto& key : keys) {
+    key = dist(gen);
+  }
+  return keys;
+}
+
+inline uint64_t hash_key(int64_t key) {
+  uint64_t h = key;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Counts data TLB load misses of the current thread. Counting is not available
+// when the kernel doesn't allow access to performance counters.
+class DtlbMissCounter {
+ public:
+  DtlbMissCounter() {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+
+  ~DtlbMissCounter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool available() const { return fd_ >= 0; }
+
+  void start() {
+    if (available()) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  uint64_t stop() {
+    uint64_t count = 0;
+    if (available()) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+      }
+    }
+    return count;
+  }
+
+ private:
+  int fd_;
+};
+
+void report_tlb_misses(benchmark::State& state,
+                       const DtlbMissCounter& counter,
+                       uint64_t misses) {
+  if (counter.available()) {
+    state.counters["dtlb_misses_per_key"] =
+        benchmark::Counter(static_cast<double>(misses) / kNumKeys / state.iterations());
+  } else {
+    state.SetLabel("dTLB counter unavailable");
+  }
+}
+
+}  // namespace
+
+// Random updates of a 1GB perfect hash group by buffer. state.range(0) enables
+// huge pages for the buffer.
+static void BM_PerfectHashUpdate(benchmark::State& state) {
+  const size_t num_entries = kBufferBytes / sizeof(int64_t);
+  auto buffer = allocate_buffer(state.range(0), true);
+  auto keys = generate_keys(num_entries);
+  std::memset(buffer.get(), 0, kBufferBytes);
+
+  DtlbMissCounter counter;
+  uint64_t misses = 0;
+  for (auto _ : state) {
+    counter.start();
+    auto groups = buffer.get();
+    for (auto key : keys) {
+      ++groups[key];
+    }
+    misses += counter.stop();
+    benchmark::ClobberMemory();
+  }
+  report_tlb_misses(state, counter, misses);
+  state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+// Random updates of a 1GB baseline hash group by buffer with linear probing.
+// state.range(0) enables huge pages for the buffer.
+static void BM_BaselineHashUpdate(benchmark::State& state) {
+  // Each entry holds a key and a count, the table is filled by 50% at most.
+  const size_t num_entries = kBufferBytes / (2 * sizeof(int64_t));
+  auto buffer = allocate_buffer(state.range(0), true);
+  auto keys = generate_keys(num_entries / 2);
+
+  DtlbMissCounter counter;
+  uint64_t misses = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::memset(buffer.get(), 0xff, kBufferBytes);
+    state.ResumeTiming();
+
+    counter.start();
+    auto entries = buffer.get();
+    for (auto key : keys) {
+      auto idx = hash_key(key) & (num_entries - 1);
+      while (entries[idx * 2] != -1 && entries[idx * 2] != key) {
+        idx = (idx + 1) & (num_entries - 1);
+      }
+      entries[idx * 2] = key;
+      ++entries[idx * 2 + 1];
+    }
+    misses += counter.stop();
+    benchmark::ClobberMemory();
+  }
+  report_tlb_misses(state, counter, misses);
+  state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+// Allocation and initialization of a 1GB group by buffer. state.range(0) enables
+// huge pages and state.range(1) enables parallel prefaulting.
+static void BM_BufferInit(benchmark::State& state) {
+  for (auto _ : state) {
+    auto buffer = allocate_buffer(state.range(0), state.range(1));
+    std::memset(buffer.get(), 0, kBufferBytes);
+    benchmark::DoNotOptimize(buffer.get());
+  }
+  state.SetBytesProcessed(state.iterations() * kBufferBytes);
+}
+
+BENCHMARK(BM_PerfectHashUpdate)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BaselineHashUpdate)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BufferInit)
+    ->ArgNames({"huge_pages", "prefault"})
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "TestHelpers.h"
+
+#include "ArrowSQLRunner/ArrowSQLRunner.h"
+#include "ConfigBuilder/ConfigBuilder.h"
+#include "QueryBuilder/QueryBuilder.h"
+#include "Shared/ArrowUtil.h"
+
+#include <arrow/api.h>
+#include <benchmark/benchmark.h>
+
+using namespace std::string_literals;
+using namespace TestHelpers::ArrowSQLRunner;
+using namespace hdk;
+
+namespace {
+
+constexpr int64_t kNumRows = 16'000'000;
+constexpr int64_t kNumGroups = 1'000;
+constexpr int64_t kSkewedFragments = 32;
+
+// Creates a table with a row index column, a group key column and a value column.
+void create_table(const std::string& table_name, size_t fragment_size) {
+  arrow::Int64Builder id_builder;
+  arrow::Int32Builder key_builder;
+  arrow::Int32Builder val_builder;
+  ARROW_THROW_NOT_OK(id_builder.Reserve(kNumRows));
+  ARROW_THROW_NOT_OK(key_builder.Reserve(kNumRows));
+  ARROW_THROW_NOT_OK(val_builder.Reserve(kNumRows));
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    id_builder.UnsafeAppend(i);
+    key_builder.UnsafeAppend(static_cast<int32_t>((i * 7919) % kNumGroups));
+    val_builder.UnsafeAppend(static_cast<int32_t>(i % 100));
+  }
+  std::shared_ptr<arrow::Array> ids, keys, vals;
+  ARROW_THROW_NOT_OK(id_builder.Finish(&ids));
+  ARROW_THROW_NOT_OK(key_builder.Finish(&keys));
+  ARROW_THROW_NOT_OK(val_builder.Finish(&vals));
+
+  auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                               arrow::field("k", arrow::int32()),
+                               arrow::field("v", arrow::int32())});
+  getStorage()->importArrowTable(arrow::Table::Make(schema, {ids, keys, vals}),
+                                 table_name,
+                                 ArrowStorage::TableOptions{fragment_size});
+}
+
+void set_sub_tasks(benchmark::State& state) {
+  config().exec.sub_tasks.enable = state.range(0);
+}
+
+}  // namespace
+
+// Group by over a table with fewer fragments than CPU threads. With a kernel per
+// fragment only two threads are busy.
+static void BM_FewFragments(benchmark::State& state) {
+  set_sub_tasks(state);
+  QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+  for (auto _ : state) {
+    auto scan = builder.scan("few_frags");
+    auto dag = scan.agg({"k"s}, {"sum(v)"s}).finalize();
+    auto res = runQuery(std::move(dag));
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Group by with a filter selecting rows of a single fragment out of eight. Other
+// fragments are skipped by metadata, so a kernel per fragment runs on one thread.
+static void BM_SelectiveFilter(benchmark::State& state) {
+  set_sub_tasks(state);
+  QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+  for (auto _ : state) {
+    auto scan = builder.scan("many_frags");
+    auto dag = scan.filter(scan.ref("id").lt(kNumRows / 8))
+                   .agg({"k"s}, {"sum(v)"s})
+                   .finalize();
+    auto res = runQuery(std::move(dag));
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRows / 8);
+}
+
+// Group by over fragments with heavily skewed processing cost. ArrowStorage fragments
+// have a fixed size, so the skew comes from the rows of the first fragment taking an
+// expensive branch. This fragment works like a fragment many times larger than the
+// others, and with a kernel per fragment it finishes long after the rest.
+static void BM_SkewedFragments(benchmark::State& state) {
+  set_sub_tasks(state);
+  QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+  for (auto _ : state) {
+    auto scan = builder.scan("skewed_frags");
+    auto heavy = scan.ref("v");
+    for (int i = 0; i < 32; ++i) {
+      heavy = (heavy * 31 + scan.ref("v")).mod(1009);
+    }
+    auto val = builder.ifThenElse(
+        scan.ref("id").lt(kNumRows / kSkewedFragments), heavy, scan.ref("v"));
+    auto dag = scan.proj({scan.ref("k"), val.rename("h")})
+                   .agg({"k"s}, {"sum(h)"s})
+                   .finalize();
+    auto res = runQuery(std::move(dag));
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+BENCHMARK(BM_FewFragments)
+    ->ArgName("sub_tasks")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SelectiveFilter)
+    ->ArgName("sub_tasks")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SkewedFragments)
+    ->ArgName("sub_tasks")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  benchmark::Initialize(&argc, argv);
+
+  ConfigBuilder builder;
+  builder.parseCommandLineArgs(argc, argv, true);
+  auto config = builder.config();
+  // Avoid Calcite initialization, queries are built with QueryBuilder.
+  config->debug.use_ra_cache = "dummy";
+
+  try {
+    init(config);
+    create_table("few_frags", kNumRows / 2);
+    create_table("many_frags", kNumRows / 8);
+    create_table("skewed_frags", kNumRows / kSkewedFragments);
+    benchmark::RunSpecifiedBenchmarks();
+    reset();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    return -1;
+  }
+  return 0;
+}
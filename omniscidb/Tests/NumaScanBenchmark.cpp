@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Shared/numa.h"
+
+#include <benchmark/benchmark.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+
+namespace {
+
+constexpr size_t kScanBytes = 1ULL << 30;
+
+}  // namespace
+
+// Sums a 1GB column placed on state.range(0) node by threads of state.range(1)
+// node. Bytes per second for each pair of nodes show the bandwidth of local and
+// remote scans.
+static void BM_NumaScan(benchmark::State& state) {
+  const int data_node = static_cast<int>(state.range(0));
+  const int exec_node = static_cast<int>(state.range(1));
+  const size_t num_values = kScanBytes / sizeof(int64_t);
+
+  std::unique_ptr<int64_t, decltype(&std::free)> data(
+      reinterpret_cast<int64_t*>(std::malloc(kScanBytes)), &std::free);
+  numa::bind_to_node(data.get(), kScanBytes, data_node);
+  numa::get_node_arena(data_node).execute([&]() {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_values),
+                      [&](const tbb::blocked_range<size_t>& r) {
+                        for (size_t i = r.begin(); i < r.end(); ++i) {
+                          data.get()[i] = i;
+                        }
+                      });
+  });
+
+  auto& arena = numa::get_node_arena(exec_node);
+  for (auto _ : state) {
+    auto sum = arena.execute([&]() {
+      return tbb::parallel_reduce(
+          tbb::blocked_range<size_t>(0, num_values),
+          int64_t(0),
+          [&](const tbb::blocked_range<size_t>& r, int64_t acc) {
+            for (size_t i = r.begin(); i < r.end(); ++i) {
+              acc += data.get()[i];
+            }
+            return acc;
+          },
+          std::plus<int64_t>());
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kScanBytes);
+}
+
+static void NodePairs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"data_node", "exec_node"});
+  for (int data_node = 0; data_node < numa::num_nodes(); ++data_node) {
+    for (int exec_node = 0; exec_node < numa::num_nodes(); ++exec_node) {
+      b->Args({data_node, exec_node});
+    }
+  }
+}
+
+BENCHMARK(BM_NumaScan)->Apply(NodePairs)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
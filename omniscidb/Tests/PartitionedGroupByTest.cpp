@@ -150,6 +150,32 @@ TEST_F(PartitionedGroupByTest, ReorderedKeys) {
   compare_res_data(res2, id4_vals, id2_vals, id1_vals, id3_vals, v1_sums, v2_sums);
 }
 
+TEST_F(PartitionedGroupByTest, ExactPercentile) {
+  auto old_exec = config().exec;
+  ScopeGuard g([&old_exec]() { config().exec = old_exec; });
+
+  config().exec.group_by.default_max_groups_buffer_entry_guess = 1;
+  config().exec.group_by.big_group_threshold = 1;
+  config().exec.group_by.enable_cpu_partitioned_groupby = true;
+  config().exec.group_by.partitioning_buffer_size_threshold = 10;
+  config().exec.group_by.partitioning_group_size_threshold = 1.5;
+  config().exec.group_by.min_partitions = 2;
+  config().exec.group_by.max_partitions = 8;
+  config().exec.group_by.partitioning_buffer_target_size = 200;
+  config().exec.enable_multifrag_execution_result = true;
+
+  QueryBuilder builder(ctx(), getSchemaProvider(), configPtr());
+  auto scan = builder.scan("test1");
+  auto dag1 = scan.agg({"id1"s}, {"median(v1)"s, "percentile_disc(v2, 0.5)"s}).finalize();
+  auto res1 = runQuery(std::move(dag1));
+  ASSERT_GT(res1.getToken()->resultSetCount(), (size_t)1);
+  auto dag2 = builder.scan(res1.tableName()).sort({0}).finalize();
+  auto res2 = runQuery(std::move(dag2));
+  std::vector<double> v1_medians(v1_vals.begin(), v1_vals.end());
+  std::vector<double> v2_medians(v2_vals.begin(), v2_vals.end());
+  compare_res_data(res2, id1_vals, v1_medians, v2_medians);
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -1113,6 +1113,74 @@ TEST_F(QueryBuilderTest, AggExpr) {
   EXPECT_THROW(ref_i32.agg("approximate quantile"), InvalidQueryError);
   EXPECT_THROW(ref_i32.approxQuantile(-1.0), InvalidQueryError);
   EXPECT_THROW(ref_i32.approxQuantile(1.5), InvalidQueryError);
+  // PERCENTILE_CONT, PERCENTILE_DISC, MEDIAN
+  checkAgg(ref_i32.percentileCont(0.0),
+           ctx().fp64(),
+           AggType::kPercentileCont,
+           false,
+           "col_i_percentile_cont",
+           0.0);
+  checkAgg(ref_f64.percentileDisc(0.9),
+           ctx().fp64(),
+           AggType::kPercentileDisc,
+           false,
+           "col_d_percentile_disc",
+           0.9);
+  checkAgg(ref_dec.median(),
+           ctx().fp64(),
+           AggType::kPercentileCont,
+           false,
+           "col_dec_median",
+           0.5);
+  checkAgg(ref_i64.agg("percentile cont", 0.4),
+           ctx().fp64(),
+           AggType::kPercentileCont,
+           false,
+           "col_bi_percentile_cont",
+           0.4);
+  checkAgg(ref_f32.agg("percentile_disc", 1.0),
+           ctx().fp64(),
+           AggType::kPercentileDisc,
+           false,
+           "col_f_percentile_disc",
+           1.0);
+  checkAgg(ref_f32.agg("median"),
+           ctx().fp64(),
+           AggType::kPercentileCont,
+           false,
+           "col_f_median",
+           0.5);
+  EXPECT_THROW(ref_str.percentileCont(0.5), InvalidQueryError);
+  EXPECT_THROW(ref_dict.percentileDisc(0.5), InvalidQueryError);
+  EXPECT_THROW(ref_arr.median(), InvalidQueryError);
+  EXPECT_THROW(ref_i32.percentileCont(-0.1), InvalidQueryError);
+  EXPECT_THROW(ref_i32.percentileDisc(1.1), InvalidQueryError);
+  EXPECT_THROW(ref_i32.agg("percentile_cont"), InvalidQueryError);
+  EXPECT_THROW(ref_i32.agg("median", 0.5), InvalidQueryError);
+  // HLL_SKETCH, HLL_MERGE, HLL_MERGE_COUNT
+  auto sketch_type = ctx().arrayVarLen(ctx().int8(false), 4, false);
+  auto ref_sketch = builder.cst({1, 2, 3, 4}, "array(int8)");
+  checkAgg(
+      ref_i32.hllSketch(), sketch_type, AggType::kHllSketch, false, "col_i_hll_sketch");
+  checkAgg(ref_str.agg("hll sketch", 12),
+           sketch_type,
+           AggType::kHllSketch,
+           false,
+           "col_str_hll_sketch");
+  ASSERT_EQ(ref_str.agg("hll sketch", 12).expr()->as<AggExpr>()->arg1()->intVal(), 12);
+  checkAgg(ref_sketch.hllMerge(4), sketch_type, AggType::kHllMerge, false, "hll_merge");
+  checkAgg(ref_sketch.agg("hll_merge_count"),
+           ctx().int64(false),
+           AggType::kHllMergeCount,
+           false,
+           "hll_merge_count");
+  ASSERT_EQ(ref_i32.approxCountDist(5).expr()->as<AggExpr>()->arg1()->intVal(), 5);
+  EXPECT_THROW(ref_i32.hllSketch(3), InvalidQueryError);
+  EXPECT_THROW(ref_i32.hllSketch(17), InvalidQueryError);
+  EXPECT_THROW(ref_i32.agg("hll_sketch", 10.5), InvalidQueryError);
+  EXPECT_THROW(ref_i32.hllMerge(), InvalidQueryError);
+  EXPECT_THROW(ref_arr.hllMergeCount(), InvalidQueryError);
+  EXPECT_THROW(ref_i32.approxCountDist(101), InvalidQueryError);
   // SAMPLE
   checkAgg(
       ref_i32.sample(), ref_i32.expr()->type(), AggType::kSample, false, "col_i_sample");
@@ -1262,6 +1330,94 @@ TEST_F(QueryBuilderTest, AggExpr) {
   EXPECT_THROW(ref_f64.corr(builder.cst(3.5)), InvalidQueryError);
 }
 
+TEST_F(QueryBuilderTest, HllSketchRegisters) {
+  QueryBuilder builder(ctx(), schema_mgr_, configPtr());
+  const size_t register_count = 64;
+  std::vector<int64_t> cpu_registers;
+  for (auto dt : testedDevices()) {
+    auto scan = builder.scan("test2");
+    auto dag = scan.agg(std::vector<int>{}, scan.ref("val1").hllSketch(6)).finalize();
+    auto res = runQuery(std::move(dag), dt);
+
+    // Registers are read back as TINYINT values regardless of the device.
+    auto rows = res.getRows();
+    ASSERT_EQ(rows->rowCount(), (size_t)1);
+    auto row = rows->getNextRow(true, true);
+    ASSERT_EQ(row.size(), (size_t)1);
+    auto sketch = boost::get<ArrayTargetValue>(&row[0]);
+    ASSERT_TRUE(sketch && *sketch);
+    ASSERT_EQ((*sketch)->size(), register_count);
+    std::vector<int64_t> registers;
+    for (auto& val : **sketch) {
+      registers.push_back(boost::get<int64_t>(val));
+      ASSERT_GE(registers.back(), 0);
+      ASSERT_LE(registers.back(), 64);
+    }
+    ASSERT_GT(std::count_if(
+                  registers.begin(), registers.end(), [](int64_t v) { return v > 0; }),
+              0);
+    if (cpu_registers.empty()) {
+      cpu_registers = registers;
+    } else {
+      ASSERT_EQ(registers, cpu_registers);
+    }
+
+    auto at = toArrow(res);
+    auto col_type = at->column(0)->type();
+    ASSERT_EQ(col_type->id(), arrow::Type::LIST);
+    ASSERT_EQ(std::static_pointer_cast<arrow::ListType>(col_type)->value_type()->id(),
+              arrow::Type::INT8);
+    auto list = std::static_pointer_cast<arrow::ListArray>(at->column(0)->chunk(0));
+    ASSERT_EQ(list->value_length(0), (int32_t)register_count);
+    auto values = std::static_pointer_cast<arrow::Int8Array>(list->values());
+    for (size_t i = 0; i < register_count; ++i) {
+      ASSERT_EQ(values->Value(list->value_offset(0) + i), registers[i]);
+    }
+  }
+}
+
+TEST_F(QueryBuilderTest, HllSketchMerge) {
+  QueryBuilder builder(ctx(), schema_mgr_, configPtr());
+  auto scan = builder.scan("test2");
+  auto dag1 = scan.agg({"id1"s, "id2"s},
+                       {scan.ref("val1").hllSketch().rename("s"),
+                        scan.ref("val1").hllSketch(12).rename("s12"),
+                        scan.ref("val1").hllSketch(8).rename("s8")})
+                  .finalize();
+  auto res1 = runQuery(std::move(dag1));
+  auto sketches = builder.scan(res1.tableName());
+  auto dag2 = sketches
+                  .agg(std::vector<int>{},
+                       {sketches.ref("s").hllMergeCount(),
+                        sketches.ref("s12").hllMergeCount(8),
+                        sketches.ref("s8").hllMergeCount(8)})
+                  .finalize();
+  auto at2 = toArrow(runQuery(std::move(dag2)));
+  auto dag3 =
+      scan.agg(std::vector<int>{}, scan.ref("val1").approxCountDist()).finalize();
+  auto at3 = toArrow(runQuery(std::move(dag3)));
+
+  // Merged sketches estimate the same count as APPROX_COUNT_DISTINCT with the same
+  // precision, and sketches with a higher precision are folded exactly.
+  auto expected = std::static_pointer_cast<arrow::Int32Array>(at3->column(0)->chunk(0));
+  compare_arrow_array(std::vector<int64_t>({expected->Value(0)}), at2->column(0));
+  auto folded = std::static_pointer_cast<arrow::Int64Array>(at2->column(2)->chunk(0));
+  compare_arrow_array(std::vector<int64_t>({folded->Value(0)}), at2->column(1));
+
+  // Merged sketch is a sketch too.
+  auto dag4 = sketches.agg({"id1"s}, sketches.ref("s").hllMerge().rename("m")).finalize();
+  auto res4 = runQuery(std::move(dag4));
+  auto merged = builder.scan(res4.tableName());
+  auto dag5 = merged.agg(std::vector<int>{}, merged.ref("m").hllMergeCount()).finalize();
+  compare_arrow_array(std::vector<int64_t>({expected->Value(0)}),
+                      toArrow(runQuery(std::move(dag5)))->column(0));
+
+  // Sketches cannot be merged with a higher precision.
+  auto dag6 = sketches.agg(std::vector<int>{}, sketches.ref("s8").hllMergeCount(12))
+                  .finalize();
+  EXPECT_THROW(runQuery(std::move(dag6)), std::runtime_error);
+}
+
 TEST_F(QueryBuilderTest, ParseAgg) {
   class TestNode : public BuilderNode {
    public:
@@ -1399,6 +1555,28 @@ TEST_F(QueryBuilderTest, ParseAgg) {
   EXPECT_THROW(node.parseAgg("approx_quantile(col_i, 1.5)"), InvalidQueryError);
   EXPECT_THROW(node.parseAgg("approx_quantile(col_i, 1..5)"), InvalidQueryError);
   EXPECT_THROW(node.parseAgg("approx_quantile(col_i, 0.5, 1.5)"), InvalidQueryError);
+  // PERCENTILE_CONT, PERCENTILE_DISC, MEDIAN
+  checkAgg(node.parseAgg("percentile_cont(col_i, 0.2)"),
+           ctx().fp64(),
+           AggType::kPercentileCont,
+           false,
+           "col_i_percentile_cont",
+           0.2);
+  checkAgg(node.parseAgg(" percentile DISC ( col_i  ,  0.7 ) "),
+           ctx().fp64(),
+           AggType::kPercentileDisc,
+           false,
+           "col_i_percentile_disc",
+           0.7);
+  checkAgg(node.parseAgg("median(col_i)"),
+           ctx().fp64(),
+           AggType::kPercentileCont,
+           false,
+           "col_i_median",
+           0.5);
+  EXPECT_THROW(node.parseAgg("percentile_cont(col_i)"), InvalidQueryError);
+  EXPECT_THROW(node.parseAgg("percentile_disc(col_i, 1.5)"), InvalidQueryError);
+  EXPECT_THROW(node.parseAgg("median(col_i, 0.5)"), InvalidQueryError);
   // SAMPLE
   checkAgg(node.parseAgg("sample(col_i)"),
            ctx().int32(),
@@ -965,6 +965,114 @@ TEST(ArrowTable, MultifragResult) {
   CHECK_EQ(res.getToken()->resultSetCount(), (size_t)2);
   auto table = res.getToken()->toArrow();
   CHECK_EQ(table->column(1)->num_chunks(), 2);
+  CHECK_EQ((size_t)table->num_rows(), res.getToken()->rowCount());
+  compare_columns(table6x4_col_i64, table->column(1));
+  compare_columns(table6x4_col_bi, table->column(2));
+  compare_columns(table6x4_col_d, table->column(3));
+}
+
+TEST(ArrowTable, MultifragTimestampZeroCopy) {
+  bool prev_enable_multifrag_execution_result =
+      config().exec.enable_multifrag_execution_result;
+  bool prev_enable_columnar_output = config().rs.enable_columnar_output;
+  bool prev_enable_lazy_fetch = config().rs.enable_lazy_fetch;
+  ScopeGuard reset = [prev_enable_multifrag_execution_result,
+                      prev_enable_columnar_output,
+                      prev_enable_lazy_fetch] {
+    config().exec.enable_multifrag_execution_result =
+        prev_enable_multifrag_execution_result;
+    config().rs.enable_columnar_output = prev_enable_columnar_output;
+    config().rs.enable_lazy_fetch = prev_enable_lazy_fetch;
+    getStorage()->dropTable("test_ts");
+  };
+
+  config().exec.enable_multifrag_execution_result = true;
+  config().rs.enable_columnar_output = true;
+  config().rs.enable_lazy_fetch = false;
+
+  // Seconds since epoch, the second value is null.
+  std::vector<int64_t> seconds = {1577836800, 0, 1577923200, 1578009600, 1578096000};
+  std::vector<std::pair<arrow::TimeUnit::type, int64_t>> units = {
+      {arrow::TimeUnit::MILLI, 1'000},
+      {arrow::TimeUnit::MICRO, 1'000'000},
+      {arrow::TimeUnit::NANO, 1'000'000'000}};
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (auto [unit, scale] : units) {
+    auto type = arrow::timestamp(unit);
+    arrow::TimestampBuilder builder(type, arrow::default_memory_pool());
+    for (size_t i = 0; i < seconds.size(); ++i) {
+      ARROW_THROW_NOT_OK(i == 1 ? builder.AppendNull()
+                                : builder.Append(seconds[i] * scale + (int64_t)i));
+    }
+    fields.push_back(arrow::field("ts" + std::to_string(fields.size()), type));
+    columns.emplace_back();
+    ARROW_THROW_NOT_OK(builder.Finish(&columns.back()));
+  }
+  getStorage()->importArrowTable(arrow::Table::Make(arrow::schema(fields), columns),
+                                 "test_ts",
+                                 ArrowStorage::TableOptions{2});
+
+  auto res = runSqlQuery("select * from test_ts;", ExecutorDeviceType::CPU, false);
+  auto token = res.getToken();
+  ASSERT_EQ(token->resultSetCount(), (size_t)3);
+  auto table = token->toArrow();
+  ASSERT_EQ(table->num_columns(), 3);
+  ASSERT_EQ((size_t)table->num_rows(), seconds.size());
+  for (int col_idx = 0; col_idx < table->num_columns(); ++col_idx) {
+    auto [unit, scale] = units[col_idx];
+    auto col = table->column(col_idx);
+    ASSERT_TRUE(col->type()->Equals(arrow::timestamp(unit)));
+    ASSERT_EQ((size_t)col->num_chunks(), token->resultSetCount());
+    size_t row_idx = 0;
+    for (int chunk_idx = 0; chunk_idx < col->num_chunks(); ++chunk_idx) {
+      // Values are not copied, the Arrow array refers to the result set buffer.
+      auto rs = token->resultSet(chunk_idx);
+      ASSERT_TRUE(rs->isChunkedZeroCopyColumnarConversionPossible(col_idx));
+      auto rs_buffers = rs->getChunkedColumnarBuffer(col_idx);
+      ASSERT_EQ(rs_buffers.size(), (size_t)1);
+      auto chunk = col->chunk(chunk_idx);
+      ASSERT_EQ(chunk->data()->buffers[1]->data(),
+                reinterpret_cast<const uint8_t*>(rs_buffers.front().first));
+
+      auto ts_chunk = std::static_pointer_cast<arrow::TimestampArray>(chunk);
+      for (int64_t i = 0; i < ts_chunk->length(); ++i, ++row_idx) {
+        if (row_idx == 1) {
+          ASSERT_TRUE(ts_chunk->IsNull(i));
+        } else {
+          ASSERT_FALSE(ts_chunk->IsNull(i));
+          ASSERT_EQ(ts_chunk->Value(i), seconds[row_idx] * scale + (int64_t)row_idx);
+        }
+      }
+    }
+    ASSERT_EQ(row_idx, seconds.size());
+  }
+}
+
+TEST(ArrowTable, MultifragResultReader) {
+  bool prev_enable_multifrag_execution_result =
+      config().exec.enable_multifrag_execution_result;
+  ScopeGuard reset = [prev_enable_multifrag_execution_result] {
+    config().exec.enable_multifrag_execution_result =
+        prev_enable_multifrag_execution_result;
+  };
+
+  config().exec.enable_multifrag_execution_result = true;
+
+  auto res = runSqlQuery("select * from test_chunked;", ExecutorDeviceType::CPU, false);
+  CHECK_EQ(res.getToken()->resultSetCount(), (size_t)2);
+  auto reader = res.getToken()->toArrowReader(2);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+  while (batch) {
+    ASSERT_LE(batch->num_rows(), 2);
+    ASSERT_TRUE(batch->schema()->Equals(*reader->schema()));
+    batches.push_back(batch);
+    ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+  }
+  ARROW_ASSIGN_OR_THROW(auto table, arrow::Table::FromRecordBatches(batches));
+  CHECK_EQ((size_t)table->num_rows(), res.getToken()->rowCount());
   compare_columns(table6x4_col_i64, table->column(1));
   compare_columns(table6x4_col_bi, table->column(2));
   compare_columns(table6x4_col_d, table->column(3));
@@ -38,6 +38,12 @@ cdef extern from "omniscidb/QueryBuilder/QueryBuilder.h":
     CBuilderExpr count(bool) except +
     CBuilderExpr approxCountDist() except +
     CBuilderExpr approxQuantile(double) except +
+    CBuilderExpr percentileCont(double) except +
+    CBuilderExpr percentileDisc(double) except +
+    CBuilderExpr median() except +
+    CBuilderExpr hllSketch(int) except +
+    CBuilderExpr hllMerge(int) except +
+    CBuilderExpr hllMergeCount(int) except +
     CBuilderExpr sample() except +
     CBuilderExpr singleValue() except +
     CBuilderExpr stdDev() except +
@@ -86,6 +86,55 @@ cdef class QueryExpr:
     res.c_expr = self.c_expr.approxQuantile(prob)
     return res
 
+  def percentile_cont(self, prob):
+    if not isinstance(prob, (float, int)):
+      raise TypeError(f"Float number expected for 'prob' argument. Provided: {type(prob)}.")
+    prob = float(prob)
+    if prob < 0.0 or prob > 1.0:
+      raise ValueError(f"Expected 'prob' to be in [0, 1] range. Provided: {prob}.")
+    res = QueryExpr();
+    res.c_expr = self.c_expr.percentileCont(prob)
+    return res
+
+  def percentile_disc(self, prob):
+    if not isinstance(prob, (float, int)):
+      raise TypeError(f"Float number expected for 'prob' argument. Provided: {type(prob)}.")
+    prob = float(prob)
+    if prob < 0.0 or prob > 1.0:
+      raise ValueError(f"Expected 'prob' to be in [0, 1] range. Provided: {prob}.")
+    res = QueryExpr();
+    res.c_expr = self.c_expr.percentileDisc(prob)
+    return res
+
+  def median(self):
+    res = QueryExpr();
+    res.c_expr = self.c_expr.median()
+    return res
+
+  def _hll_precision(self, precision):
+    if precision is None:
+      return 0
+    if not isinstance(precision, int):
+      raise TypeError(f"Integer expected for 'precision' argument. Provided: {type(precision)}.")
+    if precision < 4 or precision > 16:
+      raise ValueError(f"Expected 'precision' to be in [4, 16] range. Provided: {precision}.")
+    return precision
+
+  def hll_sketch(self, precision=None):
+    res = QueryExpr();
+    res.c_expr = self.c_expr.hllSketch(self._hll_precision(precision))
+    return res
+
+  def hll_merge(self, precision=None):
+    res = QueryExpr();
+    res.c_expr = self.c_expr.hllMerge(self._hll_precision(precision))
+    return res
+
+  def hll_merge_count(self, precision=None):
+    res = QueryExpr();
+    res.c_expr = self.c_expr.hllMergeCount(self._hll_precision(precision))
+    return res
+
   def sample(self):
     res = QueryExpr();
     res.c_expr = self.c_expr.sample()
@@ -186,6 +186,7 @@ cdef extern from "omniscidb/Shared/Config.h":
     CCodegenConfig codegen
     size_t streaming_topn_max
     size_t parallel_top_min
+    bool enable_top_n_fragment_pruning
     bool enable_experimental_string_functions
     bool enable_interop
     size_t parallel_linearization_threshold
@@ -233,9 +234,13 @@ cdef extern from "omniscidb/Shared/Config.h":
     bool use_hashtable_cache
     size_t hashtable_cache_total_bytes
     size_t max_cacheable_hashtable_size_bytes
+    bool use_query_resultset_cache
+    size_t query_resultset_cache_total_bytes
+    size_t max_query_resultset_size_bytes
     double gpu_fraction_code_cache_to_evict
     size_t dag_cache_size
     size_t code_cache_size
+    size_t cardinality_cache_size
 
   cdef cppclass CDebugConfig "DebugConfig":
     string build_ra_cache
@@ -3,12 +3,14 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
+from libc.stdint cimport int64_t
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 
 from pyarrow.lib cimport CTable as CArrowTable
+from pyarrow.lib cimport CRecordBatchReader
 
 from pyhdk._common cimport CConfig, CType
 from pyhdk._storage cimport CSchemaProvider, CSchemaProviderPtr, CDataProvider, CDataMgr, CBufferProvider
@@ -56,6 +58,7 @@ cdef extern from "omniscidb/ResultSetRegistry/ResultSetTableToken.h":
   cdef cppclass CResultSetTableToken "hdk::ResultSetTableToken":
     size_t rowCount()
     shared_ptr[CArrowTable] toArrow() except +
+    shared_ptr[CRecordBatchReader] toArrowReader(int64_t) except +
     string description()
     string memoryDescription()
     string contentToString(bool)
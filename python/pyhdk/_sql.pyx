@@ -3,13 +3,16 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
-from libc.stdint cimport int64_t
+from libc.stdint cimport int64_t, uintptr_t
 from libcpp.memory cimport make_shared, make_unique
 from libcpp.utility cimport move
 from cython.operator cimport dereference, preincrement, address
 
 from pyarrow.lib cimport pyarrow_wrap_table
 from pyarrow.lib cimport CTable as CArrowTable
+from pyarrow.lib cimport CRecordBatchReader, ArrowArrayStream, ExportRecordBatchReader
+from pyarrow.lib cimport check_status
+import pyarrow
 
 from pyhdk._common cimport CConfig, Config, boost_get, CType, CArrayBaseType
 from pyhdk._storage cimport SchemaProvider, CDataMgr, DataMgr
@@ -82,6 +85,14 @@ cdef class ExecutionResult:
     cdef shared_ptr[CArrowTable] at = c_token.get().toArrow()
     return pyarrow_wrap_table(at)
 
+  def to_arrow_reader(self, max_chunk_size=0):
+    cdef CResultSetTableTokenPtr c_token = self.c_result.getToken()
+    cdef shared_ptr[CRecordBatchReader] c_reader = c_token.get().toArrowReader(max_chunk_size)
+    # Exported stream owns the reader and is moved to the Python reader on import.
+    cdef ArrowArrayStream c_stream
+    check_status(ExportRecordBatchReader(c_reader, &c_stream))
+    return pyarrow.RecordBatchReader._import_from_c(<uintptr_t>&c_stream)
+
   def to_explain_str(self):
     return self.c_result.getExplanation()
 
@@ -4,6 +4,7 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from libcpp cimport bool
+from libc.stdint cimport int64_t
 from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
 from libcpp.vector cimport vector
@@ -139,6 +140,8 @@ cdef extern from "omniscidb/ArrowStorage/ArrowStorage.h":
     CTableInfoPtr appendCsvFile(string&, string&, CCsvParseOptions) except +
     CTableInfoPtr importParquetFile(string&, string&, CTableOptions&) except +
     CTableInfoPtr appendParquetFile(string&, string&) except +
+    void deleteRows(const string&, const vector[int64_t]&) except +
+    void updateRows(shared_ptr[CArrowTable], const vector[int64_t]&, const string&) except +
     void dropTable(const string&, bool) except +;
 
     int dbId() const
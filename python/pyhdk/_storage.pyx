@@ -4,6 +4,7 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from libcpp cimport bool
+from libc.stdint cimport int64_t
 from libcpp.memory cimport shared_ptr, make_shared, static_pointer_cast
 from libcpp.string cimport string
 from libcpp.vector cimport vector
@@ -354,6 +355,13 @@ cdef class ArrowStorage(Storage):
   def appendParquetFile(self, file_name, table_name):
     self.c_storage.get().appendParquetFile(file_name, table_name)
 
+  def deleteRows(self, string name, vector[int64_t] row_ids):
+    self.c_storage.get().deleteRows(name, row_ids)
+
+  def updateRows(self, table, vector[int64_t] row_ids, string name):
+    cdef shared_ptr[CArrowTable] at = pyarrow_unwrap_table(table)
+    self.c_storage.get().updateRows(at, row_ids, name)
+
   def dropTable(self, string name, bool throw_if_not_exist = False):
     self.c_storage.get().dropTable(name, throw_if_not_exist)
 
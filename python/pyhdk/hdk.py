@@ -223,6 +223,154 @@ class QueryExprAPI:
         """
         pass
 
+    def percentile_cont(self, prob):
+        """
+        Create PERCENTILE_CONT aggregate expression with the current expression
+        as its argument. The result is exact and linearly interpolated between
+        two closest values.
+
+        Parameters
+        ----------
+        prob : float
+            Quantile probability. Should be in [0, 1] range.
+
+        Returns
+        -------
+        QueryExpr
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"id": [1, 2, 1, 2, 1, 2], "x": [4, 7, 9, 11, 5, 13]})
+        >>> ht.agg(["id"], ht["x"].percentile_cont(0.25)).run()
+        Schema:
+          id: INT64
+          x_percentile_cont: FP64
+        Data:
+        1|4.5
+        2|9
+        """
+        pass
+
+    def percentile_disc(self, prob):
+        """
+        Create PERCENTILE_DISC aggregate expression with the current expression
+        as its argument. The result is the first value whose cumulative
+        distribution is not less than the requested probability.
+
+        Parameters
+        ----------
+        prob : float
+            Quantile probability. Should be in [0, 1] range.
+
+        Returns
+        -------
+        QueryExpr
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"id": [1, 2, 1, 2, 1, 2], "x": [4, 7, 9, 11, 5, 13]})
+        >>> ht.agg(["id"], ht["x"].percentile_disc(0.25)).run()
+        Schema:
+          id: INT64
+          x_percentile_disc: FP64
+        Data:
+        1|4
+        2|7
+        """
+        pass
+
+    def median(self):
+        """
+        Create exact MEDIAN aggregate expression with the current expression as
+        its argument. It is equivalent to PERCENTILE_CONT with 0.5 probability.
+
+        Returns
+        -------
+        QueryExpr
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"id": [1, 2, 1, 2, 1, 2, 2], "x": [4, 7, 9, 11, 5, 13, 8]})
+        >>> ht.agg(["id"], ht["x"].median()).run()
+        Schema:
+          id: INT64
+          x_median: FP64
+        Data:
+        1|5
+        2|9.5
+        """
+        pass
+
+    def hll_sketch(self, precision=None):
+        """
+        Create HLL_SKETCH aggregate expression with the current expression as
+        its argument. The result is a TINYINT array holding HyperLogLog registers
+        which can be stored and later combined by HLL_MERGE and HLL_MERGE_COUNT.
+
+        Parameters
+        ----------
+        precision : int, default: None
+            Number of bits used for register index. Should be in [4, 16] range.
+            The configured default precision is used if not specified.
+
+        Returns
+        -------
+        QueryExpr
+        """
+        pass
+
+    def hll_merge(self, precision=None):
+        """
+        Create HLL_MERGE aggregate expression with the current expression as
+        its argument. The current expression should hold sketches produced by
+        HLL_SKETCH. The result is a sketch built from the union of merged ones.
+        Sketches with a higher precision are folded to the requested one, a
+        lower precision causes a query error.
+
+        Parameters
+        ----------
+        precision : int, default: None
+            Number of bits used for register index. Should be in [4, 16] range.
+            The configured default precision is used if not specified.
+
+        Returns
+        -------
+        QueryExpr
+        """
+        pass
+
+    def hll_merge_count(self, precision=None):
+        """
+        Create HLL_MERGE_COUNT aggregate expression with the current expression
+        as its argument. It merges sketches the same way HLL_MERGE does and
+        returns the estimated number of distinct values.
+
+        Parameters
+        ----------
+        precision : int, default: None
+            Number of bits used for register index. Should be in [4, 16] range.
+            The configured default precision is used if not specified.
+
+        Returns
+        -------
+        QueryExpr
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"id": [1, 2, 1, 2], "x": [4, 7, 9, 7]})
+        >>> sketches = hdk.import_arrow(ht.agg(["id"], ht["x"].hll_sketch()).run().to_arrow())
+        >>> sketches.agg([], sketches["x_hll_sketch"].hll_merge_count()).run()
+        Schema:
+          x_hll_sketch_hll_merge_count: INT64[NN]
+        Data:
+        3
+        """
+        pass
+
     def sample(self):
         """
         Create SAMPLE aggregate expression with the current expression as its
@@ -1960,6 +2108,87 @@ class HDK:
                 f"Only str and QueryNode scans are allowed for 'table' arg. Provided: {table}"
             )
 
+    def delete_rows(self, table, row_ids):
+        """
+        Delete rows from existing table in HDK in-memory storage.
+
+        Only table fragments holding deleted rows are rewritten. Rowids of rows
+        following deleted ones are shifted.
+
+        Parameters
+        ----------
+        table : str or QueryNode
+            Name of the table or a scan node referencing the table.
+        row_ids : list of int
+            Values of the 'rowid' virtual column for rows to delete.
+
+        Returns
+        -------
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"a": [1, 2, 3]})
+        >>> hdk.delete_rows(ht, [1])
+        >>> ht.proj("a").run()
+        Schema:
+          a: INT64
+        Data:
+        1
+        3
+        """
+        if isinstance(table, QueryNode) and table.is_scan:
+            table = table.table_name
+
+        if not isinstance(table, str):
+            raise TypeError(
+                f"Only str and QueryNode scans are allowed for 'table' arg. Provided: {table}"
+            )
+        self._storage.deleteRows(table, row_ids)
+
+    def update_rows(self, table, row_ids, values):
+        """
+        Set new values for rows of existing table in HDK in-memory storage.
+
+        Only table fragments holding updated rows are rewritten.
+
+        Parameters
+        ----------
+        table : str or QueryNode
+            Name of the table or a scan node referencing the table.
+        row_ids : list of int
+            Values of the 'rowid' virtual column for rows to update.
+        values : pyarrow.Table or dict
+            New values. Columns to update are chosen by column names. i-th
+            value in each column is used for the row with rowid row_ids[i].
+
+        Returns
+        -------
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"a": [1, 2, 3], "b": [10, 20, 30]})
+        >>> hdk.update_rows(ht, [0, 2], {"b": [100, 300]})
+        >>> ht.proj("b").run()
+        Schema:
+          b: INT64
+        Data:
+        100
+        20
+        300
+        """
+        if isinstance(table, QueryNode) and table.is_scan:
+            table = table.table_name
+
+        if not isinstance(table, str):
+            raise TypeError(
+                f"Only str and QueryNode scans are allowed for 'table' arg. Provided: {table}"
+            )
+        if isinstance(values, dict):
+            values = pyarrow.Table.from_pydict(values)
+        self._storage.updateRows(values, row_ids, table)
+
     def __verify_files_param(self, file_name):
         files = []
         if isinstance(file_name, str):
@@ -184,6 +184,33 @@ class TestBuilder(BaseTest):
         with pytest.raises(TypeError) as e:
             hdk.drop_table(1)
 
+    def test_delete_update_rows(self, exe_cfg):
+        hdk = pyhdk.init()
+        table_name = "table_test_delete_update_rows"
+
+        ht = hdk.import_pydict(
+            {"a": [1, 2, 3, 4, 5], "b": [10, 20, 30, 40, 50]},
+            table_name,
+            fragment_size=2,
+        )
+        hdk.delete_rows(ht, [1, 2])
+        check_res(
+            ht.proj("a", "b").sort("a").run(), {"a": [1, 4, 5], "b": [10, 40, 50]}
+        )
+
+        hdk.update_rows(table_name, [0, 2], {"b": [100, 500]})
+        check_res(
+            ht.proj("a", "b").sort("a").run(), {"a": [1, 4, 5], "b": [100, 40, 500]}
+        )
+
+        with pytest.raises(RuntimeError) as e:
+            hdk.delete_rows(ht, [3])
+        with pytest.raises(RuntimeError) as e:
+            hdk.update_rows(ht, [0], {"c": [1]})
+        with pytest.raises(TypeError) as e:
+            hdk.delete_rows(1, [0])
+        hdk.drop_table(ht)
+
     def test_type_from_str(self, exe_cfg):
         hdk = pyhdk.init()
         assert str(hdk.type("int")) == "INT64"
@@ -493,6 +520,30 @@ class TestBuilder(BaseTest):
             {"b": [1, 2], "a1": [1, 6], "a2": [3, 8], "a3": [5, 10]},
         )
 
+        check_res(
+            ht.agg(
+                ht.ref("b"),
+                p1=ht.ref("c").percentile_cont(0.3),
+                p2=ht.ref("c").percentile_disc(0.3),
+                p3=ht.ref("c").median(),
+                p4="percentile_disc(c, 1.0)",
+            )
+            .sort("b")
+            .run(device_type=exe_cfg.device_type),
+            {"b": [1, 2], "p1": [2.2, 7.2], "p2": [2, 7], "p3": [3, 8], "p4": [5, 10]},
+        )
+
+        sketches = ht.agg(["a", "b"], s=ht.ref("c").hll_sketch()).run(
+            device_type=exe_cfg.device_type
+        )
+        approx = ht.agg([], m=ht.ref("c").count(True, True)).run()
+        check_res(
+            sketches.agg([], m=sketches.ref("s").hll_merge_count()).run(),
+            {"m": approx.to_arrow().to_pandas()["m"].to_list()},
+        )
+        with pytest.raises(ValueError):
+            ht.ref("c").hll_sketch(20)
+
         check_res(
             ht.agg("b", s1="stddev(a)", s2=ht["c"].stddev())
             .sort("b")
@@ -68,6 +68,16 @@ class TestSql:
         assert df.shape == (1, 1)
         assert df["EXPR$0"].tolist()[0] == 2
 
+    def test_arrow_reader(self):
+        res = self.execute_sql("SELECT * FROM test;")
+        reader = res.to_arrow_reader(max_chunk_size=1)
+        batches = list(reader)
+        assert len(batches) == 3
+        assert all(batch.num_rows == 1 for batch in batches)
+        df = pyarrow.Table.from_batches(batches).to_pandas()
+        assert df["a"].tolist() == [1, 2, 3]
+        assert df["b"].tolist() == [10, 20, 30]
+
     def test_explain(self):
         res = self.execute_sql("SELECT * FROM test;", just_explain=True)
         explain_str = res.to_explain_str()